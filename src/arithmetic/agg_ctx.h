@@ -10,6 +10,8 @@ struct AggCtx {
     AggError *err;
     SIValue result;
     int (*Step)(struct AggCtx *ctx, SIValue *argv, int argc);
+    /* Steps as if argv was seen weight times, NULL if function only supports stepping once. */
+    int (*StepWeighted)(struct AggCtx *ctx, SIValue *argv, int argc, size_t weight);
     int (*ReduceNext)(struct AggCtx *ctx);
 };
 typedef struct AggCtx AggCtx;
@@ -13,7 +13,7 @@ typedef struct {
     double total;
 } __agg_sumCtx;
 
-int __agg_sumStep(AggCtx *ctx, SIValue *argv, int argc) {
+int __agg_sumStepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight) {
     // convert the value of the input sequence to a double if possible
     __agg_sumCtx *ac = Agg_FuncCtx(ctx);
 
@@ -29,13 +29,17 @@ int __agg_sumStep(AggCtx *ctx, SIValue *argv, int argc) {
             }
         }
 
-        ac->num++;
-        ac->total += n;
+        ac->num += weight;
+        ac->total += n * weight;
     }
 
     return AGG_OK;
 }
 
+int __agg_sumStep(AggCtx *ctx, SIValue *argv, int argc) {
+    return __agg_sumStepWeighted(ctx, argv, argc, 1);
+}
+
 int __agg_sumReduceNext(AggCtx *ctx) {
     __agg_sumCtx *ac = Agg_FuncCtx(ctx);
     Agg_SetResult(ctx, SI_DoubleVal(ac->total));
@@ -47,7 +51,9 @@ AggCtx* Agg_SumFunc() {
     ac->num = 0;
     ac->total = 0;
     
-    return Agg_Reduce(ac, __agg_sumStep, __agg_sumReduceNext);
+    AggCtx *agg = Agg_Reduce(ac, __agg_sumStep, __agg_sumReduceNext);
+    agg->StepWeighted = __agg_sumStepWeighted;
+    return agg;
 }
 
 //------------------------------------------------------------------------
@@ -57,7 +63,7 @@ typedef struct {
     double total;
 } __agg_avgCtx;
 
-int __agg_avgStep(AggCtx *ctx, SIValue *argv, int argc) {
+int __agg_avgStepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight) {
     // convert the value of the input sequence to a double if possible
     __agg_avgCtx *ac = Agg_FuncCtx(ctx);
 
@@ -74,13 +80,17 @@ int __agg_avgStep(AggCtx *ctx, SIValue *argv, int argc) {
         }
 
 
-        ac->count++;
-        ac->total += n;
+        ac->count += weight;
+        ac->total += n * weight;
     }
 
     return AGG_OK;
 }
 
+int __agg_avgStep(AggCtx *ctx, SIValue *argv, int argc) {
+    return __agg_avgStepWeighted(ctx, argv, argc, 1);
+}
+
 int __agg_avgReduceNext(AggCtx *ctx) {
     __agg_avgCtx *ac = Agg_FuncCtx(ctx);
 
@@ -97,7 +107,9 @@ AggCtx* Agg_AvgFunc() {
     ac->count = 0;
     ac->total = 0;
     
-    return Agg_Reduce(ac, __agg_avgStep, __agg_avgReduceNext);
+    AggCtx *agg = Agg_Reduce(ac, __agg_avgStep, __agg_avgReduceNext);
+    agg->StepWeighted = __agg_avgStepWeighted;
+    return agg;
 }
 
 //------------------------------------------------------------------------
@@ -130,6 +142,11 @@ int __agg_maxStep(AggCtx *ctx, SIValue *argv, int argc) {
     return AGG_OK;
 }
 
+/* Repeated values don't affect the maximum. */
+int __agg_maxStepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight) {
+    return __agg_maxStep(ctx, argv, argc);
+}
+
 int __agg_maxReduceNext(AggCtx *ctx) {
     __agg_maxCtx *ac = Agg_FuncCtx(ctx);
     Agg_SetResult(ctx, SI_DoubleVal(ac->max));
@@ -140,7 +157,9 @@ AggCtx* Agg_MaxFunc() {
     __agg_maxCtx *ac = malloc(sizeof(__agg_maxCtx));
     ac->max = -DBL_MAX;
     
-    return Agg_Reduce(ac, __agg_maxStep, __agg_maxReduceNext);
+    AggCtx *agg = Agg_Reduce(ac, __agg_maxStep, __agg_maxReduceNext);
+    agg->StepWeighted = __agg_maxStepWeighted;
+    return agg;
 }
 
 //------------------------------------------------------------------------
@@ -173,6 +192,11 @@ int __agg_minStep(AggCtx *ctx, SIValue *argv, int argc) {
     return AGG_OK;
 }
 
+/* Repeated values don't affect the minimum. */
+int __agg_minStepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight) {
+    return __agg_minStep(ctx, argv, argc);
+}
+
 int __agg_minReduceNext(AggCtx *ctx) {
     __agg_minCtx *ac = Agg_FuncCtx(ctx);
     Agg_SetResult(ctx, SI_DoubleVal(ac->min));
@@ -183,7 +207,9 @@ AggCtx* Agg_MinFunc() {
     __agg_minCtx *ac = malloc(sizeof(__agg_minCtx));
     ac->min = DBL_MAX;
     
-    return Agg_Reduce(ac, __agg_minStep, __agg_minReduceNext);
+    AggCtx *agg = Agg_Reduce(ac, __agg_minStep, __agg_minReduceNext);
+    agg->StepWeighted = __agg_minStepWeighted;
+    return agg;
 }
 
 //------------------------------------------------------------------------
@@ -192,13 +218,17 @@ typedef struct {
     size_t count;
 } __agg_countCtx;
 
-int __agg_countStep(AggCtx *ctx, SIValue *argv, int argc) {
+int __agg_countStepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight) {
     __agg_countCtx *ac = Agg_FuncCtx(ctx);
-    ac->count += argc;
+    ac->count += argc * weight;
 
     return AGG_OK;
 }
 
+int __agg_countStep(AggCtx *ctx, SIValue *argv, int argc) {
+    return __agg_countStepWeighted(ctx, argv, argc, 1);
+}
+
 int __agg_countReduceNext(AggCtx *ctx) {
     __agg_countCtx *ac = Agg_FuncCtx(ctx);
     Agg_SetResult(ctx, SI_DoubleVal(ac->count));
@@ -209,7 +239,9 @@ AggCtx* Agg_CountFunc() {
     __agg_countCtx *ac = malloc(sizeof(__agg_countCtx));
     ac->count = 0;
     
-    return Agg_Reduce(ac, __agg_countStep, __agg_countReduceNext);
+    AggCtx *agg = Agg_Reduce(ac, __agg_countStep, __agg_countReduceNext);
+    agg->StepWeighted = __agg_countStepWeighted;
+    return agg;
 }
 
 //------------------------------------------------------------------------
@@ -13,6 +13,7 @@ AggCtx *Agg_NewCtx(void *fctx) {
     ac->fctx = fctx;
     ac->result = SI_NullVal();
     ac->Step = NULL;
+    ac->StepWeighted = NULL;
     ac->ReduceNext = NULL;
     return ac;
 }
@@ -34,6 +35,14 @@ int Agg_Step(AggCtx *ctx, SIValue *argv, int argc) {
   return ctx->Step(ctx, argv, argc);
 }
 
+int Agg_StepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight) {
+  if(ctx->StepWeighted) return ctx->StepWeighted(ctx, argv, argc, weight);
+
+  int res = AGG_OK;
+  for(size_t i = 0; i < weight && res == AGG_OK; i++) res = ctx->Step(ctx, argv, argc);
+  return res;
+}
+
 int Agg_Finalize(AggCtx *ctx) {
   return ctx->ReduceNext(ctx);
 }
@@ -27,6 +27,8 @@ void *Agg_FuncCtx(AggCtx *ctx);
 void Agg_SetResult(AggCtx *ctx, SIValue v);
 
 int Agg_Step(AggCtx *ctx, SIValue *argv, int argc);
+/* Steps as if argv was seen weight times. */
+int Agg_StepWeighted(AggCtx *ctx, SIValue *argv, int argc, size_t weight);
 int Agg_Finalize(AggCtx *ctx);
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "./repository.h"
 #include "../dep/rax/rax.h"
 #include "./arithmetic_expression.h"
+#include "../index/geo_index.h"
 
 #include "assert.h"
 #include <math.h>
@@ -49,6 +50,10 @@ SIValue AR_EXP_Evaluate(const AR_ExpNode *root) {
 }
 
 void AR_EXP_Aggregate(const AR_ExpNode *root) {
+    AR_EXP_AggregateWeighted(root, 1);
+}
+
+void AR_EXP_AggregateWeighted(const AR_ExpNode *root, size_t weight) {
 
     if(root->type == AR_EXP_OP) {
         if(root->op.type == AR_OP_AGGREGATE) {
@@ -62,12 +67,12 @@ void AR_EXP_Aggregate(const AR_ExpNode *root) {
 
             /* Aggregate. */
             AggCtx *agg = root->op.agg_func;
-            agg->Step(agg, sub_trees, root->op.child_count);
+            Agg_StepWeighted(agg, sub_trees, root->op.child_count, weight);
         } else {
             /* Keep searching for aggregation nodes. */
             for(int i = 0; i < root->op.child_count; i++) {
                 AR_ExpNode *child = root->op.children[i];
-                AR_EXP_Aggregate(child);
+                AR_EXP_AggregateWeighted(child, weight);
             }
         }
     }
@@ -353,6 +358,16 @@ SIValue AR_SIGN(SIValue *argv, int argc) {
     }
 }
 
+SIValue AR_DISTANCE(SIValue *argv, int argc) {
+    assert(argc == 4);
+    double coords[4];
+    for(int i = 0; i < 4; i++) {
+        if(!(argv[i].type & SI_NUMERIC)) return SI_NullVal();
+        SIValue_ToDouble(&argv[i], &coords[i]);
+    }
+    return SI_DoubleVal(Geo_Distance(coords[0], coords[1], coords[2], coords[3]));
+}
+
 /* String functions */
 
 SIValue AR_LEFT(SIValue *argv, int argc) {
@@ -622,6 +637,10 @@ void AR_RegisterFuncs() {
     AR_RegFunc(lower_func_name, lower_func_name_len, AR_SIGN);
     lower_func_name_len = 32;
 
+    _toLower("distance", &lower_func_name[0], &lower_func_name_len);
+    AR_RegFunc(lower_func_name, lower_func_name_len, AR_DISTANCE);
+    lower_func_name_len = 32;
+
 
     /* String operations. */
     _toLower("left", &lower_func_name[0], &lower_func_name_len);
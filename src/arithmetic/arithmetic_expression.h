@@ -45,6 +45,7 @@ SIValue AR_FLOOR(SIValue *argv, int argc); /* returns the largest floating point
 SIValue AR_RAND(SIValue *argv, int argc);  /* returns a random floating point number in the range from 0 to 1; i.e. [0,1]. The numbers returned follow an approximate uniform distribution. */
 SIValue AR_ROUND(SIValue *argv, int argc); /* returns the value of the given number rounded to the nearest integer. */
 SIValue AR_SIGN(SIValue *argv, int argc);  /* returns the signum of the given number: 0 if the number is 0, -1 for any negative number, and 1 for any positive number. */
+SIValue AR_DISTANCE(SIValue *argv, int argc); /* returns the distance in meters between two latitude, longitude points. */
 
 /* String functions */
 SIValue AR_LEFT(SIValue *argv, int argc);      /* returns a string containing the specified number of leftmost characters of the original string. */
@@ -111,6 +112,8 @@ typedef struct AR_ExpNode AR_ExpNode;
 /* Evaluate arithmetic expression tree. */
 SIValue AR_EXP_Evaluate(const AR_ExpNode *root);
 void AR_EXP_Aggregate(const AR_ExpNode *root);
+/* Aggregates as if current values were seen weight times. */
+void AR_EXP_AggregateWeighted(const AR_ExpNode *root, size_t weight);
 void AR_EXP_Reduce(const AR_ExpNode *root);
 
 /* Create arithmetic expression node. */
@@ -0,0 +1,485 @@
+#include <assert.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/param.h>
+#include "bytecode.h"
+#include "../parser/grammar.h"
+#include "../index/geo_index.h"
+
+/* Load already emitted, reused by later references to the same entity property. */
+typedef struct {
+    BC_OpCode op;
+    GraphEntity **entity;
+    const char *property;
+    int reg;
+} _BC_LoadEntry;
+
+typedef struct {
+    BC_Program *program;
+    const Graph *g;             /* Resolves filter aliases, NULL for expressions. */
+    _BC_LoadEntry *loads;
+    int load_count;
+    char *constant;             /* Per register, set at compile time. */
+} _BC_Compiler;
+
+static BC_Program* _BC_NewProgram() {
+    BC_Program *program = calloc(1, sizeof(BC_Program));
+    program->result = -1;
+    return program;
+}
+
+static int _BC_Emit(_BC_Compiler *c, BC_OpCode op) {
+    BC_Program *p = c->program;
+    if(p->code_len == p->code_cap) {
+        p->code_cap = (p->code_cap) ? p->code_cap * 2 : 16;
+        p->code = realloc(p->code, sizeof(BC_Instruction) * p->code_cap);
+    }
+    memset(&p->code[p->code_len], 0, sizeof(BC_Instruction));
+    p->code[p->code_len].op = op;
+    p->code[p->code_len].target = -1;
+    return p->code_len++;
+}
+
+static int _BC_NewRegister(_BC_Compiler *c) {
+    BC_Program *p = c->program;
+    int reg = p->register_count++;
+    p->registers = realloc(p->registers, sizeof(SIValue) * p->register_count);
+    p->loaded = realloc(p->loaded, sizeof(uint64_t) * p->register_count);
+    c->constant = realloc(c->constant, sizeof(char) * p->register_count);
+    p->registers[reg] = SI_NullVal();
+    p->loaded[reg] = 0;
+    c->constant[reg] = 0;
+    return reg;
+}
+
+static int _BC_ConstantRegister(_BC_Compiler *c, SIValue v) {
+    int reg = _BC_NewRegister(c);
+    c->program->registers[reg] = v;
+    c->constant[reg] = 1;
+    return reg;
+}
+
+/* Emits a load of entity's property or id, entities and properties
+ * loaded once share a register, filter loads fail predicate on unbound entities. */
+static int _BC_EmitLoad(_BC_Compiler *c, BC_OpCode op, GraphEntity **entity, const char *property, int fail) {
+    int reg = -1;
+    for(int i = 0; i < c->load_count; i++) {
+        _BC_LoadEntry *l = &c->loads[i];
+        if(l->op == op && l->entity == entity &&
+           ((l->property == NULL && property == NULL) ||
+            (l->property && property && strcmp(l->property, property) == 0))) {
+            reg = l->reg;
+            break;
+        }
+    }
+
+    if(reg == -1) {
+        reg = _BC_NewRegister(c);
+        c->loads = realloc(c->loads, sizeof(_BC_LoadEntry) * (c->load_count + 1));
+        c->loads[c->load_count++] = (_BC_LoadEntry){.op = op, .entity = entity, .property = property, .reg = reg};
+    } else if(!fail) {
+        /* Expressions are straight line code, first load dominates. */
+        return reg;
+    }
+
+    int idx = _BC_Emit(c, op);
+    BC_Instruction *inst = &c->program->code[idx];
+    inst->dst = reg;
+    inst->load.entity = entity;
+    inst->load.property = (char*)property;
+    return reg;
+}
+
+/* Points the pending loads emitted since first, at target. */
+static void _BC_PatchLoads(_BC_Compiler *c, int first, int target) {
+    for(int i = first; i < c->program->code_len; i++) {
+        BC_Instruction *inst = &c->program->code[i];
+        if(inst->op == BC_LOAD_PROPERTY || inst->op == BC_LOAD_ID) inst->target = target;
+    }
+}
+
+static void _BC_CompilePredicate(_BC_Compiler *c, const FT_FilterNode *node) {
+    const FT_PredicateNode *pred = &node->pred;
+    int first = c->program->code_len;
+
+    GraphEntity **lhs_entity = Graph_GetEntityRef(c->g, pred->Lop.alias);
+    GraphEntity **rhs_entity = (pred->t == FT_N_VARYING) ? Graph_GetEntityRef(c->g, pred->Rop.alias) : NULL;
+    if(lhs_entity == NULL || (pred->t == FT_N_VARYING && rhs_entity == NULL)) {
+        _BC_Emit(c, BC_FALSE);
+        return;
+    }
+
+    int idx;
+    if(pred->t == FT_N_ID) {
+        int src = _BC_EmitLoad(c, BC_LOAD_ID, lhs_entity, NULL, 1);
+        idx = _BC_Emit(c, BC_CMP_LONG);
+        c->program->code[idx].src = src;
+        c->program->code[idx].l = pred->constVal.longval;
+    } else if(pred->t == FT_N_DISTANCE) {
+        int lat = _BC_EmitLoad(c, BC_LOAD_PROPERTY, lhs_entity, pred->Lop.property, 1);
+        int lon = _BC_EmitLoad(c, BC_LOAD_PROPERTY, lhs_entity, pred->origin.lon_property, 1);
+        idx = _BC_Emit(c, BC_DISTANCE);
+        c->program->code[idx].src = lat;
+        c->program->code[idx].rhs = lon;
+        c->program->code[idx].origin.lat = pred->origin.lat;
+        c->program->code[idx].origin.lon = pred->origin.lon;
+        c->program->code[idx].origin.distance = pred->constVal.doubleval;
+    } else {
+        int rhs;
+        if(pred->t == FT_N_CONSTANT) {
+            rhs = _BC_ConstantRegister(c, pred->constVal);
+        } else {
+            rhs = _BC_EmitLoad(c, BC_LOAD_PROPERTY, rhs_entity, pred->Rop.property, 1);
+        }
+        int src = _BC_EmitLoad(c, BC_LOAD_PROPERTY, lhs_entity, pred->Lop.property, 1);
+
+        /* Specialize comparison by constant's type. */
+        BC_OpCode op = BC_CMP;
+        if(pred->op == STARTS) op = BC_STARTS_WITH;
+        else if(pred->t == FT_N_CONSTANT && pred->constVal.type == T_DOUBLE && pred->cf == cmp_double) op = BC_CMP_DOUBLE;
+        else if(pred->t == FT_N_CONSTANT && pred->constVal.type == T_STRING && pred->cf == cmp_string) op = BC_CMP_STRING;
+
+        idx = _BC_Emit(c, op);
+        BC_Instruction *inst = &c->program->code[idx];
+        inst->src = src;
+        inst->rhs = rhs;
+        inst->cf = pred->cf;
+        if(op == BC_CMP_DOUBLE) {
+            inst->d = pred->constVal.doubleval;
+        } else if(op == BC_CMP_STRING) {
+            inst->str.s = pred->constVal.stringval;
+            inst->str.len = strlen(pred->constVal.stringval);
+        }
+    }
+    c->program->code[idx].rel = pred->op;
+
+    /* Unbound entities fail the predicate, skipping its comparison. */
+    _BC_PatchLoads(c, first, idx + 1);
+}
+
+static void _BC_CompileFilter(_BC_Compiler *c, const FT_FilterNode *node) {
+    if(node->t == FT_N_PRED) {
+        _BC_CompilePredicate(c, node);
+        return;
+    }
+
+    /* Short circuit, left operand decides conditions it fails (AND) or passes (OR). */
+    _BC_CompileFilter(c, node->cond.left);
+    int jump = _BC_Emit(c, (node->cond.op == AND) ? BC_JUMP_IF_FALSE : BC_JUMP_IF_TRUE);
+    _BC_CompileFilter(c, node->cond.right);
+    c->program->code[jump].target = c->program->code_len;
+}
+
+static void _BC_CompilerFree(_BC_Compiler *c) {
+    free(c->loads);
+    free(c->constant);
+}
+
+BC_Program* BC_CompileFilter(const FT_FilterNode *root, const Graph *g) {
+    if(root == NULL) return NULL;
+
+    _BC_Compiler c = {.program = _BC_NewProgram(), .g = g, .loads = NULL,
+                      .load_count = 0, .constant = NULL};
+    _BC_CompileFilter(&c, root);
+    _BC_Emit(&c, BC_RETURN);
+    _BC_CompilerFree(&c);
+    return c.program;
+}
+
+/* Numeric functions over numeric constants are folded,
+ * these neither allocate nor depend on anything but their arguments. */
+static int _BC_Foldable(_BC_Compiler *c, AR_Func f, const int *args, int argc) {
+    if(f != AR_ADD && f != AR_SUB && f != AR_MUL && f != AR_DIV && f != AR_ABS &&
+       f != AR_CEIL && f != AR_FLOOR && f != AR_ROUND && f != AR_SIGN) return 0;
+
+    for(int i = 0; i < argc; i++) {
+        if(!c->constant[args[i]]) return 0;
+        if(!(c->program->registers[args[i]].type & SI_NUMERIC)) return 0;
+    }
+    return 1;
+}
+
+static int _BC_CompileExpression(_BC_Compiler *c, const AR_ExpNode *node) {
+    if(node->type == AR_EXP_OPERAND) {
+        if(node->operand.type == AR_EXP_CONSTANT) return _BC_ConstantRegister(c, node->operand.constant);
+        if(node->operand.variadic.entity_prop == NULL) {
+            return _BC_EmitLoad(c, BC_LOAD_ENTITY, node->operand.variadic.entity, NULL, 0);
+        }
+        return _BC_EmitLoad(c, BC_LOAD_PROPERTY, node->operand.variadic.entity, node->operand.variadic.entity_prop, 0);
+    }
+
+    if(node->op.type == AR_OP_AGGREGATE) {
+        int reg = _BC_NewRegister(c);
+        int idx = _BC_Emit(c, BC_LOAD_AGGREGATE);
+        c->program->code[idx].dst = reg;
+        c->program->code[idx].agg = node->op.agg_func;
+        return reg;
+    }
+
+    int argc = node->op.child_count;
+    int *args = malloc(sizeof(int) * MAX(argc, 1));
+    for(int i = 0; i < argc; i++) args[i] = _BC_CompileExpression(c, node->op.children[i]);
+    if(argc > c->program->max_argc) {
+        c->program->max_argc = argc;
+        c->program->args = realloc(c->program->args, sizeof(SIValue) * argc);
+    }
+
+    if(_BC_Foldable(c, node->op.f, args, argc)) {
+        for(int i = 0; i < argc; i++) c->program->args[i] = c->program->registers[args[i]];
+        SIValue v = node->op.f(c->program->args, argc);
+        free(args);
+        return _BC_ConstantRegister(c, v);
+    }
+
+    int reg = _BC_NewRegister(c);
+    int idx = _BC_Emit(c, BC_CALL);
+    c->program->code[idx].dst = reg;
+    c->program->code[idx].call.f = node->op.f;
+    c->program->code[idx].call.args = args;
+    c->program->code[idx].call.argc = argc;
+    return reg;
+}
+
+BC_Program* BC_CompileExpression(const AR_ExpNode *root) {
+    _BC_Compiler c = {.program = _BC_NewProgram(), .g = NULL, .loads = NULL,
+                      .load_count = 0, .constant = NULL};
+    c.program->result = _BC_CompileExpression(&c, root);
+    _BC_Emit(&c, BC_RETURN);
+    _BC_CompilerFree(&c);
+    return c.program;
+}
+
+static inline int _BC_Relation(int cmp, int rel) {
+    switch(rel) {
+        case EQ:
+            return cmp == 0;
+        case GT:
+            return cmp > 0;
+        case GE:
+            return cmp >= 0;
+        case LT:
+            return cmp < 0;
+        case LE:
+            return cmp <= 0;
+        default:
+            /* Relation should be enforced by AST. */
+            assert(0);
+    }
+    return 0;
+}
+
+/* Runs program, returns the flag set by its last comparison. */
+static int _BC_Run(BC_Program *p) {
+    SIValue *r = p->registers;
+    int flag = 0;
+    int pc = 0;
+    p->epoch++;
+
+    while(1) {
+        const BC_Instruction *inst = &p->code[pc++];
+        switch(inst->op) {
+            case BC_LOAD_PROPERTY: {
+                if(p->loaded[inst->dst] == p->epoch) break;
+                GraphEntity *entity = *inst->load.entity;
+                if(inst->target != -1 && (!entity || entity->id == INVALID_ENTITY_ID)) {
+                    flag = 0;
+                    pc = inst->target;
+                    break;
+                }
+                r[inst->dst] = *GraphEntity_Get_Property(entity, inst->load.property);
+                p->loaded[inst->dst] = p->epoch;
+                break;
+            }
+            case BC_LOAD_ID: {
+                if(p->loaded[inst->dst] == p->epoch) break;
+                GraphEntity *entity = *inst->load.entity;
+                if(!entity || entity->id == INVALID_ENTITY_ID) {
+                    flag = 0;
+                    pc = inst->target;
+                    break;
+                }
+                r[inst->dst] = SI_LongVal(entity->id);
+                p->loaded[inst->dst] = p->epoch;
+                break;
+            }
+            case BC_LOAD_ENTITY:
+                r[inst->dst] = SI_PtrVal(*inst->load.entity);
+                break;
+            case BC_LOAD_AGGREGATE:
+                r[inst->dst] = inst->agg->result;
+                break;
+            case BC_CALL:
+                for(int i = 0; i < inst->call.argc; i++) p->args[i] = r[inst->call.args[i]];
+                r[inst->dst] = inst->call.f(p->args, inst->call.argc);
+                break;
+            case BC_CMP_DOUBLE: {
+                const SIValue *v = &r[inst->src];
+                int cmp;
+                if(v->type == T_DOUBLE) cmp = (v->doubleval < inst->d) ? -1 : (v->doubleval > inst->d);
+                else cmp = inst->cf((void*)v, &r[inst->rhs]);
+                flag = _BC_Relation(cmp, inst->rel);
+                break;
+            }
+            case BC_CMP_LONG: {
+                int64_t id = r[inst->src].longval;
+                flag = _BC_Relation((id < inst->l) ? -1 : (id > inst->l), inst->rel);
+                break;
+            }
+            case BC_CMP_STRING: {
+                const SIValue *v = &r[inst->src];
+                int cmp;
+                if(v->type == T_STRING) {
+                    int len = strlen(v->stringval);
+                    cmp = strncasecmp(v->stringval, inst->str.s, MIN(len, inst->str.len));
+                    if(cmp == 0 && len != inst->str.len) cmp = (len > inst->str.len) ? 1 : -1;
+                } else {
+                    cmp = inst->cf((void*)v, &r[inst->rhs]);
+                }
+                flag = _BC_Relation(cmp, inst->rel);
+                break;
+            }
+            case BC_CMP:
+                flag = _BC_Relation(inst->cf(&r[inst->src], &r[inst->rhs]), inst->rel);
+                break;
+            case BC_STARTS_WITH: {
+                /* Case sensitive prefix match, applies to strings only. */
+                const SIValue *a = &r[inst->src];
+                const SIValue *b = &r[inst->rhs];
+                flag = (a->type == T_STRING && b->type == T_STRING &&
+                        strncmp(a->stringval, b->stringval, strlen(b->stringval)) == 0);
+                break;
+            }
+            case BC_DISTANCE: {
+                SIValue *lat = &r[inst->src];
+                SIValue *lon = &r[inst->rhs];
+                if(!(lat->type & SI_NUMERIC) || !(lon->type & SI_NUMERIC)) {
+                    flag = 0;
+                    break;
+                }
+                double entity_lat;
+                double entity_lon;
+                SIValue_ToDouble(lat, &entity_lat);
+                SIValue_ToDouble(lon, &entity_lon);
+                double d = Geo_Distance(entity_lat, entity_lon, inst->origin.lat, inst->origin.lon);
+                flag = _BC_Relation((d < inst->origin.distance) ? -1 : (d > inst->origin.distance), inst->rel);
+                break;
+            }
+            case BC_FALSE:
+                flag = 0;
+                break;
+            case BC_JUMP_IF_FALSE:
+                if(!flag) pc = inst->target;
+                break;
+            case BC_JUMP_IF_TRUE:
+                if(flag) pc = inst->target;
+                break;
+            case BC_RETURN:
+                return flag;
+        }
+    }
+}
+
+int BC_ApplyFilter(BC_Program *program) {
+    return _BC_Run(program) ? FILTER_PASS : FILTER_FAIL;
+}
+
+/* Number of values compared column wise at a time. */
+#define BC_COLUMN_CHUNK 256
+
+/* Program is a single comparison of ref's property against a double. */
+static int _BC_DoubleColumnFilter(const BC_Program *p, GraphEntity **ref) {
+    return (p->code_len == 3 &&
+            p->code[0].op == BC_LOAD_PROPERTY && p->code[0].load.entity == ref &&
+            p->code[1].op == BC_CMP_DOUBLE && p->code[1].src == p->code[0].dst &&
+            p->code[2].op == BC_RETURN);
+}
+
+/* Branch free loops, vectorized by the compiler,
+ * relations agree with cmp_double, for which unordered values are equal. */
+static void _BC_CompareColumn(const double *column, int count, double d, int rel, unsigned char *pass) {
+    switch(rel) {
+        case EQ:
+            for(int i = 0; i < count; i++) pass[i] = !(column[i] < d) & !(column[i] > d);
+            break;
+        case GT:
+            for(int i = 0; i < count; i++) pass[i] = (column[i] > d);
+            break;
+        case GE:
+            for(int i = 0; i < count; i++) pass[i] = !(column[i] < d);
+            break;
+        case LT:
+            for(int i = 0; i < count; i++) pass[i] = (column[i] < d);
+            break;
+        case LE:
+            for(int i = 0; i < count; i++) pass[i] = !(column[i] > d);
+            break;
+        default:
+            /* Relation should be enforced by AST. */
+            assert(0);
+    }
+}
+
+int BC_FilterBatch(BC_Program *program, GraphEntity **ref, GraphEntity **entities, int count, uint16_t *selection) {
+    GraphEntity *bound = *ref;
+    int selected = 0;
+
+    if(!_BC_DoubleColumnFilter(program, ref)) {
+        for(int i = 0; i < count; i++) {
+            *ref = entities[i];
+            selection[selected] = i;
+            selected += _BC_Run(program);
+        }
+        *ref = bound;
+        return selected;
+    }
+
+    const char *property = program->code[0].load.property;
+    const BC_Instruction *cmp = &program->code[1];
+    double column[BC_COLUMN_CHUNK];
+    unsigned char typed[BC_COLUMN_CHUNK];
+    unsigned char pass[BC_COLUMN_CHUNK];
+
+    for(int base = 0; base < count; base += BC_COLUMN_CHUNK) {
+        int len = MIN(BC_COLUMN_CHUNK, count - base);
+
+        /* Gather property into a column, values which aren't doubles run through the program. */
+        for(int i = 0; i < len; i++) {
+            GraphEntity *entity = entities[base + i];
+            const SIValue *v = (entity && entity->id != INVALID_ENTITY_ID) ?
+                               GraphEntity_Get_Property(entity, property) : PROPERTY_NOTFOUND;
+            typed[i] = (v->type == T_DOUBLE);
+            column[i] = (typed[i]) ? v->doubleval : 0;
+        }
+
+        _BC_CompareColumn(column, len, cmp->d, cmp->rel, pass);
+
+        for(int i = 0; i < len; i++) {
+            if(!typed[i]) {
+                *ref = entities[base + i];
+                pass[i] = _BC_Run(program);
+            }
+            selection[selected] = base + i;
+            selected += pass[i];
+        }
+    }
+
+    *ref = bound;
+    return selected;
+}
+
+SIValue BC_Evaluate(BC_Program *program) {
+    _BC_Run(program);
+    return program->registers[program->result];
+}
+
+void BC_Free(BC_Program *program) {
+    if(program == NULL) return;
+    for(int i = 0; i < program->code_len; i++) {
+        if(program->code[i].op == BC_CALL) free(program->code[i].call.args);
+    }
+    free(program->code);
+    free(program->registers);
+    free(program->loaded);
+    free(program->args);
+    free(program);
+}
@@ -0,0 +1,101 @@
+#ifndef __BYTECODE_H__
+#define __BYTECODE_H__
+
+#include <stdint.h>
+#include "../value.h"
+#include "../value_cmp.h"
+#include "../graph/graph.h"
+#include "../filter_tree/filter_tree.h"
+#include "../arithmetic/arithmetic_expression.h"
+
+/* Bytecode
+ * Filter trees and arithmetic expressions compiled into a flat
+ * sequence of instructions operating on a register file,
+ * evaluated by a single loop rather than by walking a tree. */
+
+typedef enum {
+    BC_LOAD_PROPERTY,   /* r[dst] = entity property, once per evaluation, jumps to target if entity is unbound. */
+    BC_LOAD_ID,         /* r[dst] = entity id, jumps to target if entity is unbound. */
+    BC_LOAD_ENTITY,     /* r[dst] = entity pointer. */
+    BC_LOAD_AGGREGATE,  /* r[dst] = aggregation function's result. */
+    BC_CALL,            /* r[dst] = f(r[args[0]], ..., r[args[argc-1]]) */
+    BC_CMP_DOUBLE,      /* flag = r[src] rel constant, specialized for doubles. */
+    BC_CMP_LONG,        /* flag = r[src] rel constant, specialized for 64 bit integers. */
+    BC_CMP_STRING,      /* flag = r[src] rel constant, specialized for strings. */
+    BC_CMP,             /* flag = cf(r[src], r[rhs]) rel 0 */
+    BC_STARTS_WITH,     /* flag = r[src] starts with r[rhs] */
+    BC_DISTANCE,        /* flag = distance(r[src], r[rhs], origin) rel constant */
+    BC_FALSE,           /* flag = 0, predicate over an entity missing from graph. */
+    BC_JUMP_IF_FALSE,   /* Jumps to target if flag is off. */
+    BC_JUMP_IF_TRUE,    /* Jumps to target if flag is on. */
+    BC_RETURN,          /* Ends evaluation. */
+} BC_OpCode;
+
+typedef struct {
+    BC_OpCode op;
+    int dst;                /* Destination register. */
+    int src;                /* Left operand register. */
+    int rhs;                /* Right operand register. */
+    int rel;                /* Relation, EQ, GT, GE, LT, LE. */
+    int target;             /* Jump target, instruction index. */
+    CmpFunc cf;             /* BC_CMP, BC_CMP_DOUBLE and BC_CMP_STRING fallback. */
+    union {
+        struct {
+            GraphEntity **entity;
+            char *property;
+        } load;             /* BC_LOAD_PROPERTY, BC_LOAD_ID, BC_LOAD_ENTITY */
+        AggCtx *agg;        /* BC_LOAD_AGGREGATE */
+        struct {
+            AR_Func f;
+            int *args;      /* Argument registers. */
+            int argc;
+        } call;             /* BC_CALL */
+        double d;           /* BC_CMP_DOUBLE */
+        int64_t l;          /* BC_CMP_LONG */
+        struct {
+            const char *s;
+            int len;
+        } str;              /* BC_CMP_STRING */
+        struct {
+            double lat;
+            double lon;
+            double distance;
+        } origin;           /* BC_DISTANCE */
+    };
+} BC_Instruction;
+
+typedef struct {
+    BC_Instruction *code;
+    int code_len;
+    int code_cap;
+    SIValue *registers;     /* Constant registers are set once, at compile time. */
+    uint64_t *loaded;       /* Per register, evaluation in which it was loaded. */
+    int register_count;
+    uint64_t epoch;         /* Current evaluation. */
+    SIValue *args;          /* Scratch, holds call arguments. */
+    int max_argc;
+    int result;             /* Register holding an expression's value. */
+} BC_Program;
+
+/* Compiles filter tree, entities are resolved through g once, returns NULL if root is NULL. */
+BC_Program* BC_CompileFilter(const FT_FilterNode *root, const Graph *g);
+
+/* Compiles an arithmetic expression, calls to deterministic functions
+ * over constants are folded into constants. */
+BC_Program* BC_CompileExpression(const AR_ExpNode *root);
+
+/* Runs filter program, returns FILTER_PASS or FILTER_FAIL,
+ * same outcome as applyFilters on the compiled tree. */
+int BC_ApplyFilter(BC_Program *program);
+
+/* Runs filter program once per entity, entity bound to ref,
+ * writes the indices of passing entities to selection, returns their number.
+ * A lone comparison of ref's property against a double is evaluated column wise. */
+int BC_FilterBatch(BC_Program *program, GraphEntity **ref, GraphEntity **entities, int count, uint16_t *selection);
+
+/* Runs expression program, returns expression's value. */
+SIValue BC_Evaluate(BC_Program *program);
+
+void BC_Free(BC_Program *program);
+
+#endif
@@ -0,0 +1,69 @@
+#include "cost.h"
+#include <string.h>
+#include "../parser/grammar.h"
+
+/* Estimates must not create stores, a missing store holds no entities. */
+double Cost_NodeCardinality(RedisModuleCtx *ctx, const char *graph, const char *label) {
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_NODE, graph, label);
+    return store ? LabelStore_Cardinality(store) : 0;
+}
+
+double Cost_EdgeCardinality(RedisModuleCtx *ctx, const char *graph, const char *relationship) {
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_EDGE, graph, relationship);
+    return store ? LabelStore_Cardinality(store) : 0;
+}
+
+double Cost_AverageDegree(RedisModuleCtx *ctx, const char *graph, const char *relationship,
+                          const char *label) {
+    double nodes = Cost_NodeCardinality(ctx, graph, label);
+    if(nodes == 0) return 0;
+    return Cost_EdgeCardinality(ctx, graph, relationship) / nodes;
+}
+
+static double _Cost_PredicateSelectivity(LabelStore *store, const AST_PredicateNode *pred) {
+    double eq = COST_EQ_SELECTIVITY;
+
+    /* Ids are unique. */
+    if(pred->t == N_ID) {
+        double cardinality = LabelStore_Cardinality(store);
+        eq = (cardinality > 1) ? 1 / cardinality : 1;
+    }
+
+    /* Evaluate property comparisons against a sample of the store. */
+    if(pred->t == N_CONSTANT) {
+        PropertySample *sample = LabelStore_GetPropertySample(store, pred->property);
+        double selectivity = PropertySample_Selectivity(sample, pred->op, &pred->constVal);
+        if(selectivity >= 0) return selectivity;
+    }
+
+    switch(pred->op) {
+        case EQ:
+            return eq;
+        case NE:
+            return 1 - eq;
+        case STARTS:
+            return COST_PREFIX_SELECTIVITY;
+        case GT:
+        case GE:
+        case LT:
+        case LE:
+            return COST_RANGE_SELECTIVITY;
+        default:
+            return 1;
+    }
+}
+
+double Cost_Selectivity(LabelStore *store, const AST_FilterNode *filter, const char *alias) {
+    if(filter == NULL) return 1;
+
+    if(filter->t == N_COND) {
+        double left = Cost_Selectivity(store, filter->cn.left, alias);
+        double right = Cost_Selectivity(store, filter->cn.right, alias);
+        /* Sides are assumed independent. */
+        if(filter->cn.op == AND) return left * right;
+        return left + right - left * right;
+    }
+
+    if(filter->pn.t == N_VARYING || strcmp(filter->pn.alias, alias) != 0) return 1;
+    return _Cost_PredicateSelectivity(store, &filter->pn);
+}
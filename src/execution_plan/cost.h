@@ -0,0 +1,30 @@
+#ifndef __COST_H__
+#define __COST_H__
+
+#include "../redismodule.h"
+#include "../parser/ast.h"
+#include "../stores/store.h"
+
+/* Fraction of entities expected to pass a predicate, used when it can't be
+ * evaluated against a sample of the store. */
+#define COST_EQ_SELECTIVITY 0.1         /* Equality. */
+#define COST_PREFIX_SELECTIVITY 0.1     /* STARTS WITH. */
+#define COST_RANGE_SELECTIVITY 0.33     /* <, <=, >, >= */
+
+/* Number of nodes carrying label, every node when label is NULL. */
+double Cost_NodeCardinality(RedisModuleCtx *ctx, const char *graph, const char *label);
+
+/* Number of edges of relationship type, every edge when relationship is NULL. */
+double Cost_EdgeCardinality(RedisModuleCtx *ctx, const char *graph, const char *relationship);
+
+/* Average number of relationship edges per node carrying label,
+ * assumes each such edge is connected to a label node. */
+double Cost_AverageDegree(RedisModuleCtx *ctx, const char *graph, const char *relationship,
+                          const char *label);
+
+/* Estimates the fraction of store's entities aliased alias passing filter,
+ * property comparisons are evaluated against a sample of the store's entities,
+ * predicates over other entities, or comparing two entities, are considered to always pass. */
+double Cost_Selectivity(LabelStore *store, const AST_FilterNode *filter, const char *alias);
+
+#endif
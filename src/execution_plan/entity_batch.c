@@ -0,0 +1,43 @@
+#include "entity_batch.h"
+
+EntityBatch* NewEntityBatch() {
+    EntityBatch *batch = malloc(sizeof(EntityBatch));
+    EntityBatch_Clear(batch);
+    return batch;
+}
+
+int EntityBatch_Fill(EntityBatch *batch, LabelStoreIterator *iter) {
+    char *id;
+    uint16_t idLen;
+    int count = 0;
+    while(count < ENTITY_BATCH_SIZE &&
+          LabelStoreIterator_Next(iter, &id, &idLen, (void**)&batch->entities[count])) {
+        batch->selection[count] = count;
+        count++;
+    }
+
+    batch->count = count;
+    batch->selected = count;
+    batch->position = 0;
+    return count;
+}
+
+void EntityBatch_Filter(EntityBatch *batch, BC_Program *program, GraphEntity **ref) {
+    batch->selected = BC_FilterBatch(program, ref, batch->entities, batch->count, batch->selection);
+    batch->position = 0;
+}
+
+GraphEntity* EntityBatch_Next(EntityBatch *batch) {
+    if(batch->position == batch->selected) return NULL;
+    return batch->entities[batch->selection[batch->position++]];
+}
+
+void EntityBatch_Clear(EntityBatch *batch) {
+    batch->count = 0;
+    batch->selected = 0;
+    batch->position = 0;
+}
+
+void EntityBatch_Free(EntityBatch *batch) {
+    free(batch);
+}
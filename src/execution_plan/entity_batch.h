@@ -0,0 +1,40 @@
+#ifndef __ENTITY_BATCH_H__
+#define __ENTITY_BATCH_H__
+
+#include <stdint.h>
+#include "../graph/graph_entity.h"
+#include "../stores/store.h"
+#include "../bytecode/bytecode.h"
+
+/* Number of entities pulled off a store at a time. */
+#define ENTITY_BATCH_SIZE 1024
+
+/* EntityBatch
+ * A column of entities scanned ahead of their consumers,
+ * filtered as a whole, handed out one selected entity at a time. */
+typedef struct {
+    GraphEntity *entities[ENTITY_BATCH_SIZE];
+    uint16_t selection[ENTITY_BATCH_SIZE];  /* Indices of entities which passed filtering. */
+    int count;                              /* Number of entities in batch. */
+    int selected;                           /* Number of entities in selection. */
+    int position;                           /* Next selected entity to hand out. */
+} EntityBatch;
+
+EntityBatch* NewEntityBatch();
+
+/* Refills batch from iter, every entity is selected,
+ * returns number of entities read, 0 once iter is depleted. */
+int EntityBatch_Fill(EntityBatch *batch, LabelStoreIterator *iter);
+
+/* Narrows selection to the entities passing program, entities are bound to ref. */
+void EntityBatch_Filter(EntityBatch *batch, BC_Program *program, GraphEntity **ref);
+
+/* Returns next selected entity, NULL once selection is exhausted. */
+GraphEntity* EntityBatch_Next(EntityBatch *batch);
+
+/* Empties batch. */
+void EntityBatch_Clear(EntityBatch *batch);
+
+void EntityBatch_Free(EntityBatch *batch);
+
+#endif
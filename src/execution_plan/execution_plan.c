@@ -1,10 +1,13 @@
+#include <math.h>
 #include <assert.h>
 
 #include "execution_plan.h"
+#include "cost.h"
 #include "./ops/ops.h"
 #include "../graph/edge.h"
 #include "../rmutil/vector.h"
 #include "../query_executor.h"
+#include "../parser/grammar.h"
 
 /* Forward declarations */
 OpResult PullFromStreams(OpNode *source, Graph *graph);
@@ -17,6 +20,7 @@ OpNode* NewOpNode(OpBase *op) {
     opNode->parents = NULL;
     opNode->parentCount = 0;
     opNode->state = StreamUnInitialized;
+    opNode->estimate = -1;
     return opNode;
 }
 
@@ -103,42 +107,75 @@ void _OpNode_PushInBetween(OpNode *parent, OpNode *onlyChild) {
     _OpNode_AddChild(parent, onlyChild);
 }
 
-/*  Nodes with more than one incoming edge
- * will take part in two expand operations
- * MergeNodes will replace one of the expand operation
- * with an expand_into operation 
- * plan - execution plan to be modified
- * n - node with two incoming edges. */
-void _ExecutionPlan_MergeNodes(ExecutionPlan *plan, const Node *n) {
-    if(Node_IncomeDegree(n) != 2) {
-        return;
+/* Replaces parent's child a with b, keeping its position. */
+void _OpNode_ReplaceChild(OpNode *parent, OpNode *a, OpNode *b) {
+    for(int i = 0; i < parent->childCount; i++) {
+        if(parent->children[i] == a) {
+            parent->children[i] = b;
+            break;
+        }
     }
+    _OpNode_RemoveParent(a, parent);
 
-    /* Locate both expand operations involving 
-     * n as the dest node. */
-    
-    OpNode *a = NULL;
-    OpNode *b = NULL;
+    if(b->parents == NULL) b->parents = malloc(sizeof(OpNode *));
+    b->parents[b->parentCount] = parent;
+    b->parentCount++;
+    b->parents = realloc(b->parents, sizeof(OpNode *) * (b->parentCount+1));
+}
+
+/* Number of children pulled by PullFromStreams,
+ * a hash join consumes its last child, the build stream, by itself,
+ * a cache consumes its only child by itself. */
+int _OpNode_StreamCount(const OpNode *op) {
+    if(op->operation->type == OPType_HASH_JOIN) return op->childCount - 1;
+    if(op->operation->type == OPType_CACHE) return 0;
+    return op->childCount;
+}
+
+void OpNode_CollectModified(const OpNode *stream, Vector *aliases) {
+    Vector *modifies = stream->operation->modifies;
+    for(int i = 0; modifies && i < Vector_Size(modifies); i++) {
+        char *alias;
+        Vector_Get(modifies, i, &alias);
+
+        int seen = 0;
+        for(int j = 0; j < Vector_Size(aliases) && !seen; j++) {
+            char *existing;
+            Vector_Get(aliases, j, &existing);
+            seen = (strcmp(existing, alias) == 0);
+        }
+        if(!seen) Vector_Push(aliases, alias);
+    }
+
+    for(int i = 0; i < stream->childCount; i++) {
+        OpNode_CollectModified(stream->children[i], aliases);
+    }
+}
+
+/* Returns the stream, a child of root, op belongs to. */
+OpNode* _ExecutionPlan_StreamOf(const OpNode *root, OpNode *op) {
+    while(op->parents[0] != root) op = op->parents[0];
+    return op;
+}
 
+/* Locates two expand operations into n belonging to different streams of root,
+ * returns 0 if n is bound by a single stream. */
+int _ExecutionPlan_StreamsExpandingInto(OpNode *root, const Node *n, OpNode **a, OpNode **b) {
+    *a = NULL;
+    *b = NULL;
     OpNode *current = NULL;
     Vector *nodesToVisit = NewVector(OpNode*, 3);
-    Vector_Push(nodesToVisit, plan->root);
+    Vector_Push(nodesToVisit, root);
     /* Due to the structure of our execution plan
      * there's not need to maintain a visited nodes 
      * as in classic BFS/DFS. */
-    while(Vector_Size (nodesToVisit) > 0) {
+    while(Vector_Size(nodesToVisit) > 0 && *b == NULL) {
         Vector_Pop(nodesToVisit, &current);
-        if(current->operation->type == OPType_EXPAND_ALL) {
-            ExpandAll *op = (ExpandAll*)current->operation;
-            // if(Node_Compare(*(op->dest_node), n)) {
-            if(*op->dest_node == n) {
-                if(a == NULL) {
-                    a = current;
-                    continue;
-                } else {
-                    b = current;
-                    break;
-                }
+        if(current->operation->type == OPType_EXPAND_ALL && *((ExpandAll*)current->operation)->dest_node == n) {
+            if(*a == NULL) {
+                *a = current;
+            } else if(_ExecutionPlan_StreamOf(root, *a) != _ExecutionPlan_StreamOf(root, current)) {
+                *b = current;
             }
         }
 
@@ -147,47 +184,699 @@ void _ExecutionPlan_MergeNodes(ExecutionPlan *plan, const Node *n) {
         }
     }
     Vector_Free(nodesToVisit);
-    
-    if(a == NULL || b == NULL) {
-        return;
-    }
+    return (*b != NULL);
+}
+
+/* Joins streams a and b, both binding n, by hashing the one expected
+ * to produce fewer records and probing it with the other,
+ * the hash join takes a's place and b is removed from root. */
+void _ExecutionPlan_HashJoin(RedisModuleCtx *ctx, ExecutionPlan *plan, OpNode *a, OpNode *b, const Node *n) {
+    OpNode *probe = (a->estimate >= b->estimate) ? a : b;
+    OpNode *build = (probe == a) ? b : a;
+    OpNode *join = NewOpNode(NewHashJoinOp(plan->graph, build, Graph_GetNodeRef(plan->graph, n)));
+
+    /* Every pair agreeing on n is joined. */
+    double cardinality = Cost_NodeCardinality(ctx, plan->graph_name, n->label);
+    join->estimate = a->estimate * b->estimate / ((cardinality > 1) ? cardinality : 1);
+
+    _OpNode_ReplaceChild(plan->root, a, join);
+    _OpNode_RemoveChild(plan->root, b);
+    _OpNode_AddChild(join, probe);
+    _OpNode_AddChild(join, build);
+}
 
-    /* now that both operations involving node n
-     * are found we can replace one of them with
-     * an expand into operation */
-    ExpandAll *op = (ExpandAll*)a->operation;
+/* Replaces expand operation op with an expand into operation
+ * and nests stream below it, op checks for an edge once both
+ * its source, bound by its own child, and its destination, bound by stream, are set. */
+void _ExecutionPlan_ExpandInto(ExecutionPlan *plan, OpNode *op, OpNode *stream) {
+    ExpandAll *expand = (ExpandAll*)op->operation;
     OpBase *opExpandInto;
-    NewExpandIntoOp(op->ctx, plan->graph, plan->graph_name, op->src_node,
-                    op->relation, op->dest_node, &opExpandInto);
+    NewExpandIntoOp(expand->ctx, plan->graph, plan->graph_name, expand->src_node,
+                    expand->relation, expand->dest_node, &opExpandInto);
 
     // free previous operation.
-    a->operation->free(a->operation);
-    a->operation = opExpandInto;
-    OpNode *expandInto = a;
+    op->operation->free(op->operation);
+    op->operation = opExpandInto;
 
-    // link b operation with expand into
-    _OpNode_AddChild(expandInto, b);
+    _OpNode_RemoveChild(plan->root, stream);
+    _OpNode_AddChild(op, stream);
+}
 
-    // expand into should inherit b's parents
-    for(int i = 0; i < b->parentCount; i++) {
-        OpNode *bParent = b->parents[i];
-        
-        if(bParent == expandInto) {
-            continue;
+/* Nodes with more than one incoming edge are bound
+ * by a stream per incoming edge, MergeNodes joins these streams
+ * either by a nested loop, replacing one of the expand operations into n
+ * with an expand into operation consuming the other stream for every record
+ * entering it, or by a hash join, consuming each stream once, whichever is cheaper.
+ * plan - execution plan to be modified
+ * n - node with multiple incoming edges. */
+void _ExecutionPlan_MergeNodes(RedisModuleCtx *ctx, ExecutionPlan *plan, const Node *n) {
+    OpNode *a;
+    OpNode *b;
+    while(_ExecutionPlan_StreamsExpandingInto(plan->root, n, &a, &b)) {
+        OpNode *a_stream = _ExecutionPlan_StreamOf(plan->root, a);
+        OpNode *b_stream = _ExecutionPlan_StreamOf(plan->root, b);
+
+        double into_a = a->children[0]->estimate * b_stream->estimate;
+        double into_b = b->children[0]->estimate * a_stream->estimate;
+        double hash = a_stream->estimate + b_stream->estimate;
+        int estimated = (a->children[0]->estimate >= 0 && b->children[0]->estimate >= 0 &&
+                         a_stream->estimate >= 0 && b_stream->estimate >= 0);
+
+        if(estimated && hash < into_a && hash < into_b) {
+            _ExecutionPlan_HashJoin(ctx, plan, a_stream, b_stream, n);
+        } else if(!estimated || into_a <= into_b) {
+            _ExecutionPlan_ExpandInto(plan, a, b_stream);
+        } else {
+            _ExecutionPlan_ExpandInto(plan, b, a_stream);
         }
+    }
+}
+
+/* Collects constant and distance predicates over alias which must hold for
+ * the entire WHERE clause to pass, predicates under an OR are ignored. */
+void _ExecutionPlan_CollectConjunctivePredicates(AST_FilterNode *filter, const char *alias,
+                                                 Vector *predicates) {
+    if(filter == NULL) return;
+
+    if(filter->t == N_COND) {
+        if(filter->cn.op != AND) return;
+        _ExecutionPlan_CollectConjunctivePredicates(filter->cn.left, alias, predicates);
+        _ExecutionPlan_CollectConjunctivePredicates(filter->cn.right, alias, predicates);
+        return;
+    }
 
-        if(!_OpNode_ContainsChild(bParent, expandInto)) {
-            _OpNode_AddChild(bParent, expandInto);
+    if((filter->pn.t == N_CONSTANT || filter->pn.t == N_DISTANCE) &&
+       strcmp(filter->pn.alias, alias) == 0) {
+        Vector_Push(predicates, &filter->pn);
+    }
+}
+
+/* Collects id(alias) = x predicates making up filter, which is either
+ * a single such predicate or a disjunction of them, returns 0 otherwise. */
+int _ExecutionPlan_CollectIdDisjunction(AST_FilterNode *filter, const char *alias, Vector *predicates) {
+    if(filter->t == N_COND) {
+        if(filter->cn.op != OR) return 0;
+        return (_ExecutionPlan_CollectIdDisjunction(filter->cn.left, alias, predicates) &&
+                _ExecutionPlan_CollectIdDisjunction(filter->cn.right, alias, predicates));
+    }
+
+    if(filter->pn.t != N_ID || filter->pn.op != EQ || strcmp(filter->pn.alias, alias) != 0) return 0;
+    Vector_Push(predicates, &filter->pn);
+    return 1;
+}
+
+/* Finds the smallest set of id predicates one of which must hold
+ * for the entire WHERE clause to pass, returns NULL if alias isn't restricted by id. */
+Vector* _ExecutionPlan_IdSeekPredicates(AST_FilterNode *filter, const char *alias) {
+    if(filter->t == N_COND && filter->cn.op == AND) {
+        Vector *left = _ExecutionPlan_IdSeekPredicates(filter->cn.left, alias);
+        Vector *right = _ExecutionPlan_IdSeekPredicates(filter->cn.right, alias);
+        if(left == NULL) return right;
+        if(right == NULL) return left;
+        if(Vector_Size(left) <= Vector_Size(right)) {
+            Vector_Free(right);
+            return left;
         }
+        Vector_Free(left);
+        return right;
+    }
+
+    Vector *predicates = NewVector(AST_PredicateNode*, 1);
+    if(_ExecutionPlan_CollectIdDisjunction(filter, alias, predicates)) return predicates;
+    Vector_Free(predicates);
+    return NULL;
+}
+
+static int _ExecutionPlan_CompareIds(const void *a, const void *b) {
+    long int x = *(const long int *)a;
+    long int y = *(const long int *)b;
+    return (x > y) - (x < y);
+}
+
+/* Returns a sorted array of the unique ids alias is restricted to,
+ * NULL if alias isn't restricted by id. */
+long int* _ExecutionPlan_SeekIds(AST_QueryExpressionNode *ast, const char *alias, size_t *id_count) {
+    if(ast->whereNode == NULL) return NULL;
+
+    Vector *predicates = _ExecutionPlan_IdSeekPredicates(ast->whereNode->filters, alias);
+    if(predicates == NULL) return NULL;
+
+    size_t count = Vector_Size(predicates);
+    long int *ids = malloc(sizeof(long int) * count);
+    for(int i = 0; i < count; i++) {
+        AST_PredicateNode *pred;
+        Vector_Get(predicates, i, &pred);
+        ids[i] = pred->constVal.longval;
+    }
+    Vector_Free(predicates);
+
+    qsort(ids, count, sizeof(long int), _ExecutionPlan_CompareIds);
+    size_t unique = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(unique == 0 || ids[unique - 1] != ids[i]) ids[unique++] = ids[i];
+    }
+
+    *id_count = unique;
+    return ids;
+}
+
+/* Looks up node by id when the WHERE clause restricts its id,
+ * returns NULL otherwise. */
+OpBase* _ExecutionPlan_NodeByIdSeekOp(RedisModuleCtx *ctx, Graph *g, Node **node,
+                                      const char *graph_name, AST_QueryExpressionNode *ast) {
+    size_t id_count;
+    long int *ids = _ExecutionPlan_SeekIds(ast, Graph_GetNodeAlias(g, *node), &id_count);
+    if(ids == NULL) return NULL;
+    return NewNodeByIdSeekOp(ctx, g, node, graph_name, ids, id_count);
+}
 
-        _OpNode_RemoveChild(bParent, b);
+/* Ranks how well an index serves predicate, 0 if it can't.
+ * String equality and ranges compare case insensitively
+ * while the index is ordered bytewise, those are left to the filter. */
+int _ExecutionPlan_IndexablePredicateRank(const AST_PredicateNode *pred) {
+    if(pred->t != N_CONSTANT) return 0;
+    if(pred->op == STARTS) return 2;
+    if(!(pred->constVal.type & SI_NUMERIC)) return 0;
+
+    switch(pred->op) {
+        case EQ:
+            return 3;
+        case GT:
+        case GE:
+        case LT:
+        case LE:
+            return 1;
+        default:
+            return 0;
     }
 }
 
-/* Returns the number of expected IDs given node will generate */
-int _ExecutionPlan_EstimateNodeCardinality(RedisModuleCtx *ctx, const char *graph, const Node *n) {
-    LabelStore *s = LabelStore_Get(ctx, STORE_NODE, graph, n->label);
-    return raxSize(s->items);
+/* Narrows box by a numeric range predicate over a coordinate. */
+void _ExecutionPlan_NarrowCoordinateRange(const AST_PredicateNode *pred, double *min, double *max) {
+    double v;
+    SIValue_ToDouble((SIValue *)&pred->constVal, &v);
+    if(pred->op == EQ || pred->op == GT || pred->op == GE) *min = (v > *min) ? v : *min;
+    if(pred->op == EQ || pred->op == LT || pred->op == LE) *max = (v < *max) ? v : *max;
+}
+
+/* Looks for a geospatial index serving predicates, either a distance
+ * predicate bounding the distance from above, or ranges over both coordinates.
+ * Sets box to the region entities must reside in, returns NULL if no index applies. */
+GeoIndex* _ExecutionPlan_GeoIndexBoundingBox(LabelStore *store, Vector *predicates, GeoBoundingBox *box) {
+    GeoIndex *idx = NULL;
+    raxIterator it;
+    raxStart(&it, store->geo_indices);
+    raxSeek(&it, "^", NULL, 0);
+
+    while(idx == NULL && raxNext(&it)) {
+        GeoIndex *candidate = it.data;
+        GeoBoundingBox b = {.min_lat = -90, .min_lon = -180, .max_lat = 90, .max_lon = 180};
+        int radius_bounded = 0;
+        int lat_bounded = 0;
+        int lon_bounded = 0;
+
+        for(int i = 0; i < Vector_Size(predicates); i++) {
+            AST_PredicateNode *pred;
+            Vector_Get(predicates, i, &pred);
+
+            if(pred->t == N_DISTANCE) {
+                if(pred->op != LT && pred->op != LE) continue;
+                if(strcmp(pred->property, candidate->lat_property) != 0 ||
+                   strcmp(pred->distance.lon_property, candidate->lon_property) != 0) continue;
+
+                GeoBoundingBox r = Geo_RadiusBoundingBox(pred->distance.lat, pred->distance.lon,
+                                                         pred->constVal.doubleval);
+                b.min_lat = fmax(b.min_lat, r.min_lat);
+                b.max_lat = fmin(b.max_lat, r.max_lat);
+                b.min_lon = fmax(b.min_lon, r.min_lon);
+                b.max_lon = fmin(b.max_lon, r.max_lon);
+                radius_bounded = 1;
+                continue;
+            }
+
+            if(!(pred->constVal.type & SI_NUMERIC)) continue;
+            if(pred->op != EQ && pred->op != GT && pred->op != GE && pred->op != LT && pred->op != LE) continue;
+
+            if(strcmp(pred->property, candidate->lat_property) == 0) {
+                _ExecutionPlan_NarrowCoordinateRange(pred, &b.min_lat, &b.max_lat);
+                lat_bounded = 1;
+            } else if(strcmp(pred->property, candidate->lon_property) == 0) {
+                _ExecutionPlan_NarrowCoordinateRange(pred, &b.min_lon, &b.max_lon);
+                lon_bounded = 1;
+            }
+        }
+
+        if(radius_bounded || (lat_bounded && lon_bounded)) {
+            idx = candidate;
+            *box = b;
+        }
+    }
+
+    raxStop(&it);
+    return idx;
+}
+
+/* Picks the ordered index best serving predicates and sets bounds to the portion
+ * of it holding qualifying entities, prefix scans are considered only if allow_prefix is set.
+ * Sets rank to the chosen predicate's rank, returns NULL if no predicate is served by an index. */
+Index* _ExecutionPlan_IndexBounds(LabelStore *store, Vector *predicates, int allow_prefix,
+                                  IndexScanBounds *bounds, int *rank) {
+    /* Pick best indexed predicate. */
+    Index *idx = NULL;
+    AST_PredicateNode *best = NULL;
+    *rank = 0;
+    for(int i = 0; i < Vector_Size(predicates); i++) {
+        AST_PredicateNode *pred;
+        Vector_Get(predicates, i, &pred);
+        int pred_rank = _ExecutionPlan_IndexablePredicateRank(pred);
+        if(pred_rank <= *rank) continue;
+        if(pred->op == STARTS && !allow_prefix) continue;
+        Index *pred_idx = LabelStore_GetIndex(store, pred->property);
+        /* Indices still being built are incomplete. */
+        if(pred_idx == NULL || !Index_IsReady(pred_idx)) continue;
+        idx = pred_idx;
+        best = pred;
+        *rank = pred_rank;
+    }
+
+    if(best == NULL) return NULL;
+
+    *bounds = (IndexScanBounds){.prefix = NULL, .min = NULL, .min_inclusive = 0,
+                                .max = NULL, .max_inclusive = 0, .reverse = 0};
+    if(best->op == STARTS) {
+        bounds->prefix = best->constVal.stringval;
+    } else if(best->op == EQ) {
+        bounds->min = bounds->max = &best->constVal;
+        bounds->min_inclusive = bounds->max_inclusive = 1;
+    } else {
+        /* Intersect every numeric range over the indexed property. */
+        for(int i = 0; i < Vector_Size(predicates); i++) {
+            AST_PredicateNode *pred;
+            Vector_Get(predicates, i, &pred);
+            if(_ExecutionPlan_IndexablePredicateRank(pred) != 1) continue;
+            if(strcmp(pred->property, best->property) != 0) continue;
+
+            double v = pred->constVal.doubleval;
+            SIValue_ToDouble(&pred->constVal, &v);
+            if(pred->op == GT || pred->op == GE) {
+                double current;
+                if(bounds->min) SIValue_ToDouble(bounds->min, &current);
+                if(!bounds->min || v > current || (v == current && pred->op == GT)) {
+                    bounds->min = &pred->constVal;
+                    bounds->min_inclusive = (pred->op == GE);
+                }
+            } else {
+                double current;
+                if(bounds->max) SIValue_ToDouble(bounds->max, &current);
+                if(!bounds->max || v < current || (v == current && pred->op == LT)) {
+                    bounds->max = &pred->constVal;
+                    bounds->max_inclusive = (pred->op == LE);
+                }
+            }
+        }
+    }
+
+    return idx;
+}
+
+/* Tries to replace a label scan with an index scan,
+ * returns NULL if none of the node's predicates is served by an index.
+ * Filters are kept as is, index scan only narrows down the scanned nodes. */
+OpBase* _ExecutionPlan_IndexScanOp(RedisModuleCtx *ctx, Graph *g, Node **node,
+                                   const char *graph_name, AST_QueryExpressionNode *ast) {
+    if(ast->whereNode == NULL || (*node)->label == NULL) return NULL;
+
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_NODE, graph_name, (*node)->label);
+    if(store == NULL) return NULL;
+    if(raxSize(store->indices) == 0 && raxSize(store->geo_indices) == 0) return NULL;
+
+    Vector *predicates = NewVector(AST_PredicateNode*, 0);
+    _ExecutionPlan_CollectConjunctivePredicates(ast->whereNode->filters,
+                                                Graph_GetNodeAlias(g, *node), predicates);
+
+    int rank;
+    IndexScanBounds bounds;
+    Index *idx = _ExecutionPlan_IndexBounds(store, predicates, 1, &bounds, &rank);
+
+    /* Unless an exact or prefix match is available, a geospatial
+     * bounding box is expected to be more selective than a range over a single property. */
+    if(rank < 2) {
+        GeoBoundingBox box;
+        GeoIndex *geo_idx = _ExecutionPlan_GeoIndexBoundingBox(store, predicates, &box);
+        if(geo_idx) {
+            Vector_Free(predicates);
+            return NewGeoScanOp(g, node, geo_idx, box);
+        }
+    }
+
+    Vector_Free(predicates);
+    if(idx == NULL) return NULL;
+    return NewIndexScanOp(g, node, idx, bounds);
+}
+
+/* Scans node, preferring an id lookup followed by an index scan. */
+OpBase* _ExecutionPlan_NodeScanOp(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                                  AST_QueryExpressionNode *ast, Node *node) {
+    Node **ref = Graph_GetNodeRef(g, node);
+    OpBase *scan_op = _ExecutionPlan_NodeByIdSeekOp(ctx, g, ref, graph_name, ast);
+    if(scan_op == NULL) scan_op = _ExecutionPlan_IndexScanOp(ctx, g, ref, graph_name, ast);
+    if(scan_op) return scan_op;
+
+    if(node->label) return NewNodeByLabelScanOp(ctx, g, ref, graph_name, node->label);
+    /* Node is not labeled, no other option but a full scan. */
+    return NewAllNodeScanOp(ctx, g, ref, graph_name);
+}
+
+/* Looks for an edge index serving relation's predicates,
+ * if found, expand op seeks the qualifying range of each source node's edges. */
+void _ExecutionPlan_EdgeIndexSeek(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                                  AST_QueryExpressionNode *ast, ExpandAll *op) {
+    Edge *e = *op->relation;
+    if(ast->whereNode == NULL || e->relationship == NULL) return;
+
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_EDGE, graph_name, e->relationship);
+    if(store == NULL || raxSize(store->indices) == 0) return;
+
+    Vector *predicates = NewVector(AST_PredicateNode*, 0);
+    _ExecutionPlan_CollectConjunctivePredicates(ast->whereNode->filters,
+                                                Graph_GetEdgeAlias(g, e), predicates);
+
+    int rank;
+    IndexScanBounds bounds;
+    Index *idx = _ExecutionPlan_IndexBounds(store, predicates, 0, &bounds, &rank);
+    if(idx) ExpandAll_SeekIndex(op, idx, bounds);
+
+    Vector_Free(predicates);
+}
+
+/* Checks if scanning n is narrowed down by an id lookup or an index. */
+int _ExecutionPlan_NarrowedScan(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                                AST_QueryExpressionNode *ast, Node *n) {
+    if(ast->whereNode == NULL) return 0;
+
+    Vector *id_predicates = _ExecutionPlan_IdSeekPredicates(ast->whereNode->filters,
+                                                            Graph_GetNodeAlias(g, n));
+    if(id_predicates) {
+        Vector_Free(id_predicates);
+        return 1;
+    }
+    if(n->label == NULL) return 0;
+
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_NODE, graph_name, n->label);
+    if(store == NULL) return 0;
+    Vector *predicates = NewVector(AST_PredicateNode*, 0);
+    _ExecutionPlan_CollectConjunctivePredicates(ast->whereNode->filters,
+                                                Graph_GetNodeAlias(g, n), predicates);
+    int rank;
+    IndexScanBounds bounds;
+    GeoBoundingBox box;
+    int narrowed = (_ExecutionPlan_IndexBounds(store, predicates, 1, &bounds, &rank) != NULL ||
+                    _ExecutionPlan_GeoIndexBoundingBox(store, predicates, &box) != NULL);
+    Vector_Free(predicates);
+    return narrowed;
+}
+
+/* Estimates the fraction of store's entities aliased alias passing the WHERE clause. */
+double _ExecutionPlan_Selectivity(RedisModuleCtx *ctx, const char *graph_name, AST_QueryExpressionNode *ast,
+                                  LabelStoreType type, const char *label, const char *alias) {
+    if(ast->whereNode == NULL) return 1;
+    /* Missing store holds no entities, selectivity is irrelevant. */
+    LabelStore *store = LabelStore_Lookup(ctx, type, graph_name, label);
+    if(store == NULL) return 1;
+    return Cost_Selectivity(store, ast->whereNode->filters, alias);
+}
+
+/* Estimates the number of records scanning n produces once filtered,
+ * sets visited to the number of nodes the scan goes through. */
+double _ExecutionPlan_EstimateScan(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                                   AST_QueryExpressionNode *ast, Node *n, double *visited) {
+    double cardinality = Cost_NodeCardinality(ctx, graph_name, n->label);
+    double records = cardinality * _ExecutionPlan_Selectivity(ctx, graph_name, ast, STORE_NODE, n->label,
+                                                              Graph_GetNodeAlias(g, n));
+    *visited = _ExecutionPlan_NarrowedScan(ctx, g, graph_name, ast, n) ? records : cardinality;
+    return records;
+}
+
+/* Collects the edges reachable from n in depth-first order, every edge
+ * leaves either n or a node reached by a preceding edge, branches
+ * of a star pattern are traversed one after the other.
+ * Edges already planned by another path are skipped, such paths share a node
+ * which streams are later joined on. */
+void _ExecutionPlan_CollectPath(const Node *n, Vector *path, Vector *planned) {
+    for(int i = 0; i < Vector_Size(n->outgoing_edges); i++) {
+        Edge *e;
+        Vector_Get(n->outgoing_edges, i, &e);
+
+        int seen = 0;
+        for(int j = 0; j < Vector_Size(planned) && !seen; j++) {
+            Edge *p;
+            Vector_Get(planned, j, &p);
+            seen = (p == e);
+        }
+        if(seen) continue;
+
+        Vector_Push(path, e);
+        Vector_Push(planned, e);
+        _ExecutionPlan_CollectPath(e->dest, path, planned);
+    }
+}
+
+/* Estimates the cost of traversing path, edges in traversal order,
+ * starting at its first node, or at its last node when reverse is set.
+ * Cost is the number of nodes scanned plus the number of edges expanded,
+ * sets records[i] to the number of records produced after i expansions. */
+double _ExecutionPlan_PathCost(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                               AST_QueryExpressionNode *ast, Vector *path, int reverse, double *records) {
+    int len = Vector_Size(path);
+    Edge *e;
+    Vector_Get(path, reverse ? len - 1 : 0, &e);
+
+    double cost;
+    records[0] = _ExecutionPlan_EstimateScan(ctx, g, graph_name, ast, reverse ? e->dest : e->src, &cost);
+
+    for(int i = 0; i < len; i++) {
+        Vector_Get(path, reverse ? len - 1 - i : i, &e);
+        Node *from = reverse ? e->dest : e->src;
+        Node *to = reverse ? e->src : e->dest;
+
+        double expanded = records[i] * Cost_AverageDegree(ctx, graph_name, e->relationship, from->label);
+        cost += expanded;
+        records[i + 1] = expanded *
+            _ExecutionPlan_Selectivity(ctx, graph_name, ast, STORE_EDGE, e->relationship,
+                                       Graph_GetEdgeAlias(g, e)) *
+            _ExecutionPlan_Selectivity(ctx, graph_name, ast, STORE_NODE, to->label,
+                                       Graph_GetNodeAlias(g, to));
+    }
+
+    return cost;
+}
+
+/* Path can be traversed in either direction when it doesn't branch and none
+ * of its nodes is shared with another path or populated by a procedure. */
+int _ExecutionPlan_ReversiblePath(Vector *path, const Node *fulltext_node) {
+    Edge *prev = NULL;
+    for(int i = 0; i < Vector_Size(path); i++) {
+        Edge *e;
+        Vector_Get(path, i, &e);
+        if(prev && prev->dest != e->src) return 0;
+        prev = e;
+        if(e->src == fulltext_node || e->dest == fulltext_node) return 0;
+        if(Node_IncomeDegree(e->dest) != 1 || Vector_Size(e->dest->outgoing_edges) > 1) return 0;
+    }
+    return 1;
+}
+
+/* Orders root's independent streams such that streams expected to produce
+ * fewer records are consumed in the outer loops, as each stream is reset and
+ * consumed again for every combination of records produced by the streams following it. */
+void _ExecutionPlan_OrderStreams(OpNode *root) {
+    for(int i = 1; i < root->childCount; i++) {
+        OpNode *stream = root->children[i];
+        int j = i - 1;
+        while(j >= 0 && root->children[j]->estimate < stream->estimate) {
+            root->children[j + 1] = root->children[j];
+            j--;
+        }
+        root->children[j + 1] = stream;
+    }
+}
+
+int _ExecutionPlan_NodeIndex(const Graph *g, const Node *n) {
+    for(int i = 0; i < g->node_count; i++) {
+        if(g->nodes[i] == n) return i;
+    }
+    return -1;
+}
+
+int _ExecutionPlan_ContainsNode(Vector *nodes, const Node *n) {
+    for(int i = 0; i < Vector_Size(nodes); i++) {
+        Node *node;
+        Vector_Get(nodes, i, &node);
+        if(node == n) return 1;
+    }
+    return 0;
+}
+
+/* Returns the connected components of the MATCH pattern, ignoring edge direction,
+ * which contain a cycle, as a vector of node vectors. */
+Vector* _ExecutionPlan_CyclicComponents(const Graph *g) {
+    Vector *components = NewVector(Vector*, 0);
+    if(g->node_count == 0) return components;
+
+    /* Propagate smallest node index across edges until every
+     * node is labeled by the smallest index within its component. */
+    int component[g->node_count];
+    for(int i = 0; i < g->node_count; i++) component[i] = i;
+    int changed = 1;
+    while(changed) {
+        changed = 0;
+        for(int i = 0; i < g->edge_count; i++) {
+            int src = _ExecutionPlan_NodeIndex(g, g->edges[i]->src);
+            int dest = _ExecutionPlan_NodeIndex(g, g->edges[i]->dest);
+            if(component[src] == component[dest]) continue;
+            int min = (component[src] < component[dest]) ? component[src] : component[dest];
+            component[src] = component[dest] = min;
+            changed = 1;
+        }
+    }
+
+    /* A component holding as many edges as nodes contains a cycle. */
+    for(int c = 0; c < g->node_count; c++) {
+        if(component[c] != c) continue;
+        int node_count = 0;
+        int edge_count = 0;
+        for(int i = 0; i < g->node_count; i++) node_count += (component[i] == c);
+        for(int i = 0; i < g->edge_count; i++) {
+            edge_count += (component[_ExecutionPlan_NodeIndex(g, g->edges[i]->src)] == c);
+        }
+        if(edge_count < node_count) continue;
+
+        Vector *nodes = NewVector(Node*, node_count);
+        for(int i = 0; i < g->node_count; i++) {
+            if(component[i] == c) Vector_Push(nodes, g->nodes[i]);
+        }
+        Vector_Push(components, nodes);
+    }
+
+    return components;
+}
+
+/* Collects n's edges connecting it to bound nodes, self loops excluded,
+ * returns the number of edges collected. */
+int _ExecutionPlan_BoundEdges(const Node *n, Vector *bound, Edge **edges) {
+    int count = 0;
+    for(int i = 0; i < Vector_Size(n->outgoing_edges); i++) {
+        Edge *e;
+        Vector_Get(n->outgoing_edges, i, &e);
+        if(e->dest != n && _ExecutionPlan_ContainsNode(bound, e->dest)) edges[count++] = e;
+    }
+    for(int i = 0; i < Vector_Size(n->incoming_edges); i++) {
+        Edge *e;
+        Vector_Get(n->incoming_edges, i, &e);
+        if(e->src != n && _ExecutionPlan_ContainsNode(bound, e->src)) edges[count++] = e;
+    }
+    return count;
+}
+
+/* Plans a cyclic component by binding its nodes one at a time, starting with the node
+ * expected to yield the fewest records, then repeatedly the node connected to the most bound nodes.
+ * A node connected to a single bound node is expanded to, a node connected to several is bound
+ * by intersecting the adjacency of all of them at once, a leapfrog join, such that
+ * intermediate results never exceed the worst-case output size of the pattern.
+ * Returns the top operation of the resulting chain. */
+OpNode* _ExecutionPlan_PlanCyclicComponent(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                                           AST_QueryExpressionNode *ast, Vector *nodes) {
+    int node_count = Vector_Size(nodes);
+    double scan_records[node_count];
+    int first = 0;
+    for(int i = 0; i < node_count; i++) {
+        Node *n;
+        Vector_Get(nodes, i, &n);
+        double visited;
+        scan_records[i] = _ExecutionPlan_EstimateScan(ctx, g, graph_name, ast, n, &visited);
+        if(scan_records[i] < scan_records[first]) first = i;
+    }
+
+    Node *n;
+    Vector_Get(nodes, first, &n);
+    OpNode *top = NewOpNode(_ExecutionPlan_NodeScanOp(ctx, g, graph_name, ast, n));
+    top->estimate = scan_records[first];
+    Vector *bound = NewVector(Node*, node_count);
+    Vector_Push(bound, n);
+
+    Edge *edges[g->edge_count];
+    while(Vector_Size(bound) < node_count) {
+        /* Pick the node connected to the most bound nodes. */
+        Node *next = NULL;
+        int next_idx = 0;
+        int next_degree = 0;
+        for(int i = 0; i < node_count; i++) {
+            Vector_Get(nodes, i, &n);
+            if(_ExecutionPlan_ContainsNode(bound, n)) continue;
+            int degree = _ExecutionPlan_BoundEdges(n, bound, edges);
+            if(degree > next_degree ||
+               (degree == next_degree && degree > 0 && scan_records[i] < scan_records[next_idx])) {
+                next = n;
+                next_idx = i;
+                next_degree = degree;
+            }
+        }
+
+        _ExecutionPlan_BoundEdges(next, bound, edges);
+
+        /* Each edge narrows candidates down to bound node's neighbors. */
+        double records = top->estimate *
+            _ExecutionPlan_Selectivity(ctx, graph_name, ast, STORE_NODE, next->label, Graph_GetNodeAlias(g, next));
+        double cardinality = Cost_NodeCardinality(ctx, graph_name, next->label);
+        if(next_degree > 1) records *= cardinality;
+        for(int i = 0; i < next_degree; i++) {
+            Edge *e = edges[i];
+            Node *neighbor = (e->src == next) ? e->dest : e->src;
+            double degree = Cost_AverageDegree(ctx, graph_name, e->relationship, neighbor->label);
+            if(next_degree > 1) degree = (cardinality > 0) ? degree / cardinality : 0;
+            records *= degree * _ExecutionPlan_Selectivity(ctx, graph_name, ast, STORE_EDGE, e->relationship,
+                                                           Graph_GetEdgeAlias(g, e));
+        }
+
+        OpNode *step;
+        Edge *e = edges[0];
+        if(next_degree == 1) {
+            ExpandAll *expand_all = NewExpandAll(ctx, g, graph_name, Graph_GetNodeRef(g, e->src),
+                                                 Graph_GetEdgeRef(g, e), Graph_GetNodeRef(g, e->dest));
+            if(e->src == next) ExpandAll_Reverse(expand_all);
+            else _ExecutionPlan_EdgeIndexSeek(ctx, g, graph_name, ast, expand_all);
+            step = NewOpNode((OpBase*)expand_all);
+        } else {
+            Edge **edge_refs[next_degree];
+            for(int i = 0; i < next_degree; i++) edge_refs[i] = Graph_GetEdgeRef(g, edges[i]);
+            step = NewOpNode(NewLeapfrogJoinOp(ctx, g, graph_name, Graph_GetNodeRef(g, next),
+                                               edge_refs, next_degree));
+        }
+        step->estimate = records;
+        _OpNode_AddChild(step, top);
+        top = step;
+        Vector_Push(bound, next);
+    }
+
+    /* Self loops are checked once their node is bound. */
+    for(int i = 0; i < node_count; i++) {
+        Vector_Get(nodes, i, &n);
+        for(int j = 0; j < Vector_Size(n->outgoing_edges); j++) {
+            Edge *e;
+            Vector_Get(n->outgoing_edges, j, &e);
+            if(e->dest != n) continue;
+            OpBase *expand_into;
+            NewExpandIntoOp(ctx, g, graph_name, Graph_GetNodeRef(g, n), Graph_GetEdgeRef(g, e),
+                            Graph_GetNodeRef(g, n), &expand_into);
+            OpNode *step = NewOpNode(expand_into);
+            step->estimate = top->estimate;
+            _OpNode_AddChild(step, top);
+            top = step;
+        }
+    }
+
+    Vector_Free(bound);
+    return top;
 }
 
 /* Locates expand all operations which do not have a child operation,
@@ -198,26 +887,52 @@ void _ExecutionPlan_OptimizeEntryPoints(RedisModuleCtx *ctx, Graph *g, const cha
     if(root->childCount == 0 && root->operation->type == OPType_EXPAND_ALL) {
         Node **src = ((ExpandAll*)(root->operation))->src_node;
         Node **dest = ((ExpandAll*)(root->operation))->dest_node;
-        Node **entry_point = src;
+        /* Direction was picked by cost when the plan was constructed. */
+        Node **entry_point = ((ExpandAll*)(root->operation))->reversed ? dest : src;
+
+        /* Prefer an id lookup, followed by an index scan when possible. */
+        OpBase *scan_op = _ExecutionPlan_NodeByIdSeekOp(ctx, g, entry_point, graph_name, ast);
+
+        /* Rather than scanning every node, locate qualifying edges directly,
+         * unless destination is shared with another expansion which expects to expand into it. */
+        ExpandAll *expand_all = (ExpandAll*)root->operation;
+        size_t edge_id_count;
+        long int *edge_ids = NULL;
+        if(scan_op == NULL && Node_IncomeDegree(*dest) == 1) {
+            edge_ids = _ExecutionPlan_SeekIds(ast, Graph_GetEdgeAlias(g, *expand_all->relation),
+                                              &edge_id_count);
+        }
+        if(edge_ids) {
+            OpBase *edge_seek = NewEdgeByIdSeekOp(ctx, g, src, expand_all->relation, dest,
+                                                  graph_name, edge_ids, edge_id_count);
+            root->operation->free(root->operation);
+            root->operation = edge_seek;
+            return;
+        }
 
-        // Determin which node should be scaned, based on node cardinality
-        // int src_cardinality = _ExecutionPlan_EstimateNodeCardinality(ctx, graph_name, *src);
-        // int dest_cardinality = _ExecutionPlan_EstimateNodeCardinality(ctx, graph_name, *dest);
-        
-        // if(dest_cardinality < src_cardinality) {
-        //     entry_point = dest;
-        // }
-        
-        OpBase *scan_op = NULL;
-        if((*entry_point)->label) {
-            /* TODO: when indexing is enabled, use index when possible. */
-            scan_op = NewNodeByLabelScanOp(ctx, g, entry_point, graph_name, (*entry_point)->label);
-        } else {
-            /* Node is not labeled, no other option but a full scan. */
-            scan_op = NewAllNodeScanOp(ctx, g, entry_point, graph_name);
-        }        
-        
-        _OpNode_AddChild(root, NewOpNode(scan_op));
+        if(scan_op == NULL) scan_op = _ExecutionPlan_IndexScanOp(ctx, g, entry_point, graph_name, ast);
+        if(scan_op == NULL && (*entry_point)->label == NULL && expand_all->index &&
+           Node_IncomeDegree(*dest) == 1) {
+            OpBase *edge_scan = NewEdgeIndexScanOp(g, src, expand_all->relation, dest,
+                                                   expand_all->index, expand_all->bounds);
+            root->operation->free(root->operation);
+            root->operation = edge_scan;
+            return;
+        }
+
+        if(scan_op == NULL) {
+            if((*entry_point)->label) {
+                scan_op = NewNodeByLabelScanOp(ctx, g, entry_point, graph_name, (*entry_point)->label);
+            } else {
+                /* Node is not labeled, no other option but a full scan. */
+                scan_op = NewAllNodeScanOp(ctx, g, entry_point, graph_name);
+            }
+        }
+
+        OpNode *scan = NewOpNode(scan_op);
+        double visited;
+        scan->estimate = _ExecutionPlan_EstimateScan(ctx, g, graph_name, ast, *entry_point, &visited);
+        _OpNode_AddChild(root, scan);
 
     } else {
         /* Continue scanning. */
@@ -227,6 +942,63 @@ void _ExecutionPlan_OptimizeEntryPoints(RedisModuleCtx *ctx, Graph *g, const cha
     }
 }
 
+/* Returns plan's only leaf, NULL if plan branches. */
+OpNode* _ExecutionPlan_SingleLeaf(OpNode *root) {
+    while(root->childCount == 1) root = root->children[0];
+    return (root->childCount == 0) ? root : NULL;
+}
+
+/* When results are ordered by a single property of the node scanned by the plan's only leaf,
+ * and an index holding every node of the label orders them by that property,
+ * scans the index in the requested direction such that records are produced in order,
+ * result set is marked as presorted and execution stops once limit is reached. */
+void _ExecutionPlan_OrderByIndex(RedisModuleCtx *ctx, ExecutionPlan *plan, const char *graph_name,
+                                 AST_QueryExpressionNode *ast) {
+    if(ast->orderNode == NULL || ast->limitNode == NULL) return;
+    if(plan->result_set->aggregated) return;
+    if(plan->root->operation->type != OPType_PRODUCE_RESULTS) return;
+    if(Vector_Size(ast->orderNode->columns) != 1) return;
+
+    AST_ColumnNode *column;
+    Vector_Get(ast->orderNode->columns, 0, &column);
+    if(column->type != N_VARIABLE) return;
+
+    OpNode *leaf = _ExecutionPlan_SingleLeaf(plan->root);
+    if(leaf == NULL) return;
+
+    Node **node;
+    IndexScanBounds bounds = {.prefix = NULL, .min = NULL, .min_inclusive = 0,
+                              .max = NULL, .max_inclusive = 0, .reverse = 0};
+    if(leaf->operation->type == OPType_NODE_BY_LABEL_SCAN) {
+        node = ((NodeByLabelScan*)leaf->operation)->node;
+    } else if(leaf->operation->type == OPType_INDEX_SCAN) {
+        IndexScan *index_scan = (IndexScan*)leaf->operation;
+        if(strcmp(index_scan->index->property, column->property) != 0) return;
+        node = index_scan->node;
+        bounds = index_scan->bounds;
+    } else {
+        return;
+    }
+
+    if(strcmp(Graph_GetNodeAlias(plan->graph, *node), column->alias) != 0) return;
+
+    /* Nodes missing from the index, or holding strings, which the index
+     * and result set order differently, would be misplaced. */
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_NODE, graph_name, (*node)->label);
+    if(store == NULL) return;
+    Index *idx = LabelStore_GetIndex(store, column->property);
+    if(idx == NULL || !Index_IsReady(idx)) return;
+    if(bounds.prefix || Index_ContainsStrings(idx)) return;
+    if(bounds.min == NULL && bounds.max == NULL &&
+       Index_Cardinality(idx) != LabelStore_Cardinality(store)) return;
+
+    bounds.reverse = (ast->orderNode->direction == ORDER_DIR_DESC);
+    OpBase *ordered_scan = NewIndexScanOp(plan->graph, node, idx, bounds);
+    leaf->operation->free(leaf->operation);
+    leaf->operation = ordered_scan;
+    ResultSet_MarkPresorted(plan->result_set);
+}
+
 Vector* _ExecutionPlan_AddFilters(OpNode *root, FT_FilterNode **filterTree) {
     /* We've reached the end of our execution plan. */
     if(root == NULL) {
@@ -262,8 +1034,9 @@ Vector* _ExecutionPlan_AddFilters(OpNode *root, FT_FilterNode **filterTree) {
         }
     }
 
-    // See if filter tree filters any of the current op modified entities
-    if(FilterTree_ContainsNode(*filterTree, seen)) {    
+    /* See if filter tree filters any of the current op modified entities,
+     * filters spanning both sides of a hash join are placed above it. */
+    if(root->operation->type != OPType_HASH_JOIN && FilterTree_ContainsNode(*filterTree, seen)) {
         // Create a minimum filter tree for the current execution plan operation
         FT_FilterNode *minTree = FilterTree_MinFilterTree(*filterTree, seen);
         
@@ -285,6 +1058,87 @@ Vector* _ExecutionPlan_AddFilters(OpNode *root, FT_FilterNode **filterTree) {
     return seen;
 }
 
+/* Returns the slot holding op's inline predicate, NULL if op can't evaluate one. */
+FT_FilterNode** _OpNode_PredicateSlot(const OpNode *op) {
+    switch(op->operation->type) {
+        case OPType_ALL_NODE_SCAN:
+            return &((AllNodeScan*)op->operation)->predicate;
+        case OPType_NODE_BY_LABEL_SCAN:
+            return &((NodeByLabelScan*)op->operation)->predicate;
+        case OPType_INDEX_SCAN:
+            return &((IndexScan*)op->operation)->predicate;
+        case OPType_EXPAND_ALL:
+            return &((ExpandAll*)op->operation)->predicate;
+        default:
+            return NULL;
+    }
+}
+
+/* A filter placed right above a scan or an expansion is evaluated by the op itself
+ * as it iterates, such that rejected entities never leave it. */
+void _ExecutionPlan_PushDownFilters(OpNode *root) {
+    for(int i = 0; i < root->childCount; i++) {
+        OpNode *child = root->children[i];
+        if(child->operation->type == OPType_FILTER && child->childCount == 1 && child->parentCount == 1) {
+            OpNode *target = child->children[0];
+            FT_FilterNode **slot = _OpNode_PredicateSlot(target);
+            if(slot && target->parentCount == 1) {
+                Filter *filter = (Filter*)child->operation;
+                if(*slot) {
+                    FT_FilterNode *conjunction = CreateCondFilterNode(AND);
+                    AppendLeftChild(conjunction, *slot);
+                    AppendRightChild(conjunction, filter->filterTree);
+                    *slot = conjunction;
+                } else {
+                    *slot = filter->filterTree;
+                }
+                filter->filterTree = NULL;
+
+                _OpNode_RemoveNode(child, target);
+                _OpNode_ReplaceChild(root, child, target);
+                OpNode_Free(child);
+                child = target;
+            }
+        }
+        _ExecutionPlan_PushDownFilters(child);
+    }
+}
+
+int _OpNode_ContainsType(const OpNode *root, OPType type) {
+    if(root->operation->type == type) return 1;
+    for(int i = 0; i < root->childCount; i++) {
+        if(_OpNode_ContainsType(root->children[i], type)) return 1;
+    }
+    return 0;
+}
+
+/* PullFromStreams resets and reconsumes every stream but the last one
+ * for each record of the streams following it, inner streams which expand or join
+ * are cached such that they're evaluated once and replayed afterwards.
+ * Streams are independent of one another hence have no parameters.
+ * A full-text scan's score isn't an entity, streams yielding it aren't cached. */
+void _ExecutionPlan_CacheInnerStreams(ExecutionPlan *plan, OpNode *root) {
+    if(root->operation->type == OPType_CACHE) return;
+
+    int stream_count = _OpNode_StreamCount(root);
+    for(int i = 0; i < stream_count - 1; i++) {
+        OpNode *stream = root->children[i];
+        if(stream->childCount == 0 || stream->parentCount != 1) continue;
+        if(stream->operation->type == OPType_CACHE) continue;
+        if(_OpNode_ContainsType(stream, OPType_FULLTEXT_SCAN)) continue;
+        OpNode *cache = NewOpNode(NewCacheOp(plan->graph, stream, NULL, CACHE_MEMORY_CAP));
+        cache->estimate = stream->estimate;
+        _OpNode_ReplaceChild(root, stream, cache);
+        _OpNode_AddChild(cache, stream);
+    }
+
+    for(int i = 0; i < root->childCount; i++) {
+        OpNode *child = root->children[i];
+        if(child->operation->type == OPType_CACHE) child = child->children[0];
+        _ExecutionPlan_CacheInnerStreams(plan, child);
+    }
+}
+
 void _Count_Graph_Entities(const Vector *entities, size_t *node_count, size_t *edge_count) {
     for(int i = 0; i < Vector_Size(entities); i++) {
         AST_GraphEntity *entity;
@@ -314,6 +1168,290 @@ void _Determine_Graph_Size(const AST_QueryExpressionNode *ast, size_t *node_coun
     }
 }
 
+/* Entity within a MATCH pattern matched by any entity of its kind, label aside. */
+int _ExecutionPlan_UnconstrainedEntity(const AST_GraphEntity *entity) {
+    return (entity->properties == NULL || Vector_Size(entity->properties) == 0);
+}
+
+/* Recognizes count-only queries whose result is the number of entities held by
+ * a single label store: MATCH (n:L) RETURN count(n) and MATCH ()-[r:R]->() RETURN count(r),
+ * returns 1 and sets store, NULL if the store doesn't exist, returns 0 if query is of any other form. */
+int _ExecutionPlan_CountStore(RedisModuleCtx *ctx, const char *graph_name,
+                              const AST_QueryExpressionNode *ast, LabelStore **store) {
+    if(!ast->matchNode || !ast->returnNode) return 0;
+    if(ast->whereNode || ast->createNode || ast->setNode || ast->deleteNode || ast->callNode) return 0;
+    if(Vector_Size(ast->returnNode->returnElements) != 1) return 0;
+
+    /* Return clause is count(alias). */
+    AST_ReturnElementNode *ret_elem;
+    Vector_Get(ast->returnNode->returnElements, 0, &ret_elem);
+    AST_ArithmeticExpressionNode *exp = ret_elem->exp;
+    if(exp->type != AST_AR_EXP_OP || strcasecmp(exp->op.function, "count") != 0) return 0;
+    if(Vector_Size(exp->op.args) != 1) return 0;
+    AST_ArithmeticExpressionNode *arg;
+    Vector_Get(exp->op.args, 0, &arg);
+    if(arg->type != AST_AR_EXP_OPERAND || arg->operand.type != AST_AR_EXP_VARIADIC) return 0;
+    if(arg->operand.variadic.property != NULL) return 0;
+
+    Vector *entities = ast->matchNode->graphEntities;
+    AST_GraphEntity *entity;
+    if(Vector_Size(entities) == 1) {
+        /* Every node, or every node of a label. */
+        Vector_Get(entities, 0, &entity);
+        if(entity->t != N_ENTITY || !_ExecutionPlan_UnconstrainedEntity(entity)) return 0;
+        *store = LabelStore_Lookup(ctx, STORE_NODE, graph_name, entity->label);
+        return 1;
+    }
+
+    if(Vector_Size(entities) == 3) {
+        /* Every edge, or every edge of a relationship type, between unconstrained distinct nodes. */
+        AST_GraphEntity *src;
+        AST_GraphEntity *dest;
+        Vector_Get(entities, 0, &src);
+        Vector_Get(entities, 1, &entity);
+        Vector_Get(entities, 2, &dest);
+        if(src->t != N_ENTITY || entity->t != N_LINK || dest->t != N_ENTITY) return 0;
+        if(src->label || dest->label || strcmp(src->alias, dest->alias) == 0) return 0;
+        if(!_ExecutionPlan_UnconstrainedEntity(src) || !_ExecutionPlan_UnconstrainedEntity(dest) ||
+           !_ExecutionPlan_UnconstrainedEntity(entity)) return 0;
+        /* Undirected patterns match each edge twice. */
+        if(((AST_LinkEntity*)entity)->direction == N_DIR_UNKNOWN) return 0;
+        *store = LabelStore_Lookup(ctx, STORE_EDGE, graph_name, entity->label);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Returns 1 if expression refers to alias. */
+int _ExecutionPlan_ExpReferences(const AST_ArithmeticExpressionNode *exp, const char *alias) {
+    if(exp->type == AST_AR_EXP_OPERAND) {
+        return (exp->operand.type == AST_AR_EXP_VARIADIC &&
+                strcmp(exp->operand.variadic.alias, alias) == 0);
+    }
+    for(int i = 0; i < Vector_Size(exp->op.args); i++) {
+        AST_ArithmeticExpressionNode *arg;
+        Vector_Get(exp->op.args, i, &arg);
+        if(_ExecutionPlan_ExpReferences(arg, alias)) return 1;
+    }
+    return 0;
+}
+
+/* Returns 1 if expression is count(alias). */
+int _ExecutionPlan_IsCount(const AST_ArithmeticExpressionNode *exp) {
+    if(exp->type != AST_AR_EXP_OP || strcasecmp(exp->op.function, "count") != 0) return 0;
+    if(Vector_Size(exp->op.args) != 1) return 0;
+    AST_ArithmeticExpressionNode *arg;
+    Vector_Get(exp->op.args, 0, &arg);
+    return (arg->type == AST_AR_EXP_OPERAND && arg->operand.type == AST_AR_EXP_VARIADIC &&
+            arg->operand.variadic.property == NULL);
+}
+
+/* Returns 1 if expression refers to the neighbor or edge bound by expansion. */
+int _ExecutionPlan_ExpReferencesExpansion(const ExecutionPlan *plan, const AST_ArithmeticExpressionNode *exp,
+                                          const ExpandAll *expand) {
+    Node *neighbor = (expand->reversed) ? expand->_src_node : expand->_dest_node;
+    return (_ExecutionPlan_ExpReferences(exp, Graph_GetNodeAlias(plan->graph, neighbor)) ||
+            _ExecutionPlan_ExpReferences(exp, Graph_GetEdgeAlias(plan->graph, expand->_relation)));
+}
+
+/* Returns 1 if expansion's neighbor appears in the pattern only through the expanded edge,
+ * the node it expands from is bound before expansion, neither neighbor nor edge are. */
+int _ExecutionPlan_IsolatedExpansion(const ExecutionPlan *plan, const OpNode *op) {
+    if(op->operation->type != OPType_EXPAND_ALL || op->childCount != 1) return 0;
+    ExpandAll *expand = (ExpandAll*)op->operation;
+
+    Node *neighbor = (expand->reversed) ? expand->_src_node : expand->_dest_node;
+    Node **bound = (expand->reversed) ? expand->dest_node : expand->src_node;
+    if(*bound == neighbor) return 0;
+    if(Vector_Size(neighbor->incoming_edges) + Vector_Size(neighbor->outgoing_edges) != 1) return 0;
+
+    char *neighbor_alias = Graph_GetNodeAlias(plan->graph, neighbor);
+    char *edge_alias = Graph_GetEdgeAlias(plan->graph, expand->_relation);
+    char *bound_alias = Graph_GetNodeAlias(plan->graph, *bound);
+    Vector *aliases = NewVector(char*, 4);
+    OpNode_CollectModified(op->children[0], aliases);
+    int bound_before = 0;
+    int source_bound = 0;
+    for(int i = 0; i < Vector_Size(aliases); i++) {
+        char *alias;
+        Vector_Get(aliases, i, &alias);
+        if(strcmp(alias, neighbor_alias) == 0 || strcmp(alias, edge_alias) == 0) bound_before = 1;
+        if(strcmp(alias, bound_alias) == 0) source_bound = 1;
+    }
+    Vector_Free(aliases);
+    return (source_bound && !bound_before);
+}
+
+/* Expansion can be factorized if its neighbor is matched by any node it's connected to. */
+int _ExecutionPlan_FactorizableExpansion(const ExecutionPlan *plan, const OpNode *op) {
+    if(!_ExecutionPlan_IsolatedExpansion(plan, op)) return 0;
+    ExpandAll *expand = (ExpandAll*)op->operation;
+    if(expand->predicate || expand->index) return 0;
+    Node *neighbor = (expand->reversed) ? expand->_src_node : expand->_dest_node;
+    return (neighbor->label == NULL);
+}
+
+/* When an aggregation is computed over the neighbors of star pattern branches,
+ * e.g. MATCH (a:user)-[:follows]->(b), (a)-[:likes]->(c) RETURN a.name, count(b), sum(c.price),
+ * and grouping keys ignore those neighbors, replaces each branch's expansion with a factorized one,
+ * producing a single record per bound node rather than per combination of edges.
+ * Aggregate weighs each value by the number of combinations it's part of, enumerating only
+ * the edges of a branch an aggregation reads, counts are read from degree counters. */
+void _ExecutionPlan_Factorize(ExecutionPlan *plan, AST_QueryExpressionNode *ast) {
+    OpNode *root = plan->root;
+    if(root->operation->type != OPType_AGGREGATE || root->childCount != 1) return;
+
+    /* Chain of factorizable expansions right below aggregation. */
+    Vector *branches = NewVector(OpNode*, 2);
+    OpNode *current = root->children[0];
+    while(_ExecutionPlan_FactorizableExpansion(plan, current)) {
+        Vector_Push(branches, current);
+        current = current->children[0];
+    }
+    int branch_count = Vector_Size(branches);
+
+    /* Grouping keys ignore every branch, an aggregated term reads a single branch at most,
+     * counting a neighbor doesn't read it. */
+    Vector *elements = ast->returnNode->returnElements;
+    int *agg_branches = malloc(sizeof(int) * Vector_Size(elements));
+    int agg_count = 0;
+    int factorizable = (branch_count > 0);
+    for(int i = 0; i < Vector_Size(elements) && factorizable; i++) {
+        AST_ReturnElementNode *ret_elem;
+        Vector_Get(elements, i, &ret_elem);
+        AR_ExpNode *exp = AR_EXP_BuildFromAST(ret_elem->exp, NULL);
+        int aggregated = AR_EXP_ContainsAggregation(exp, NULL);
+        AR_EXP_Free(exp);
+
+        int branch = -1;
+        for(int j = 0; j < branch_count; j++) {
+            OpNode *branch_node;
+            Vector_Get(branches, j, &branch_node);
+            if(!_ExecutionPlan_ExpReferencesExpansion(plan, ret_elem->exp, (ExpandAll*)branch_node->operation)) continue;
+            if(!aggregated || branch != -1) factorizable = 0;
+            branch = j;
+        }
+
+        if(!aggregated) continue;
+        agg_branches[agg_count++] = (_ExecutionPlan_IsCount(ret_elem->exp)) ? -1 : branch;
+    }
+
+    if(!factorizable) {
+        free(agg_branches);
+        Vector_Free(branches);
+        return;
+    }
+
+    Aggregate *aggregate = (Aggregate*)root->operation;
+    aggregate->branches = malloc(sizeof(ExpandFactorized*) * branch_count);
+    aggregate->branch_count = branch_count;
+    aggregate->agg_branches = agg_branches;
+
+    for(int i = 0; i < branch_count; i++) {
+        OpNode *branch_node;
+        Vector_Get(branches, i, &branch_node);
+        ExpandAll *expand = (ExpandAll*)branch_node->operation;
+        Node **bound = (expand->reversed) ? expand->dest_node : expand->src_node;
+        Node **neighbor = (expand->reversed) ? expand->src_node : expand->dest_node;
+
+        ExpandFactorized *factorized = (ExpandFactorized*)NewExpandFactorizedOp(bound, expand->relation,
+                                                                               neighbor, expand->reversed);
+        for(int j = 0; j < agg_count; j++) {
+            if(agg_branches[j] == i) ExpandFactorized_Collect(factorized);
+        }
+
+        expand->op.free((OpBase*)expand);
+        branch_node->operation = (OpBase*)factorized;
+        branch_node->estimate = branch_node->children[0]->estimate;
+        aggregate->branches[i] = factorized;
+    }
+    Vector_Free(branches);
+}
+
+/* Returns 1 if filter tree refers to alias. */
+int _ExecutionPlan_FilterReferences(const FT_FilterNode *root, const char *alias) {
+    if(root == NULL) return 0;
+    if(root->t == FT_N_COND) {
+        return (_ExecutionPlan_FilterReferences(root->cond.left, alias) ||
+                _ExecutionPlan_FilterReferences(root->cond.right, alias));
+    }
+    if(strcmp(root->pred.Lop.alias, alias) == 0) return 1;
+    return (root->pred.t == FT_N_VARYING && strcmp(root->pred.Rop.alias, alias) == 0);
+}
+
+/* Returns 1 if any op within plan filters by alias. */
+int _ExecutionPlan_FiltersBy(const OpNode *root, const char *alias) {
+    FT_FilterNode **predicate = _OpNode_PredicateSlot(root);
+    if(predicate && _ExecutionPlan_FilterReferences(*predicate, alias)) return 1;
+    if(root->operation->type == OPType_FILTER &&
+       _ExecutionPlan_FilterReferences(((Filter*)root->operation)->filterTree, alias)) return 1;
+    for(int i = 0; i < root->childCount; i++) {
+        if(_ExecutionPlan_FiltersBy(root->children[i], alias)) return 1;
+    }
+    return 0;
+}
+
+/* Expansion only checks for existence if neither its neighbor nor its edge
+ * are returned, sorted by or filtered by, including by the expansion's own predicate. */
+int _ExecutionPlan_ExistentialExpansion(const ExecutionPlan *plan, const AST_QueryExpressionNode *ast,
+                                        const OpNode *op) {
+    if(!_ExecutionPlan_IsolatedExpansion(plan, op)) return 0;
+    ExpandAll *expand = (ExpandAll*)op->operation;
+    Node *neighbor = (expand->reversed) ? expand->_src_node : expand->_dest_node;
+    char *aliases[2] = {Graph_GetNodeAlias(plan->graph, neighbor),
+                        Graph_GetEdgeAlias(plan->graph, expand->_relation)};
+
+    Vector *elements = ast->returnNode->returnElements;
+    for(int i = 0; i < Vector_Size(elements); i++) {
+        AST_ReturnElementNode *ret_elem;
+        Vector_Get(elements, i, &ret_elem);
+        if(_ExecutionPlan_ExpReferencesExpansion(plan, ret_elem->exp, expand)) return 0;
+    }
+
+    for(int i = 0; i < 2; i++) {
+        if(_ExecutionPlan_FiltersBy(plan->root, aliases[i])) return 0;
+        for(int j = 0; ast->orderNode && j < Vector_Size(ast->orderNode->columns); j++) {
+            AST_ColumnNode *column;
+            Vector_Get(ast->orderNode->columns, j, &column);
+            if(strcmp(column->alias, aliases[i]) == 0) return 0;
+        }
+    }
+    return 1;
+}
+
+void _ExecutionPlan_SemiJoinExpansions(ExecutionPlan *plan, const AST_QueryExpressionNode *ast, OpNode *root) {
+    if(_ExecutionPlan_ExistentialExpansion(plan, ast, root)) {
+        ExpandAll_SemiJoin((ExpandAll*)root->operation);
+    }
+    for(int i = 0; i < root->childCount; i++) {
+        _ExecutionPlan_SemiJoinExpansions(plan, ast, root->children[i]);
+    }
+}
+
+/* When distinct records are returned, an expansion whose edge and neighbor are used
+ * only to filter the node it expands from, e.g. MATCH (a:user)-[:follows]->() RETURN DISTINCT a.name,
+ * stops at the first match per bound node rather than producing duplicates to be dropped later. */
+void _ExecutionPlan_SemiJoin(ExecutionPlan *plan, AST_QueryExpressionNode *ast) {
+    if(!ast->returnNode || !ast->returnNode->distinct || plan->result_set->aggregated) return;
+    /* Updates apply once per matched pattern. */
+    if(ast->createNode || ast->setNode || ast->deleteNode) return;
+    _ExecutionPlan_SemiJoinExpansions(plan, ast, plan->root);
+}
+
+/* Leaf scans read entities off the store a batch at a time,
+ * their predicate is evaluated over the whole batch at once. */
+void _ExecutionPlan_BatchScans(OpNode *root) {
+    if(root->operation->type == OPType_ALL_NODE_SCAN) {
+        ((AllNodeScan*)root->operation)->batch = NewEntityBatch();
+    } else if(root->operation->type == OPType_NODE_BY_LABEL_SCAN) {
+        ((NodeByLabelScan*)root->operation)->batch = NewEntityBatch();
+    }
+    for(int i = 0; i < root->childCount; i++) {
+        _ExecutionPlan_BatchScans(root->children[i]);
+    }
+}
+
 ExecutionPlan *NewExecutionPlan(RedisModuleCtx *ctx, const char *graph_name, AST_QueryExpressionNode *ast) {
     /* Predetermine graph size: (entities in both MATCH and CREATE clauses)
      * have graph object maintain an entity capacity, to avoid reallocs,
@@ -327,68 +1465,133 @@ ExecutionPlan *NewExecutionPlan(RedisModuleCtx *ctx, const char *graph_name, AST
     if(ast->matchNode) BuildGraph(graph, ast->matchNode->graphEntities);
 
     ExecutionPlan *execution_plan = (ExecutionPlan*)calloc(1, sizeof(ExecutionPlan));
-    
+    execution_plan->graph = graph;
+    execution_plan->graph_name = graph_name;
+    execution_plan->result_set = NewResultSet(ast);
+
+    /* Count-only queries are answered by the stores' counters, no scan required. */
+    LabelStore *count_store;
+    if(_ExecutionPlan_CountStore(ctx, graph_name, ast, &count_store)) {
+        execution_plan->root = NewOpNode(NewStatisticsCountOp(count_store, execution_plan->result_set));
+        execution_plan->root->estimate = 1;
+        /* Count is produced as is, not through the group cache. */
+        execution_plan->result_set->aggregated = 0;
+        return execution_plan;
+    }
+
     /* List of operations. */    
     FT_FilterNode *filterTree = NULL;
 
     Vector *Ops = NewVector(OpNode*, 0);
 
     execution_plan->root = NewOpNode(NULL);
-    execution_plan->graph = graph;
-    execution_plan->graph_name = graph_name;
-    execution_plan->result_set = NewResultSet(ast);
 
     Vector_Push(Ops, execution_plan->root);
 
+    /* Nodes yielded by a full-text query procedure. */
+    Node *fulltext_node = NULL;
+    Node *score_node = NULL;
+    if(ast->callNode && strcmp(ast->callNode->procedure, PROC_FULLTEXT_QUERY_NODES) == 0) {
+        char *alias;
+        Vector_Get(ast->callNode->yields, 0, &alias);
+        fulltext_node = Graph_GetNodeByAlias(graph, alias);
+        if(Vector_Size(ast->callNode->yields) > 1) {
+            Vector_Get(ast->callNode->yields, 1, &alias);
+            score_node = Graph_GetNodeByAlias(graph, alias);
+        }
+    }
+
+    /* Cyclic sub-patterns are planned separately, nodes yielded by
+     * the full-text query must be scanned first hence are left out. */
+    Vector *cyclicComponents = _ExecutionPlan_CyclicComponents(graph);
+    Vector *cyclicNodes = NewVector(Node*, 0);
+    for(int i = 0; i < Vector_Size(cyclicComponents); i++) {
+        Vector *component;
+        Vector_Get(cyclicComponents, i, &component);
+        if(_ExecutionPlan_ContainsNode(component, fulltext_node) ||
+           _ExecutionPlan_ContainsNode(component, score_node)) {
+            Vector_Free(component);
+            Vector_Put(cyclicComponents, i, NULL);
+            continue;
+        }
+        for(int j = 0; j < Vector_Size(component); j++) {
+            Node *node;
+            Vector_Get(component, j, &node);
+            Vector_Push(cyclicNodes, node);
+        }
+    }
+
     /* Get all nodes without incoming edges */
     Vector *entryNodes = Graph_GetNDegreeNodes(graph, 0);
+    Vector *plannedEdges = NewVector(Edge*, graph->edge_count);
 
     for(int i = 0; i < Vector_Size(entryNodes); i++) {
         Node *node;
         Vector_Get(entryNodes, i, &node);
+
+        /* Score is populated by the full-text scan operation. */
+        if(node == score_node) continue;
+        if(_ExecutionPlan_ContainsNode(cyclicNodes, node)) continue;
         
         /* Advance if possible. */
         if(Vector_Size(node->outgoing_edges) > 0) {
-            Vector *reversedExpandOps = NewVector(OpNode*, 0);
-
-            /* Traverse sub-graph expanded from current node. */
-            Node *srcNode = node;
-            Node *destNode;
+            /* Traverse sub-graph expanded from current node, every branch included. */
+            Vector *path = NewVector(Edge*, 0);
             Edge *edge;
+            _ExecutionPlan_CollectPath(node, path, plannedEdges);
+
+            /* Start from whichever end of the path is expected to be cheaper. */
+            int len = Vector_Size(path);
+            double forward_records[len + 1];
+            double reverse_records[len + 1];
+            double forward_cost = _ExecutionPlan_PathCost(ctx, graph, graph_name, ast, path, 0, forward_records);
+            int reverse = 0;
+            if(_ExecutionPlan_ReversiblePath(path, fulltext_node)) {
+                double reverse_cost = _ExecutionPlan_PathCost(ctx, graph, graph_name, ast, path, 1,
+                                                              reverse_records);
+                reverse = (reverse_cost < forward_cost);
+            }
 
-            while(Vector_Size(srcNode->outgoing_edges) > 0) {
-                Vector_Get(srcNode->outgoing_edges, 0, &edge);
-                destNode = edge->dest;
-                
+            /* Expand ops are pushed such that the op expanding from the entry node is last. */
+            OpNode *expandOps[len];
+            for(int j = 0; j < len; j++) {
+                Vector_Get(path, j, &edge);
                 OpNode *opNodeExpandAll = NewOpNode(NewExpandAllOp(ctx, graph, graph_name,
-                                                                   Graph_GetNodeRef(graph, srcNode),
+                                                                   Graph_GetNodeRef(graph, edge->src),
                                                                    Graph_GetEdgeRef(graph, edge),
-                                                                   Graph_GetNodeRef(graph, destNode)));
-                Vector_Push(reversedExpandOps, opNodeExpandAll);
-                
-                /* Advance. */
-                srcNode = destNode;
+                                                                   Graph_GetNodeRef(graph, edge->dest)));
+                ExpandAll *expand_all = (ExpandAll*)opNodeExpandAll->operation;
+                _ExecutionPlan_EdgeIndexSeek(ctx, graph, graph_name, ast, expand_all);
+                if(reverse) {
+                    ExpandAll_Reverse(expand_all);
+                    opNodeExpandAll->estimate = reverse_records[len - j];
+                } else {
+                    opNodeExpandAll->estimate = forward_records[j + 1];
+                }
+                expandOps[j] = opNodeExpandAll;
             }
-
-            /* Save expand ops in reverse order. */
-            while(Vector_Size(reversedExpandOps) > 0) {
-                OpNode *opNodeExpandAll;
-                Vector_Pop(reversedExpandOps, &opNodeExpandAll);
-                Vector_Push(Ops, opNodeExpandAll);
+            for(int j = 0; j < len; j++) {
+                Vector_Push(Ops, expandOps[reverse ? j : len - 1 - j]);
             }
+            Vector_Free(path);
         } else {
             /* Node doesn't have any incoming nor outgoing edges, 
              * this is an hanging node "()", create a scan operation. */
             OpNode *scan_op;
-            if(node->label) {
-                /* TODO: when indexing is enabled, use index when possible. */
-                scan_op = NewOpNode(NewNodeByLabelScanOp(ctx, graph, Graph_GetNodeRef(graph, node),
-                                    graph_name, node->label));
+            if(node == fulltext_node) {
+                SIValue *property;
+                SIValue *query;
+                Vector_Get(ast->callNode->args, 1, &property);
+                Vector_Get(ast->callNode->args, 2, &query);
+                Node **score_node_ref = (score_node) ? Graph_GetNodeRef(graph, score_node) : NULL;
+                scan_op = NewOpNode(NewFullTextScanOp(ctx, graph, Graph_GetNodeRef(graph, node),
+                                    score_node_ref, graph_name, node->label,
+                                    property->stringval, query->stringval));
             } else {
-                /* Node is not labeled, no other option but a full scan. */
-                scan_op = NewOpNode(NewAllNodeScanOp(ctx, graph, Graph_GetNodeRef(graph, node),
-                                    graph_name));
+                scan_op = NewOpNode(_ExecutionPlan_NodeScanOp(ctx, graph, graph_name, ast, node));
             }
+            double visited;
+            scan_op->estimate = _ExecutionPlan_EstimateScan(ctx, graph, graph_name, ast, node, &visited);
             Vector_Push(Ops, scan_op);
         }
 
@@ -409,8 +1612,20 @@ ExecutionPlan *NewExecutionPlan(RedisModuleCtx *ctx, const char *graph_name, AST
             Vector_Push(Ops, execution_plan->root);
         }
     } /* End of entry nodes loop */
+    Vector_Free(plannedEdges);
+
+    for(int i = 0; i < Vector_Size(cyclicComponents); i++) {
+        Vector *component;
+        Vector_Get(cyclicComponents, i, &component);
+        if(component == NULL) continue;
+        OpNode *stream = _ExecutionPlan_PlanCyclicComponent(ctx, graph, graph_name, ast, component);
+        _OpNode_AddChild(execution_plan->root, stream);
+        Vector_Free(component);
+    }
+    Vector_Free(cyclicComponents);
 
     Vector_Free(Ops);
+    _ExecutionPlan_OrderStreams(execution_plan->root);
 
     /* Set root operation */
 
@@ -418,8 +1633,31 @@ ExecutionPlan *NewExecutionPlan(RedisModuleCtx *ctx, const char *graph_name, AST
         execution_plan->root->operation = NewDeleteOp(ctx, ast->deleteNode, graph,
                                                       graph_name, execution_plan->result_set);
     } else if(ast->setNode) {
-        execution_plan->root->operation = NewUpdateOp(ast->setNode,
-                                                      graph, execution_plan->result_set);
+        execution_plan->root->operation = NewUpdateOp(ctx, ast->setNode, graph,
+                                                      graph_name, execution_plan->result_set);
+    } else if(ast->callNode && strcmp(ast->callNode->procedure, PROC_FULLTEXT_CREATE_NODE_INDEX) == 0) {
+        SIValue *label;
+        SIValue *property;
+        Vector_Get(ast->callNode->args, 0, &label);
+        Vector_Get(ast->callNode->args, 1, &property);
+        execution_plan->root->operation = NewCreateIndexOp(ctx, graph_name, STORE_NODE, label->stringval,
+                                                           property->stringval, NULL, INDEX_FULLTEXT,
+                                                           execution_plan->result_set);
+    } else if(ast->callNode && strcmp(ast->callNode->procedure, PROC_SPATIAL_CREATE_NODE_INDEX) == 0) {
+        SIValue *label;
+        SIValue *lat_property;
+        SIValue *lon_property;
+        Vector_Get(ast->callNode->args, 0, &label);
+        Vector_Get(ast->callNode->args, 1, &lat_property);
+        Vector_Get(ast->callNode->args, 2, &lon_property);
+        execution_plan->root->operation = NewCreateIndexOp(ctx, graph_name, STORE_NODE, label->stringval,
+                                                           lat_property->stringval, lon_property->stringval,
+                                                           INDEX_GEO, execution_plan->result_set);
+    } else if(ast->indexNode) {
+        LabelStoreType store_type = (ast->indexNode->entity_type == N_LINK) ? STORE_EDGE : STORE_NODE;
+        execution_plan->root->operation = NewCreateIndexOp(ctx, graph_name, store_type, ast->indexNode->label,
+                                                           ast->indexNode->property, NULL, INDEX_ORDERED,
+                                                           execution_plan->result_set);
     } else {
         if(ast->returnNode) {
             if(execution_plan->result_set->aggregated) {
@@ -446,19 +1684,48 @@ ExecutionPlan *NewExecutionPlan(RedisModuleCtx *ctx, const char *graph_name, AST
         }
     }
 
+    /* Nothing to produce nor update, e.g. a pattern which isn't returned. */
+    if(execution_plan->root->operation == NULL) {
+        for(int i = 0; i < execution_plan->root->childCount; i++) {
+            OpNode_Free(execution_plan->root->children[i]);
+        }
+        free(execution_plan->root);
+        execution_plan->root = NULL;
+        Vector_Free(cyclicNodes);
+        return execution_plan;
+    }
+
     /* Optimizations and modifications. */
     _ExecutionPlan_OptimizeEntryPoints(ctx, graph, graph_name, ast, execution_plan->root);
     
-    Vector *nodesToMerge = Graph_GetNDegreeNodes(graph, 2);
-    for(int i = 0; i < Vector_Size(nodesToMerge); i++) {
-        Node *nodeToMerge;
-        Vector_Get(nodesToMerge, i, &nodeToMerge);
-        _ExecutionPlan_MergeNodes(execution_plan, nodeToMerge);
+    for(int i = 0; i < graph->node_count; i++) {
+        Node *nodeToMerge = graph->nodes[i];
+        if(Node_IncomeDegree(nodeToMerge) < 2) continue;
+        /* Cyclic sub-patterns are bound within a single stream. */
+        if(_ExecutionPlan_ContainsNode(cyclicNodes, nodeToMerge)) continue;
+        _ExecutionPlan_MergeNodes(ctx, execution_plan, nodeToMerge);
     }
+    Vector_Free(cyclicNodes);
+
+    _ExecutionPlan_OrderByIndex(ctx, execution_plan, graph_name, ast);
 
     if(ast->whereNode != NULL) {
         execution_plan->filter_tree = BuildFiltersTree(ast->whereNode->filters);
         _ExecutionPlan_AddFilters(execution_plan->root, &execution_plan->filter_tree);
+        _ExecutionPlan_PushDownFilters(execution_plan->root);
+    }
+
+    _ExecutionPlan_Factorize(execution_plan, ast);
+    _ExecutionPlan_SemiJoin(execution_plan, ast);
+
+    /* Scanning ahead would filter entities before preceding records' updates apply. */
+    if(!ast->createNode && !ast->setNode && !ast->deleteNode) {
+        _ExecutionPlan_BatchScans(execution_plan->root);
+    }
+
+    /* Cached records would go stale as the graph is modified. */
+    if(!ast->createNode && !ast->deleteNode) {
+        _ExecutionPlan_CacheInnerStreams(execution_plan, execution_plan->root);
     }
 
     return execution_plan;
@@ -466,7 +1733,17 @@ ExecutionPlan *NewExecutionPlan(RedisModuleCtx *ctx, const char *graph_name, AST
 
 void _ExecutionPlanPrint(const OpNode *op, char **strPlan, int ident) {
     char strOp[512] = {0};
-    sprintf(strOp, "%*s%s\n", ident, "", op->operation->name);
+    FT_FilterNode **predicate = _OpNode_PredicateSlot(op);
+    int len = sprintf(strOp, "%*s%s", ident, "", op->operation->name);
+    if(predicate && *predicate) len += sprintf(strOp + len, " | filtered");
+    if(op->operation->type == OPType_PRODUCE_RESULTS) {
+        /* Pipeline stops once skip + limit records were produced. */
+        const ResultSet *set = ((ProduceResults*)op->operation)->result_set;
+        if(set->skip) len += sprintf(strOp + len, " | skip: %d", set->skip);
+        if(set->limit != RESULTSET_UNLIMITED) len += sprintf(strOp + len, " | limit: %d", set->limit);
+    }
+    if(op->estimate >= 0) len += sprintf(strOp + len, " | estimated records: %.0f", op->estimate);
+    sprintf(strOp + len, "\n");
     
     if(*strPlan == NULL) {
         *strPlan = calloc(strlen(strOp) + 1, sizeof(char));
@@ -482,6 +1759,7 @@ void _ExecutionPlanPrint(const OpNode *op, char **strPlan, int ident) {
 
 char* ExecutionPlanPrint(const ExecutionPlan *plan) {
     char *strPlan = NULL;
+    if(plan->root == NULL) return strdup("");
     _ExecutionPlanPrint(plan->root, &strPlan, 0);
     return strPlan;
 }
@@ -489,7 +1767,9 @@ char* ExecutionPlanPrint(const ExecutionPlan *plan) {
 void ResetStream(OpNode *stream) {
     stream->operation->reset(stream->operation);
     
-    for(int i = 0; i < stream->childCount; i++) {
+    /* Streams consumed by the op itself are reset by it. */
+    int stream_count = _OpNode_StreamCount(stream);
+    for(int i = 0; i < stream_count; i++) {
         ResetStream(stream->children[i]);
     }
 }
@@ -524,9 +1804,11 @@ OpResult PullFromStreams(OpNode *source, Graph *graph) {
     /* Assuming stream are independent, and do not effect each other. */
     OpNode *stream;
 
+    int stream_count = _OpNode_StreamCount(source);
+
     /* Advance stream(s) */
     int stream_idx = 0;
-    for(; stream_idx < source->childCount; stream_idx++) {
+    for(; stream_idx < stream_count; stream_idx++) {
         stream = source->children[stream_idx];
         if(_ExecuteOpNode(stream, graph) == OP_OK) {
             break;
@@ -534,12 +1816,12 @@ OpResult PullFromStreams(OpNode *source, Graph *graph) {
     }
 
     /* All streams are depleted. */
-    if(stream_idx == source->childCount) {
+    if(stream_idx == stream_count) {
         return OP_DEPLETED;
     }
 
     /* Pull from all uninitialized streams. */
-    for(int i = stream_idx+1; i < source->childCount; i++) {
+    for(int i = stream_idx+1; i < stream_count; i++) {
         stream = source->children[i];
         if(stream->state == StreamUnInitialized) {
             if(_ExecuteOpNode(stream, graph) != OP_OK) {
@@ -562,8 +1844,16 @@ OpResult PullFromStreams(OpNode *source, Graph *graph) {
     return OP_OK;
 }
 
+OpResult OpNode_Consume(OpNode *op, Graph *graph) {
+    return _ExecuteOpNode(op, graph);
+}
+
 ResultSet* ExecutionPlan_Execute(ExecutionPlan *plan) {
+    if(plan->root == NULL) return plan->result_set;
     while(_ExecuteOpNode(plan->root, plan->graph) == OP_OK);
+    if(plan->root->operation->type == OPType_PRODUCE_RESULTS) {
+        ProduceResults_Materialize((ProduceResults*)plan->root->operation);
+    }
     return plan->result_set;
 }
 
@@ -579,10 +1869,10 @@ void OpNode_Free(OpNode* op) {
 }
 
 void ExecutionPlanFree(ExecutionPlan *plan) {
-    OpNode_Free(plan->root);
-    // Graph_Free(plan->graph);
-    // if(plan->filter_tree) {
-    //     FilterTree_Free(plan->filter_tree);
-    // }
+    if(plan->root) OpNode_Free(plan->root);
+    Graph_Free(plan->graph);
+    if(plan->filter_tree) {
+        FilterTree_Free(plan->filter_tree);
+    }
     free(plan);
 }
\ No newline at end of file
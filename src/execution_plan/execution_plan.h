@@ -5,6 +5,7 @@
 #include "../parser/ast.h"
 #include "../resultset/resultset.h"
 #include "../filter_tree/filter_tree.h"
+#include "../stores/store.h"
 
 /* StreamState
  * Different states in which stream can be at. */
@@ -23,6 +24,7 @@ struct OpNode {
     struct OpNode **parents;    /* Parent operations. */
     int parentCount;            /* Number of parents. */
     StreamState state;          /* Stream state. */
+    double estimate;            /* Estimated number of records produced, negative if unknown. */
 };
 
 typedef struct OpNode OpNode;
@@ -30,6 +32,16 @@ typedef struct OpNode OpNode;
 OpNode* NewOpNode(OpBase *op);
 void OpNode_Free(OpNode* op);
 
+/* Consumes op until it produces a record, pulling data from its children as required,
+ * returns OP_OK once a record was produced. */
+OpResult OpNode_Consume(OpNode *op, Graph *graph);
+
+/* Resets stream and every stream it pulls from. */
+void ResetStream(OpNode *stream);
+
+/* Collects every alias bound within stream, each alias is collected once. */
+void OpNode_CollectModified(const OpNode *stream, Vector *aliases);
+
 
 typedef struct {
     OpNode *root;
@@ -51,4 +63,8 @@ ResultSet* ExecutionPlan_Execute(ExecutionPlan *plan);
 /* Free execution plan */
 void ExecutionPlanFree(ExecutionPlan *plan);
 
+/* Returns 1 if query only counts the entities of a single label store, and sets store. */
+int _ExecutionPlan_CountStore(RedisModuleCtx *ctx, const char *graph_name,
+                              const AST_QueryExpressionNode *ast, LabelStore **store);
+
 #endif
\ No newline at end of file
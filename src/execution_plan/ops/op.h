@@ -20,7 +20,19 @@ OPType_NODE_BY_LABEL_SCAN,
 OPType_PRODUCE_RESULTS,
 OPType_CREATE,
 OPType_UPDATE,
-OPType_DELETE
+OPType_DELETE,
+OPType_FULLTEXT_SCAN,
+OPType_CREATE_INDEX,
+OPType_INDEX_SCAN,
+OPType_GEO_SCAN,
+OPType_EDGE_INDEX_SCAN,
+OPType_NODE_BY_ID_SEEK,
+OPType_EDGE_BY_ID_SEEK,
+OPType_HASH_JOIN,
+OPType_LEAPFROG_JOIN,
+OPType_CACHE,
+OPType_STATISTICS_COUNT,
+OPType_EXPAND_FACTORIZED
 } OPType;
 
 typedef enum {
@@ -17,7 +17,13 @@ Aggregate* NewAggregate(RedisModuleCtx *ctx, AST_QueryExpressionNode *ast) {
     aggregate->init = 0;
     aggregate->none_aggregated_expression_count = 0;
     aggregate->none_aggregated_expressions = NULL;
+    aggregate->key_programs = NULL;
     aggregate->group_keys = NULL;
+    aggregate->group_key = NULL;
+    aggregate->group_key_cap = 0;
+    aggregate->branches = NULL;
+    aggregate->branch_count = 0;
+    aggregate->agg_branches = NULL;
 
     aggregate->op.name = "Aggregate";
     aggregate->op.type = OPType_AGGREGATE;
@@ -46,18 +52,36 @@ Vector* _build_aggregated_expressions(AST_QueryExpressionNode *ast, Graph* g) {
     return aggregated_expressions;
 }
 
-/* Construct group key based on none aggregated terms. 
- * Returns group name which must be freed by caller. */
+/* Construct group key based on none aggregated terms.
+ * Returns group name, valid until next call, group cache copies keys. */
 char* _computeGroupKey(Aggregate *op, SIValue *group_keys) {
-    char *group;
-
     for(int i = 0; i < op->none_aggregated_expression_count; i++) {
-        AR_ExpNode *exp = op->none_aggregated_expressions[i];
-        group_keys[i] = AR_EXP_Evaluate(exp);
+        group_keys[i] = BC_Evaluate(op->key_programs[i]);
     }
 
-    SIValue_StringConcat(group_keys, op->none_aggregated_expression_count, &group);
-    return group;
+    SIValue_StringConcatBuffer(group_keys, op->none_aggregated_expression_count, &op->group_key, &op->group_key_cap);
+    return op->group_key;
+}
+
+/* Aggregates exp over the cross product of the factorized branches' edges,
+ * every combination weighs the same, only the edges of the branch exp reads are enumerated. */
+void _aggregateFactorized(Aggregate *op, AR_ExpNode *exp, int branch) {
+    size_t weight = 1;
+    for(int i = 0; i < op->branch_count; i++) {
+        if(i != branch) weight *= op->branches[i]->count;
+    }
+
+    if(branch == -1) {
+        AR_EXP_AggregateWeighted(exp, weight);
+        return;
+    }
+
+    ExpandFactorized *read = op->branches[branch];
+    for(size_t i = 0; i < read->count; i++) {
+        ExpandFactorized_Bind(read, i);
+        AR_EXP_AggregateWeighted(exp, weight);
+    }
+    ExpandFactorized_Unbind(read);
 }
 
 void _aggregateRecord(Aggregate *op, Graph *g) {
@@ -86,7 +110,8 @@ void _aggregateRecord(Aggregate *op, Graph *g) {
     for(int i = 0; i < Vector_Size(group->aggregationFunctions); i++) {
         AR_ExpNode *exp;
         Vector_Get(group->aggregationFunctions, i, &exp);
-        AR_EXP_Aggregate(exp);
+        if(op->branch_count) _aggregateFactorized(op, exp, op->agg_branches[i]);
+        else AR_EXP_Aggregate(exp);
     }
 }
 
@@ -100,6 +125,10 @@ OpResult AggregateConsume(OpBase *opBase, Graph* graph) {
                                                      graph);
         /* Allocate memory for group keys. */
         op->group_keys = malloc(sizeof(SIValue) * op->none_aggregated_expression_count);
+        op->key_programs = malloc(sizeof(BC_Program*) * op->none_aggregated_expression_count);
+        for(int i = 0; i < op->none_aggregated_expression_count; i++) {
+            op->key_programs[i] = BC_CompileExpression(op->none_aggregated_expressions[i]);
+        }
         op->init = 1;
         return OP_REFRESH;
     }
@@ -121,5 +150,13 @@ OpResult AggregateReset(OpBase *opBase) {
 
 void AggregateFree(OpBase *opBase) {
     Aggregate *op = (Aggregate*)opBase;
+    if(op->key_programs) {
+        for(int i = 0; i < op->none_aggregated_expression_count; i++) BC_Free(op->key_programs[i]);
+        free(op->key_programs);
+    }
+    free(op->group_keys);
+    free(op->group_key);
+    free(op->branches);
+    free(op->agg_branches);
     free(op);
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "../../redismodule.h"
 #include "../../graph/graph.h"
 #include "../../arithmetic/arithmetic_expression.h"
+#include "op_expand_factorized.h"
+#include "../../bytecode/bytecode.h"
 
 /* Aggregate
  * aggregates graph according to  
@@ -17,7 +19,13 @@
      AST_QueryExpressionNode *ast;
      int none_aggregated_expression_count; /* Number of return terms which are not aggregated. */
      AR_ExpNode **none_aggregated_expressions;
+     BC_Program **key_programs; /* Per none aggregated term, its compiled expression. */
      SIValue *group_keys;   /* Array of values composing an aggregated group. */
+     char *group_key;       /* Buffer holding current group's key, reused across records. */
+     size_t group_key_cap;  /* Group key buffer capacity. */
+     ExpandFactorized **branches;   /* Factorized expansions feeding op, NULL if none. */
+     int branch_count;
+     int *agg_branches;     /* Per aggregated term, branch whose edges it reads, -1 if none. */
      int init;
  } Aggregate;
 
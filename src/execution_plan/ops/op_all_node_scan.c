@@ -5,11 +5,8 @@ OpBase* NewAllNodeScanOp(RedisModuleCtx *ctx, Graph *g, Node **n, const char *gr
 }
 
 AllNodeScan* NewAllNodeScan(RedisModuleCtx *ctx, Graph *g, Node **n, const char *graph_name) {
-    // Get graph store
-    LabelStore *store = LabelStore_Get(ctx, STORE_NODE, graph_name, NULL);
-    if(store == NULL) {
-        return NULL;
-    }
+    // Get graph store, a missing store is scanned as empty rather than created.
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_NODE, graph_name, NULL);
 
     AllNodeScan *allNodeScan = malloc(sizeof(AllNodeScan));
     allNodeScan->ctx = ctx;
@@ -17,6 +14,9 @@ AllNodeScan* NewAllNodeScan(RedisModuleCtx *ctx, Graph *g, Node **n, const char
     allNodeScan->_node = *n;
     allNodeScan->store = store;
     allNodeScan->graph = graph_name;
+    allNodeScan->predicate = NULL;
+    allNodeScan->program = NULL;
+    allNodeScan->batch = NULL;
     LabelStore_Scan(store, &allNodeScan->iter);
 
     // Set our Op operations
@@ -32,8 +32,23 @@ AllNodeScan* NewAllNodeScan(RedisModuleCtx *ctx, Graph *g, Node **n, const char
     return allNodeScan;
 }
 
+/* Hands out the next node of the current batch, scanning and filtering
+ * another batch once it's exhausted. */
+static OpResult _AllNodeScanConsumeBatch(AllNodeScan *op, Graph *graph) {
+    GraphEntity *node;
+    while((node = EntityBatch_Next(op->batch)) == NULL) {
+        if(EntityBatch_Fill(op->batch, &op->iter) == 0) return OP_DEPLETED;
+        if(op->predicate == NULL) continue;
+        if(op->program == NULL) op->program = BC_CompileFilter(op->predicate, graph);
+        EntityBatch_Filter(op->batch, op->program, (GraphEntity**)op->node);
+    }
+    *op->node = (Node*)node;
+    return OP_OK;
+}
+
 OpResult AllNodeScanConsume(OpBase *opBase, Graph* graph) {
     AllNodeScan *op = (AllNodeScan*)opBase;
+    if(op->batch) return _AllNodeScanConsumeBatch(op, graph);
     
     if(raxEOF(&op->iter)) {
         return OP_DEPLETED;
@@ -42,22 +57,22 @@ OpResult AllNodeScanConsume(OpBase *opBase, Graph* graph) {
     char *id;
     uint16_t idLen;
     Node *node;
-    int res = LabelStoreIterator_Next(&op->iter, &id, &idLen, (void**)&node);
-    
-    if(res == 0) {
-        return OP_DEPLETED;
+    while(LabelStoreIterator_Next(&op->iter, &id, &idLen, (void**)&node)) {
+        /* Update node */
+        *op->node = node;
+        if(op->predicate == NULL) return OP_OK;
+        if(op->program == NULL) op->program = BC_CompileFilter(op->predicate, graph);
+        if(BC_ApplyFilter(op->program)) return OP_OK;
     }
-    
-    /* Update node */
-    *op->node = node;
 
-    return OP_OK;
+    return OP_DEPLETED;
 }
 
 OpResult AllNodeScanReset(OpBase *op) {
     AllNodeScan *allNodeScan = (AllNodeScan*)op;
     
     *allNodeScan->node = allNodeScan->_node;
+    if(allNodeScan->batch) EntityBatch_Clear(allNodeScan->batch);
     LabelStoreIterator_Free(&allNodeScan->iter);
 
     LabelStore_Scan(allNodeScan->store, &allNodeScan->iter);
@@ -67,5 +82,8 @@ OpResult AllNodeScanReset(OpBase *op) {
 void AllNodeScanFree(OpBase *ctx) {
     AllNodeScan *allNodeScan = (AllNodeScan *)ctx;
     LabelStoreIterator_Free(&allNodeScan->iter);
+    FilterTree_Free(allNodeScan->predicate);
+    BC_Free(allNodeScan->program);
+    if(allNodeScan->batch) EntityBatch_Free(allNodeScan->batch);
     free(allNodeScan);
 }
\ No newline at end of file
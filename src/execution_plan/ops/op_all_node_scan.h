@@ -2,6 +2,9 @@
 #define __OP_ALL_NODE_SCAN_H__
 
 #include "op.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../bytecode/bytecode.h"
+#include "../entity_batch.h"
 #include "../../redismodule.h"
 #include "../../graph/graph.h"
 #include "../../graph/node.h"
@@ -19,6 +22,9 @@
     RedisModuleCtx *ctx;        /* redis module API context */
     const char *graph;          /* queried graph id */
     LabelStoreIterator iter;    /* graph iterator */
+    FT_FilterNode *predicate;   /* evaluated on each node, failing nodes are skipped, NULL if none */
+    BC_Program *program;        /* predicate compiled on first evaluation */
+    EntityBatch *batch;         /* nodes scanned ahead, NULL if scanning a node at a time */
  } AllNodeScan;
 
 OpBase* NewAllNodeScanOp(RedisModuleCtx *ctx, Graph *g, Node **n, const char *graph_name);
@@ -0,0 +1,192 @@
+#include "op_cache.h"
+#include "../execution_plan.h"
+#include "../../util/key_encoding.h"
+
+OpBase* NewCacheOp(Graph *g, struct OpNode *stream, Vector *params, size_t memory_cap) {
+    Cache *cache = calloc(1, sizeof(Cache));
+    cache->stream = stream;
+    cache->entries = raxNew();
+    cache->memory_cap = memory_cap;
+
+    Vector *aliases = NewVector(char*, 3);
+    OpNode_CollectModified(stream, aliases);
+    cache->ref_count = Vector_Size(aliases);
+    cache->refs = malloc(sizeof(GraphEntity**) * cache->ref_count);
+    cache->originals = malloc(sizeof(GraphEntity*) * cache->ref_count);
+    for(int i = 0; i < cache->ref_count; i++) {
+        char *alias;
+        Vector_Get(aliases, i, &alias);
+        cache->refs[i] = Graph_GetEntityRef(g, alias);
+        cache->originals[i] = *cache->refs[i];
+    }
+    Vector_Free(aliases);
+
+    cache->param_count = (params) ? Vector_Size(params) : 0;
+    cache->params = malloc(sizeof(GraphEntity**) * cache->param_count);
+    for(int i = 0; i < cache->param_count; i++) {
+        char *alias;
+        Vector_Get(params, i, &alias);
+        cache->params[i] = Graph_GetEntityRef(g, alias);
+    }
+
+    // Set our Op operations
+    cache->op.name = "Cache";
+    cache->op.type = OPType_CACHE;
+    cache->op.consume = CacheConsume;
+    cache->op.reset = CacheReset;
+    cache->op.free = CacheFree;
+    cache->op.modifies = NULL;
+
+    return (OpBase*)cache;
+}
+
+static size_t _Cache_KeyLength(const Cache *op) {
+    return KEY_ENCODING_UINT64_LEN * op->param_count;
+}
+
+static void _CacheEntry_Free(CacheEntry *entry) {
+    free(entry->key);
+    free(entry->records);
+    free(entry);
+}
+
+static void _Cache_Unlink(Cache *op, CacheEntry *entry) {
+    if(entry->prev) entry->prev->next = entry->next;
+    else op->lru_head = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+    else op->lru_tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void _Cache_PushFront(Cache *op, CacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = op->lru_head;
+    if(op->lru_head) op->lru_head->prev = entry;
+    op->lru_head = entry;
+    if(op->lru_tail == NULL) op->lru_tail = entry;
+}
+
+/* Drops the least recently used entry. */
+static void _Cache_Evict(Cache *op) {
+    CacheEntry *entry = op->lru_tail;
+    _Cache_Unlink(op, entry);
+    raxRemove(op->entries, entry->key, _Cache_KeyLength(op), NULL);
+    op->memory -= entry->memory;
+    _CacheEntry_Free(entry);
+}
+
+/* Stops caching current pass, its records are streamed as is. */
+static void _Cache_Abandon(Cache *op) {
+    op->memory -= op->current->memory;
+    _CacheEntry_Free(op->current);
+    op->current = NULL;
+}
+
+/* Looks up the entry of the parameters' current binding,
+ * replays it when found, otherwise starts consuming stream into a new entry. */
+static void _Cache_Begin(Cache *op) {
+    size_t key_len = _Cache_KeyLength(op);
+    unsigned char key[key_len + 1];
+    for(int i = 0; i < op->param_count; i++) {
+        KeyEncoding_Uint64((*op->params[i])->id, key + i * KEY_ENCODING_UINT64_LEN);
+    }
+
+    op->started = 1;
+    op->position = 0;
+    CacheEntry *entry = raxFind(op->entries, key, key_len);
+    if(entry != raxNotFound) {
+        _Cache_Unlink(op, entry);
+        _Cache_PushFront(op, entry);
+        op->current = entry;
+        op->filling = 0;
+        return;
+    }
+
+    entry = calloc(1, sizeof(CacheEntry));
+    entry->key = malloc(key_len + 1);
+    memcpy(entry->key, key, key_len);
+    entry->memory = sizeof(CacheEntry) + key_len;
+    op->memory += entry->memory;
+    op->current = entry;
+    op->filling = 1;
+
+    if(op->stream_used) ResetStream(op->stream);
+    op->stream_used = 1;
+}
+
+/* Appends current record to the entry being filled,
+ * evicting entries as required to stay within the memory cap. */
+static void _Cache_Append(Cache *op) {
+    CacheEntry *entry = op->current;
+    if(entry->record_count == entry->record_cap) {
+        size_t cap = (entry->record_cap) ? entry->record_cap * 2 : 16;
+        size_t growth = (cap - entry->record_cap) * op->ref_count * sizeof(GraphEntity*);
+        while(op->memory + growth > op->memory_cap && op->lru_tail) _Cache_Evict(op);
+        if(op->memory + growth > op->memory_cap) {
+            _Cache_Abandon(op);
+            return;
+        }
+        entry->records = realloc(entry->records, cap * op->ref_count * sizeof(GraphEntity*));
+        entry->record_cap = cap;
+        entry->memory += growth;
+        op->memory += growth;
+    }
+
+    GraphEntity **record = entry->records + entry->record_count * op->ref_count;
+    for(int i = 0; i < op->ref_count; i++) record[i] = *op->refs[i];
+    entry->record_count++;
+}
+
+OpResult CacheConsume(OpBase *opBase, Graph *graph) {
+    Cache *op = (Cache*)opBase;
+
+    if(!op->started) _Cache_Begin(op);
+
+    if(!op->filling) {
+        if(op->position == op->current->record_count) return OP_REFRESH;
+        GraphEntity **record = op->current->records + op->position * op->ref_count;
+        for(int i = 0; i < op->ref_count; i++) *op->refs[i] = record[i];
+        op->position++;
+        return OP_OK;
+    }
+
+    if(OpNode_Consume(op->stream, graph) != OP_OK) {
+        /* Pass is complete, entry can be replayed. */
+        if(op->current) {
+            raxInsert(op->entries, op->current->key, _Cache_KeyLength(op), op->current, NULL);
+            _Cache_PushFront(op, op->current);
+            op->current = NULL;
+        }
+        op->filling = 0;
+        return OP_REFRESH;
+    }
+
+    if(op->current) _Cache_Append(op);
+    return OP_OK;
+}
+
+/* Entries are kept, an incomplete entry is dropped. */
+OpResult CacheReset(OpBase *ctx) {
+    Cache *op = (Cache*)ctx;
+    if(op->filling && op->current) _Cache_Abandon(op);
+    op->current = NULL;
+    op->filling = 0;
+    op->started = 0;
+    for(int i = 0; i < op->ref_count; i++) *op->refs[i] = op->originals[i];
+    return OP_OK;
+}
+
+void CacheFree(OpBase *ctx) {
+    Cache *op = (Cache*)ctx;
+    if(op->filling && op->current) _CacheEntry_Free(op->current);
+    while(op->lru_head) {
+        CacheEntry *entry = op->lru_head;
+        op->lru_head = entry->next;
+        _CacheEntry_Free(entry);
+    }
+    raxFree(op->entries);
+    free(op->refs);
+    free(op->originals);
+    free(op->params);
+    free(op);
+}
@@ -0,0 +1,58 @@
+#ifndef __OP_CACHE_H
+#define __OP_CACHE_H
+
+#include "op.h"
+#include "../../dep/rax/rax.h"
+
+/* Memory available to a single cache op, in bytes. */
+#define CACHE_MEMORY_CAP (16 * 1024 * 1024)
+
+struct OpNode;
+
+/* Records produced by the cached stream for a single binding of its parameters. */
+typedef struct CacheEntry {
+    unsigned char *key;         /* Parameters' ids. */
+    GraphEntity **records;      /* Records, ref_count entities each. */
+    size_t record_count;
+    size_t record_cap;
+    size_t memory;              /* Bytes held by entry. */
+    struct CacheEntry *prev;    /* More recently used entry. */
+    struct CacheEntry *next;    /* Less recently used entry. */
+} CacheEntry;
+
+/* Cache materializes the records of a stream which is reset and consumed over and over,
+ * the stream is consumed once per distinct binding of its parameters, entities it reads
+ * but does not bind, and its records are replayed from memory on following passes.
+ * Once entries exceed the memory cap the least recently used ones are evicted,
+ * a pass that doesn't fit on its own is streamed without being cached. */
+typedef struct {
+    OpBase op;
+    struct OpNode *stream;      /* Cached stream, consumed by the op itself. */
+    int ref_count;              /* Number of entities bound by stream. */
+    GraphEntity ***refs;        /* Entities bound by stream. */
+    GraphEntity **originals;    /* Unbound value of each ref. */
+    int param_count;            /* Number of parameters. */
+    GraphEntity ***params;      /* Entities read by stream, bound elsewhere. */
+    rax *entries;               /* Parameters' ids -> entry. */
+    CacheEntry *lru_head;       /* Most recently used entry. */
+    CacheEntry *lru_tail;       /* Least recently used entry. */
+    size_t memory;              /* Bytes held by all entries. */
+    size_t memory_cap;          /* Maximum bytes held by all entries. */
+    CacheEntry *current;        /* Entry replayed or filled by current pass. */
+    size_t position;            /* Next record replayed. */
+    int filling;                /* Current pass consumes stream. */
+    int stream_used;            /* Stream must be reset before it's consumed again. */
+    int started;                /* Current pass began. */
+} Cache;
+
+/* Creates a new Cache operation over stream, which is expected to be the op's only child,
+ * params lists the aliases of entities stream reads but does not bind, may be NULL. */
+OpBase* NewCacheOp(Graph *g, struct OpNode *stream, Vector *params, size_t memory_cap);
+
+OpResult CacheConsume(OpBase *opBase, Graph *graph);
+
+OpResult CacheReset(OpBase *ctx);
+
+void CacheFree(OpBase *ctx);
+
+#endif
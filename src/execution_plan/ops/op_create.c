@@ -118,8 +118,10 @@ void _CreateNodes(RedisModuleCtx *ctx, OpCreate *op) {
         /* Add properties.*/
         /* TODO: add all properties in one go. */
         for(int prop_idx = 0; prop_idx < n->prop_count; prop_idx++) {
-            EntityProperty prop = n->properties[prop_idx];
-            Node_Add_Properties(node, 1, &(prop.name), &(prop.value));
+            /* Placeholder's properties are released along with the query's AST. */
+            char *name = strdup(n->properties[prop_idx].name);
+            SIValue value = SI_Clone(n->properties[prop_idx].value);
+            Node_Add_Properties(node, 1, &name, &value);
         }
 
         /* Save node for later insertion. */
@@ -130,7 +132,6 @@ void _CreateNodes(RedisModuleCtx *ctx, OpCreate *op) {
     }
 
     /* Nodes creation should only happen once. */
-    /* TODO: There's a leak here, original graph node (placeholder) is not released. */
     free(op->nodes_to_create);
     op->node_count = 0;
 }
@@ -150,8 +151,9 @@ void _CreateEdges(RedisModuleCtx *ctx, OpCreate *op, Graph *graph) {
         /* Add properties.*/
         /* TODO: add all properties in one go. */
         for(int prop_idx = 0; prop_idx < e->prop_count; prop_idx++) {
-            EntityProperty prop = e->properties[prop_idx];
-            Edge_Add_Properties(edge, 1, &(prop.name), &prop.value);
+            char *name = strdup(e->properties[prop_idx].name);
+            SIValue value = SI_Clone(e->properties[prop_idx].value);
+            Edge_Add_Properties(edge, 1, &name, &value);
         }        
         
         Node_ConnectNode(src_node, dest_node, edge);
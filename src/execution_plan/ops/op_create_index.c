@@ -0,0 +1,56 @@
+#include "op_create_index.h"
+
+OpBase* NewCreateIndexOp(RedisModuleCtx *ctx, const char *graph_name, LabelStoreType store_type, const char *label,
+                         const char *property, const char *lon_property, IndexType index_type,
+                         ResultSet *result_set) {
+    OpCreateIndex *op_create_index = calloc(1, sizeof(OpCreateIndex));
+    op_create_index->ctx = ctx;
+    op_create_index->graph_name = graph_name;
+    op_create_index->store_type = store_type;
+    op_create_index->label = label;
+    op_create_index->property = property;
+    op_create_index->lon_property = lon_property;
+    op_create_index->index_type = index_type;
+    op_create_index->result_set = result_set;
+    op_create_index->done = 0;
+
+    // Set our Op operations
+    op_create_index->op.name = "Create Index";
+    op_create_index->op.type = OPType_CREATE_INDEX;
+    op_create_index->op.consume = OpCreateIndexConsume;
+    op_create_index->op.reset = OpCreateIndexReset;
+    op_create_index->op.free = OpCreateIndexFree;
+    op_create_index->op.modifies = NULL;
+    return (OpBase*)op_create_index;
+}
+
+OpResult OpCreateIndexConsume(OpBase *opBase, Graph* graph) {
+    OpCreateIndex *op = (OpCreateIndex*)opBase;
+    if(op->done) return OP_DEPLETED;
+    op->done = 1;
+
+    LabelStore *store = LabelStore_Get(op->ctx, op->store_type, op->graph_name, op->label);
+    int created;
+    if(op->index_type == INDEX_FULLTEXT) {
+        created = (LabelStore_AddFullTextIndex(store, op->property) != NULL);
+    } else if(op->index_type == INDEX_GEO) {
+        created = (LabelStore_AddGeoIndex(store, op->property, op->lon_property) != NULL);
+    } else {
+        created = (LabelStore_AddIndex(store, op->store_type, op->property) != NULL);
+    }
+
+    /* Index already exists. */
+    if(!created) return OP_DEPLETED;
+
+    if(op->result_set) op->result_set->indices_created++;
+    return OP_DEPLETED;
+}
+
+OpResult OpCreateIndexReset(OpBase *ctx) {
+    return OP_OK;
+}
+
+void OpCreateIndexFree(OpBase *ctx) {
+    OpCreateIndex *op = (OpCreateIndex*)ctx;
+    free(op);
+}
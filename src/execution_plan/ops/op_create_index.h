@@ -0,0 +1,32 @@
+#ifndef __OP_CREATE_INDEX_H
+#define __OP_CREATE_INDEX_H
+
+#include "op.h"
+#include "../../resultset/resultset.h"
+
+/* CreateIndex
+ * Builds an index over a label's or relationship type's property,
+ * indexing every entity currently holding the label. */
+
+typedef struct {
+    OpBase op;
+    RedisModuleCtx *ctx;
+    const char *graph_name;
+    LabelStoreType store_type;  /* Indexing nodes or edges. */
+    const char *label;          /* Indexed label or relationship type. */
+    const char *property;       /* Indexed property, latitude property for geospatial indices. */
+    const char *lon_property;   /* Longitude property, geospatial indices only. */
+    IndexType index_type;       /* Kind of index to build. */
+    ResultSet *result_set;
+    int done;
+} OpCreateIndex;
+
+OpBase* NewCreateIndexOp(RedisModuleCtx *ctx, const char *graph_name, LabelStoreType store_type, const char *label,
+                         const char *property, const char *lon_property, IndexType index_type,
+                         ResultSet *result_set);
+
+OpResult OpCreateIndexConsume(OpBase *opBase, Graph* graph);
+OpResult OpCreateIndexReset(OpBase *ctx);
+void OpCreateIndexFree(OpBase *ctx);
+
+#endif
@@ -100,6 +100,11 @@ void _DeleteNode(OpDelete *op, Node *n) {
         Edge *outgoing_edge;
         Vector_Get(n->outgoing_edges, i, &outgoing_edge);
         
+        /* Edge indices order edges by source node,
+         * unindex edge while its source node is still known. */
+        LabelStore *edge_store = LabelStore_Get(ctx, STORE_EDGE, graph_name, outgoing_edge->relationship);
+        LabelStore_UnindexEntity(edge_store, (GraphEntity*)outgoing_edge);
+
         /* Set edge source node to NULL, to prevent _DeleteEdge from 
          * modifying edge's source node. */
         outgoing_edge->src = NULL;
@@ -150,6 +155,7 @@ void _DeleteEdge(OpDelete *op, Edge *e) {
         }
         Vector_Free(src_node->outgoing_edges);
         src_node->outgoing_edges = new_outgoing_edges;
+        Node_UpdateDegree(src_node, e->relationship, -1, 0);
     }
     
     /* Remove edge from its destination node. */
@@ -165,6 +171,7 @@ void _DeleteEdge(OpDelete *op, Edge *e) {
         }
         Vector_Free(dest_node->incoming_edges);
         dest_node->incoming_edges = new_incoming_edges;
+        Node_UpdateDegree(dest_node, e->relationship, 0, -1);
     }
     
     /* Remove edge from hexastore. */
@@ -0,0 +1,73 @@
+#include "op_edge_by_id_seek.h"
+
+OpBase *NewEdgeByIdSeekOp(RedisModuleCtx *ctx, Graph *g, Node **src_node, Edge **relation,
+                          Node **dest_node, const char *graph_name, long int *ids, size_t id_count) {
+    EdgeByIdSeek *edgeByIdSeek = malloc(sizeof(EdgeByIdSeek));
+    edgeByIdSeek->src_node = src_node;
+    edgeByIdSeek->_src_node = *src_node;
+    edgeByIdSeek->relation = relation;
+    edgeByIdSeek->_relation = *relation;
+    edgeByIdSeek->dest_node = dest_node;
+    edgeByIdSeek->_dest_node = *dest_node;
+    edgeByIdSeek->store = LabelStore_Get(ctx, STORE_EDGE, graph_name, (*relation)->relationship);
+    edgeByIdSeek->ids = ids;
+    edgeByIdSeek->id_count = id_count;
+    edgeByIdSeek->position = 0;
+
+    // Set our Op operations
+    edgeByIdSeek->op.name = "Edge By Id Seek";
+    edgeByIdSeek->op.type = OPType_EDGE_BY_ID_SEEK;
+    edgeByIdSeek->op.consume = EdgeByIdSeekConsume;
+    edgeByIdSeek->op.reset = EdgeByIdSeekReset;
+    edgeByIdSeek->op.free = EdgeByIdSeekFree;
+    edgeByIdSeek->op.modifies = NewVector(char*, 3);
+
+    Vector_Push(edgeByIdSeek->op.modifies, Graph_GetNodeAlias(g, *src_node));
+    Vector_Push(edgeByIdSeek->op.modifies, Graph_GetEdgeAlias(g, *relation));
+    Vector_Push(edgeByIdSeek->op.modifies, Graph_GetNodeAlias(g, *dest_node));
+
+    return (OpBase*)edgeByIdSeek;
+}
+
+/* Node matches pattern node if pattern node isn't labeled or both share the same label. */
+static int _EdgeByIdSeek_LabelMatch(const Node *pattern, const Node *n) {
+    if(pattern->label == NULL) return 1;
+    return (n->label != NULL && strcmp(pattern->label, n->label) == 0);
+}
+
+OpResult EdgeByIdSeekConsume(OpBase *opBase, Graph* graph) {
+    EdgeByIdSeek *op = (EdgeByIdSeek*)opBase;
+
+    while(op->position < op->id_count) {
+        char id[32];
+        int id_len = snprintf(id, 32, "%ld", op->ids[op->position++]);
+        Edge *e = raxFind(op->store->items, (unsigned char *)id, id_len);
+        if(e == raxNotFound) continue;
+        if(!_EdgeByIdSeek_LabelMatch(op->_src_node, e->src) ||
+           !_EdgeByIdSeek_LabelMatch(op->_dest_node, e->dest)) continue;
+
+        *op->relation = e;
+        *op->src_node = e->src;
+        *op->dest_node = e->dest;
+        return OP_OK;
+    }
+
+    return OP_DEPLETED;
+}
+
+OpResult EdgeByIdSeekReset(OpBase *ctx) {
+    EdgeByIdSeek *edgeByIdSeek = (EdgeByIdSeek*)ctx;
+
+    /* Restore original entities. */
+    *edgeByIdSeek->src_node = edgeByIdSeek->_src_node;
+    *edgeByIdSeek->relation = edgeByIdSeek->_relation;
+    *edgeByIdSeek->dest_node = edgeByIdSeek->_dest_node;
+    edgeByIdSeek->position = 0;
+    return OP_OK;
+}
+
+void EdgeByIdSeekFree(OpBase *op) {
+    EdgeByIdSeek *edgeByIdSeek = (EdgeByIdSeek*)op;
+    free(edgeByIdSeek->ids);
+    free(edgeByIdSeek);
+}
@@ -0,0 +1,43 @@
+#ifndef __OP_EDGE_BY_ID_SEEK_H
+#define __OP_EDGE_BY_ID_SEEK_H
+
+#include "op.h"
+#include "../../redismodule.h"
+#include "../../graph/graph.h"
+#include "../../graph/edge.h"
+#include "../../stores/store.h"
+
+/* EdgeByIdSeek
+ * Looks up each of a given list of ids within the relationship type's store,
+ * sets edge to each edge found together with its source and destination nodes,
+ * edges connecting nodes which don't carry the expected labels are skipped. */
+
+typedef struct {
+    OpBase op;
+    Node **src_node;        /* Edge's source node. */
+    Node *_src_node;
+    Edge **relation;        /* Edge being looked up. */
+    Edge *_relation;
+    Node **dest_node;       /* Edge's destination node. */
+    Node *_dest_node;
+    LabelStore *store;      /* Relationship type store, or 'ALL' store for untyped edges. */
+    long int *ids;          /* Sorted, unique ids to look up. */
+    size_t id_count;
+    size_t position;        /* Next id to look up. */
+} EdgeByIdSeek;
+
+/* Creates a new EdgeByIdSeek operation, takes ownership of ids. */
+OpBase *NewEdgeByIdSeekOp(RedisModuleCtx *ctx, Graph *g, Node **src_node, Edge **relation,
+                          Node **dest_node, const char *graph_name, long int *ids, size_t id_count);
+
+/* EdgeByIdSeek next operation
+ * called each time a new edge is required. */
+OpResult EdgeByIdSeekConsume(OpBase *opBase, Graph* graph);
+
+/* Restart lookup */
+OpResult EdgeByIdSeekReset(OpBase *ctx);
+
+/* Frees EdgeByIdSeek */
+void EdgeByIdSeekFree(OpBase *ctx);
+
+#endif
@@ -0,0 +1,69 @@
+#include "op_edge_index_scan.h"
+
+static void _EdgeIndexScan_Seek(EdgeIndexScan *op) {
+    if(op->bounds.prefix) {
+        Index_ScanPrefix(op->index, op->bounds.prefix, &op->iter);
+    } else {
+        Index_ScanRange(op->index, op->bounds.min, op->bounds.min_inclusive,
+                        op->bounds.max, op->bounds.max_inclusive, &op->iter);
+    }
+}
+
+OpBase *NewEdgeIndexScanOp(Graph *g, Node **src_node, Edge **relation, Node **dest_node,
+                           Index *index, IndexScanBounds bounds) {
+    EdgeIndexScan *edgeIndexScan = malloc(sizeof(EdgeIndexScan));
+    edgeIndexScan->src_node = src_node;
+    edgeIndexScan->_src_node = *src_node;
+    edgeIndexScan->relation = relation;
+    edgeIndexScan->_relation = *relation;
+    edgeIndexScan->dest_node = dest_node;
+    edgeIndexScan->_dest_node = *dest_node;
+    edgeIndexScan->index = index;
+    edgeIndexScan->bounds = bounds;
+    _EdgeIndexScan_Seek(edgeIndexScan);
+
+    // Set our Op operations
+    edgeIndexScan->op.name = "Edge Index Scan";
+    edgeIndexScan->op.type = OPType_EDGE_INDEX_SCAN;
+    edgeIndexScan->op.consume = EdgeIndexScanConsume;
+    edgeIndexScan->op.reset = EdgeIndexScanReset;
+    edgeIndexScan->op.free = EdgeIndexScanFree;
+    edgeIndexScan->op.modifies = NewVector(char*, 3);
+
+    Vector_Push(edgeIndexScan->op.modifies, Graph_GetNodeAlias(g, *src_node));
+    Vector_Push(edgeIndexScan->op.modifies, Graph_GetEdgeAlias(g, *relation));
+    Vector_Push(edgeIndexScan->op.modifies, Graph_GetNodeAlias(g, *dest_node));
+
+    return (OpBase*)edgeIndexScan;
+}
+
+OpResult EdgeIndexScanConsume(OpBase *opBase, Graph* graph) {
+    EdgeIndexScan *op = (EdgeIndexScan*)opBase;
+
+    Edge *e = (Edge*)IndexIterator_Next(&op->iter);
+    if(e == NULL) return OP_DEPLETED;
+
+    *op->relation = e;
+    *op->src_node = e->src;
+    *op->dest_node = e->dest;
+    return OP_OK;
+}
+
+OpResult EdgeIndexScanReset(OpBase *ctx) {
+    EdgeIndexScan *edgeIndexScan = (EdgeIndexScan*)ctx;
+
+    /* Restore original entities. */
+    *edgeIndexScan->src_node = edgeIndexScan->_src_node;
+    *edgeIndexScan->relation = edgeIndexScan->_relation;
+    *edgeIndexScan->dest_node = edgeIndexScan->_dest_node;
+
+    IndexIterator_Free(&edgeIndexScan->iter);
+    _EdgeIndexScan_Seek(edgeIndexScan);
+    return OP_OK;
+}
+
+void EdgeIndexScanFree(OpBase *op) {
+    EdgeIndexScan *edgeIndexScan = (EdgeIndexScan*)op;
+    IndexIterator_Free(&edgeIndexScan->iter);
+    free(edgeIndexScan);
+}
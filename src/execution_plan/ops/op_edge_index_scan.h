@@ -0,0 +1,40 @@
+#ifndef __OP_EDGE_INDEX_SCAN_H
+#define __OP_EDGE_INDEX_SCAN_H
+
+#include "op.h"
+#include "op_index_scan.h"
+#include "../../graph/graph.h"
+#include "../../graph/edge.h"
+
+/* EdgeIndexScan
+ * Scans a portion of a relationship type's property index,
+ * sets edge to each entity within bounds together with its source and destination nodes. */
+
+typedef struct {
+    OpBase op;
+    Node **src_node;        /* Edge's source node. */
+    Node *_src_node;
+    Edge **relation;        /* Edge being scanned. */
+    Edge *_relation;
+    Node **dest_node;       /* Edge's destination node. */
+    Node *_dest_node;
+    Index *index;
+    IndexScanBounds bounds;
+    IndexIterator iter;
+} EdgeIndexScan;
+
+/* Creates a new EdgeIndexScan operation. */
+OpBase *NewEdgeIndexScanOp(Graph *g, Node **src_node, Edge **relation, Node **dest_node,
+                           Index *index, IndexScanBounds bounds);
+
+/* EdgeIndexScan next operation
+ * called each time a new edge is required. */
+OpResult EdgeIndexScanConsume(OpBase *opBase, Graph* graph);
+
+/* Restart iterator */
+OpResult EdgeIndexScanReset(OpBase *ctx);
+
+/* Frees EdgeIndexScan */
+void EdgeIndexScanFree(OpBase *ctx);
+
+#endif
@@ -48,6 +48,80 @@ ExpandAll* NewExpandAll(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
     return expand_all;
 }
 
+void ExpandAll_SeekIndex(ExpandAll *op, Index *index, IndexScanBounds bounds) {
+    op->index = index;
+    op->bounds = bounds;
+}
+
+void ExpandAll_Reverse(ExpandAll *op) {
+    op->reversed = 1;
+    op->op.name = (op->semi) ? "Semi Expand (Reverse)" : "Expand All (Reverse)";
+}
+
+void ExpandAll_SemiJoin(ExpandAll *op) {
+    op->semi = 1;
+    op->op.name = (op->reversed) ? "Semi Expand (Reverse)" : "Semi Expand";
+}
+
+/* Index can serve expansion when source node is known and edge isn't. */
+static int _ExpandAll_CanSeek(const ExpandAll *op) {
+    return (op->index != NULL &&
+            (op->triplet->kind == SP || op->triplet->kind == SOP) &&
+            op->triplet->predicate->id == INVALID_ENTITY_ID);
+}
+
+static int _ExpandAll_Labeled(const Node *n, const char *label) {
+    return (label == NULL || (n->label && strcmp(n->label, label) == 0));
+}
+
+/* Nodes bound by op must carry their pattern's label, and pass op's predicate. */
+static int _ExpandAll_Accepts(ExpandAll *op, const Graph *graph) {
+    if((op->modifies.kind & S) && !_ExpandAll_Labeled(*op->src_node, op->_src_node->label)) return 0;
+    if((op->modifies.kind & O) && !_ExpandAll_Labeled(*op->dest_node, op->_dest_node->label)) return 0;
+    if(op->predicate == NULL) return 1;
+    if(op->program == NULL) op->program = BC_CompileFilter(op->predicate, graph);
+    return BC_ApplyFilter(op->program);
+}
+
+/* Consumes next edge within index range leading to a valid destination. */
+static OpResult _ExpandAll_ConsumeIndex(ExpandAll *op, Graph *graph) {
+    Edge *e;
+    while((e = (Edge*)IndexIterator_Next(&op->index_iter)) != NULL) {
+        /* Destination node is already set, make sure edge leads to it. */
+        if(!(op->modifies.kind & O) && e->dest->id != (*op->dest_node)->id) continue;
+
+        if(op->modifies.kind & P) {
+            *op->relation = e;
+        }
+        if(op->modifies.kind & O) {
+            *op->dest_node = e->dest;
+        }
+        if(_ExpandAll_Accepts(op, graph)) return OP_OK;
+    }
+
+    return OP_REFRESH;
+}
+
+/* Consumes next triplet matching current triplet's pattern. */
+static OpResult _ExpandAll_ConsumeHexastore(ExpandAll *op, Graph *graph) {
+    Triplet *triplet = NULL;
+    while(TripletIterator_Next(&op->iter, &triplet)) {
+        /* Update graph. */
+        if(op->modifies.kind & S) {
+            *op->src_node = triplet->subject;
+        }
+        if(op->modifies.kind & P) {
+            *op->relation = triplet->predicate;
+        }
+        if(op->modifies.kind & O) {
+            *op->dest_node = triplet->object;
+        }
+        if(_ExpandAll_Accepts(op, graph)) return OP_OK;
+    }
+
+    return OP_REFRESH;
+}
+
 /* ExpandAllConsume next operation 
  * each call will update the graph
  * returns OP_DEPLETED when no additional updates are available */
@@ -72,35 +146,32 @@ OpResult ExpandAllConsume(OpBase *opBase, Graph* graph) {
             op->modifies.kind = (s > 0) << 2 | (o > 0) << 1 | (p > 0);
         }
 
-        /* Overrides current value with triplet string representation,
-        * if string buffer is large enough, there will be no allocation. */
-        TripletToString(op->triplet, &op->str_triplet);
-        
-        /* Search hexastore, reuse iterator. */
-        HexaStore_Search_Iterator(op->hexastore, op->str_triplet, &op->iter);
+        if(op->seeking) IndexIterator_Free(&op->index_iter);
+        op->seeking = _ExpandAll_CanSeek(op);
 
+        if(op->seeking) {
+            Index_ScanSourceRange(op->index, op->triplet->subject->id,
+                                  op->bounds.min, op->bounds.min_inclusive,
+                                  op->bounds.max, op->bounds.max_inclusive, &op->index_iter);
+        } else {
+            /* Overrides current value with triplet string representation,
+            * if string buffer is large enough, there will be no allocation. */
+            TripletToString(op->triplet, &op->str_triplet);
+
+            /* Search hexastore, reuse iterator. */
+            HexaStore_Search_Iterator(op->hexastore, op->str_triplet, &op->iter);
+        }
+
+        op->matched = 0;
         op->state = ExpandAllConsuming;
     }
-    
-    Triplet *triplet = NULL;
-    if(!TripletIterator_Next(&op->iter, &triplet)) {
-        return OP_REFRESH;
-    }
 
-    /* TODO: Make sure retrieved id are indeed
-     * labeled under nodes / edge lables. */
-         
-    /* Update graph. */
-    if(op->modifies.kind & S) {
-        *op->src_node = triplet->subject;
-    }
-    if(op->modifies.kind & P) {
-        *op->relation = triplet->predicate;
-    }
-    if(op->modifies.kind & O) {
-        *op->dest_node = triplet->object;
-    }
-    return OP_OK;
+    /* Semi join, bound node is known to have a match, no need to look any further. */
+    if(op->matched) return OP_REFRESH;
+
+    OpResult res = (op->seeking) ? _ExpandAll_ConsumeIndex(op, graph) : _ExpandAll_ConsumeHexastore(op, graph);
+    if(res == OP_OK && op->semi) op->matched = 1;
+    return res;
 }
 
 OpResult ExpandAllReset(OpBase *ctx) {
@@ -127,6 +198,9 @@ OpResult ExpandAllReset(OpBase *ctx) {
 /* Frees ExpandAll */
 void ExpandAllFree(OpBase *ctx) {
     ExpandAll *op = (ExpandAll*)ctx;
+    if(op->seeking) IndexIterator_Free(&op->index_iter);
     sdsfree(op->str_triplet);
+    FilterTree_Free(op->predicate);
+    BC_Free(op->program);
     free(op);
 }
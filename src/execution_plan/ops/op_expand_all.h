@@ -4,6 +4,9 @@
 #include "op.h"
 #include "../../rmutil/sds.h"
 #include "../../hexastore/triplet.h"
+#include "op_index_scan.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../bytecode/bytecode.h"
 
 
 /* ExpandAllStates 
@@ -32,6 +35,15 @@ typedef struct {
     sds str_triplet;        /* String representation of current triplet. */
     TripletIterator iter;   /* Graph iterator. */
     ExpandAllStates state;  /* Operation current state. */
+    Index *index;           /* Edge index serving relation's predicates, NULL if none. */
+    IndexScanBounds bounds; /* Range of index qualifying edges reside in. */
+    IndexIterator index_iter;
+    int seeking;            /* Current expansion is served by index_iter. */
+    int reversed;           /* Expansion starts at dest node, moving against edge direction. */
+    int semi;               /* Only the first accepted expansion of each bound node is produced. */
+    int matched;            /* Current bound node was expanded, semi join only. */
+    FT_FilterNode *predicate;   /* Evaluated on each expansion, failing ones are skipped, NULL if none. */
+    BC_Program *program;        /* Predicate compiled on first evaluation. */
 } ExpandAll;
 
 /* Creates a new ExpandAll operation */
@@ -41,6 +53,19 @@ OpBase* NewExpandAllOp(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
 ExpandAll* NewExpandAll(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
                         Node **src_node, Edge **relation, Node **dest_node);
 
+/* Expand only source node's edges within bounds,
+ * located via index rather than scanning every edge. */
+void ExpandAll_SeekIndex(ExpandAll *op, Index *index, IndexScanBounds bounds);
+
+/* Marks op as expanding from its destination node to its source node,
+ * dest node is expected to be set by op's child. */
+void ExpandAll_Reverse(ExpandAll *op);
+
+/* Marks op as a semi join, expected when neither the expanded edge nor the node
+ * it leads to are referenced by any other op, op then checks the bound node
+ * is connected to any matching node, producing it at most once. */
+void ExpandAll_SemiJoin(ExpandAll *op);
+
 /* ExpandAllConsume next operation 
  * each call will update the graph
  * returns OP_DEPLETED when no additional updates are available */
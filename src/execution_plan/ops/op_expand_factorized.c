@@ -0,0 +1,84 @@
+#include "op_expand_factorized.h"
+#include <string.h>
+
+OpBase* NewExpandFactorizedOp(Node **node, Edge **edge, Node **neighbor, int incoming) {
+    ExpandFactorized *expand_factorized = calloc(1, sizeof(ExpandFactorized));
+    expand_factorized->node = node;
+    expand_factorized->neighbor = neighbor;
+    expand_factorized->_neighbor = *neighbor;
+    expand_factorized->edge = edge;
+    expand_factorized->_edge = *edge;
+    expand_factorized->relationship = (*edge)->relationship;
+    expand_factorized->incoming = incoming;
+    expand_factorized->consumed = 1;   /* Nothing to produce before node is bound. */
+
+    // Set our Op operations
+    expand_factorized->op.name = "Expand Factorized";
+    expand_factorized->op.type = OPType_EXPAND_FACTORIZED;
+    expand_factorized->op.consume = ExpandFactorizedConsume;
+    expand_factorized->op.reset = ExpandFactorizedReset;
+    expand_factorized->op.free = ExpandFactorizedFree;
+    expand_factorized->op.modifies = NULL;
+    return (OpBase*)expand_factorized;
+}
+
+void ExpandFactorized_Collect(ExpandFactorized *op) {
+    op->collect = 1;
+}
+
+void ExpandFactorized_Bind(ExpandFactorized *op, size_t i) {
+    Edge *e = op->edges[i];
+    *op->edge = e;
+    *op->neighbor = (op->incoming) ? e->src : e->dest;
+}
+
+void ExpandFactorized_Unbind(ExpandFactorized *op) {
+    *op->edge = op->_edge;
+    *op->neighbor = op->_neighbor;
+}
+
+/* Collects node's edges of expanded relationship type. */
+static void _ExpandFactorized_CollectEdges(ExpandFactorized *op, const Node *n) {
+    Vector *edges = (op->incoming) ? n->incoming_edges : n->outgoing_edges;
+    if(op->edge_cap < Vector_Size(edges)) {
+        op->edge_cap = Vector_Size(edges);
+        op->edges = realloc(op->edges, sizeof(Edge*) * op->edge_cap);
+    }
+
+    op->count = 0;
+    for(int i = 0; i < Vector_Size(edges); i++) {
+        Edge *e;
+        Vector_Get(edges, i, &e);
+        if(op->relationship && (e->relationship == NULL || strcmp(e->relationship, op->relationship) != 0)) continue;
+        op->edges[op->count++] = e;
+    }
+}
+
+OpResult ExpandFactorizedConsume(OpBase *opBase, Graph* graph) {
+    ExpandFactorized *op = (ExpandFactorized*)opBase;
+    if(op->consumed) return OP_REFRESH;
+    op->consumed = 1;
+
+    const Node *n = *op->node;
+    if(op->collect) {
+        _ExpandFactorized_CollectEdges(op, n);
+    } else {
+        op->count = (op->incoming) ? Node_InDegree(n, op->relationship) : Node_OutDegree(n, op->relationship);
+    }
+
+    /* Node without edges has no match. */
+    if(op->count == 0) return OP_REFRESH;
+    return OP_OK;
+}
+
+OpResult ExpandFactorizedReset(OpBase *ctx) {
+    ExpandFactorized *op = (ExpandFactorized*)ctx;
+    op->consumed = 0;
+    return OP_OK;
+}
+
+void ExpandFactorizedFree(OpBase *ctx) {
+    ExpandFactorized *op = (ExpandFactorized*)ctx;
+    free(op->edges);
+    free(op);
+}
@@ -0,0 +1,44 @@
+#ifndef __OP_EXPAND_FACTORIZED_H
+#define __OP_EXPAND_FACTORIZED_H
+
+#include "op.h"
+
+/* ExpandFactorized
+ * Replaces an expansion into a neighbor which is only aggregated over,
+ * rather than producing a record per edge, produces a single record per bound node,
+ * along with the number of edges it would have expanded, read from the node's degree counters,
+ * and when neighbor is read by an aggregation, the edges themselves.
+ * Aggregate combines the branches of a star pattern from their counts and edges,
+ * without enumerating their cross product. */
+typedef struct ExpandFactorized {
+    OpBase op;
+    Node **node;                /* Bound node, set by op's child. */
+    Node **neighbor;            /* Neighbor, bound by Aggregate while it reads edges. */
+    Node *_neighbor;            /* Original neighbor. */
+    Edge **edge;                /* Edge, bound by Aggregate while it reads edges. */
+    Edge *_edge;                /* Original edge. */
+    const char *relationship;   /* Expanded relationship type, NULL for any. */
+    int incoming;               /* Expand edges entering node rather than leaving it. */
+    int collect;                /* Edges are required, not just their count. */
+    size_t count;               /* Number of edges expanded from current node. */
+    Edge **edges;               /* Edges expanded from current node, when collected. */
+    size_t edge_cap;
+    int consumed;               /* Current node was produced. */
+} ExpandFactorized;
+
+OpBase* NewExpandFactorizedOp(Node **node, Edge **edge, Node **neighbor, int incoming);
+
+/* Collect expanded edges rather than only counting them. */
+void ExpandFactorized_Collect(ExpandFactorized *op);
+
+/* Binds neighbor and edge to the ith edge expanded from current node. */
+void ExpandFactorized_Bind(ExpandFactorized *op, size_t i);
+
+/* Restores neighbor and edge to their original values. */
+void ExpandFactorized_Unbind(ExpandFactorized *op);
+
+OpResult ExpandFactorizedConsume(OpBase *opBase, Graph* graph);
+OpResult ExpandFactorizedReset(OpBase *ctx);
+void ExpandFactorizedFree(OpBase *ctx);
+
+#endif
@@ -50,7 +50,8 @@ OpResult ExpandIntoConsume(OpBase *opBase, Graph* graph) {
                  .predicate = *(op->relation),
                  .object = *(op->dest_node)};
 
-    t.kind = SO;
+    /* Typed relationships restrict the search to edges of that type. */
+    t.kind = TripletGetKind(&t);
 
     /* Overrides current value with triplet string representation,
      * If string buffer is large enough, there will be no allocation. */
@@ -7,7 +7,9 @@ OpBase* NewFilterOp(FT_FilterNode *filterTree) {
 Filter* NewFilter(FT_FilterNode *filterTree) {
     Filter *filter = malloc(sizeof(Filter));
     filter->filterTree = filterTree;
+    filter->program = NULL;
     filter->state = FilterUninitialized;
+    filter->evaluations = 0;
 
     // Set our Op operations
     filter->op.name = "Filter";
@@ -30,7 +32,21 @@ OpResult FilterConsume(OpBase *opBase, Graph* graph) {
     }
 
     /* Pass graph through filter tree */
-    int pass = applyFilters(graph, filter->filterTree);
+    int pass;
+    if(filter->evaluations < FILTER_PROFILE_SAMPLE) {
+        pass = FilterTree_Apply(graph, filter->filterTree);
+    } else {
+        if(filter->program == NULL) filter->program = BC_CompileFilter(filter->filterTree, graph);
+        pass = BC_ApplyFilter(filter->program);
+    }
+
+    /* Evaluate cheap and decisive predicates first, based on records seen so far. */
+    if(++filter->evaluations == FILTER_REORDER_INTERVAL) {
+        FilterTree_Reorder(filter->filterTree);
+        BC_Free(filter->program);
+        filter->program = NULL;
+        filter->evaluations = 0;
+    }
 
     filter->state = FilterRequestRefresh;
 
@@ -51,5 +67,6 @@ OpResult FilterReset(OpBase *ctx) {
 void FilterFree(OpBase *ctx) {
     Filter *filter = (Filter*)ctx;
     FilterTree_Free(filter->filterTree);
+    BC_Free(filter->program);
     free(filter);
 }
\ No newline at end of file
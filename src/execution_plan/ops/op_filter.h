@@ -3,6 +3,14 @@
 
 #include "op.h"
 #include "../../filter_tree/filter_tree.h"
+#include "../../bytecode/bytecode.h"
+
+/* Number of records filtered between reorderings of the filter tree. */
+#define FILTER_REORDER_INTERVAL 1024
+
+/* Number of records, out of every interval, run through the filter tree itself
+ * to collect the statistics reordering relies on, the rest run through its compiled form. */
+#define FILTER_PROFILE_SAMPLE 64
 
 /* FilterState 
  * Different states in which ExpandAll can be at. */
@@ -17,7 +25,9 @@ typedef enum {
 typedef struct {
     OpBase op;
     FT_FilterNode *filterTree;
+    BC_Program *program;    /* Filter tree compiled, recompiled once tree is reordered. */
     FilterState state;
+    uint64_t evaluations;   /* Records filtered since last reordering. */
 } Filter;
 
 /* Creates a new Filter operation */
@@ -0,0 +1,78 @@
+#include "op_fulltext_scan.h"
+#include "../../parser/ast.h"
+
+OpBase *NewFullTextScanOp(RedisModuleCtx *ctx, Graph *g, Node **node, Node **score_node,
+                          const char *graph_name, const char *label, const char *property,
+                          const char *query) {
+    FullTextScan *fullTextScan = calloc(1, sizeof(FullTextScan));
+    fullTextScan->ctx = ctx;
+    fullTextScan->node = node;
+    fullTextScan->_node = *node;
+    fullTextScan->graph = graph_name;
+    fullTextScan->label = label;
+    fullTextScan->property = property;
+    fullTextScan->query = query;
+    fullTextScan->queried = 0;
+    fullTextScan->results = NULL;
+    fullTextScan->result_count = 0;
+    fullTextScan->position = 0;
+    fullTextScan->score = NULL;
+
+    // Set our Op operations
+    fullTextScan->op.name = "FullText Scan";
+    fullTextScan->op.type = OPType_FULLTEXT_SCAN;
+    fullTextScan->op.consume = FullTextScanConsume;
+    fullTextScan->op.reset = FullTextScanReset;
+    fullTextScan->op.free = FullTextScanFree;
+    fullTextScan->op.modifies = NewVector(char*, 2);
+
+    Vector_Push(fullTextScan->op.modifies, Graph_GetNodeAlias(g, *node));
+
+    if(score_node) {
+        /* Score is exposed as a property of a placeholder node. */
+        char *key = strdup(PROC_FULLTEXT_SCORE_PROPERTY);
+        SIValue score = SI_DoubleVal(0);
+        Node_Add_Properties(*score_node, 1, &key, &score);
+        fullTextScan->score = Node_Get_Property(*score_node, PROC_FULLTEXT_SCORE_PROPERTY);
+        Vector_Push(fullTextScan->op.modifies, Graph_GetNodeAlias(g, *score_node));
+    }
+
+    return (OpBase*)fullTextScan;
+}
+
+OpResult FullTextScanConsume(OpBase *opBase, Graph* graph) {
+    FullTextScan *op = (FullTextScan*)opBase;
+
+    /* Query index lazily, on first call. */
+    if(!op->queried) {
+        op->queried = 1;
+        LabelStore *store = LabelStore_Get(op->ctx, STORE_NODE, op->graph, op->label);
+        FullTextIndex *idx = LabelStore_GetFullTextIndex(store, op->property);
+        /* Property isn't indexed, no matches. */
+        if(idx == NULL) return OP_DEPLETED;
+        op->result_count = FullTextIndex_Query(idx, op->query, &op->results);
+    }
+
+    if(op->position >= op->result_count) return OP_DEPLETED;
+
+    FullTextResult *match = &op->results[op->position++];
+    *op->node = (Node*)match->entity;
+    if(op->score) *op->score = SI_DoubleVal(match->score);
+
+    return OP_OK;
+}
+
+OpResult FullTextScanReset(OpBase *ctx) {
+    FullTextScan *fullTextScan = (FullTextScan*)ctx;
+
+    /* Restore original node. */
+    *fullTextScan->node = fullTextScan->_node;
+    fullTextScan->position = 0;
+    return OP_OK;
+}
+
+void FullTextScanFree(OpBase *op) {
+    FullTextScan *fullTextScan = (FullTextScan*)op;
+    if(fullTextScan->results) free(fullTextScan->results);
+    free(fullTextScan);
+}
@@ -0,0 +1,48 @@
+#ifndef __OP_FULLTEXT_SCAN_H
+#define __OP_FULLTEXT_SCAN_H
+
+#include "op.h"
+#include "../../redismodule.h"
+#include "../../graph/graph.h"
+#include "../../graph/node.h"
+#include "../../stores/store.h"
+#include "../../index/fulltext_index.h"
+
+/* FullTextScan
+ * Queries a label's full-text index, sets node to each
+ * matching node, in descending relevance order, and
+ * exposes match score through score node's score property. */
+
+typedef struct {
+    OpBase op;
+    Node **node;                /* Node being scanned. */
+    Node *_node;
+    SIValue *score;             /* Score placeholder node's score property, optional. */
+    RedisModuleCtx *ctx;
+    const char *graph;          /* Queried graph id. */
+    const char *label;
+    const char *property;       /* Indexed property. */
+    const char *query;          /* Full-text query. */
+    int queried;                /* Rather or not index has been queried. */
+    FullTextResult *results;    /* Query matches. */
+    size_t result_count;
+    size_t position;            /* Next result to return. */
+} FullTextScan;
+
+/* Creates a new FullTextScan operation,
+ * score_node is optional and might be NULL. */
+OpBase *NewFullTextScanOp(RedisModuleCtx *ctx, Graph *g, Node **node, Node **score_node,
+                          const char *graph_name, const char *label, const char *property,
+                          const char *query);
+
+/* FullTextScan next operation
+ * called each time a new match is required. */
+OpResult FullTextScanConsume(OpBase *opBase, Graph* graph);
+
+/* Restart scan from first match. */
+OpResult FullTextScanReset(OpBase *ctx);
+
+/* Frees FullTextScan */
+void FullTextScanFree(OpBase *ctx);
+
+#endif
@@ -0,0 +1,49 @@
+#include "op_geo_scan.h"
+
+OpBase *NewGeoScanOp(Graph *g, Node **node, GeoIndex *index, GeoBoundingBox box) {
+    GeoScan *geoScan = malloc(sizeof(GeoScan));
+    geoScan->node = node;
+    geoScan->_node = *node;
+    geoScan->index = index;
+    geoScan->box = box;
+    GeoIndex_Scan(index, box, &geoScan->iter);
+
+    // Set our Op operations
+    geoScan->op.name = "Geo Scan";
+    geoScan->op.type = OPType_GEO_SCAN;
+    geoScan->op.consume = GeoScanConsume;
+    geoScan->op.reset = GeoScanReset;
+    geoScan->op.free = GeoScanFree;
+    geoScan->op.modifies = NewVector(char*, 1);
+
+    Vector_Push(geoScan->op.modifies, Graph_GetNodeAlias(g, *node));
+
+    return (OpBase*)geoScan;
+}
+
+OpResult GeoScanConsume(OpBase *opBase, Graph* graph) {
+    GeoScan *op = (GeoScan*)opBase;
+
+    Node *n = (Node*)GeoIndexIterator_Next(&op->iter);
+    if(n == NULL) return OP_DEPLETED;
+
+    *op->node = n;
+    return OP_OK;
+}
+
+OpResult GeoScanReset(OpBase *ctx) {
+    GeoScan *geoScan = (GeoScan*)ctx;
+
+    /* Restore original node. */
+    *geoScan->node = geoScan->_node;
+
+    GeoIndexIterator_Free(&geoScan->iter);
+    GeoIndex_Scan(geoScan->index, geoScan->box, &geoScan->iter);
+    return OP_OK;
+}
+
+void GeoScanFree(OpBase *op) {
+    GeoScan *geoScan = (GeoScan*)op;
+    GeoIndexIterator_Free(&geoScan->iter);
+    free(geoScan);
+}
@@ -0,0 +1,35 @@
+#ifndef __OP_GEO_SCAN_H
+#define __OP_GEO_SCAN_H
+
+#include "op.h"
+#include "../../graph/graph.h"
+#include "../../graph/node.h"
+#include "../../index/geo_index.h"
+
+/* GeoScan
+ * Scans a label's geospatial index,
+ * sets node to each entity located within a bounding box. */
+
+typedef struct {
+    OpBase op;
+    Node **node;            /* Node being scanned. */
+    Node *_node;
+    GeoIndex *index;
+    GeoBoundingBox box;
+    GeoIndexIterator iter;
+} GeoScan;
+
+/* Creates a new GeoScan operation. */
+OpBase *NewGeoScanOp(Graph *g, Node **node, GeoIndex *index, GeoBoundingBox box);
+
+/* GeoScan next operation
+ * called each time a new node is required. */
+OpResult GeoScanConsume(OpBase *opBase, Graph* graph);
+
+/* Restart iterator */
+OpResult GeoScanReset(OpBase *ctx);
+
+/* Frees GeoScan */
+void GeoScanFree(OpBase *ctx);
+
+#endif
@@ -0,0 +1,103 @@
+#include "op_hash_join.h"
+#include "../execution_plan.h"
+#include "../../util/key_encoding.h"
+
+OpBase* NewHashJoinOp(Graph *g, struct OpNode *build, Node **join_node) {
+    HashJoin *hash_join = calloc(1, sizeof(HashJoin));
+    hash_join->build = build;
+    hash_join->join_node = join_node;
+    hash_join->table = raxNew();
+
+    Vector *aliases = NewVector(char*, 3);
+    OpNode_CollectModified(build, aliases);
+    hash_join->ref_count = Vector_Size(aliases);
+    hash_join->refs = malloc(sizeof(GraphEntity**) * hash_join->ref_count);
+    hash_join->originals = malloc(sizeof(GraphEntity*) * hash_join->ref_count);
+    for(int i = 0; i < hash_join->ref_count; i++) {
+        char *alias;
+        Vector_Get(aliases, i, &alias);
+        hash_join->refs[i] = Graph_GetEntityRef(g, alias);
+        hash_join->originals[i] = *hash_join->refs[i];
+    }
+    Vector_Free(aliases);
+
+    // Set our Op operations
+    hash_join->op.name = "Hash Join";
+    hash_join->op.type = OPType_HASH_JOIN;
+    hash_join->op.consume = HashJoinConsume;
+    hash_join->op.reset = HashJoinReset;
+    hash_join->op.free = HashJoinFree;
+    hash_join->op.modifies = NULL;
+
+    return (OpBase*)hash_join;
+}
+
+static void _HashJoin_Unbind(HashJoin *op) {
+    for(int i = 0; i < op->ref_count; i++) *op->refs[i] = op->originals[i];
+}
+
+/* Consumes build stream, storing each of its records under its join node's id. */
+static void _HashJoin_Build(HashJoin *op, Graph *graph) {
+    unsigned char key[KEY_ENCODING_UINT64_LEN * 2];
+    while(OpNode_Consume(op->build, graph) == OP_OK) {
+        GraphEntity **record = malloc(sizeof(GraphEntity*) * op->ref_count);
+        for(int i = 0; i < op->ref_count; i++) record[i] = *op->refs[i];
+
+        /* Record number keeps records sharing a join node apart. */
+        KeyEncoding_Uint64((*op->join_node)->id, key);
+        KeyEncoding_Uint64(op->record_count++, key + KEY_ENCODING_UINT64_LEN);
+        raxInsert(op->table, key, sizeof(key), record, NULL);
+    }
+
+    /* Probe stream expects to bind the join node itself. */
+    _HashJoin_Unbind(op);
+    op->built = 1;
+}
+
+OpResult HashJoinConsume(OpBase *opBase, Graph *graph) {
+    HashJoin *op = (HashJoin*)opBase;
+
+    if(!op->built) {
+        _HashJoin_Build(op, graph);
+        return OP_REFRESH;
+    }
+
+    if(!op->probing) {
+        /* Probe stream hasn't produced a record yet. */
+        if((*op->join_node)->id == INVALID_ENTITY_ID) return OP_REFRESH;
+
+        KeyEncoding_Uint64((*op->join_node)->id, op->key);
+        raxStart(&op->matches, op->table);
+        raxSeek(&op->matches, ">=", op->key, sizeof(op->key));
+        op->probing = 1;
+    }
+
+    if(!raxNext(&op->matches) || memcmp(op->matches.key, op->key, sizeof(op->key)) != 0) {
+        return OP_REFRESH;
+    }
+
+    GraphEntity **record = op->matches.data;
+    for(int i = 0; i < op->ref_count; i++) *op->refs[i] = record[i];
+    return OP_OK;
+}
+
+/* Build records are kept, streams are independent
+ * such that rebuilding would yield the same table. */
+OpResult HashJoinReset(OpBase *ctx) {
+    HashJoin *op = (HashJoin*)ctx;
+    if(op->probing) {
+        raxStop(&op->matches);
+        op->probing = 0;
+    }
+    if(op->built) _HashJoin_Unbind(op);
+    return OP_OK;
+}
+
+void HashJoinFree(OpBase *ctx) {
+    HashJoin *op = (HashJoin*)ctx;
+    if(op->probing) raxStop(&op->matches);
+    raxFreeWithCallback(op->table, free);
+    free(op->refs);
+    free(op->originals);
+    free(op);
+}
@@ -0,0 +1,38 @@
+#ifndef __OP_HASH_JOIN_H
+#define __OP_HASH_JOIN_H
+
+#include "op.h"
+#include "../../dep/rax/rax.h"
+
+struct OpNode;
+
+/* HashJoin joins two independent streams binding the same node,
+ * the build stream is consumed entirely into a table keyed by the join node's id,
+ * each record of the probe stream, which is the op's only pulled child,
+ * is then extended with every build record sharing its join node. */
+typedef struct {
+    OpBase op;
+    struct OpNode *build;       /* Stream hashed, consumed by the op itself. */
+    Node **join_node;           /* Node both streams bind. */
+    int ref_count;              /* Number of entities bound by build stream. */
+    GraphEntity ***refs;        /* Entities bound by build stream. */
+    GraphEntity **originals;    /* Unbound value of each ref. */
+    rax *table;                 /* Join node id + record number -> build record. */
+    uint64_t record_count;      /* Number of build records. */
+    int built;                  /* Build stream was consumed. */
+    int probing;                /* matches is positioned on current probe record's key. */
+    unsigned char key[sizeof(uint64_t)];    /* Current probe record's join node id. */
+    raxIterator matches;        /* Build records sharing current probe record's join node. */
+} HashJoin;
+
+/* Creates a new HashJoin operation, build is expected to be the op's
+ * last child, its entities must not be bound by any other stream but join_node. */
+OpBase* NewHashJoinOp(Graph *g, struct OpNode *build, Node **join_node);
+
+OpResult HashJoinConsume(OpBase *opBase, Graph *graph);
+
+OpResult HashJoinReset(OpBase *ctx);
+
+void HashJoinFree(OpBase *ctx);
+
+#endif
@@ -0,0 +1,69 @@
+#include "op_index_scan.h"
+
+static void _IndexScan_Seek(IndexScan *op) {
+    if(op->bounds.prefix) {
+        Index_ScanPrefix(op->index, op->bounds.prefix, &op->iter);
+    } else if(op->bounds.reverse) {
+        Index_ScanRangeReverse(op->index, op->bounds.min, op->bounds.min_inclusive,
+                               op->bounds.max, op->bounds.max_inclusive, &op->iter);
+    } else {
+        Index_ScanRange(op->index, op->bounds.min, op->bounds.min_inclusive,
+                        op->bounds.max, op->bounds.max_inclusive, &op->iter);
+    }
+}
+
+OpBase *NewIndexScanOp(Graph *g, Node **node, Index *index, IndexScanBounds bounds) {
+    IndexScan *indexScan = malloc(sizeof(IndexScan));
+    indexScan->node = node;
+    indexScan->_node = *node;
+    indexScan->index = index;
+    indexScan->bounds = bounds;
+    indexScan->predicate = NULL;
+    indexScan->program = NULL;
+    _IndexScan_Seek(indexScan);
+
+    // Set our Op operations
+    indexScan->op.name = "Index Scan";
+    indexScan->op.type = OPType_INDEX_SCAN;
+    indexScan->op.consume = IndexScanConsume;
+    indexScan->op.reset = IndexScanReset;
+    indexScan->op.free = IndexScanFree;
+    indexScan->op.modifies = NewVector(char*, 1);
+
+    Vector_Push(indexScan->op.modifies, Graph_GetNodeAlias(g, *node));
+
+    return (OpBase*)indexScan;
+}
+
+OpResult IndexScanConsume(OpBase *opBase, Graph* graph) {
+    IndexScan *op = (IndexScan*)opBase;
+
+    Node *n;
+    while((n = (Node*)IndexIterator_Next(&op->iter)) != NULL) {
+        *op->node = n;
+        if(op->predicate == NULL) return OP_OK;
+        if(op->program == NULL) op->program = BC_CompileFilter(op->predicate, graph);
+        if(BC_ApplyFilter(op->program)) return OP_OK;
+    }
+
+    return OP_DEPLETED;
+}
+
+OpResult IndexScanReset(OpBase *ctx) {
+    IndexScan *indexScan = (IndexScan*)ctx;
+
+    /* Restore original node. */
+    *indexScan->node = indexScan->_node;
+
+    IndexIterator_Free(&indexScan->iter);
+    _IndexScan_Seek(indexScan);
+    return OP_OK;
+}
+
+void IndexScanFree(OpBase *op) {
+    IndexScan *indexScan = (IndexScan*)op;
+    IndexIterator_Free(&indexScan->iter);
+    FilterTree_Free(indexScan->predicate);
+    BC_Free(indexScan->program);
+    free(indexScan);
+}
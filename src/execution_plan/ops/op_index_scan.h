@@ -0,0 +1,49 @@
+#ifndef __OP_INDEX_SCAN_H
+#define __OP_INDEX_SCAN_H
+
+#include "op.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../bytecode/bytecode.h"
+#include "../../graph/graph.h"
+#include "../../graph/node.h"
+#include "../../index/index.h"
+
+/* Portion of index to scan. */
+typedef struct {
+    const char *prefix;     /* String prefix, NULL for range scans. */
+    SIValue *min;           /* Lower bound, NULL if unbounded. */
+    int min_inclusive;
+    SIValue *max;           /* Upper bound, NULL if unbounded. */
+    int max_inclusive;
+    int reverse;            /* Scan range in descending order, range scans only. */
+} IndexScanBounds;
+
+/* IndexScan
+ * Scans a portion of a label's property index,
+ * sets node to each entity within bounds. */
+
+typedef struct {
+    OpBase op;
+    Node **node;            /* Node being scanned. */
+    Node *_node;
+    Index *index;
+    IndexScanBounds bounds;
+    IndexIterator iter;
+    FT_FilterNode *predicate;   /* Evaluated on each node, failing nodes are skipped, NULL if none. */
+    BC_Program *program;        /* Predicate compiled on first evaluation. */
+} IndexScan;
+
+/* Creates a new IndexScan operation. */
+OpBase *NewIndexScanOp(Graph *g, Node **node, Index *index, IndexScanBounds bounds);
+
+/* IndexScan next operation
+ * called each time a new node is required. */
+OpResult IndexScanConsume(OpBase *opBase, Graph* graph);
+
+/* Restart iterator */
+OpResult IndexScanReset(OpBase *ctx);
+
+/* Frees IndexScan */
+void IndexScanFree(OpBase *ctx);
+
+#endif
@@ -0,0 +1,225 @@
+#include "op_leapfrog_join.h"
+#include <string.h>
+
+OpBase* NewLeapfrogJoinOp(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                          Node **node, Edge ***edges, int edge_count) {
+    return (OpBase*)NewLeapfrogJoin(GetHexaStore(ctx, graph_name), g, node, edges, edge_count);
+}
+
+LeapfrogJoin* NewLeapfrogJoin(HexaStore *hexastore, Graph *g, Node **node, Edge ***edges, int edge_count) {
+    LeapfrogJoin *leapfrog_join = calloc(1, sizeof(LeapfrogJoin));
+    leapfrog_join->node = node;
+    leapfrog_join->_node = *node;
+    leapfrog_join->hexastore = hexastore;
+    leapfrog_join->edge_count = edge_count;
+    leapfrog_join->edges = calloc(edge_count, sizeof(LeapfrogEdge));
+    leapfrog_join->state = LeapfrogJoinUninitialized;
+
+    // Set our Op operations
+    leapfrog_join->op.name = "Leapfrog Join";
+    leapfrog_join->op.type = OPType_LEAPFROG_JOIN;
+    leapfrog_join->op.consume = LeapfrogJoinConsume;
+    leapfrog_join->op.reset = LeapfrogJoinReset;
+    leapfrog_join->op.free = LeapfrogJoinFree;
+    leapfrog_join->op.modifies = NewVector(char*, edge_count + 1);
+    Vector_Push(leapfrog_join->op.modifies, Graph_GetNodeAlias(g, *node));
+
+    for(int i = 0; i < edge_count; i++) {
+        LeapfrogEdge *e = &leapfrog_join->edges[i];
+        e->edge = edges[i];
+        e->_edge = *edges[i];
+        e->outgoing = ((*edges[i])->dest == *node);
+        e->neighbor = Graph_GetNodeRef(g, e->outgoing ? (*edges[i])->src : (*edges[i])->dest);
+        e->prefix = sdsempty();
+        e->token = sdsempty();
+        e->key = sdsempty();
+        raxStart(&e->iter, leapfrog_join->hexastore);
+        Vector_Push(leapfrog_join->op.modifies, Graph_GetEdgeAlias(g, *edges[i]));
+    }
+
+    return leapfrog_join;
+}
+
+/* Positions e's cursor on the first key following prefix + token,
+ * and updates e's token, returns 0 if neighbor's adjacency is depleted. */
+static int _LeapfrogEdge_Seek(LeapfrogEdge *e, const char *token, size_t token_len) {
+    e->key = sdscpylen(e->key, e->prefix, sdslen(e->prefix));
+    e->key = sdscatlen(e->key, token, token_len);
+    raxSeek(&e->iter, ">=", (unsigned char *)e->key, sdslen(e->key));
+    if(!raxNext(&e->iter)) return 0;
+
+    size_t prefix_len = sdslen(e->prefix);
+    if(e->iter.key_len <= prefix_len || memcmp(e->iter.key, e->prefix, prefix_len) != 0) return 0;
+
+    /* Token spans the joined node id and its trailing delimiter. */
+    unsigned char *start = e->iter.key + prefix_len;
+    unsigned char *end = memchr(start, TRIPLET_ELEMENT_DELIMITER[0], e->iter.key_len - prefix_len);
+    if(end == NULL) return 0;
+    e->token = sdscpylen(e->token, (char *)start, end - start + 1);
+    return 1;
+}
+
+/* Moves e's cursor past every key of the current token. */
+static int _LeapfrogEdge_SeekPast(LeapfrogEdge *e) {
+    /* Replacing the delimiter with its successor skips the entire token. */
+    size_t len = sdslen(e->token);
+    char next[len];
+    memcpy(next, e->token, len);
+    next[len - 1]++;
+    return _LeapfrogEdge_Seek(e, next, len);
+}
+
+/* Collects the triplets connecting e's neighbor to the node under its cursor,
+ * returns the number of triplets collected. */
+static size_t _LeapfrogEdge_CollectMatches(LeapfrogEdge *e) {
+    e->key = sdscpylen(e->key, e->prefix, sdslen(e->prefix));
+    e->key = sdscatsds(e->key, e->token);
+    if(e->_edge->relationship) {
+        e->key = sdscatprintf(e->key, "%s%s", e->_edge->relationship, TRIPLET_PREDICATE_DELIMITER);
+    }
+
+    e->match_count = 0;
+    e->position = 0;
+    raxSeek(&e->iter, ">=", (unsigned char *)e->key, sdslen(e->key));
+    while(raxNext(&e->iter)) {
+        if(e->iter.key_len < sdslen(e->key) || memcmp(e->iter.key, e->key, sdslen(e->key)) != 0) break;
+        if(e->match_count == e->match_cap) {
+            e->match_cap = (e->match_cap) ? e->match_cap * 2 : 4;
+            e->matches = realloc(e->matches, sizeof(Triplet*) * e->match_cap);
+        }
+        e->matches[e->match_count++] = e->iter.data;
+    }
+    return e->match_count;
+}
+
+/* Leapfrogs cursors until all of them agree on a token,
+ * returns 0 if any adjacency is depleted first. */
+static int _LeapfrogJoin_Search(LeapfrogJoin *op) {
+    while(1) {
+        int max = 0;
+        for(int i = 1; i < op->edge_count; i++) {
+            if(sdscmp(op->edges[i].token, op->edges[max].token) > 0) max = i;
+        }
+
+        int aligned = 1;
+        for(int i = 0; i < op->edge_count; i++) {
+            LeapfrogEdge *e = &op->edges[i];
+            if(sdscmp(e->token, op->edges[max].token) >= 0) continue;
+            aligned = 0;
+            if(!_LeapfrogEdge_Seek(e, op->edges[max].token, sdslen(op->edges[max].token))) return 0;
+        }
+        if(aligned) return 1;
+    }
+}
+
+/* Candidate must carry the joined node's label. */
+static int _LeapfrogJoin_Labeled(const LeapfrogJoin *op) {
+    if(op->_node->label == NULL) return 1;
+    LeapfrogEdge *e = &op->edges[0];
+    Node *candidate = (e->outgoing) ? e->matches[0]->object : e->matches[0]->subject;
+    return (candidate->label && strcmp(candidate->label, op->_node->label) == 0);
+}
+
+/* Advances to the next node connected to every bound node by edges
+ * of the required relationship types, returns 0 once there are none. */
+static int _LeapfrogJoin_NextCandidate(LeapfrogJoin *op, int first) {
+    if(first) {
+        for(int i = 0; i < op->edge_count; i++) {
+            LeapfrogEdge *e = &op->edges[i];
+            e->prefix = sdscpylen(e->prefix, "", 0);
+            e->prefix = sdscatprintf(e->prefix, "%s:%ld%s", e->outgoing ? "SOP" : "OSP",
+                                     (*e->neighbor)->id, TRIPLET_ELEMENT_DELIMITER);
+            if(!_LeapfrogEdge_Seek(e, "", 0)) return 0;
+        }
+    } else if(!_LeapfrogEdge_SeekPast(&op->edges[0])) {
+        return 0;
+    }
+
+    while(_LeapfrogJoin_Search(op)) {
+        int matched = 1;
+        for(int i = 0; i < op->edge_count && matched; i++) {
+            matched = (_LeapfrogEdge_CollectMatches(&op->edges[i]) > 0);
+        }
+        if(matched && _LeapfrogJoin_Labeled(op)) {
+            op->fresh = 1;
+            return 1;
+        }
+        if(!_LeapfrogEdge_SeekPast(&op->edges[0])) return 0;
+    }
+    return 0;
+}
+
+/* Advances to the next combination of edges connecting current candidate. */
+static int _LeapfrogJoin_NextCombination(LeapfrogJoin *op) {
+    if(op->fresh) {
+        op->fresh = 0;
+        return 1;
+    }
+
+    for(int i = op->edge_count - 1; i >= 0; i--) {
+        LeapfrogEdge *e = &op->edges[i];
+        if(++e->position < e->match_count) return 1;
+        e->position = 0;
+    }
+    return 0;
+}
+
+OpResult LeapfrogJoinConsume(OpBase *opBase, Graph *graph) {
+    LeapfrogJoin *op = (LeapfrogJoin*)opBase;
+
+    if(op->state == LeapfrogJoinUninitialized) {
+        return OP_REFRESH;
+    }
+
+    /* State resetted, bound nodes were updated. */
+    if(op->state == LeapfrogJoinResetted) {
+        op->state = LeapfrogJoinConsuming;
+        op->depleted = 0;
+        for(int i = 0; i < op->edge_count; i++) {
+            if((*op->edges[i].neighbor)->id == INVALID_ENTITY_ID) op->depleted = 1;
+        }
+        if(!op->depleted) op->depleted = !_LeapfrogJoin_NextCandidate(op, 1);
+    }
+
+    if(op->depleted) return OP_REFRESH;
+
+    if(!_LeapfrogJoin_NextCombination(op)) {
+        if(!_LeapfrogJoin_NextCandidate(op, 0)) {
+            op->depleted = 1;
+            return OP_REFRESH;
+        }
+        _LeapfrogJoin_NextCombination(op);
+    }
+
+    /* Update graph. */
+    for(int i = 0; i < op->edge_count; i++) {
+        LeapfrogEdge *e = &op->edges[i];
+        Triplet *t = e->matches[e->position];
+        *e->edge = t->predicate;
+        if(i == 0) *op->node = (e->outgoing) ? t->object : t->subject;
+    }
+    return OP_OK;
+}
+
+OpResult LeapfrogJoinReset(OpBase *ctx) {
+    LeapfrogJoin *op = (LeapfrogJoin*)ctx;
+    *op->node = op->_node;
+    for(int i = 0; i < op->edge_count; i++) *op->edges[i].edge = op->edges[i]._edge;
+    op->state = LeapfrogJoinResetted;   /* Mark reset. */
+    return OP_OK;
+}
+
+void LeapfrogJoinFree(OpBase *ctx) {
+    LeapfrogJoin *op = (LeapfrogJoin*)ctx;
+    for(int i = 0; i < op->edge_count; i++) {
+        LeapfrogEdge *e = &op->edges[i];
+        raxStop(&e->iter);
+        sdsfree(e->prefix);
+        sdsfree(e->token);
+        sdsfree(e->key);
+        free(e->matches);
+    }
+    free(op->edges);
+    Vector_Free(op->op.modifies);
+    free(op);
+}
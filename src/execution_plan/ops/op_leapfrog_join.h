@@ -0,0 +1,62 @@
+#ifndef __OP_LEAPFROG_JOIN_H
+#define __OP_LEAPFROG_JOIN_H
+
+#include "op.h"
+#include "../../rmutil/sds.h"
+#include "../../hexastore/hexastore.h"
+
+/* LeapfrogJoinStates
+ * Different states in which LeapfrogJoin can be at. */
+typedef enum {
+    LeapfrogJoinUninitialized,  /* LeapfrogJoin wasn't initialized it. */
+    LeapfrogJoinResetted,       /* LeapfrogJoin was just restarted. */
+    LeapfrogJoinConsuming,      /* LeapfrogJoin consuming data. */
+} LeapfrogJoinStates;
+
+/* An edge connecting a bound node to the joined node. */
+typedef struct {
+    Node **neighbor;        /* Bound node. */
+    Edge **edge;            /* Edge to bind. */
+    Edge *_edge;            /* Original edge. */
+    int outgoing;           /* Edge leads from neighbor to joined node. */
+    sds prefix;             /* Hexastore prefix of neighbor's adjacency, ordered by joined node id. */
+    sds token;              /* Joined node id under cursor, followed by a delimiter. */
+    sds key;                /* Seek key buffer. */
+    raxIterator iter;       /* Cursor over neighbor's adjacency. */
+    Triplet **matches;      /* Triplets connecting neighbor to current candidate. */
+    size_t match_count;
+    size_t match_cap;
+    size_t position;        /* Current match. */
+} LeapfrogEdge;
+
+/* LeapfrogJoin binds a node connected to several bound nodes,
+ * the adjacency of each bound node is kept in the hexastore ordered by neighbor id,
+ * cursors over all of them leapfrog one another, each seeking to the largest id
+ * under any cursor, until all agree on a node connected to every bound node. */
+typedef struct {
+    OpBase op;
+    Node **node;            /* Joined node. */
+    Node *_node;            /* Original joined node. */
+    LeapfrogEdge *edges;    /* Edges connecting bound nodes to joined node. */
+    int edge_count;
+    HexaStore *hexastore;
+    int fresh;              /* Current candidate's first combination of edges wasn't produced yet. */
+    int depleted;           /* No more candidates for current bound nodes. */
+    LeapfrogJoinStates state;
+} LeapfrogJoin;
+
+/* Creates a new LeapfrogJoin operation binding node, each of edges
+ * connects node to a node bound by the op's child. */
+OpBase* NewLeapfrogJoinOp(RedisModuleCtx *ctx, Graph *g, const char *graph_name,
+                          Node **node, Edge ***edges, int edge_count);
+
+/* Creates a new LeapfrogJoin operation over the given hexastore. */
+LeapfrogJoin* NewLeapfrogJoin(HexaStore *hexastore, Graph *g, Node **node, Edge ***edges, int edge_count);
+
+OpResult LeapfrogJoinConsume(OpBase *opBase, Graph *graph);
+
+OpResult LeapfrogJoinReset(OpBase *ctx);
+
+void LeapfrogJoinFree(OpBase *ctx);
+
+#endif
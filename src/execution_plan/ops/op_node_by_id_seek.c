@@ -0,0 +1,56 @@
+#include "op_node_by_id_seek.h"
+
+OpBase *NewNodeByIdSeekOp(RedisModuleCtx *ctx, Graph *g, Node **node, const char *graph_name,
+                          long int *ids, size_t id_count) {
+    NodeByIdSeek *nodeByIdSeek = malloc(sizeof(NodeByIdSeek));
+    nodeByIdSeek->node = node;
+    nodeByIdSeek->_node = *node;
+    nodeByIdSeek->store = LabelStore_Get(ctx, STORE_NODE, graph_name, (*node)->label);
+    nodeByIdSeek->ids = ids;
+    nodeByIdSeek->id_count = id_count;
+    nodeByIdSeek->position = 0;
+
+    // Set our Op operations
+    nodeByIdSeek->op.name = "Node By Id Seek";
+    nodeByIdSeek->op.type = OPType_NODE_BY_ID_SEEK;
+    nodeByIdSeek->op.consume = NodeByIdSeekConsume;
+    nodeByIdSeek->op.reset = NodeByIdSeekReset;
+    nodeByIdSeek->op.free = NodeByIdSeekFree;
+    nodeByIdSeek->op.modifies = NewVector(char*, 1);
+
+    Vector_Push(nodeByIdSeek->op.modifies, Graph_GetNodeAlias(g, *node));
+
+    return (OpBase*)nodeByIdSeek;
+}
+
+OpResult NodeByIdSeekConsume(OpBase *opBase, Graph* graph) {
+    NodeByIdSeek *op = (NodeByIdSeek*)opBase;
+
+    /* Skip ids missing from store. */
+    while(op->position < op->id_count) {
+        char id[32];
+        int id_len = snprintf(id, 32, "%ld", op->ids[op->position++]);
+        Node *n = raxFind(op->store->items, (unsigned char *)id, id_len);
+        if(n == raxNotFound) continue;
+
+        *op->node = n;
+        return OP_OK;
+    }
+
+    return OP_DEPLETED;
+}
+
+OpResult NodeByIdSeekReset(OpBase *ctx) {
+    NodeByIdSeek *nodeByIdSeek = (NodeByIdSeek*)ctx;
+
+    /* Restore original node. */
+    *nodeByIdSeek->node = nodeByIdSeek->_node;
+    nodeByIdSeek->position = 0;
+    return OP_OK;
+}
+
+void NodeByIdSeekFree(OpBase *op) {
+    NodeByIdSeek *nodeByIdSeek = (NodeByIdSeek*)op;
+    free(nodeByIdSeek->ids);
+    free(nodeByIdSeek);
+}
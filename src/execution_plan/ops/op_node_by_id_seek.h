@@ -0,0 +1,38 @@
+#ifndef __OP_NODE_BY_ID_SEEK_H
+#define __OP_NODE_BY_ID_SEEK_H
+
+#include "op.h"
+#include "../../redismodule.h"
+#include "../../graph/graph.h"
+#include "../../graph/node.h"
+#include "../../stores/store.h"
+
+/* NodeByIdSeek
+ * Looks up each of a given list of ids within the node's label store,
+ * sets node to each node found. */
+
+typedef struct {
+    OpBase op;
+    Node **node;            /* Node being looked up. */
+    Node *_node;
+    LabelStore *store;      /* Label store, or 'ALL' store for unlabeled nodes. */
+    long int *ids;          /* Sorted, unique ids to look up. */
+    size_t id_count;
+    size_t position;        /* Next id to look up. */
+} NodeByIdSeek;
+
+/* Creates a new NodeByIdSeek operation, takes ownership of ids. */
+OpBase *NewNodeByIdSeekOp(RedisModuleCtx *ctx, Graph *g, Node **node, const char *graph_name,
+                          long int *ids, size_t id_count);
+
+/* NodeByIdSeek next operation
+ * called each time a new node is required. */
+OpResult NodeByIdSeekConsume(OpBase *opBase, Graph* graph);
+
+/* Restart lookup */
+OpResult NodeByIdSeekReset(OpBase *ctx);
+
+/* Frees NodeByIdSeek */
+void NodeByIdSeekFree(OpBase *ctx);
+
+#endif
@@ -7,11 +7,8 @@ OpBase *NewNodeByLabelScanOp(RedisModuleCtx *ctx, Graph *g, Node **node,
 
 NodeByLabelScan* NewNodeByLabelScan(RedisModuleCtx *ctx, Graph *g, Node **node,
                                     const char *graph_name, char *label) {
-    // Get graph store
-    LabelStore *store = LabelStore_Get(ctx, STORE_NODE, graph_name, label);
-    if(store == NULL) {
-        return NULL;
-    }
+    // Get graph store, a missing store is scanned as empty rather than created.
+    LabelStore *store = LabelStore_Lookup(ctx, STORE_NODE, graph_name, label);
     
     NodeByLabelScan *nodeByLabelScan = malloc(sizeof(NodeByLabelScan));
     nodeByLabelScan->ctx = ctx;
@@ -19,6 +16,9 @@ NodeByLabelScan* NewNodeByLabelScan(RedisModuleCtx *ctx, Graph *g, Node **node,
     nodeByLabelScan->_node = *node;
     nodeByLabelScan->graph = graph_name;
     nodeByLabelScan->store = store;
+    nodeByLabelScan->predicate = NULL;
+    nodeByLabelScan->program = NULL;
+    nodeByLabelScan->batch = NULL;
     LabelStore_Scan(store, &nodeByLabelScan->iter);
     
 
@@ -35,8 +35,23 @@ NodeByLabelScan* NewNodeByLabelScan(RedisModuleCtx *ctx, Graph *g, Node **node,
     return nodeByLabelScan;
 }
 
+/* Hands out the next node of the current batch, scanning and filtering
+ * another batch once it's exhausted. */
+static OpResult _NodeByLabelScanConsumeBatch(NodeByLabelScan *op, Graph *graph) {
+    GraphEntity *node;
+    while((node = EntityBatch_Next(op->batch)) == NULL) {
+        if(EntityBatch_Fill(op->batch, &op->iter) == 0) return OP_DEPLETED;
+        if(op->predicate == NULL) continue;
+        if(op->program == NULL) op->program = BC_CompileFilter(op->predicate, graph);
+        EntityBatch_Filter(op->batch, op->program, (GraphEntity**)op->node);
+    }
+    *op->node = (Node*)node;
+    return OP_OK;
+}
+
 OpResult NodeByLabelScanConsume(OpBase *opBase, Graph* graph) {
     NodeByLabelScan *op = (NodeByLabelScan*)opBase;
+    if(op->batch) return _NodeByLabelScanConsumeBatch(op, graph);
 
     if(raxEOF(&op->iter)) return OP_DEPLETED;
 
@@ -44,14 +59,13 @@ OpResult NodeByLabelScanConsume(OpBase *opBase, Graph* graph) {
     uint16_t idLen;
     
     /* Update node */
-    Node **n = op->node;
-    int res = LabelStoreIterator_Next(&op->iter, &id, &idLen, (void**)op->node);
-
-    if(res == 0) {
-        return OP_DEPLETED;
-    } 
+    while(LabelStoreIterator_Next(&op->iter, &id, &idLen, (void**)op->node)) {
+        if(op->predicate == NULL) return OP_OK;
+        if(op->program == NULL) op->program = BC_CompileFilter(op->predicate, graph);
+        if(BC_ApplyFilter(op->program)) return OP_OK;
+    }
 
-    return OP_OK;
+    return OP_DEPLETED;
 }
 
 OpResult NodeByLabelScanReset(OpBase *ctx) {
@@ -59,6 +73,7 @@ OpResult NodeByLabelScanReset(OpBase *ctx) {
 
     /* Restore original node. */
     *nodeByLabelScan->node = nodeByLabelScan->_node;
+    if(nodeByLabelScan->batch) EntityBatch_Clear(nodeByLabelScan->batch);
     
     LabelStoreIterator_Free(&nodeByLabelScan->iter);
     
@@ -69,5 +84,8 @@ OpResult NodeByLabelScanReset(OpBase *ctx) {
 void NodeByLabelScanFree(OpBase *op) {
     NodeByLabelScan *nodeByLabelScan = (NodeByLabelScan*)op;
     LabelStoreIterator_Free(&nodeByLabelScan->iter);
+    FilterTree_Free(nodeByLabelScan->predicate);
+    BC_Free(nodeByLabelScan->program);
+    if(nodeByLabelScan->batch) EntityBatch_Free(nodeByLabelScan->batch);
     free(nodeByLabelScan);
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define __OP_NODE_BY_LABEL_SCAN_H
 
 #include "op.h"
+#include "../../filter_tree/filter_tree.h"
+#include "../../bytecode/bytecode.h"
+#include "../entity_batch.h"
 #include "../../redismodule.h"
 #include "../../graph/graph.h"
 #include "../../graph/node.h"
@@ -19,6 +22,9 @@ typedef struct {
     RedisModuleCtx *ctx;
     const char *graph;      /* queried graph id */
     LabelStoreIterator iter;
+    FT_FilterNode *predicate;   /* Evaluated on each node, failing nodes are skipped, NULL if none. */
+    BC_Program *program;        /* Predicate compiled on first evaluation. */
+    EntityBatch *batch;         /* Nodes scanned ahead, NULL if scanning a node at a time. */
 } NodeByLabelScan;
 
 /* Creates a new NodeByLabelScan operation */
@@ -1,4 +1,5 @@
 #include "op_produce_results.h"
+#include <string.h>
 #include "../../resultset/record.h"
 #include "../../arithmetic/arithmetic_expression.h"
 #include "../../query_executor.h"
@@ -15,6 +16,10 @@ ProduceResults* NewProduceResults(RedisModuleCtx *ctx, AST_QueryExpressionNode *
     produceResults->result_set = result_set;
     produceResults->refreshAfterPass = 0;
     produceResults->return_elements = NULL;
+    produceResults->programs = NULL;
+    produceResults->deferred = NULL;
+    produceResults->refs = NULL;
+    produceResults->ref_count = 0;
     produceResults->init = 0;
 
     // Set our Op operations
@@ -38,18 +43,122 @@ void _BuildArithmeticExpressions(ProduceResults* op, AST_ReturnNode *return_node
         AR_ExpNode *ae = AR_EXP_BuildFromAST(ret_node->exp, graph);
         Vector_Push(op->return_elements, ae);
     }
+
+    size_t len = Vector_Size(op->return_elements);
+    op->programs = malloc(sizeof(BC_Program*) * len);
+    for(int i = 0; i < len; i++) {
+        AR_ExpNode *ae;
+        Vector_Get(op->return_elements, i, &ae);
+        op->programs[i] = BC_CompileExpression(ae);
+    }
 }
 
-Record *_ProduceResultsetRecord(ProduceResults* op) {
-    Record *r = NewRecord(Vector_Size(op->return_elements));
-    for(int i = 0; i < Vector_Size(op->return_elements); i++) {
+/* Adds the entities exp reads to op's refs. */
+void _CollectRefs(ProduceResults *op, const AR_ExpNode *exp) {
+    if(exp->type == AR_EXP_OP) {
+        for(int i = 0; i < exp->op.child_count; i++) _CollectRefs(op, exp->op.children[i]);
+        return;
+    }
+    if(exp->operand.type != AR_EXP_VARIADIC) return;
+
+    GraphEntity **ref = exp->operand.variadic.entity;
+    for(int i = 0; i < op->ref_count; i++) {
+        if(op->refs[i] == ref) return;
+    }
+    op->refs = realloc(op->refs, sizeof(GraphEntity**) * (op->ref_count + 1));
+    op->refs[op->ref_count++] = ref;
+}
+
+/* Returns 1 if exp reads entity alias. */
+int _ReadsAlias(const AR_ExpNode *exp, const char *alias) {
+    if(exp->type == AR_EXP_OP) {
+        for(int i = 0; i < exp->op.child_count; i++) {
+            if(_ReadsAlias(exp->op.children[i], alias)) return 1;
+        }
+        return 0;
+    }
+    return (exp->operand.type == AR_EXP_VARIADIC && strcmp(exp->operand.variadic.entity_alias, alias) == 0);
+}
+
+/* Full-text score isn't an entity, a single placeholder node holds
+ * the score of the current match, returns its alias, NULL if there's none. */
+const char* _ScoreAlias(const AST_QueryExpressionNode *ast) {
+    if(!ast->callNode || strcmp(ast->callNode->procedure, PROC_FULLTEXT_QUERY_NODES) != 0) return NULL;
+    if(Vector_Size(ast->callNode->yields) < 2) return NULL;
+    char *alias;
+    Vector_Get(ast->callNode->yields, 1, &alias);
+    return alias;
+}
+
+/* Once a heap keeps the top records, most records produced are dropped,
+ * only return elements sorted by are evaluated upfront.
+ * Entities are bound to the graph's stores, records keep pointers to them. */
+void _DeferReturnElements(ProduceResults *op) {
+    const ResultSet *set = op->result_set;
+    if(set->heap == NULL || set->distinct) return;
+    /* Deferred values must reflect entities as they were when record was produced. */
+    if(op->ast->createNode || op->ast->setNode || op->ast->deleteNode) return;
+
+    size_t len = Vector_Size(op->return_elements);
+    op->deferred = malloc(sizeof(int) * len);
+    for(int i = 0; i < len; i++) op->deferred[i] = 1;
+    for(int i = 0; i < set->header->orderby_len; i++) op->deferred[set->header->orderBys[i]] = 0;
+
+    const char *score_alias = _ScoreAlias(op->ast);
+    for(int i = 0; i < len; i++) {
+        if(!op->deferred[i]) continue;
         AR_ExpNode *ae;
         Vector_Get(op->return_elements, i, &ae);
-        r->values[i] = AR_EXP_Evaluate(ae);
+        /* Score placeholder is overwritten by every match. */
+        if(score_alias && _ReadsAlias(ae, score_alias)) {
+            op->deferred[i] = 0;
+            continue;
+        }
+        _CollectRefs(op, ae);
+    }
+}
+
+Record *_ProduceResultsetRecord(ProduceResults* op) {
+    Record *r = ResultSet_NewRecord(op->result_set, Vector_Size(op->return_elements));
+    for(int i = 0; i < Vector_Size(op->return_elements); i++) {
+        if(op->deferred && op->deferred[i]) {
+            r->values[i] = SI_NullVal();
+            continue;
+        }
+        r->values[i] = BC_Evaluate(op->programs[i]);
+    }
+
+    if(op->ref_count) {
+        r->entities = malloc(sizeof(GraphEntity*) * op->ref_count);
+        for(int i = 0; i < op->ref_count; i++) r->entities[i] = *op->refs[i];
     }
     return r;
 }
 
+/* Binds op's refs to the entities record was produced from
+ * and evaluates its deferred return elements. */
+void _MaterializeRecord(Record *r, void *udata) {
+    ProduceResults *op = (ProduceResults*)udata;
+    for(int i = 0; i < op->ref_count; i++) *op->refs[i] = r->entities[i];
+
+    for(int i = 0; i < Vector_Size(op->return_elements); i++) {
+        if(!op->deferred[i]) continue;
+        r->values[i] = BC_Evaluate(op->programs[i]);
+    }
+
+    free(r->entities);
+    r->entities = NULL;
+}
+
+void ProduceResults_Materialize(ProduceResults *op) {
+    if(op->deferred == NULL) return;
+
+    GraphEntity *bound[op->ref_count];
+    for(int i = 0; i < op->ref_count; i++) bound[i] = *op->refs[i];
+    ResultSet_ForEachRecord(op->result_set, _MaterializeRecord, op);
+    for(int i = 0; i < op->ref_count; i++) *op->refs[i] = bound[i];
+}
+
 /* ProduceResults next operation
  * called each time a new result record is required */
 OpResult ProduceResultsConsume(OpBase *opBase, Graph* graph) {
@@ -57,10 +166,17 @@ OpResult ProduceResultsConsume(OpBase *opBase, Graph* graph) {
 
     if(!op->init) {
         _BuildArithmeticExpressions(op, op->ast->returnNode, graph);
+        _DeferReturnElements(op);
         op->init = 1;
         return OP_REFRESH;
     }
 
+    /* Once result set is full there's no point in pulling another record,
+     * the entire pipeline stops. */
+    if(ResultSet_Full(op->result_set)) {
+        return OP_DEPLETED;
+    }
+
     if(op->refreshAfterPass == 1) {
         op->refreshAfterPass = 0;
         return OP_REFRESH;
@@ -68,9 +184,7 @@ OpResult ProduceResultsConsume(OpBase *opBase, Graph* graph) {
 
     /* Append to final result set. */
     Record *r = _ProduceResultsetRecord(op);
-    if(ResultSet_AddRecord(op->result_set, r) == RESULTSET_FULL) {
-        return OP_ERR;
-    }
+    ResultSet_AddRecord(op->result_set, r);
 
     /* Request data refresh next time consume is called. */
     op->refreshAfterPass = 1;
@@ -85,6 +199,15 @@ OpResult ProduceResultsReset(OpBase *op) {
 /* Frees ProduceResults */
 void ProduceResultsFree(OpBase *op) {
     if(op != NULL) {
+        ProduceResults *produceResults = (ProduceResults*)op;
+        if(produceResults->programs) {
+            for(int i = 0; i < Vector_Size(produceResults->return_elements); i++) {
+                BC_Free(produceResults->programs[i]);
+            }
+            free(produceResults->programs);
+        }
+        free(produceResults->deferred);
+        free(produceResults->refs);
         free(op);
     }
 }
\ No newline at end of file
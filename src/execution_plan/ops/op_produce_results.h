@@ -6,9 +6,13 @@
 #include "../../redismodule.h"
 #include "../../graph/graph.h"
 #include "../../resultset/resultset.h"
+#include "../../bytecode/bytecode.h"
 
 /* ProduceResults
- * generates result set */
+ * generates result set,
+ * when only the top records of an ordered result set are kept, return elements
+ * which aren't sorted by are evaluated once the result set is complete,
+ * and only for the records which made it into the result set. */
 
 typedef struct {
     OpBase op;
@@ -16,7 +20,11 @@ typedef struct {
     int refreshAfterPass;
     AST_QueryExpressionNode *ast;
     Vector *return_elements; /* Vector of arithmetic expressions. */
+    BC_Program **programs;  /* Per return element, its compiled expression. */
     ResultSet *result_set;
+    int *deferred;          /* Per return element, evaluation deferred, NULL if none is. */
+    GraphEntity ***refs;    /* Entities deferred return elements read. */
+    int ref_count;
     int init;
 } ProduceResults;
 
@@ -30,6 +38,10 @@ ProduceResults* NewProduceResults(RedisModuleCtx *ctx, AST_QueryExpressionNode *
  * called each time a new result record is required */
 OpResult ProduceResultsConsume(OpBase *op, Graph* graph);
 
+/* Evaluates deferred return elements of every record in result set,
+ * expected to be called once the execution plan is depleted. */
+void ProduceResults_Materialize(ProduceResults *op);
+
 /* Restart iterator */
 OpResult ProduceResultsReset(OpBase *ctx);
 
@@ -0,0 +1,38 @@
+#include "op_statistics_count.h"
+
+OpBase* NewStatisticsCountOp(LabelStore *store, ResultSet *result_set) {
+    StatisticsCount *statistics_count = calloc(1, sizeof(StatisticsCount));
+    statistics_count->store = store;
+    statistics_count->result_set = result_set;
+    statistics_count->done = 0;
+
+    // Set our Op operations
+    statistics_count->op.name = "Statistics Count";
+    statistics_count->op.type = OPType_STATISTICS_COUNT;
+    statistics_count->op.consume = StatisticsCountConsume;
+    statistics_count->op.reset = StatisticsCountReset;
+    statistics_count->op.free = StatisticsCountFree;
+    statistics_count->op.modifies = NULL;
+    return (OpBase*)statistics_count;
+}
+
+OpResult StatisticsCountConsume(OpBase *opBase, Graph* graph) {
+    StatisticsCount *op = (StatisticsCount*)opBase;
+    if(op->done) return OP_DEPLETED;
+    op->done = 1;
+
+    /* Single record holding the count, typed as count's aggregation result. */
+    Record *r = ResultSet_NewRecord(op->result_set, 1);
+    r->values[0] = SI_DoubleVal(op->store ? LabelStore_Cardinality(op->store) : 0);
+    ResultSet_AddRecord(op->result_set, r);
+    return OP_OK;
+}
+
+OpResult StatisticsCountReset(OpBase *ctx) {
+    return OP_OK;
+}
+
+void StatisticsCountFree(OpBase *ctx) {
+    StatisticsCount *op = (StatisticsCount*)ctx;
+    free(op);
+}
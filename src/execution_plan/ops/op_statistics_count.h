@@ -0,0 +1,24 @@
+#ifndef __OP_STATISTICS_COUNT_H
+#define __OP_STATISTICS_COUNT_H
+
+#include "op.h"
+#include "../../resultset/resultset.h"
+
+/* StatisticsCount
+ * Answers count-only queries, e.g. MATCH (n:L) RETURN count(n),
+ * from the number of entities held by a label store, without scanning it. */
+
+typedef struct {
+    OpBase op;
+    LabelStore *store;      /* Store holding every counted entity, NULL if there's no such store. */
+    ResultSet *result_set;
+    int done;
+} StatisticsCount;
+
+OpBase* NewStatisticsCountOp(LabelStore *store, ResultSet *result_set);
+
+OpResult StatisticsCountConsume(OpBase *opBase, Graph* graph);
+OpResult StatisticsCountReset(OpBase *ctx);
+void StatisticsCountFree(OpBase *ctx);
+
+#endif
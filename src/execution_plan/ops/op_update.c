@@ -4,8 +4,10 @@
 /* Forward declarations. */
 void _OpUpdate_BuildUpdateEvalCtx(OpUpdate* op, AST_SetNode *ast, Graph *graph);
 
-OpBase* NewUpdateOp(AST_SetNode *ast, Graph *graph, ResultSet *result_set) {
+OpBase* NewUpdateOp(RedisModuleCtx *ctx, AST_SetNode *ast, Graph *graph, const char *graph_name, ResultSet *result_set) {
     OpUpdate* op_update = calloc(1, sizeof(OpUpdate));
+    op_update->ctx = ctx;
+    op_update->graph_name = graph_name;
     op_update->result_set = result_set;
     op_update->request_refresh = 1;
     op_update->update_expressions = NULL;
@@ -18,7 +20,7 @@ OpBase* NewUpdateOp(AST_SetNode *ast, Graph *graph, ResultSet *result_set) {
 
     // Set our Op operations
     op_update->op.name = "Update";
-    op_update->op.type = OPType_CREATE;
+    op_update->op.type = OPType_UPDATE;
     op_update->op.consume = OpUpdateConsume;
     op_update->op.reset = OpUpdateReset;
     op_update->op.free = OpUpdateFree;
@@ -39,6 +41,8 @@ void _OpUpdate_BuildUpdateEvalCtx(OpUpdate* op, AST_SetNode *ast, Graph *graph)
 
         /* Get a reference to the updated entity. */
         op->update_expressions[i].entity = Graph_GetEntityRef(graph, element->entity->alias);
+        op->update_expressions[i].entity_type =
+            (Graph_GetNodeByAlias(graph, element->entity->alias) != NULL) ? STORE_NODE : STORE_EDGE;
         op->update_expressions[i].property = strdup(element->entity->property);
         op->update_expressions[i].exp = AR_EXP_BuildFromAST(element->exp, graph);
     }
@@ -48,7 +52,8 @@ void _OpUpdate_BuildUpdateEvalCtx(OpUpdate* op, AST_SetNode *ast, Graph *graph)
  * more than once, we'll have to delay updates until all entities 
  * are processed, and so _OpUpdate_QueueUpdate will queue up 
  * all information necessary to perform an update. */
-void _OpUpdate_QueueUpdate(OpUpdate *op, EntityProperty *dest_entity_prop, SIValue new_value) {
+void _OpUpdate_QueueUpdate(OpUpdate *op, GraphEntity *entity, LabelStoreType entity_type,
+                           EntityProperty *dest_entity_prop, SIValue new_value) {
     /* Make sure we've got enough room in queue. */
     if(op->entities_to_update_count == op->entities_to_update_cap) {
         op->entities_to_update_cap *= 2;
@@ -57,6 +62,8 @@ void _OpUpdate_QueueUpdate(OpUpdate *op, EntityProperty *dest_entity_prop, SIVal
     }
 
     int i = op->entities_to_update_count;
+    op->entities_to_update[i].entity = entity;
+    op->entities_to_update[i].entity_type = entity_type;
     op->entities_to_update[i].dest_entity_prop = dest_entity_prop;
     op->entities_to_update[i].new_value = new_value;
     op->entities_to_update_count++;
@@ -79,7 +86,8 @@ OpResult OpUpdateConsume(OpBase *opBase, Graph* graph) {
         GraphEntity *entity = *update_expressions->entity;
         for(int j = 0; j < entity->prop_count; j++) {
             if(strcmp(entity->properties[j].name, update_expressions->property) == 0) {
-                _OpUpdate_QueueUpdate(op, &entity->properties[j], new_value);
+                _OpUpdate_QueueUpdate(op, entity, update_expressions->entity_type,
+                                      &entity->properties[j], new_value);
                 break;
             }
         }
@@ -95,12 +103,31 @@ OpResult OpUpdateReset(OpBase *ctx) {
     return OP_OK;
 }
 
+/* Returns the label store holding entity, NULL for unlabeled entities. */
+LabelStore* _OpUpdate_EntityStore(OpUpdate *op, GraphEntity *entity, LabelStoreType entity_type) {
+    const char *label = (entity_type == STORE_NODE) ?
+        ((Node*)entity)->label : ((Edge*)entity)->relationship;
+    if(label == NULL) return NULL;
+    return LabelStore_Get(op->ctx, entity_type, op->graph_name, label);
+}
+
 /* Executes delayed updates. */
 void _UpdateEntities(OpUpdate *op) {
     for(int i = 0; i < op->entities_to_update_count; i++) {
+        GraphEntity *entity = op->entities_to_update[i].entity;
         EntityProperty *dest_entity_prop = op->entities_to_update[i].dest_entity_prop;
         SIValue new_value = op->entities_to_update[i].new_value;
-        dest_entity_prop->value = new_value;
+
+        /* Keep indices in sync, remove entity before its
+         * indexed value changes and reintroduce it afterwards. */
+        LabelStore *store = _OpUpdate_EntityStore(op, entity, op->entities_to_update[i].entity_type);
+        if(store) LabelStore_UnindexEntity(store, entity);
+        /* Entity owns its property values, new value may be borrowed
+         * from the query, e.g. a bound parameter, or from the entity itself. */
+        SIValue old_value = dest_entity_prop->value;
+        dest_entity_prop->value = SI_Clone(new_value);
+        SIValue_Free(&old_value);
+        if(store) LabelStore_IndexEntity(store, entity);
     }
     op->result_set->properties_set = op->entities_to_update_count;
 }
@@ -4,22 +4,28 @@
 #include "op.h"
 #include "../../graph/node.h"
 #include "../../graph/edge.h"
+#include "../../stores/store.h"
 #include "../../resultset/resultset.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
 typedef struct {
     GraphEntity **entity;   /* Entity to update. */
+    LabelStoreType entity_type; /* Entity type, node/edge. */
     char *property;         /* Property to update. */
     AR_ExpNode *exp;        /* Expression to evaluate. */
 } EntityUpdateEvalCtx;
 
 typedef struct {
+    GraphEntity *entity;                /* Updated entity. */
+    LabelStoreType entity_type;         /* Updated entity type, node/edge. */
     EntityProperty *dest_entity_prop;   /* Entity's property to update. */
     SIValue new_value;                  /* Constant value to set. */
 } EntityUpdateCtx;
 
 typedef struct {
     OpBase op;
+    RedisModuleCtx *ctx;
+    const char *graph_name;
     int request_refresh;
     ResultSet *result_set;
     EntityUpdateEvalCtx *update_expressions;  /* List of entities to update and their arithmetic expressions. */
@@ -29,7 +35,7 @@ typedef struct {
     size_t entities_to_update_count;
 } OpUpdate;
 
-OpBase* NewUpdateOp(AST_SetNode *ast, Graph *graph, ResultSet *result_set);
+OpBase* NewUpdateOp(RedisModuleCtx *ctx, AST_SetNode *ast, Graph *graph, const char *graph_name, ResultSet *result_set);
 OpResult OpUpdateConsume(OpBase *opBase, Graph* graph);
 OpResult OpUpdateReset(OpBase *ctx);
 void OpUpdateFree(OpBase *ctx);
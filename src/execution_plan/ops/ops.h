@@ -4,13 +4,25 @@
 /* Include all available execution plan operations. */
 #include "op_aggregate.h"
 #include "op_all_node_scan.h"
+#include "op_cache.h"
 #include "op_create.h"
+#include "op_create_index.h"
 #include "op_delete.h"
+#include "op_edge_by_id_seek.h"
+#include "op_edge_index_scan.h"
 #include "op_expand_all.h"
+#include "op_expand_factorized.h"
 #include "op_expand_into.h"
 #include "op_filter.h"
+#include "op_fulltext_scan.h"
+#include "op_geo_scan.h"
+#include "op_hash_join.h"
+#include "op_index_scan.h"
+#include "op_leapfrog_join.h"
+#include "op_node_by_id_seek.h"
 #include "op_node_by_label_scan.h"
 #include "op_produce_results.h"
+#include "op_statistics_count.h"
 #include "op_update.h"
 
 #endif
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include <assert.h>
+#include <float.h>
 #include "../value.h"
 #include "filter_tree.h"
 #include "../parser/grammar.h"
 #include "../query_executor.h"
 #include "../rmutil/vector.h"
+#include "../index/geo_index.h"
 
 FT_FilterNode* LeftChild(const FT_FilterNode *node) { return node->cond.left; }
 FT_FilterNode* RightChild(const FT_FilterNode *node) { return node->cond.right; }
@@ -16,6 +18,19 @@ int static inline IsNodeVaryingPredicate(const FT_FilterNode *node) {
     return (node->t == FT_N_PRED && node->pred.t == FT_N_VARYING);
 }
 
+int static inline IsNodeDistancePredicate(const FT_FilterNode *node) {
+    return (node->t == FT_N_PRED && node->pred.t == FT_N_DISTANCE);
+}
+
+int static inline IsNodeIdPredicate(const FT_FilterNode *node) {
+    return (node->t == FT_N_PRED && node->pred.t == FT_N_ID);
+}
+
+/* Constant, distance and id predicates refer to a single entity. */
+int static inline IsNodeSingleEntityPredicate(const FT_FilterNode *node) {
+    return IsNodeConstantPredicate(node) || IsNodeDistancePredicate(node) || IsNodeIdPredicate(node);
+}
+
 int static inline IsNodePredicate(const FT_FilterNode *node) {
     return node->t == FT_N_PRED;
 }
@@ -41,7 +56,7 @@ FT_FilterNode* CreateVaryingFilterNode(const char *LAlias, const char *LProperty
     // Assuming compared data is double.
     // TODO: support all types of possible SIValues.
     CmpFunc compareFunc = cmp_double;
-    FT_FilterNode* filterNode = (FT_FilterNode*)malloc(sizeof(FT_FilterNode));
+    FT_FilterNode* filterNode = (FT_FilterNode*)calloc(1, sizeof(FT_FilterNode));
 
     // Create predicate node
     filterNode->t = FT_N_PRED;
@@ -59,7 +74,7 @@ FT_FilterNode* CreateVaryingFilterNode(const char *LAlias, const char *LProperty
 
 FT_FilterNode* CreateConstFilterNode(const char *alias, const char *property, int op, SIValue val) {
     CmpFunc compareFunc = NULL;
-    FT_FilterNode* filterNode = (FT_FilterNode*)malloc(sizeof(FT_FilterNode));
+    FT_FilterNode* filterNode = (FT_FilterNode*)calloc(1, sizeof(FT_FilterNode));
 
     // Find out which compare function should we use.
     switch(val.type) {
@@ -108,8 +123,43 @@ FT_FilterNode* CreateConstFilterNode(const char *alias, const char *property, in
     return filterNode;
 }
 
+FT_FilterNode* CreateDistanceFilterNode(const char *alias, const char *latProperty, const char *lonProperty, double lat, double lon, int op, double distance) {
+    FT_FilterNode* filterNode = (FT_FilterNode*)calloc(1, sizeof(FT_FilterNode));
+
+    // Create predicate node
+    filterNode->t = FT_N_PRED;
+    filterNode->pred.t = FT_N_DISTANCE;
+
+    filterNode->pred.Lop.alias = strdup(alias);
+    filterNode->pred.Lop.property = strdup(latProperty);
+    filterNode->pred.origin.lon_property = strdup(lonProperty);
+    filterNode->pred.origin.lat = lat;
+    filterNode->pred.origin.lon = lon;
+
+    filterNode->pred.op = op;
+    filterNode->pred.constVal = SI_DoubleVal(distance);
+    filterNode->pred.cf = cmp_double;
+    return filterNode;
+}
+
+FT_FilterNode* CreateIdFilterNode(const char *alias, int op, long int id) {
+    FT_FilterNode* filterNode = (FT_FilterNode*)calloc(1, sizeof(FT_FilterNode));
+
+    // Create predicate node
+    filterNode->t = FT_N_PRED;
+    filterNode->pred.t = FT_N_ID;
+
+    filterNode->pred.Lop.alias = strdup(alias);
+    filterNode->pred.Lop.property = NULL;
+
+    filterNode->pred.op = op;
+    filterNode->pred.constVal = SI_LongVal(id);
+    filterNode->pred.cf = cmp_long;
+    return filterNode;
+}
+
 FT_FilterNode* CreateCondFilterNode(int op) {
-    FT_FilterNode* filterNode = (FT_FilterNode*)malloc(sizeof(FT_FilterNode));
+    FT_FilterNode* filterNode = (FT_FilterNode*)calloc(1, sizeof(FT_FilterNode));
     filterNode->t = FT_N_COND;
     filterNode->cond.op = op;
     return filterNode;
@@ -133,7 +183,25 @@ FT_FilterNode* _CreateConstFilterNode(AST_PredicateNode n) {
     return CreateConstFilterNode(n.alias, n.property, n.op, n.constVal);
 }
 
+FT_FilterNode* _CreateDistanceFilterNode(AST_PredicateNode n) {
+    return CreateDistanceFilterNode(n.alias, n.property, n.distance.lon_property,
+                                    n.distance.lat, n.distance.lon, n.op, n.constVal.doubleval);
+}
+
+FT_FilterNode* _CreateIdFilterNode(AST_PredicateNode n) {
+    return CreateIdFilterNode(n.alias, n.op, n.constVal.longval);
+}
+
 FT_FilterNode* _FilterTree_ClonePredicateNode(const FT_FilterNode *root) {
+    if(IsNodeIdPredicate(root)) {
+        return CreateIdFilterNode(root->pred.Lop.alias, root->pred.op, root->pred.constVal.longval);
+    }
+    if(IsNodeDistancePredicate(root)) {
+        return CreateDistanceFilterNode(root->pred.Lop.alias, root->pred.Lop.property,
+                                        root->pred.origin.lon_property, root->pred.origin.lat,
+                                        root->pred.origin.lon, root->pred.op,
+                                        root->pred.constVal.doubleval);
+    }
     if(IsNodeConstantPredicate(root)) {
         return CreateConstFilterNode(root->pred.Lop.alias, root->pred.Lop.property, root->pred.op, SI_Clone(root->pred.constVal));
     } else {
@@ -163,7 +231,7 @@ void _FilterTree_RemovePredNodes(FT_FilterNode **root, const Vector *aliases) {
         return;
     }
 
-    if(IsNodeConstantPredicate(*root)) {
+    if(IsNodeSingleEntityPredicate(*root)) {
         if(_vectorContains(aliases, (*root)->pred.Lop.alias)) {
             FilterTree_Free(*root);
             *root = NULL;
@@ -193,7 +261,7 @@ void FilterTree_RemoveAllNodesExcept(FT_FilterNode **root, Vector *aliases) {
         return;
     }
 
-    if(IsNodeConstantPredicate(*root)) {
+    if(IsNodeSingleEntityPredicate(*root)) {
         // Check if current node is not in aliases.
         if(!_vectorContains(aliases, (*root)->pred.Lop.alias)) {
             FilterTree_Free(*root);
@@ -259,6 +327,10 @@ FT_FilterNode* BuildFiltersTree(const AST_FilterNode *root) {
     if(root->t == N_PRED) {
         if(root->pn.t == N_CONSTANT) {
             return _CreateConstFilterNode(root->pn);
+        } else if(root->pn.t == N_DISTANCE) {
+            return _CreateDistanceFilterNode(root->pn);
+        } else if(root->pn.t == N_ID) {
+            return _CreateIdFilterNode(root->pn);
         } else {
             return _CreateVaryingFilterNode(root->pn);
         }
@@ -277,6 +349,12 @@ FT_FilterNode* BuildFiltersTree(const AST_FilterNode *root) {
 int _applyFilter(SIValue* aVal, SIValue* bVal, CmpFunc f, int op) {
     /* TODO: Make sure values are of the same type
      * TODO: Make sure values type confirms with compare function. */
+    if(op == STARTS) {
+        /* Case sensitive prefix match, applies to strings only. */
+        if(aVal->type != T_STRING || bVal->type != T_STRING) return 0;
+        return strncmp(aVal->stringval, bVal->stringval, strlen(bVal->stringval)) == 0;
+    }
+
     int rel = f(aVal, bVal);
 
     switch(op) {
@@ -303,6 +381,29 @@ int _applyFilter(SIValue* aVal, SIValue* bVal, CmpFunc f, int op) {
     return 0;
 }
 
+/* Computes entity's distance from predicate's origin,
+ * returns 0 if entity's location is unknown. */
+int _applyDistanceFilter(const Graph* g, const FT_FilterNode* root) {
+    GraphEntity *entity = Graph_GetEntityByAlias(g, root->pred.Lop.alias);
+    if(!entity || entity->id == INVALID_ENTITY_ID) {
+        return 0;
+    }
+
+    SIValue *lat = GraphEntity_Get_Property(entity, root->pred.Lop.property);
+    SIValue *lon = GraphEntity_Get_Property(entity, root->pred.origin.lon_property);
+    if(lat == PROPERTY_NOTFOUND || lon == PROPERTY_NOTFOUND) return 0;
+    if(!(lat->type & SI_NUMERIC) || !(lon->type & SI_NUMERIC)) return 0;
+
+    double entity_lat;
+    double entity_lon;
+    SIValue_ToDouble(lat, &entity_lat);
+    SIValue_ToDouble(lon, &entity_lon);
+    SIValue distance = SI_DoubleVal(Geo_Distance(entity_lat, entity_lon,
+                                                 root->pred.origin.lat, root->pred.origin.lon));
+
+    return _applyFilter(&distance, (SIValue *)&root->pred.constVal, root->pred.cf, root->pred.op);
+}
+
 int _applyPredicateFilters(const Graph* g, const FT_FilterNode* root) {
     /* A op B
      * Extract both A and B values. */
@@ -310,6 +411,19 @@ int _applyPredicateFilters(const Graph* g, const FT_FilterNode* root) {
     SIValue *aVal;
     SIValue *bVal;
 
+    if(IsNodeDistancePredicate(root)) {
+        return _applyDistanceFilter(g, root);
+    }
+
+    if(IsNodeIdPredicate(root)) {
+        entity = Graph_GetEntityByAlias(g, root->pred.Lop.alias);
+        if(!entity || entity->id == INVALID_ENTITY_ID) {
+            return 0;
+        }
+        SIValue id = SI_LongVal(entity->id);
+        return _applyFilter(&id, (SIValue *)&root->pred.constVal, root->pred.cf, root->pred.op);
+    }
+
     if(IsNodeConstantPredicate(root)) {
         bVal = (SIValue *)&root->pred.constVal;
     } else {
@@ -351,6 +465,75 @@ int applyFilters(const Graph* g, const FT_FilterNode* root) {
     return pass;
 }
 
+/* Predicate weights, relative cost of evaluating each kind of predicate. */
+#define FT_ID_WEIGHT 1
+#define FT_CONSTANT_WEIGHT 2
+#define FT_VARYING_WEIGHT 3
+#define FT_DISTANCE_WEIGHT 6
+
+static double _FilterTree_PredicateWeight(const FT_FilterNode *root) {
+    if(IsNodeIdPredicate(root)) return FT_ID_WEIGHT;
+    if(IsNodeConstantPredicate(root)) return FT_CONSTANT_WEIGHT;
+    if(IsNodeDistancePredicate(root)) return FT_DISTANCE_WEIGHT;
+    return FT_VARYING_WEIGHT;
+}
+
+static int _FilterTree_Apply(const Graph *g, FT_FilterNode *root, double *cost) {
+    int pass;
+    double spent = 0;
+
+    if(IsNodePredicate(root)) {
+        pass = (_applyPredicateFilters(g, root) != 0);
+        spent = _FilterTree_PredicateWeight(root);
+    } else {
+        pass = _FilterTree_Apply(g, LeftChild(root), &spent);
+        if((root->cond.op == AND && pass) || (root->cond.op == OR && !pass)) {
+            pass = _FilterTree_Apply(g, RightChild(root), &spent);
+        }
+    }
+
+    root->stats.evaluations++;
+    root->stats.passes += pass;
+    root->stats.cost += spent;
+    *cost += spent;
+    return pass;
+}
+
+int FilterTree_Apply(const Graph *g, FT_FilterNode *root) {
+    double cost = 0;
+    return _FilterTree_Apply(g, root, &cost);
+}
+
+/* Average cost of evaluating node per evaluation deciding its parent condition,
+ * a failing child decides an AND, a passing child decides an OR. */
+static double _FilterTree_Rank(const FT_FilterNode *node, int op) {
+    double cost = node->stats.cost / node->stats.evaluations;
+    double pass_rate = (double)node->stats.passes / node->stats.evaluations;
+    double decisive = (op == AND) ? 1 - pass_rate : pass_rate;
+    if(decisive == 0) return DBL_MAX;
+    return cost / decisive;
+}
+
+void FilterTree_Reorder(FT_FilterNode *root) {
+    if(IsNodeCondition(root)) {
+        FilterTree_Reorder(LeftChild(root));
+        FilterTree_Reorder(RightChild(root));
+
+        /* Predicates have no side effects, swapping operands preserves the outcome. */
+        FT_FilterNode *left = LeftChild(root);
+        FT_FilterNode *right = RightChild(root);
+        if(left->stats.evaluations > 0 && right->stats.evaluations > 0 &&
+           _FilterTree_Rank(right, root->cond.op) < _FilterTree_Rank(left, root->cond.op)) {
+            root->cond.left = right;
+            root->cond.right = left;
+        }
+    }
+
+    root->stats.evaluations >>= 1;
+    root->stats.passes >>= 1;
+    root->stats.cost /= 2;
+}
+
 int FilterTree_ContainsNode(const FT_FilterNode *root, const Vector *aliases) {    
     if(root == NULL) {
         return 0;
@@ -358,8 +541,8 @@ int FilterTree_ContainsNode(const FT_FilterNode *root, const Vector *aliases) {
     
     // Is this a predicate node?
     if(IsNodePredicate(root)) {
-        // For const predicate nodes, check only left predicate
-        if(IsNodeConstantPredicate(root)) {
+        // For const and distance predicate nodes, check only left predicate
+        if(IsNodeSingleEntityPredicate(root)) {
             return _vectorContains(aliases, root->pred.Lop.alias);
         }
         
@@ -389,6 +572,27 @@ void _FilterTree_Print(const FT_FilterNode *root, int ident) {
         );
         return;
     }
+    if(IsNodeIdPredicate(root)) {
+        printf("id(%s) %d %ld\n",
+            root->pred.Lop.alias,
+            root->pred.op,
+            root->pred.constVal.longval
+        );
+        return;
+    }
+    if(IsNodeDistancePredicate(root)) {
+        printf("distance(%s.%s, %s.%s, %f, %f) %d %f\n",
+            root->pred.Lop.alias,
+            root->pred.Lop.property,
+            root->pred.Lop.alias,
+            root->pred.origin.lon_property,
+            root->pred.origin.lat,
+            root->pred.origin.lon,
+            root->pred.op,
+            root->pred.constVal.doubleval
+        );
+        return;
+    }
     if(IsNodeVaryingPredicate(root)) {
         printf("%s.%s %d %s.%s\n",
             root->pred.Lop.alias,
@@ -422,12 +626,15 @@ void _FreeVaryingFilterNode(FT_PredicateNode node) {
 
 void _FreeConstFilterNode(FT_PredicateNode node) {
     free(node.Lop.alias);
-    free(node.Lop.property);
+    if(node.Lop.property) free(node.Lop.property);
 }
 
 void _FilterTree_FreePredNode(FT_PredicateNode node) {
-    if(node.t == FT_N_CONSTANT) {
+    if(node.t == FT_N_CONSTANT || node.t == FT_N_ID) {
+        _FreeConstFilterNode(node);
+    } else if(node.t == FT_N_DISTANCE) {
         _FreeConstFilterNode(node);
+        free(node.origin.lon_property);
     } else {
         _FreeVaryingFilterNode(node);
     }
@@ -18,6 +18,8 @@ typedef enum {
 typedef enum {
 	FT_N_CONSTANT,
 	FT_N_VARYING,
+	FT_N_DISTANCE,
+	FT_N_ID,
 } FT_CompareValueType;
 
 struct FT_FilterNode;
@@ -25,9 +27,9 @@ struct FT_FilterNode;
 typedef struct {
 	struct {			    /* Left side of predicate. */
 		char* alias;		/* Element in question alias. */
-		char* property;		/* Element's property to check. */
+		char* property;		/* Element's property to check, NULL for id predicates. */
 	} Lop;
-	int op;					/* Operation (<, <=, =, =>, >, !). */
+	int op;					/* Operation (<, <=, =, =>, >, !, STARTS WITH). */
 	union {					/* Right side of predicate. */
 		SIValue constVal;	/* Value to compare against. */
 		struct {
@@ -35,7 +37,12 @@ typedef struct {
 			char* property;
 		} Rop;
 	};
-	FT_CompareValueType t; 	/* Comapred value type, constant/node. */
+	struct {				/* Distance predicate, Lop.property holds latitude. */
+		char* lon_property;	/* Element's longitude property. */
+		double lat;			/* Origin latitude. */
+		double lon;			/* Origin longitude. */
+	} origin;
+	FT_CompareValueType t; 	/* Comapred value type, constant/node/distance/id. */
 	CmpFunc cf;				/* Compare function, determins relation between val and element property. */
 } FT_PredicateNode;
 
@@ -45,6 +52,13 @@ typedef struct {
 	int op;					/* OR, AND */
 } FT_ConditionNode;
 
+/* Runtime statistics of a filter tree node. */
+typedef struct {
+	uint64_t evaluations;	/* Number of times node was evaluated. */
+	uint64_t passes;		/* Number of evaluations which passed. */
+	double cost;			/* Accumulated weight of predicates evaluated. */
+} FT_FilterStats;
+
 /* All nodes within the filter tree are of type FT_FilterNode. */
 struct FT_FilterNode {
   union {
@@ -52,6 +66,7 @@ struct FT_FilterNode {
     FT_ConditionNode cond;
   };
   FT_FilterNodeType t;	/* Determins actual type of this node. */
+  FT_FilterStats stats;	/* Collected by FilterTree_Apply. */
 };
 
 typedef struct FT_FilterNode FT_FilterNode;
@@ -62,6 +77,8 @@ FT_FilterNode* BuildFiltersTree(const AST_FilterNode *root);
 
 FT_FilterNode* CreateVaryingFilterNode(const char *LAlias, const char *LProperty, const char *RAlias, const char *RProperty, int op);
 FT_FilterNode* CreateConstFilterNode(const char *alias, const char *property, int op, SIValue val);
+FT_FilterNode* CreateDistanceFilterNode(const char *alias, const char *latProperty, const char *lonProperty, double lat, double lon, int op, double distance);
+FT_FilterNode* CreateIdFilterNode(const char *alias, int op, long int id);
 FT_FilterNode* CreateCondFilterNode(int op);
 
 FT_FilterNode *AppendLeftChild(FT_FilterNode *root, FT_FilterNode *child);
@@ -70,6 +87,14 @@ FT_FilterNode *AppendRightChild(FT_FilterNode *root, FT_FilterNode *child);
 /* Runs val through the filter tree. */
 int applyFilters(const Graph* g, const FT_FilterNode* root);
 
+/* Runs graph through the filter tree, recording each node's pass rate and cost. */
+int FilterTree_Apply(const Graph *g, FT_FilterNode *root);
+
+/* Swaps the children of conditions according to the statistics collected so far,
+ * such that the child most likely to decide the condition, per cost, is evaluated first,
+ * statistics are then decayed such that recent evaluations weigh more. */
+void FilterTree_Reorder(FT_FilterNode *root);
+
 /* Checks to see if aliased node is within the filter tree. */
 int FilterTree_ContainsNode(const FT_FilterNode *root, const Vector *aliases);
 
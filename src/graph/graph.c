@@ -14,15 +14,18 @@ GraphEntity* _Graph_GetEntityById(GraphEntity **entity_list, int entity_count, l
 }
 
 void _Graph_AddEntity(GraphEntity *entity, char *alias, GraphEntity ***entity_list,
-                     char ***alias_list, size_t *entity_count, size_t *entity_cap) {
+                     GraphEntity ***owned_list, char ***alias_list, size_t *entity_count,
+                     size_t *entity_cap) {
     
     if(*entity_cap <= *entity_count) {
         *entity_cap *= 2; 
         *entity_list = realloc(*entity_list, sizeof(GraphEntity*) * (*entity_cap));
+        *owned_list = realloc(*owned_list, sizeof(GraphEntity*) * (*entity_cap));
         *alias_list = realloc(*alias_list, sizeof(char*) * (*entity_cap));
     }
 
     (*entity_list)[*entity_count] = entity;
+    (*owned_list)[*entity_count] = entity;
     (*alias_list)[*entity_count] = alias;
     (*entity_count)++;
 }
@@ -31,6 +34,7 @@ void _Graph_AddEdge(Graph *g, Edge *e, char *alias) {
     _Graph_AddEntity((GraphEntity*)e,
                      alias,
                      (GraphEntity ***)(&g->edges),
+                     (GraphEntity ***)(&g->_edges),
                      &g->edge_aliases,
                      &g->edge_count,
                      &g->edge_cap);
@@ -69,24 +73,19 @@ int _Graph_ContainsEntity(GraphEntity *entity, GraphEntity **entities, int entit
 }
 
 Graph* NewGraph() {
-    Graph* g = (Graph*)malloc(sizeof(Graph));
-    g->node_count = 0;
-    g->edge_count = 0;
-    g->node_cap = DEFAULT_GRAPH_CAP;
-    g->edge_cap = DEFAULT_GRAPH_CAP;
-    g->nodes = (Node**)malloc(sizeof(Node*) * g->node_cap);
-    g->edges = (Edge**)malloc(sizeof(Edge*) * g->edge_cap);
-    g->node_aliases = (char**)malloc(sizeof(char*) * g->node_cap);
-    g->edge_aliases = (char**)malloc(sizeof(char*) * g->edge_cap);
-    return g;
+    return NewGraph_WithCapacity(DEFAULT_GRAPH_CAP, DEFAULT_GRAPH_CAP);
 }
 
 Graph* NewGraph_WithCapacity(size_t node_cap, size_t edge_cap) {
-    Graph *graph = NewGraph();
+    Graph *graph = (Graph*)malloc(sizeof(Graph));
+    graph->node_count = 0;
+    graph->edge_count = 0;
     graph->node_cap = node_cap;
     graph->edge_cap = edge_cap;
     graph->nodes = (Node**)malloc(sizeof(Node*) * node_cap);
     graph->edges = (Edge**)malloc(sizeof(Edge*) * edge_cap);
+    graph->_nodes = (Node**)malloc(sizeof(Node*) * node_cap);
+    graph->_edges = (Edge**)malloc(sizeof(Edge*) * edge_cap);
     graph->node_aliases = (char**)malloc(sizeof(char*) * node_cap);
     graph->edge_aliases = (char**)malloc(sizeof(char*) * edge_cap);
     return graph;
@@ -121,6 +120,7 @@ int Graph_AddNode(Graph* g, Node *n, char *alias) {
         _Graph_AddEntity((GraphEntity*)n,
         alias,
         (GraphEntity ***)&g->nodes,
+        (GraphEntity ***)&g->_nodes,
         &g->node_aliases,
         &g->node_count,
         &g->node_cap);
@@ -263,19 +263,16 @@ Edge** Graph_GetEdgeRef(const Graph *g, const Edge *e) {
 
 /* Frees entire graph. */
 void Graph_Free(Graph* g) {
-    /* Free graph's nodes. */
-    int i;
-    int nodeCount = g->node_count;
-
-    for(i = 0; i < nodeCount; i++) {
-        Node* n = g->nodes[i];
-        FreeNode(n);
-    }
-
-    /* TODO: Free edges. */
+    /* Entities currently referenced might have been bound by
+     * the execution plan, free the entities added to the graph. */
+    for(int i = 0; i < g->node_count; i++) FreeNode(g->_nodes[i]);
+    for(int i = 0; i < g->edge_count; i++) FreeEdge(g->_edges[i]);
 
-    /* Edges are freed internaly by nodes */
     free(g->nodes);
     free(g->edges);
+    free(g->_nodes);
+    free(g->_edges);
+    free(g->node_aliases);
+    free(g->edge_aliases);
     free(g);
 }
\ No newline at end of file
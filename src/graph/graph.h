@@ -11,6 +11,8 @@
 typedef struct {
     Node **nodes;
     Edge **edges;
+    Node **_nodes;      /* Nodes added to the graph, nodes might be rebound during execution. */
+    Edge **_edges;      /* Edges added to the graph, edges might be rebound during execution. */
     char **node_aliases;
     char **edge_aliases;
     size_t node_count;
@@ -62,7 +64,7 @@ GraphEntity** Graph_GetEntityRef(const Graph *g, const char *alias);
 Node** Graph_GetNodeRef(const Graph *g, const Node *n);
 Edge** Graph_GetEdgeRef(const Graph *g, const Edge *e);
 
-/* Frees entire graph */
+/* Frees entire graph, along with the entities added to it. */
 void Graph_Free(Graph* g);
 
 #endif
\ No newline at end of file
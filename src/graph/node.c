@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <string.h>
 
 #include "node.h"
 #include "edge.h"
@@ -28,6 +29,43 @@ void Node_ConnectNode(Node* src, Node* dest, struct Edge* e) {
 	// assert(src && dest && e->src == src && e->dest == dest);
 	Vector_Push(src->outgoing_edges, e);
 	Vector_Push(dest->incoming_edges, e);
+	Node_UpdateDegree(src, e->relationship, 1, 0);
+	Node_UpdateDegree(dest, e->relationship, 0, 1);
+}
+
+static NodeDegree* _Node_GetDegree(const Node *n, const char *relationship) {
+	for(int i = 0; i < n->degree_count; i++) {
+		if(strcmp(n->degrees[i].relationship, relationship) == 0) return &n->degrees[i];
+	}
+	return NULL;
+}
+
+void Node_UpdateDegree(Node *n, const char *relationship, int outgoing, int incoming) {
+	/* Untyped edges are only counted by the node's edge lists. */
+	if(relationship == NULL) return;
+
+	NodeDegree *degree = _Node_GetDegree(n, relationship);
+	if(degree == NULL) {
+		n->degrees = realloc(n->degrees, sizeof(NodeDegree) * (n->degree_count + 1));
+		degree = &n->degrees[n->degree_count++];
+		degree->relationship = strdup(relationship);
+		degree->outgoing = 0;
+		degree->incoming = 0;
+	}
+	degree->outgoing += outgoing;
+	degree->incoming += incoming;
+}
+
+int Node_OutDegree(const Node *n, const char *relationship) {
+	if(relationship == NULL) return Vector_Size(n->outgoing_edges);
+	NodeDegree *degree = _Node_GetDegree(n, relationship);
+	return (degree) ? degree->outgoing : 0;
+}
+
+int Node_InDegree(const Node *n, const char *relationship) {
+	if(relationship == NULL) return Vector_Size(n->incoming_edges);
+	NodeDegree *degree = _Node_GetDegree(n, relationship);
+	return (degree) ? degree->incoming : 0;
 }
 
 int Node_IncomeDegree(const Node *n) {
@@ -53,6 +91,8 @@ void FreeNode(Node* node) {
 
 	Vector_Free(node->outgoing_edges);
 	Vector_Free(node->incoming_edges);
+	for(int i = 0; i < node->degree_count; i++) free(node->degrees[i].relationship);
+	free(node->degrees);
 	
 	free(node);
 	node = NULL;
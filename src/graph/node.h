@@ -7,6 +7,14 @@
 
 /* Forward declaration of edge */
 struct Edge;
+
+/* Number of edges of a single relationship type connected to a node. */
+typedef struct {
+	char *relationship;
+	int outgoing;
+	int incoming;
+} NodeDegree;
+
 typedef struct {
 	// GraphEntity entity;
 	struct {
@@ -17,6 +25,8 @@ typedef struct {
 	char *label;			/* label attached to node */
 	Vector* outgoing_edges;	/* list of incoming edges (ME)<-(SRC) */
 	Vector* incoming_edges;	/* list on outgoing edges (ME)->(DEST) */
+	NodeDegree *degrees;	/* Degree per relationship type. */
+	int degree_count;
 } Node;
 
 /* Creates a new node. */
@@ -31,6 +41,18 @@ int Node_IncomeDegree(const Node *n);
 /* Connects source node to destination node by edge */
 void Node_ConnectNode(Node* src, Node* dest, struct Edge* e);
 
+/* Updates node's number of outgoing and incoming edges of relationship type
+ * by the given deltas, expected to be called whenever an edge is connected or removed. */
+void Node_UpdateDegree(Node *n, const char *relationship, int outgoing, int incoming);
+
+/* Returns number of edges of relationship type leaving node,
+ * or of any type if relationship is NULL. */
+int Node_OutDegree(const Node *n, const char *relationship);
+
+/* Returns number of edges of relationship type entering node,
+ * or of any type if relationship is NULL. */
+int Node_InDegree(const Node *n, const char *relationship);
+
 /* Adds properties to node
  * prop_count - number of new properties to add 
  * keys - array of properties keys 
@@ -0,0 +1,353 @@
+#include "fulltext_index.h"
+#include <math.h>
+#include <ctype.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* Accumulates a single entity's score while processing a query. */
+typedef struct {
+    GraphEntity *entity;
+    double score;
+    int terms_matched;      /* Number of query terms entity matched. */
+    int last_term;          /* Last query term which matched entity. */
+} _FullTextMatch;
+
+/* Query term kinds. */
+typedef enum {
+    FT_TERM_EXACT,
+    FT_TERM_PREFIX,
+    FT_TERM_FUZZY,
+} _FullTextTermKind;
+
+FullTextIndex* NewFullTextIndex(const char *property) {
+    FullTextIndex *idx = malloc(sizeof(FullTextIndex));
+    idx->property = strdup(property);
+    idx->terms = raxNew();
+    idx->doc_count = 0;
+    return idx;
+}
+
+static inline int _FullText_IsTermChar(unsigned char c) {
+    /* Treat none ASCII bytes as word characters, this keeps
+     * UTF-8 encoded words in one piece. */
+    return isalnum(c) || c >= 0x80;
+}
+
+Vector* FullText_Tokenize(const char *text) {
+    Vector *tokens = NewVector(char*, 4);
+    char term[FULLTEXT_MAX_TERM_LEN + 1];
+    size_t term_len = 0;
+    const unsigned char *c = (const unsigned char *)text;
+
+    for(;; c++) {
+        if(*c != '\0' && _FullText_IsTermChar(*c)) {
+            if(term_len < FULLTEXT_MAX_TERM_LEN) term[term_len++] = tolower(*c);
+            continue;
+        }
+
+        /* Term boundary. */
+        if(term_len > 0) {
+            term[term_len] = '\0';
+            Vector_Push(tokens, strdup(term));
+            term_len = 0;
+        }
+        if(*c == '\0') break;
+    }
+
+    return tokens;
+}
+
+static inline size_t _FullText_EntityId(const GraphEntity *entity, char *buf, size_t len) {
+    return snprintf(buf, len, "%ld", entity->id);
+}
+
+void FullTextIndex_Insert(FullTextIndex *idx, GraphEntity *entity) {
+    SIValue *text = GraphEntity_Get_Property(entity, idx->property);
+    if(text == PROPERTY_NOTFOUND || text->type != T_STRING) return;
+
+    char entity_id[32];
+    size_t entity_id_len = _FullText_EntityId(entity, entity_id, 32);
+    Vector *tokens = FullText_Tokenize(text->stringval);
+
+    for(int i = 0; i < Vector_Size(tokens); i++) {
+        char *token;
+        Vector_Get(tokens, i, &token);
+        size_t token_len = strlen(token);
+
+        rax *postings = raxFind(idx->terms, (unsigned char *)token, token_len);
+        if(postings == raxNotFound) {
+            postings = raxNew();
+            raxInsert(idx->terms, (unsigned char *)token, token_len, postings, NULL);
+        }
+
+        FullTextPosting *posting = raxFind(postings, (unsigned char *)entity_id, entity_id_len);
+        if(posting == raxNotFound) {
+            posting = malloc(sizeof(FullTextPosting));
+            posting->entity = entity;
+            posting->freq = 0;
+            raxInsert(postings, (unsigned char *)entity_id, entity_id_len, posting, NULL);
+        }
+        posting->freq++;
+        free(token);
+    }
+
+    Vector_Free(tokens);
+    idx->doc_count++;
+}
+
+void FullTextIndex_Remove(FullTextIndex *idx, GraphEntity *entity) {
+    SIValue *text = GraphEntity_Get_Property(entity, idx->property);
+    if(text == PROPERTY_NOTFOUND || text->type != T_STRING) return;
+
+    char entity_id[32];
+    size_t entity_id_len = _FullText_EntityId(entity, entity_id, 32);
+    Vector *tokens = FullText_Tokenize(text->stringval);
+
+    for(int i = 0; i < Vector_Size(tokens); i++) {
+        char *token;
+        Vector_Get(tokens, i, &token);
+        size_t token_len = strlen(token);
+
+        /* Term might have been removed already, (repeated token). */
+        rax *postings = raxFind(idx->terms, (unsigned char *)token, token_len);
+        if(postings != raxNotFound) {
+            FullTextPosting *posting;
+            if(raxRemove(postings, (unsigned char *)entity_id, entity_id_len, (void**)&posting)) {
+                free(posting);
+            }
+            /* Drop terms with an empty posting list. */
+            if(raxSize(postings) == 0) {
+                raxRemove(idx->terms, (unsigned char *)token, token_len, NULL);
+                raxFree(postings);
+            }
+        }
+        free(token);
+    }
+
+    Vector_Free(tokens);
+    if(idx->doc_count > 0) idx->doc_count--;
+}
+
+/* Bounded Levenshtein distance between term and key.
+ * Returns max_dist+1 as soon as distance is known to exceed max_dist,
+ * in which case prune_len is set to the length of key's shortest prefix
+ * which no key sharing it can match, otherwise prune_len is set to 0. */
+static int _FullText_EditDistance(const char *term, size_t term_len,
+                                  const unsigned char *key, size_t key_len,
+                                  int max_dist, size_t *prune_len) {
+    int rows[2][FULLTEXT_MAX_TERM_LEN + 1];
+    int *prev = rows[0];
+    int *cur = rows[1];
+    *prune_len = 0;
+
+    for(int j = 0; j <= term_len; j++) prev[j] = j;
+
+    for(size_t i = 1; i <= key_len; i++) {
+        int row_min = cur[0] = i;
+        for(size_t j = 1; j <= term_len; j++) {
+            int substitution = prev[j-1] + (key[i-1] != (unsigned char)term[j-1]);
+            int deletion = prev[j] + 1;
+            int insertion = cur[j-1] + 1;
+            int d = substitution;
+            if(deletion < d) d = deletion;
+            if(insertion < d) d = insertion;
+            cur[j] = d;
+            if(d < row_min) row_min = d;
+        }
+
+        if(row_min > max_dist) {
+            *prune_len = i;
+            return max_dist + 1;
+        }
+
+        int *tmp = prev;
+        prev = cur;
+        cur = tmp;
+    }
+
+    return prev[term_len];
+}
+
+/* Collects posting lists of every indexed term matching query term. */
+static void _FullTextIndex_ExpandTerm(FullTextIndex *idx, const char *term, _FullTextTermKind kind,
+                                      int max_dist, Vector *postings) {
+    size_t term_len = strlen(term);
+
+    if(kind == FT_TERM_EXACT) {
+        rax *p = raxFind(idx->terms, (unsigned char *)term, term_len);
+        if(p != raxNotFound) Vector_Push(postings, p);
+        return;
+    }
+
+    raxIterator it;
+    raxStart(&it, idx->terms);
+
+    if(kind == FT_TERM_PREFIX) {
+        /* Every term sharing prefix is located right after it. */
+        raxSeek(&it, ">=", (unsigned char *)term, term_len);
+        while(raxNext(&it) && Vector_Size(postings) < FULLTEXT_MAX_EXPANSIONS) {
+            if(it.key_len < term_len || memcmp(it.key, term, term_len) != 0) break;
+            Vector_Push(postings, it.data);
+        }
+        raxStop(&it);
+        return;
+    }
+
+    /* Fuzzy, walk the trie in order, whenever a key prefix can no longer
+     * be within max_dist of term, skip every key sharing that prefix. */
+    unsigned char successor[FULLTEXT_MAX_TERM_LEN + 1];
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it) && Vector_Size(postings) < FULLTEXT_MAX_EXPANSIONS) {
+        size_t prune_len;
+        int dist = _FullText_EditDistance(term, term_len, it.key, it.key_len, max_dist, &prune_len);
+        if(dist <= max_dist) {
+            Vector_Push(postings, it.data);
+            continue;
+        }
+        if(prune_len == 0) continue;
+
+        /* Seek to the first key which doesn't share key[0..prune_len). */
+        size_t successor_len = prune_len;
+        memcpy(successor, it.key, successor_len);
+        while(successor_len > 0 && successor[successor_len-1] == 0xFF) successor_len--;
+        if(successor_len == 0) break;
+        successor[successor_len-1]++;
+        raxSeek(&it, ">=", successor, successor_len);
+    }
+    raxStop(&it);
+}
+
+static int _FullTextResult_Compare(const void *a, const void *b) {
+    const FullTextResult *ra = a;
+    const FullTextResult *rb = b;
+    if(ra->score > rb->score) return -1;
+    if(ra->score < rb->score) return 1;
+    /* Break ties by entity id, keeps results stable. */
+    if(ra->entity->id < rb->entity->id) return -1;
+    return (ra->entity->id > rb->entity->id);
+}
+
+size_t FullTextIndex_Query(FullTextIndex *idx, const char *query, FullTextResult **results) {
+    *results = NULL;
+    rax *matches = raxNew();    /* entity id -> _FullTextMatch. */
+    Vector *postings = NewVector(rax*, 4);
+    int term_count = 0;
+    size_t result_count = 0;
+
+    char *q = strdup(query);
+    char *saveptr;
+    for(char *raw = strtok_r(q, " \t\r\n", &saveptr); raw; raw = strtok_r(NULL, " \t\r\n", &saveptr)) {
+        /* Determine term kind. */
+        _FullTextTermKind kind = FT_TERM_EXACT;
+        int max_dist = 0;
+
+        while(*raw == '%') {
+            max_dist++;
+            raw++;
+        }
+        size_t raw_len = strlen(raw);
+        while(raw_len > 0 && (raw[raw_len-1] == '%' || raw[raw_len-1] == '*')) {
+            if(raw[raw_len-1] == '*' && max_dist == 0) kind = FT_TERM_PREFIX;
+            raw[--raw_len] = '\0';
+        }
+        if(max_dist > 0) {
+            kind = FT_TERM_FUZZY;
+            if(max_dist > FULLTEXT_MAX_FUZZY_DISTANCE) max_dist = FULLTEXT_MAX_FUZZY_DISTANCE;
+        }
+
+        /* Normalize term the same way indexed text is. */
+        Vector *tokens = FullText_Tokenize(raw);
+        for(int i = 0; i < Vector_Size(tokens); i++) {
+            char *token;
+            Vector_Get(tokens, i, &token);
+
+            /* Prefix applies only to the last token. */
+            _FullTextTermKind token_kind = kind;
+            if(kind == FT_TERM_PREFIX && i < Vector_Size(tokens) - 1) token_kind = FT_TERM_EXACT;
+
+            while(Vector_Size(postings) > 0) Vector_Pop(postings, NULL);
+            _FullTextIndex_ExpandTerm(idx, token, token_kind, max_dist, postings);
+
+            for(int j = 0; j < Vector_Size(postings); j++) {
+                rax *posting_list;
+                Vector_Get(postings, j, &posting_list);
+                double idf = log(1.0 + (double)idx->doc_count / (double)raxSize(posting_list));
+
+                raxIterator it;
+                raxStart(&it, posting_list);
+                raxSeek(&it, "^", NULL, 0);
+                while(raxNext(&it)) {
+                    FullTextPosting *posting = it.data;
+                    _FullTextMatch *match = raxFind(matches, it.key, it.key_len);
+                    if(match == raxNotFound) {
+                        /* All terms must match, only the first term introduces candidates. */
+                        if(term_count > 0) continue;
+                        match = calloc(1, sizeof(_FullTextMatch));
+                        match->entity = posting->entity;
+                        match->last_term = -1;
+                        raxInsert(matches, it.key, it.key_len, match, NULL);
+                    }
+                    match->score += posting->freq * idf;
+                    if(match->last_term != term_count) {
+                        match->last_term = term_count;
+                        match->terms_matched++;
+                    }
+                }
+                raxStop(&it);
+            }
+
+            free(token);
+            term_count++;
+        }
+        Vector_Free(tokens);
+    }
+    free(q);
+    Vector_Free(postings);
+
+    /* Collect entities which matched every term. */
+    if(term_count > 0 && raxSize(matches) > 0) {
+        *results = malloc(sizeof(FullTextResult) * raxSize(matches));
+    }
+
+    raxIterator it;
+    raxStart(&it, matches);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) {
+        _FullTextMatch *match = it.data;
+        if(match->terms_matched == term_count) {
+            (*results)[result_count].entity = match->entity;
+            (*results)[result_count].score = match->score;
+            result_count++;
+        }
+        free(match);
+    }
+    raxStop(&it);
+    raxFree(matches);
+
+    if(result_count > 1) {
+        qsort(*results, result_count, sizeof(FullTextResult), _FullTextResult_Compare);
+    }
+
+    return result_count;
+}
+
+void FullTextIndex_Free(FullTextIndex *idx) {
+    raxIterator it;
+    raxStart(&it, idx->terms);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) {
+        rax *postings = it.data;
+        raxIterator posting_it;
+        raxStart(&posting_it, postings);
+        raxSeek(&posting_it, "^", NULL, 0);
+        while(raxNext(&posting_it)) free(posting_it.data);
+        raxStop(&posting_it);
+        raxFree(postings);
+    }
+    raxStop(&it);
+
+    raxFree(idx->terms);
+    free(idx->property);
+    free(idx);
+}
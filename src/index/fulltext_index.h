@@ -0,0 +1,60 @@
+#ifndef __FULLTEXT_INDEX_H__
+#define __FULLTEXT_INDEX_H__
+
+#include "../graph/graph_entity.h"
+#include "../dep/rax/rax.h"
+#include "../rmutil/vector.h"
+
+#define FULLTEXT_MAX_TERM_LEN 64            /* Longer terms are truncated. */
+#define FULLTEXT_MAX_EXPANSIONS 256         /* Max number of terms a single prefix/fuzzy term expands to. */
+#define FULLTEXT_MAX_FUZZY_DISTANCE 2       /* Max edit distance allowed for fuzzy terms. */
+
+/* An entry within a term's posting list. */
+typedef struct {
+    GraphEntity *entity;    /* Entity containing term. */
+    uint32_t freq;          /* Number of times term appears within entity's text. */
+} FullTextPosting;
+
+/* Inverted index over a single string property of a label,
+ * maps each term to a posting list, which is a rax keyed by entity id. */
+typedef struct {
+    char *property;         /* Indexed property. */
+    rax *terms;             /* term -> posting list. */
+    size_t doc_count;       /* Number of indexed entities. */
+} FullTextIndex;
+
+/* A single query match. */
+typedef struct {
+    GraphEntity *entity;
+    double score;           /* Relevance score, TF-IDF. */
+} FullTextResult;
+
+/* Creates a new empty full-text index over property. */
+FullTextIndex* NewFullTextIndex(const char *property);
+
+/* Breaks text into lowercased alphanumeric terms,
+ * returns a vector of heap allocated strings. */
+Vector* FullText_Tokenize(const char *text);
+
+/* Indexes entity's property text, entities missing the
+ * property or holding a none string value are ignored. */
+void FullTextIndex_Insert(FullTextIndex *idx, GraphEntity *entity);
+
+/* Removes entity from index, must be called before
+ * entity's indexed property is modified. */
+void FullTextIndex_Remove(FullTextIndex *idx, GraphEntity *entity);
+
+/* Searches index, query is a list of whitespace separated terms
+ * all of which must match, a term can be:
+ * term     - exact match.
+ * term*    - prefix match, expands to every indexed term starting with term.
+ * %term%   - fuzzy match, expands to terms within edit distance 1,
+ *            %%term%% allows an edit distance of 2.
+ * Sets results to an array of matches sorted by descending score,
+ * returns number of matches, caller is responsible for freeing results. */
+size_t FullTextIndex_Query(FullTextIndex *idx, const char *query, FullTextResult **results);
+
+/* Free index. */
+void FullTextIndex_Free(FullTextIndex *idx);
+
+#endif
@@ -0,0 +1,203 @@
+#include "geo_index.h"
+#include <math.h>
+#include <string.h>
+
+#define GEO_LAT_MIN -90.0
+#define GEO_LAT_MAX 90.0
+#define GEO_LON_MIN -180.0
+#define GEO_LON_MAX 180.0
+#define GEO_KEY_LEN 16      /* Geohash followed by entity id, both big endian. */
+
+static inline double _deg_to_rad(double d) { return d * M_PI / 180.0; }
+static inline double _rad_to_deg(double r) { return r * 180.0 / M_PI; }
+
+double Geo_Distance(double lat1, double lon1, double lat2, double lon2) {
+    double lat1r = _deg_to_rad(lat1);
+    double lat2r = _deg_to_rad(lat2);
+    double u = sin((lat2r - lat1r) / 2);
+    double v = sin(_deg_to_rad(lon2 - lon1) / 2);
+    return 2.0 * GEO_EARTH_RADIUS_METERS * asin(sqrt(u * u + cos(lat1r) * cos(lat2r) * v * v));
+}
+
+GeoBoundingBox Geo_RadiusBoundingBox(double lat, double lon, double radius) {
+    GeoBoundingBox box;
+    double dlat = _rad_to_deg(radius / GEO_EARTH_RADIUS_METERS);
+    box.min_lat = fmax(lat - dlat, GEO_LAT_MIN);
+    box.max_lat = fmin(lat + dlat, GEO_LAT_MAX);
+
+    /* Longitude degrees shrink towards the poles,
+     * use the box's latitude closest to a pole. */
+    double max_abs_lat = fmax(fabs(box.min_lat), fabs(box.max_lat));
+    double cos_lat = cos(_deg_to_rad(max_abs_lat));
+    double dlon = (cos_lat > 1e-9) ? _rad_to_deg(radius / (GEO_EARTH_RADIUS_METERS * cos_lat)) : 360;
+    box.min_lon = lon - dlon;
+    box.max_lon = lon + dlon;
+
+    /* Box crosses the antimeridian or a pole, scan every longitude. */
+    if(box.min_lon < GEO_LON_MIN || box.max_lon > GEO_LON_MAX ||
+       box.max_lat == GEO_LAT_MAX || box.min_lat == GEO_LAT_MIN) {
+        box.min_lon = GEO_LON_MIN;
+        box.max_lon = GEO_LON_MAX;
+    }
+    return box;
+}
+
+/* Maps coordinate to a cell index at given step. */
+static inline uint32_t _Geo_Cell(double v, double min, double max, int step) {
+    double cells = (double)((uint64_t)1 << step);
+    double offset = (v - min) / (max - min) * cells;
+    if(offset < 0) return 0;
+    if(offset >= cells) return (uint32_t)(cells - 1);
+    return (uint32_t)offset;
+}
+
+/* Interleaves step bits of lat and lon cells, lon occupies odd bits. */
+static uint64_t _Geo_Interleave(uint32_t lat, uint32_t lon, int step) {
+    uint64_t hash = 0;
+    for(int i = step - 1; i >= 0; i--) {
+        hash = (hash << 1) | ((lon >> i) & 1);
+        hash = (hash << 1) | ((lat >> i) & 1);
+    }
+    return hash;
+}
+
+static inline void _Geo_EncodeUint64(uint64_t v, unsigned char *buf) {
+    for(int i = 7; i >= 0; i--) {
+        buf[i] = v & 0xFF;
+        v >>= 8;
+    }
+}
+
+static inline uint64_t _Geo_DecodeUint64(const unsigned char *buf) {
+    uint64_t v = 0;
+    for(int i = 0; i < 8; i++) v = (v << 8) | buf[i];
+    return v;
+}
+
+/* Extracts entity's location, returns 0 if entity can't be indexed. */
+static int _GeoIndex_Location(const GeoIndex *idx, GraphEntity *entity, double *lat, double *lon) {
+    SIValue *lat_val = GraphEntity_Get_Property(entity, idx->lat_property);
+    SIValue *lon_val = GraphEntity_Get_Property(entity, idx->lon_property);
+    if(lat_val == PROPERTY_NOTFOUND || lon_val == PROPERTY_NOTFOUND) return 0;
+    if(!(lat_val->type & SI_NUMERIC) || !(lon_val->type & SI_NUMERIC)) return 0;
+
+    SIValue_ToDouble(lat_val, lat);
+    SIValue_ToDouble(lon_val, lon);
+    return (*lat >= GEO_LAT_MIN && *lat <= GEO_LAT_MAX &&
+            *lon >= GEO_LON_MIN && *lon <= GEO_LON_MAX);
+}
+
+static int _GeoIndex_EntityKey(const GeoIndex *idx, GraphEntity *entity, unsigned char *key) {
+    double lat, lon;
+    if(!_GeoIndex_Location(idx, entity, &lat, &lon)) return 0;
+
+    uint64_t hash = _Geo_Interleave(_Geo_Cell(lat, GEO_LAT_MIN, GEO_LAT_MAX, GEO_STEP_MAX),
+                                    _Geo_Cell(lon, GEO_LON_MIN, GEO_LON_MAX, GEO_STEP_MAX),
+                                    GEO_STEP_MAX);
+    _Geo_EncodeUint64(hash, key);
+    _Geo_EncodeUint64((uint64_t)entity->id, key + 8);
+    return 1;
+}
+
+GeoIndex* NewGeoIndex(const char *lat_property, const char *lon_property) {
+    GeoIndex *idx = malloc(sizeof(GeoIndex));
+    idx->lat_property = strdup(lat_property);
+    idx->lon_property = strdup(lon_property);
+    idx->entities = raxNew();
+    return idx;
+}
+
+void GeoIndex_Insert(GeoIndex *idx, GraphEntity *entity) {
+    unsigned char key[GEO_KEY_LEN];
+    if(!_GeoIndex_EntityKey(idx, entity, key)) return;
+    raxInsert(idx->entities, key, GEO_KEY_LEN, entity, NULL);
+}
+
+void GeoIndex_Remove(GeoIndex *idx, GraphEntity *entity) {
+    unsigned char key[GEO_KEY_LEN];
+    if(!_GeoIndex_EntityKey(idx, entity, key)) return;
+    raxRemove(idx->entities, key, GEO_KEY_LEN, NULL);
+}
+
+/* Seeks to the beginning of the current cell. */
+static void _GeoIndexIterator_SeekCell(GeoIndexIterator *iter) {
+    unsigned char key[8];
+    _Geo_EncodeUint64(iter->cells_start[iter->cell], key);
+    raxSeek(&iter->it, ">=", key, 8);
+}
+
+void GeoIndex_Scan(GeoIndex *idx, GeoBoundingBox box, GeoIndexIterator *iter) {
+    iter->idx = idx;
+    iter->box = box;
+    iter->cell = 0;
+    iter->cell_count = 0;
+    raxStart(&iter->it, idx->entities);
+
+    /* Empty box, e.g. contradicting bounds. */
+    if(box.min_lat > box.max_lat || box.min_lon > box.max_lon) return;
+
+    /* Find the finest step at which the box is covered by a few cells. */
+    int step = GEO_STEP_MAX;
+    uint32_t lat_from, lat_to, lon_from, lon_to;
+    for(; step > 0; step--) {
+        lat_from = _Geo_Cell(box.min_lat, GEO_LAT_MIN, GEO_LAT_MAX, step);
+        lat_to = _Geo_Cell(box.max_lat, GEO_LAT_MIN, GEO_LAT_MAX, step);
+        lon_from = _Geo_Cell(box.min_lon, GEO_LON_MIN, GEO_LON_MAX, step);
+        lon_to = _Geo_Cell(box.max_lon, GEO_LON_MIN, GEO_LON_MAX, step);
+        if((uint64_t)(lat_to - lat_from + 1) * (lon_to - lon_from + 1) <= GEO_MAX_CELLS) break;
+    }
+
+    if(step == 0) {
+        /* Box spans the entire world, single cell. */
+        iter->cells_start[0] = 0;
+        iter->cells_end[0] = (uint64_t)1 << (2 * GEO_STEP_MAX);
+        iter->cell_count = 1;
+    } else {
+        /* Each cell is a contiguous range of full precision geohashes. */
+        int shift = 2 * (GEO_STEP_MAX - step);
+        for(uint32_t lat = lat_from; lat <= lat_to; lat++) {
+            for(uint32_t lon = lon_from; lon <= lon_to; lon++) {
+                uint64_t cell = _Geo_Interleave(lat, lon, step);
+                iter->cells_start[iter->cell_count] = cell << shift;
+                iter->cells_end[iter->cell_count] = (cell + 1) << shift;
+                iter->cell_count++;
+            }
+        }
+    }
+
+    _GeoIndexIterator_SeekCell(iter);
+}
+
+GraphEntity* GeoIndexIterator_Next(GeoIndexIterator *iter) {
+    while(iter->cell < iter->cell_count) {
+        if(!raxNext(&iter->it) ||
+           _Geo_DecodeUint64(iter->it.key) >= iter->cells_end[iter->cell]) {
+            /* Move to next cell. */
+            iter->cell++;
+            if(iter->cell < iter->cell_count) _GeoIndexIterator_SeekCell(iter);
+            continue;
+        }
+
+        /* Cells may extend beyond the box, check exact location. */
+        GraphEntity *entity = iter->it.data;
+        double lat, lon;
+        _GeoIndex_Location(iter->idx, entity, &lat, &lon);
+        if(lat >= iter->box.min_lat && lat <= iter->box.max_lat &&
+           lon >= iter->box.min_lon && lon <= iter->box.max_lon) {
+            return entity;
+        }
+    }
+
+    return NULL;
+}
+
+void GeoIndexIterator_Free(GeoIndexIterator *iter) {
+    raxStop(&iter->it);
+}
+
+void GeoIndex_Free(GeoIndex *idx) {
+    free(idx->lat_property);
+    free(idx->lon_property);
+    raxFree(idx->entities);
+    free(idx);
+}
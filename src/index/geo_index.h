@@ -0,0 +1,69 @@
+#ifndef __GEO_INDEX_H__
+#define __GEO_INDEX_H__
+
+#include "../graph/graph_entity.h"
+#include "../dep/rax/rax.h"
+
+#define GEO_STEP_MAX 26                         /* Bits per coordinate, 52 bits geohash. */
+#define GEO_EARTH_RADIUS_METERS 6372797.560856  /* Same as Redis GEO commands. */
+#define GEO_MAX_CELLS 16                        /* Max number of cells a single scan covers. */
+
+/* Geographic bounding box, in degrees. */
+typedef struct {
+    double min_lat;
+    double min_lon;
+    double max_lat;
+    double max_lon;
+} GeoBoundingBox;
+
+/* Geospatial index over a pair of latitude, longitude properties,
+ * entities are kept in a rax keyed by the interleaved geohash of their
+ * location followed by their id, nearby locations share key prefixes. */
+typedef struct {
+    char *lat_property;     /* Latitude property. */
+    char *lon_property;     /* Longitude property. */
+    rax *entities;          /* Geohash + entity id -> entity. */
+} GeoIndex;
+
+/* Iterates over entities within a bounding box,
+ * scanning each geohash cell covering the box. */
+typedef struct {
+    GeoIndex *idx;
+    raxIterator it;
+    GeoBoundingBox box;
+    uint64_t cells_start[GEO_MAX_CELLS];    /* First geohash of each cell. */
+    uint64_t cells_end[GEO_MAX_CELLS];      /* Geohash following each cell's last geohash. */
+    int cell_count;
+    int cell;                               /* Cell currently scanned. */
+} GeoIndexIterator;
+
+/* Great-circle distance between two points, in meters. */
+double Geo_Distance(double lat1, double lon1, double lat2, double lon2);
+
+/* Bounding box containing every point within radius meters of lat, lon. */
+GeoBoundingBox Geo_RadiusBoundingBox(double lat, double lon, double radius);
+
+/* Creates a new empty geospatial index. */
+GeoIndex* NewGeoIndex(const char *lat_property, const char *lon_property);
+
+/* Indexes entity, entities missing either property,
+ * or holding none numeric or out of range coordinates are ignored. */
+void GeoIndex_Insert(GeoIndex *idx, GraphEntity *entity);
+
+/* Removes entity from index, must be called before
+ * entity's indexed properties are modified. */
+void GeoIndex_Remove(GeoIndex *idx, GraphEntity *entity);
+
+/* Scans entities located within box. */
+void GeoIndex_Scan(GeoIndex *idx, GeoBoundingBox box, GeoIndexIterator *iter);
+
+/* Returns next entity within box, NULL once iterator is depleted. */
+GraphEntity* GeoIndexIterator_Next(GeoIndexIterator *iter);
+
+/* Free iterator. */
+void GeoIndexIterator_Free(GeoIndexIterator *iter);
+
+/* Free index. */
+void GeoIndex_Free(GeoIndex *idx);
+
+#endif
@@ -0,0 +1,374 @@
+#include "index.h"
+#include "index_builder.h"
+#include "../graph/edge.h"
+#include "../util/key_encoding.h"
+#include <string.h>
+#include <assert.h>
+
+#define INDEX_TAG_NUMERIC 0x01
+#define INDEX_TAG_STRING 0x02
+#define INDEX_ID_LEN KEY_ENCODING_UINT64_LEN
+
+Index* NewIndex(const char *property) {
+    Index *idx = malloc(sizeof(Index));
+    idx->property = strdup(property);
+    idx->entities = raxNew();
+    idx->by_source = NULL;
+    idx->state = INDEX_STATE_READY;
+    idx->build_total = 0;
+    idx->build_done = 0;
+    idx->side_log = NULL;
+    idx->cancelled = 0;
+    return idx;
+}
+
+Index* NewEdgeIndex(const char *property) {
+    Index *idx = NewIndex(property);
+    idx->by_source = raxNew();
+    return idx;
+}
+
+/* Encodes value such that encoded values compare bytewise
+ * in the same order as the original values,
+ * returns encoded length or 0 if value can't be indexed,
+ * buf must be able to hold 1 + strlen + 1 bytes for strings and 9 for numbers. */
+static size_t _Index_EncodeValue(const SIValue *v, unsigned char *buf) {
+    if(v->type == T_STRING) {
+        size_t len = strlen(v->stringval);
+        buf[0] = INDEX_TAG_STRING;
+        memcpy(buf + 1, v->stringval, len);
+        /* Terminate, shorter strings precede their extensions. */
+        buf[len + 1] = 0;
+        return len + 2;
+    }
+
+    if(v->type & SI_NUMERIC) {
+        double d;
+        SIValue_ToDouble((SIValue *)v, &d);
+        if(d == 0) d = 0;   /* Normalize -0. */
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        /* Flip negatives entirely, set sign bit for positives. */
+        bits = (bits & ((uint64_t)1 << 63)) ? ~bits : bits | ((uint64_t)1 << 63);
+        buf[0] = INDEX_TAG_NUMERIC;
+        KeyEncoding_Uint64(bits, buf + 1);
+        return 1 + INDEX_ID_LEN;
+    }
+
+    return 0;
+}
+
+static inline size_t _Index_ValueMaxLen(const SIValue *v) {
+    return (v->type == T_STRING) ? strlen(v->stringval) + 2 : 1 + INDEX_ID_LEN;
+}
+
+/* Builds entity's key, prefixed by scope_len bytes of scope,
+ * returns NULL if entity can't be indexed. */
+static unsigned char* _Index_EntityKey(const Index *idx, const GraphEntity *entity,
+                                       const unsigned char *scope, size_t scope_len, size_t *key_len) {
+    SIValue *v = GraphEntity_Get_Property((GraphEntity *)entity, idx->property);
+    if(v == PROPERTY_NOTFOUND) return NULL;
+
+    unsigned char *key = malloc(scope_len + _Index_ValueMaxLen(v) + INDEX_ID_LEN);
+    memcpy(key, scope, scope_len);
+    size_t len = _Index_EncodeValue(v, key + scope_len);
+    if(len == 0) {
+        free(key);
+        return NULL;
+    }
+
+    len += scope_len;
+    KeyEncoding_Uint64((uint64_t)entity->id, key + len);
+    *key_len = len + INDEX_ID_LEN;
+    return key;
+}
+
+int Index_EntityEntry(const Index *idx, GraphEntity *entity, int remove, IndexEntry *entry) {
+    entry->entity = entity;
+    entry->remove = remove;
+    entry->source_key = NULL;
+    entry->source_key_len = 0;
+    entry->key = _Index_EntityKey(idx, entity, (const unsigned char *)"", 0, &entry->key_len);
+    if(entry->key == NULL) return 0;
+
+    /* Edges detached from their source node were already unindexed. */
+    if(idx->by_source && ((Edge*)entity)->src) {
+        unsigned char scope[INDEX_ID_LEN];
+        KeyEncoding_Uint64((uint64_t)((Edge*)entity)->src->id, scope);
+        entry->source_key = _Index_EntityKey(idx, entity, scope, INDEX_ID_LEN, &entry->source_key_len);
+    }
+    return 1;
+}
+
+void Index_ApplyEntry(Index *idx, const IndexEntry *entry) {
+    if(entry->remove) {
+        raxRemove(idx->entities, entry->key, entry->key_len, NULL);
+        if(entry->source_key) raxRemove(idx->by_source, entry->source_key, entry->source_key_len, NULL);
+    } else {
+        raxInsert(idx->entities, entry->key, entry->key_len, entry->entity, NULL);
+        if(entry->source_key) raxInsert(idx->by_source, entry->source_key, entry->source_key_len, entry->entity, NULL);
+    }
+}
+
+void IndexEntry_Free(IndexEntry *entry) {
+    free(entry->key);
+    if(entry->source_key) free(entry->source_key);
+}
+
+/* Applies write or records it in the side log while building,
+ * builder completes the index under the write lock, state and side log are read under it too. */
+static void _Index_Write(Index *idx, GraphEntity *entity, int remove) {
+    IndexEntry entry;
+    IndexBuilder_AcquireWriteLock();
+    if(!Index_EntityEntry(idx, entity, remove, &entry)) {
+        IndexBuilder_ReleaseWriteLock();
+        return;
+    }
+
+    if(idx->state == INDEX_STATE_BUILDING) {
+        IndexEntry *logged = malloc(sizeof(IndexEntry));
+        *logged = entry;
+        Vector_Push(idx->side_log, logged);
+        IndexBuilder_ReleaseWriteLock();
+        return;
+    }
+
+    Index_ApplyEntry(idx, &entry);
+    IndexBuilder_ReleaseWriteLock();
+    IndexEntry_Free(&entry);
+}
+
+void Index_Insert(Index *idx, GraphEntity *entity) {
+    _Index_Write(idx, entity, 0);
+}
+
+void Index_Remove(Index *idx, GraphEntity *entity) {
+    _Index_Write(idx, entity, 1);
+}
+
+void Index_BeginBuild(Index *idx, size_t total) {
+    idx->state = INDEX_STATE_BUILDING;
+    idx->build_total = total;
+    idx->build_done = 0;
+    idx->side_log = NewVector(IndexEntry*, 0);
+}
+
+void Index_Complete(Index *idx) {
+    /* Replay writes in order, later writes override earlier ones. */
+    for(int i = 0; i < Vector_Size(idx->side_log); i++) {
+        IndexEntry *entry;
+        Vector_Get(idx->side_log, i, &entry);
+        Index_ApplyEntry(idx, entry);
+        IndexEntry_Free(entry);
+        free(entry);
+    }
+    Vector_Free(idx->side_log);
+    idx->side_log = NULL;
+
+    /* Queries planned on other threads observe state. */
+    __atomic_store_n(&idx->state, INDEX_STATE_READY, __ATOMIC_RELEASE);
+}
+
+int Index_IsReady(const Index *idx) {
+    return __atomic_load_n(&idx->state, __ATOMIC_ACQUIRE) == INDEX_STATE_READY;
+}
+
+size_t Index_Cardinality(const Index *idx) {
+    return raxSize(idx->entities);
+}
+
+int Index_ContainsStrings(const Index *idx) {
+    unsigned char tag = INDEX_TAG_STRING;
+    raxIterator it;
+    raxStart(&it, idx->entities);
+    raxSeek(&it, ">=", &tag, 1);
+    int found = raxNext(&it);
+    raxStop(&it);
+    return found;
+}
+
+static void _IndexIterator_Init(rax *entries, IndexIterator *iter) {
+    raxStart(&iter->it, entries);
+    iter->prefix = NULL;
+    iter->prefix_len = 0;
+    iter->min = NULL;
+    iter->min_len = 0;
+    iter->min_inclusive = 0;
+    iter->max = NULL;
+    iter->max_len = 0;
+    iter->max_inclusive = 0;
+    iter->reverse = 0;
+    iter->depleted = 0;
+}
+
+void Index_ScanPrefix(Index *idx, const char *prefix, IndexIterator *iter) {
+    _IndexIterator_Init(idx->entities, iter);
+
+    size_t len = strlen(prefix);
+    iter->prefix_len = len + 1;
+    iter->prefix = malloc(iter->prefix_len);
+    iter->prefix[0] = INDEX_TAG_STRING;
+    memcpy(iter->prefix + 1, prefix, len);
+
+    raxSeek(&iter->it, ">=", iter->prefix, iter->prefix_len);
+}
+
+/* Encodes scope followed by value into a newly allocated buffer with
+ * INDEX_ID_LEN spare bytes, sets len to 0 if value can't be indexed. */
+static unsigned char* _Index_EncodeBound(const unsigned char *scope, size_t scope_len,
+                                         const SIValue *value, size_t *len) {
+    unsigned char *bound = malloc(scope_len + _Index_ValueMaxLen(value) + INDEX_ID_LEN);
+    memcpy(bound, scope, scope_len);
+    size_t value_len = _Index_EncodeValue(value, bound + scope_len);
+    *len = (value_len == 0) ? 0 : scope_len + value_len;
+    return bound;
+}
+
+/* Scans range within entries, every key is expected to start with scope. */
+static void _Index_ScanRange(rax *entries, const unsigned char *scope, size_t scope_len,
+                             const SIValue *min, int min_inclusive,
+                             const SIValue *max, int max_inclusive, int reverse,
+                             IndexIterator *iter) {
+    _IndexIterator_Init(entries, iter);
+    iter->reverse = reverse;
+
+    /* Restrict scan to scope and bounds' type, unbounded scans cover numeric values. */
+    iter->prefix_len = scope_len + 1;
+    iter->prefix = malloc(iter->prefix_len);
+    memcpy(iter->prefix, scope, scope_len);
+    iter->prefix[scope_len] = INDEX_TAG_NUMERIC;
+
+    if(min) {
+        iter->min = _Index_EncodeBound(scope, scope_len, min, &iter->min_len);
+        iter->min_inclusive = min_inclusive;
+        /* Can't be indexed, nothing to scan. */
+        if(iter->min_len == 0) {
+            iter->depleted = 1;
+            return;
+        }
+        iter->prefix[scope_len] = iter->min[scope_len];
+    }
+
+    if(max) {
+        iter->max = _Index_EncodeBound(scope, scope_len, max, &iter->max_len);
+        iter->max_inclusive = max_inclusive;
+        if(iter->max_len == 0) {
+            iter->depleted = 1;
+            return;
+        }
+        /* Bounds of different types. */
+        if(min && iter->max[scope_len] != iter->prefix[scope_len]) {
+            iter->depleted = 1;
+            return;
+        }
+        iter->prefix[scope_len] = iter->max[scope_len];
+    }
+
+    if(!reverse) {
+        if(min == NULL) {
+            raxSeek(&iter->it, ">=", iter->prefix, iter->prefix_len);
+        } else if(min_inclusive) {
+            raxSeek(&iter->it, ">=", iter->min, iter->min_len);
+        } else {
+            /* Skip every entity holding min. */
+            memset(iter->min + iter->min_len, 0xFF, INDEX_ID_LEN);
+            raxSeek(&iter->it, ">", iter->min, iter->min_len + INDEX_ID_LEN);
+        }
+        return;
+    }
+
+    if(max == NULL) {
+        /* Start right before the first key past prefix. */
+        iter->prefix[scope_len]++;
+        raxSeek(&iter->it, "<", iter->prefix, iter->prefix_len);
+        iter->prefix[scope_len]--;
+    } else if(max_inclusive) {
+        memset(iter->max + iter->max_len, 0xFF, INDEX_ID_LEN);
+        raxSeek(&iter->it, "<=", iter->max, iter->max_len + INDEX_ID_LEN);
+    } else {
+        /* Keys of entities holding max extend it, skipping all of them. */
+        raxSeek(&iter->it, "<", iter->max, iter->max_len);
+    }
+}
+
+void Index_ScanRange(Index *idx, const SIValue *min, int min_inclusive,
+                     const SIValue *max, int max_inclusive, IndexIterator *iter) {
+    _Index_ScanRange(idx->entities, (const unsigned char *)"", 0,
+                     min, min_inclusive, max, max_inclusive, 0, iter);
+}
+
+void Index_ScanRangeReverse(Index *idx, const SIValue *min, int min_inclusive,
+                            const SIValue *max, int max_inclusive, IndexIterator *iter) {
+    _Index_ScanRange(idx->entities, (const unsigned char *)"", 0,
+                     min, min_inclusive, max, max_inclusive, 1, iter);
+}
+
+void Index_ScanSourceRange(Index *idx, long int src_id, const SIValue *min, int min_inclusive,
+                           const SIValue *max, int max_inclusive, IndexIterator *iter) {
+    assert(idx->by_source);
+    unsigned char scope[INDEX_ID_LEN];
+    KeyEncoding_Uint64((uint64_t)src_id, scope);
+    _Index_ScanRange(idx->by_source, scope, INDEX_ID_LEN, min, min_inclusive, max, max_inclusive, 0, iter);
+}
+
+/* Compares value portion of current key against an encoded bound. */
+static int _IndexIterator_CompareValue(const IndexIterator *iter, const unsigned char *bound, size_t bound_len) {
+    size_t value_len = iter->it.key_len - INDEX_ID_LEN;
+    size_t len = (value_len < bound_len) ? value_len : bound_len;
+    int cmp = memcmp(iter->it.key, bound, len);
+    if(cmp == 0) cmp = (value_len > bound_len) - (value_len < bound_len);
+    return cmp;
+}
+
+GraphEntity* IndexIterator_Next(IndexIterator *iter) {
+    if(iter->depleted) return NULL;
+
+    int more = (iter->reverse) ? raxPrev(&iter->it) : raxNext(&iter->it);
+    if(!more ||
+       iter->it.key_len < iter->prefix_len ||
+       memcmp(iter->it.key, iter->prefix, iter->prefix_len) != 0) {
+        iter->depleted = 1;
+        return NULL;
+    }
+
+    /* Range start is located by seeking, only the end of the range is checked. */
+    if(!iter->reverse && iter->max) {
+        int cmp = _IndexIterator_CompareValue(iter, iter->max, iter->max_len);
+        if(cmp > 0 || (cmp == 0 && !iter->max_inclusive)) {
+            iter->depleted = 1;
+            return NULL;
+        }
+    }
+
+    if(iter->reverse && iter->min) {
+        int cmp = _IndexIterator_CompareValue(iter, iter->min, iter->min_len);
+        if(cmp < 0 || (cmp == 0 && !iter->min_inclusive)) {
+            iter->depleted = 1;
+            return NULL;
+        }
+    }
+
+    return iter->it.data;
+}
+
+void IndexIterator_Free(IndexIterator *iter) {
+    raxStop(&iter->it);
+    if(iter->prefix) free(iter->prefix);
+    if(iter->min) free(iter->min);
+    if(iter->max) free(iter->max);
+    iter->prefix = NULL;
+    iter->min = NULL;
+    iter->max = NULL;
+}
+
+void Index_Free(Index *idx) {
+    if(idx->state == INDEX_STATE_BUILDING) {
+        idx->cancelled = 1;
+        return;
+    }
+
+    free(idx->property);
+    raxFree(idx->entities);
+    if(idx->by_source) raxFree(idx->by_source);
+    free(idx);
+}
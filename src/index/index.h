@@ -0,0 +1,133 @@
+#ifndef __INDEX_H__
+#define __INDEX_H__
+
+#include "../graph/graph_entity.h"
+#include "../dep/rax/rax.h"
+#include "../rmutil/vector.h"
+
+/* Kinds of property indices. */
+typedef enum {
+    INDEX_ORDERED,      /* Ordered index, serves equality, range and prefix lookups. */
+    INDEX_FULLTEXT,     /* Full-text inverted index. */
+    INDEX_GEO,          /* Geospatial index over a latitude, longitude pair. */
+} IndexType;
+
+/* Index lifecycle, indices built in the background
+ * can't serve queries until they're complete. */
+typedef enum {
+    INDEX_STATE_BUILDING,   /* Being populated, writes are recorded in the side log. */
+    INDEX_STATE_READY,      /* Complete, kept up to date by writers. */
+} IndexState;
+
+/* Ordered index over a single property of a label,
+ * entities are kept in a rax keyed by their encoded property value
+ * followed by their id, keys encoding preserves value order:
+ * numbers are ordered numerically and placed before strings,
+ * strings are ordered bytewise (case sensitive). */
+typedef struct {
+    char *property;         /* Indexed property. */
+    rax *entities;          /* Encoded value + entity id -> entity. */
+    rax *by_source;         /* Edge indices only, source node id + encoded value + edge id -> edge. */
+    IndexState state;
+    size_t build_total;     /* Number of entities to index when build started. */
+    size_t build_done;      /* Number of entities indexed so far. */
+    Vector *side_log;       /* IndexEntry*, writes performed while building. */
+    int cancelled;          /* Index was freed while building, builder is responsible for freeing it. */
+} Index;
+
+/* Keys an entity is indexed under, captured at a point in time
+ * such that they can be applied to the index later on. */
+typedef struct {
+    GraphEntity *entity;
+    unsigned char *key;         /* Global ordering key. */
+    size_t key_len;
+    unsigned char *source_key;  /* Per source node ordering key, edge indices only. */
+    size_t source_key_len;
+    int remove;                 /* Entry should be removed rather than inserted. */
+} IndexEntry;
+
+/* Iterates over a range of index entries. */
+typedef struct {
+    raxIterator it;
+    unsigned char *prefix;  /* Every visited key must start with prefix. */
+    size_t prefix_len;
+    unsigned char *min;     /* Encoded lower bound value, NULL if unbounded. */
+    size_t min_len;
+    int min_inclusive;
+    unsigned char *max;     /* Encoded upper bound value, NULL if unbounded. */
+    size_t max_len;
+    int max_inclusive;
+    int reverse;            /* Visit entities in descending order. */
+    int depleted;
+} IndexIterator;
+
+/* Creates a new empty index over property. */
+Index* NewIndex(const char *property);
+
+/* Creates a new empty index over an edge property, in addition to the global
+ * ordering edges are ordered per source node, see Index_ScanSourceRange. */
+Index* NewEdgeIndex(const char *property);
+
+/* Indexes entity, entities missing the property or holding
+ * a value of none indexable type (numeric or string) are ignored,
+ * while building, insertion is recorded in the side log. */
+void Index_Insert(Index *idx, GraphEntity *entity);
+
+/* Removes entity from index, must be called before
+ * entity's indexed property is modified,
+ * while building, removal is recorded in the side log. */
+void Index_Remove(Index *idx, GraphEntity *entity);
+
+/* Captures entity's current keys into entry,
+ * returns 0 if entity can't be indexed. */
+int Index_EntityEntry(const Index *idx, GraphEntity *entity, int remove, IndexEntry *entry);
+
+/* Inserts or removes entry's keys. */
+void Index_ApplyEntry(Index *idx, const IndexEntry *entry);
+
+/* Free entry's keys. */
+void IndexEntry_Free(IndexEntry *entry);
+
+/* Marks index as being built, writes are logged until Index_Complete is called. */
+void Index_BeginBuild(Index *idx, size_t total);
+
+/* Replays side log and marks index as ready. */
+void Index_Complete(Index *idx);
+
+/* Returns 1 if index is complete and can serve queries. */
+int Index_IsReady(const Index *idx);
+
+/* Number of indexed entities. */
+size_t Index_Cardinality(const Index *idx);
+
+/* Scans entities whose string value starts with prefix. */
+void Index_ScanPrefix(Index *idx, const char *prefix, IndexIterator *iter);
+
+/* Returns 1 if any of the indexed values is a string. */
+int Index_ContainsStrings(const Index *idx);
+
+/* Scans entities whose value is within range,
+ * a NULL bound is unbounded, both bounds must be either numeric or strings,
+ * when both bounds are NULL every numeric value is scanned. */
+void Index_ScanRange(Index *idx, const SIValue *min, int min_inclusive,
+                     const SIValue *max, int max_inclusive, IndexIterator *iter);
+
+/* Same as Index_ScanRange, visiting entities in descending order. */
+void Index_ScanRangeReverse(Index *idx, const SIValue *min, int min_inclusive,
+                            const SIValue *max, int max_inclusive, IndexIterator *iter);
+
+/* Same as Index_ScanRange, restricted to edges leaving source node,
+ * index must be an edge index. */
+void Index_ScanSourceRange(Index *idx, long int src_id, const SIValue *min, int min_inclusive,
+                           const SIValue *max, int max_inclusive, IndexIterator *iter);
+
+/* Returns next entity in range, NULL once iterator is depleted. */
+GraphEntity* IndexIterator_Next(IndexIterator *iter);
+
+/* Free iterator. */
+void IndexIterator_Free(IndexIterator *iter);
+
+/* Free index, an index being built is freed by its builder. */
+void Index_Free(Index *idx);
+
+#endif
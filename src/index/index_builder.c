@@ -0,0 +1,139 @@
+#include "index_builder.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+static pthread_mutex_t _write_lock;
+static pthread_once_t _write_lock_once = PTHREAD_ONCE_INIT;
+
+typedef struct {
+    Index *idx;
+    rax *entities;
+} IndexBuildTask;
+
+static void _IndexBuilder_InitLock() {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&_write_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void IndexBuilder_AcquireWriteLock() {
+    pthread_once(&_write_lock_once, _IndexBuilder_InitLock);
+    pthread_mutex_lock(&_write_lock);
+}
+
+void IndexBuilder_ReleaseWriteLock() {
+    pthread_mutex_unlock(&_write_lock);
+}
+
+/* Frees an index whose store was freed while it was being built. */
+static void _IndexBuilder_Discard(Index *idx) {
+    for(int i = 0; i < Vector_Size(idx->side_log); i++) {
+        IndexEntry *entry;
+        Vector_Get(idx->side_log, i, &entry);
+        IndexEntry_Free(entry);
+        free(entry);
+    }
+    Vector_Free(idx->side_log);
+    idx->side_log = NULL;
+    idx->state = INDEX_STATE_READY;
+    Index_Free(idx);
+}
+
+static void* _IndexBuilder_Run(void *arg) {
+    IndexBuildTask *task = arg;
+    Index *idx = task->idx;
+    rax *entities = task->entities;
+    free(task);
+
+    IndexEntry *batch = malloc(sizeof(IndexEntry) * INDEX_BUILDER_BATCH_SIZE);
+    unsigned char *last_key = NULL;
+    size_t last_key_len = 0;
+    int depleted = 0;
+
+    while(!depleted) {
+        /* Capture a batch of entries while entities can't be modified,
+         * entities scanned in an earlier batch and modified since
+         * are corrected by the side log. */
+        IndexBuilder_AcquireWriteLock();
+        if(idx->cancelled) {
+            IndexBuilder_ReleaseWriteLock();
+            break;
+        }
+
+        raxIterator it;
+        raxStart(&it, entities);
+        if(last_key) raxSeek(&it, ">", last_key, last_key_len);
+        else raxSeek(&it, "^", NULL, 0);
+
+        size_t batch_len = 0;
+        size_t scanned = 0;
+        while(scanned < INDEX_BUILDER_BATCH_SIZE) {
+            if(!raxNext(&it)) {
+                depleted = 1;
+                break;
+            }
+            scanned++;
+            if(Index_EntityEntry(idx, it.data, 0, &batch[batch_len])) batch_len++;
+        }
+
+        if(!depleted) {
+            last_key = realloc(last_key, it.key_len);
+            memcpy(last_key, it.key, it.key_len);
+            last_key_len = it.key_len;
+        }
+        raxStop(&it);
+        idx->build_done += scanned;
+        IndexBuilder_ReleaseWriteLock();
+
+        /* Index is invisible to queries while building, populate it without the lock. */
+        for(size_t i = 0; i < batch_len; i++) {
+            Index_ApplyEntry(idx, &batch[i]);
+            IndexEntry_Free(&batch[i]);
+        }
+    }
+
+    free(batch);
+    if(last_key) free(last_key);
+
+    IndexBuilder_AcquireWriteLock();
+    if(idx->cancelled) _IndexBuilder_Discard(idx);
+    else Index_Complete(idx);
+    IndexBuilder_ReleaseWriteLock();
+
+    return NULL;
+}
+
+int IndexBuilder_Start(Index *idx, rax *entities) {
+    Index_BeginBuild(idx, raxSize(entities));
+
+    IndexBuildTask *task = malloc(sizeof(IndexBuildTask));
+    task->idx = idx;
+    task->entities = entities;
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int rc = pthread_create(&thread, &attr, _IndexBuilder_Run, task);
+    pthread_attr_destroy(&attr);
+    if(rc == 0) return 1;
+
+    /* Fall back to building on the calling thread. */
+    free(task);
+    raxIterator it;
+    raxStart(&it, entities);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) {
+        IndexEntry entry;
+        if(!Index_EntityEntry(idx, it.data, 0, &entry)) continue;
+        Index_ApplyEntry(idx, &entry);
+        IndexEntry_Free(&entry);
+    }
+    raxStop(&it);
+    idx->build_done = idx->build_total;
+    Index_Complete(idx);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#ifndef __INDEX_BUILDER_H__
+#define __INDEX_BUILDER_H__
+
+#include "index.h"
+#include "../dep/rax/rax.h"
+
+#define INDEX_BUILDER_BATCH_SIZE 1024   /* Number of entities indexed per lock acquisition. */
+
+/* Builders read entities while holding the write lock,
+ * anything modifying entities or their stores must hold it as well.
+ * Lock is recursive. */
+void IndexBuilder_AcquireWriteLock();
+
+void IndexBuilder_ReleaseWriteLock();
+
+/* Populates idx from entities on a background thread,
+ * caller must hold the write lock, idx is marked as building
+ * and becomes ready once every entity and every write performed
+ * during the build has been applied.
+ * Returns 0 if thread creation failed, in which case idx is built synchronously. */
+int IndexBuilder_Start(Index *idx, rax *entities);
+
+#endif
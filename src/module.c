@@ -25,6 +25,7 @@
 #include "parser/parser_common.h"
 
 #include "stores/store.h"
+#include "index/index_builder.h"
 
 #include "grouping/group_cache.h"
 #include "arithmetic/agg_funcs.h"
@@ -35,6 +36,8 @@
 #include "resultset/resultset.h"
 
 #include "execution_plan/execution_plan.h"
+#include "prepared_statement.h"
+#include "plan_cache.h"
 
 /* Removes given graph.
  * Args:
@@ -49,7 +52,9 @@ int MGraph_DeleteGraph(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
     char *graph;
     char *storeId;
     RMUtil_ParseArgs(argv, argc, 1, "c", &graph);
-    
+
+    /* Entities might be read by index builders. */
+    IndexBuilder_AcquireWriteLock();
     LabelStore *store = LabelStore_Get(ctx, STORE_NODE, graph, NULL);
     LabelStoreIterator it;
     LabelStore_Scan(store, &it);
@@ -103,83 +108,290 @@ int MGraph_DeleteGraph(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
     RedisModule_DeleteKey(key);
     RedisModule_CloseKey(key);
     
+    IndexBuilder_ReleaseWriteLock();
+    PlanCache_Remove(graph);
+    PreparedStatement_RemoveGraph(graph);
+
     /* TODO: delete store key.
      * TODO: Delete label stores... */
     RedisModule_ReplyWithSimpleString(ctx, "OK");
     return REDISMODULE_OK;
 }
 
-/* Queries graph
- * Args:
- * argv[1] graph name
- * argv[2] query to execute */
-int MGraph_Query(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
-    if (argc < 3) return RedisModule_WrongArity(ctx);
-
-    /* Time query execution */
-    clock_t start = clock();
-    clock_t end;
+/* Parses a parameter's value, quoted values are strings,
+ * true and false are booleans, numbers are doubles, anything else is a string. */
+static SIValue _MGraph_ParseParamValue(const char *str) {
+    size_t len = strlen(str);
+    if(len >= 2 && (str[0] == '\'' || str[0] == '"') && str[len - 1] == str[0]) {
+        char *unquoted = strndup(str + 1, len - 2);
+        SIValue v = SI_StringVal(unquoted);
+        free(unquoted);
+        return v;
+    }
+    if(strcasecmp(str, "true") == 0) return SI_BoolVal(1);
+    if(strcasecmp(str, "false") == 0) return SI_BoolVal(0);
 
-    const char *graphName;
-    const char *query;
-    RMUtil_ParseArgs(argv, argc, 1, "cc", &graphName, &query);
+    char *end = NULL;
+    double d = strtod(str, &end);
+    if(len > 0 && *end == '\0') return SI_DoubleVal(d);
+    return SI_StringVal(str);
+}
 
-    /* Parse query, get AST. */
-    char *errMsg = NULL;
+/* Binds query parameters given as PARAMS name value ... starting at argv[offset],
+ * along with implicit_count implicit parameters lifted off the query.
+ * On failure replies with an error and returns REDISMODULE_ERR. */
+static int _MGraph_BindParams(RedisModuleCtx *ctx, Vector *params, RedisModuleString **argv,
+                              int argc, int offset, char **implicit_names,
+                              SIValue *implicit_values, int implicit_count) {
+    int count = 0;
+    if(offset < argc) {
+        const char *token = RedisModule_StringPtrLen(argv[offset], NULL);
+        if(strcasecmp(token, "PARAMS") != 0 || (argc - offset - 1) % 2 != 0) {
+            RedisModule_ReplyWithError(ctx, "Expecting PARAMS followed by name value pairs");
+            return REDISMODULE_ERR;
+        }
+        count = (argc - offset - 1) / 2;
+    }
 
-    AST_QueryExpressionNode* ast;
+    char *names[count + implicit_count];
+    SIValue values[count + implicit_count];
+    for(int i = 0; i < count; i++) {
+        names[i] = (char*)RedisModule_StringPtrLen(argv[offset + 1 + i * 2], NULL);
+        /* Leading $ is optional. */
+        if(names[i][0] == '$') names[i]++;
+        if(PlanCache_ReservedParam(names[i])) {
+            for(int j = 0; j < i; j++) SIValue_Free(&values[j]);
+            RedisModule_ReplyWithError(ctx, "Parameter names starting with " PLAN_CACHE_PARAM_PREFIX " are reserved");
+            return REDISMODULE_ERR;
+        }
+        values[i] = _MGraph_ParseParamValue(RedisModule_StringPtrLen(argv[offset + 2 + i * 2], NULL));
+    }
+    for(int i = 0; i < implicit_count; i++) {
+        names[count + i] = implicit_names[i];
+        values[count + i] = implicit_values[i];
+    }
 
-    ast = ParseQuery(query, strlen(query), &errMsg);
+    char *reason = NULL;
+    AST_Validation res = AST_BindParams(params, names, values, count + implicit_count, &reason);
+    for(int i = 0; i < count; i++) SIValue_Free(&values[i]);
 
-    if (!ast) {
-        RedisModule_Log(ctx, "debug", "Error parsing query: %s", errMsg);
-        RedisModule_ReplyWithError(ctx, errMsg);
-        free(errMsg);
-        return REDISMODULE_OK;
-    }
-    
-    char *reason;
-    if (Validate_AST(ast, &reason) != AST_VALID) {
+    if(res != AST_VALID) {
         RedisModule_ReplyWithError(ctx, reason);
-        return REDISMODULE_OK;
-    }
-    
-    /* Modify AST */
-    if(ReturnClause_ContainsCollapsedNodes(ast) == 1) {
-        /* Expand collapsed nodes. */
-        ReturnClause_ExpandCollapsedNodes(ctx, ast, graphName);
+        free(reason);
+        return REDISMODULE_ERR;
     }
+    return REDISMODULE_OK;
+}
+
+/* Executes a validated AST whose parameters are bound, replies with its result set.
+ * Returns 1 if the keyspace was modified. */
+static int _MGraph_ExecuteQuery(RedisModuleCtx *ctx, const char *graphName,
+                                AST_QueryExpressionNode *ast, clock_t start) {
+    /* Writers exclude index builders from reading entities mid update. */
+    int writer = Query_Modifies_KeySpace(ast);
+    if(writer) IndexBuilder_AcquireWriteLock();
 
     ExecutionPlan *plan = NewExecutionPlan(ctx, graphName, ast);
     ResultSet* resultSet = ExecutionPlan_Execute(plan);
     /* Send result-set back to client. */
     ExecutionPlanFree(plan);
+    if(writer) IndexBuilder_ReleaseWriteLock();
     ResultSet_Replay(ctx, resultSet);
 
-    /* Replicate query only if it modified the keyspace. */
-    if(Query_Modifies_KeySpace(ast) &&
+    int modified = (writer &&
        (resultSet->labels_added > 0 ||
        resultSet->nodes_created > 0 ||
        resultSet->properties_set > 0 ||
        resultSet->relationships_created > 0 ||
        resultSet->nodes_deleted > 0 ||
-       resultSet->relationships_deleted > 0)) {
-        RedisModule_ReplicateVerbatim(ctx);
-    }
+       resultSet->relationships_deleted > 0 ||
+       resultSet->indices_created > 0));
 
     ResultSet_Free(ctx, resultSet);
 
     /* Report execution timing. */
-    end = clock();
+    clock_t end = clock();
     double elapsed = (double)(end - start) / CLOCKS_PER_SEC;
     double elapsedMS = elapsed * 1000; 
     char* strElapsed;
     asprintf(&strElapsed, "Query internal execution time: %f milliseconds", elapsedMS);
     RedisModule_ReplyWithStringBuffer(ctx, strElapsed, strlen(strElapsed));
     free(strElapsed);
+
+    return modified;
+}
+
+/* Parses and validates query, replies with an error and returns NULL if it's invalid,
+ * unless quiet is set. */
+static AST_QueryExpressionNode* _MGraph_ParseQuery(RedisModuleCtx *ctx, const char *graphName,
+                                                   const char *query, int quiet) {
+    char *errMsg = NULL;
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+
+    if (!ast) {
+        RedisModule_Log(ctx, "debug", "Error parsing query: %s", errMsg);
+        if(!quiet) RedisModule_ReplyWithError(ctx, errMsg);
+        free(errMsg);
+        return NULL;
+    }
+    
+    char *reason;
+    if (Validate_AST(ast, &reason) != AST_VALID) {
+        if(!quiet) RedisModule_ReplyWithError(ctx, reason);
+        Free_AST_QueryExpressionNode(ast);
+        return NULL;
+    }
     
-    /* TODO: free AST
-     * FreeQueryExpressionNode(ast); */
+    /* Modify AST */
+    if(ReturnClause_ContainsCollapsedNodes(ast) == 1) {
+        /* Expand collapsed nodes. */
+        ReturnClause_ExpandCollapsedNodes(ctx, ast, graphName);
+    }
+
+    return ast;
+}
+
+/* Queries graph
+ * Args:
+ * argv[1] graph name
+ * argv[2] query to execute
+ * argv[3...] optional PARAMS name value ... */
+int MGraph_Query(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    if (argc < 3) return RedisModule_WrongArity(ctx);
+
+    /* Time query execution */
+    clock_t start = clock();
+
+    const char *graphName;
+    const char *query;
+    RMUtil_ParseArgs(argv, argc, 1, "cc", &graphName, &query);
+
+    /* Queries differing only by their literals share a cached AST. */
+    NormalizedQuery normalized;
+    PlanCache_Normalize(query, &normalized);
+    PlanCache *cache = PlanCache_Get(graphName);
+    PlanCacheEntry *entry = PlanCache_Lookup(cache, normalized.text);
+    if(!entry) {
+        AST_QueryExpressionNode *cached = _MGraph_ParseQuery(ctx, graphName, normalized.text, 1);
+        entry = PlanCache_Insert(cache, normalized.text, cached);
+    }
+
+    /* Normalized query isn't valid, parse query as is. */
+    AST_QueryExpressionNode *ast = entry->ast;
+    Vector *params = entry->params;
+    if(!ast) {
+        ast = _MGraph_ParseQuery(ctx, graphName, query, 0);
+        if(!ast) {
+            NormalizedQuery_Free(&normalized);
+            return REDISMODULE_OK;
+        }
+        params = AST_CollectParams(ast);
+    }
+
+    int bound = _MGraph_BindParams(ctx, params, argv, argc, 3, normalized.names,
+                                   normalized.values, normalized.count);
+    NormalizedQuery_Free(&normalized);
+
+    /* Replicate query only if it modified the keyspace. */
+    if(bound == REDISMODULE_OK && _MGraph_ExecuteQuery(ctx, graphName, ast, start)) {
+        RedisModule_ReplicateVerbatim(ctx);
+    }
+
+    /* Uncached AST is done with. */
+    if(ast != entry->ast) {
+        AST_FreeParams(params);
+        Free_AST_QueryExpressionNode(ast);
+    }
+    return REDISMODULE_OK;
+}
+
+/* Prepares query for later execution
+ * replies with a handle identifying the prepared statement
+ * Args:
+ * argv[1] graph name
+ * argv[2] query to prepare */
+int MGraph_Prepare(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    if (argc != 3) return RedisModule_WrongArity(ctx);
+
+    const char *graphName;
+    const char *query;
+    RMUtil_ParseArgs(argv, argc, 1, "cc", &graphName, &query);
+
+    PreparedStatement *stmt = PreparedStatement_Lookup(graphName, query);
+    if(!stmt) {
+        AST_QueryExpressionNode *ast = _MGraph_ParseQuery(ctx, graphName, query, 0);
+        if(!ast) return REDISMODULE_OK;
+        stmt = PreparedStatement_Register(graphName, query, ast);
+    }
+
+    RedisModule_ReplyWithLongLong(ctx, stmt->id);
+    return REDISMODULE_OK;
+}
+
+/* Executes a prepared statement
+ * Args:
+ * argv[1] graph name
+ * argv[2] prepared statement handle
+ * argv[3...] optional PARAMS name value ... */
+int MGraph_Execute(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    if (argc < 3) return RedisModule_WrongArity(ctx);
+
+    /* Time query execution */
+    clock_t start = clock();
+
+    const char *graphName;
+    long long id;
+    if(RMUtil_ParseArgs(argv, argc, 1, "cl", &graphName, &id) != REDISMODULE_OK) {
+        RedisModule_ReplyWithError(ctx, "Invalid prepared statement handle");
+        return REDISMODULE_OK;
+    }
+
+    PreparedStatement *stmt = PreparedStatement_Get(id);
+    if(!stmt || strcmp(stmt->graph_name, graphName) != 0) {
+        RedisModule_ReplyWithError(ctx, "Unknown prepared statement");
+        return REDISMODULE_OK;
+    }
+
+    /* Schema changed since statement was prepared, e.g. collapsed nodes
+     * expand to a different set of properties, reparse query. */
+    if(PreparedStatement_Stale(stmt)) {
+        AST_QueryExpressionNode *ast = _MGraph_ParseQuery(ctx, graphName, stmt->query, 0);
+        if(!ast) return REDISMODULE_OK;
+        PreparedStatement_Reprepare(stmt, ast);
+    }
+
+    if(_MGraph_BindParams(ctx, stmt->params, argv, argc, 3, NULL, NULL, 0) != REDISMODULE_OK) return REDISMODULE_OK;
+
+    /* Replicas don't hold prepared statements, replicate query text. */
+    if(_MGraph_ExecuteQuery(ctx, graphName, stmt->ast, start)) {
+        RedisModule_Replicate(ctx, "graph.QUERY", "ccv", graphName, stmt->query, argv + 3, (size_t)(argc - 3));
+    }
+
+    return REDISMODULE_OK;
+}
+
+/* Frees a prepared statement, its handle is no longer valid
+ * Args:
+ * argv[1] graph name
+ * argv[2] prepared statement handle */
+int MGraph_Deallocate(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    if (argc != 3) return RedisModule_WrongArity(ctx);
+
+    const char *graphName;
+    long long id;
+    if(RMUtil_ParseArgs(argv, argc, 1, "cl", &graphName, &id) != REDISMODULE_OK) {
+        RedisModule_ReplyWithError(ctx, "Invalid prepared statement handle");
+        return REDISMODULE_OK;
+    }
+
+    PreparedStatement *stmt = PreparedStatement_Get(id);
+    if(!stmt || strcmp(stmt->graph_name, graphName) != 0) {
+        RedisModule_ReplyWithError(ctx, "Unknown prepared statement");
+        return REDISMODULE_OK;
+    }
+
+    PreparedStatement_Deallocate(id);
+    RedisModule_ReplyWithSimpleString(ctx, "OK");
     return REDISMODULE_OK;
 }
 
@@ -187,7 +399,8 @@ int MGraph_Query(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
  * reports plan back to the client
  * Args:
  * argv[1] graph name
- * argv[2] query */
+ * argv[2] query
+ * argv[3...] optional PARAMS name value ... */
 int MGraph_Explain(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
     if (argc < 2) return RedisModule_WrongArity(ctx);
     
@@ -212,16 +425,140 @@ int MGraph_Explain(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
         ReturnClause_ExpandCollapsedNodes(ctx, ast, graphName);
     }
 
+    /* Plan depends on parameters' values. */
+    Vector *params = AST_CollectParams(ast);
+    int bound = _MGraph_BindParams(ctx, params, argv, argc, 3, NULL, NULL, 0);
+    AST_FreeParams(params);
+    if(bound != REDISMODULE_OK) {
+        Free_AST_QueryExpressionNode(ast);
+        return REDISMODULE_OK;
+    }
+
     ExecutionPlan *plan = NewExecutionPlan(ctx, graphName, ast);
     char* strPlan = ExecutionPlanPrint(plan);
-    /* TODO: free execution plan.
-     * ExecutionPlanFree(plan); */
+    ResultSet_Free(ctx, plan->result_set);
+    ExecutionPlanFree(plan);
 
     RedisModule_ReplyWithStringBuffer(ctx, strPlan, strlen(strPlan));
     free(strPlan);
     
-    /* TODO: free AST
-     * FreeQueryExpressionNode(ast); */
+    Free_AST_QueryExpressionNode(ast);
+    return REDISMODULE_OK;
+}
+
+/* Replies with a row per index within store:
+ * label, property, entity type, index kind, state and build progress. */
+static long _MGraph_ReplyWithStoreIndices(RedisModuleCtx *ctx, LabelStore *store, const char *entity_type) {
+    long rows = 0;
+    raxIterator it;
+
+    raxStart(&it, store->indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) {
+        Index *idx = it.data;
+        int ready = Index_IsReady(idx);
+        double progress = 100;
+        if(!ready && idx->build_total > 0) progress = (double)idx->build_done * 100 / idx->build_total;
+
+        RedisModule_ReplyWithArray(ctx, 6);
+        RedisModule_ReplyWithStringBuffer(ctx, store->label, strlen(store->label));
+        RedisModule_ReplyWithStringBuffer(ctx, idx->property, strlen(idx->property));
+        RedisModule_ReplyWithSimpleString(ctx, entity_type);
+        RedisModule_ReplyWithSimpleString(ctx, "ordered");
+        RedisModule_ReplyWithSimpleString(ctx, ready ? "ready" : "building");
+        RedisModule_ReplyWithDouble(ctx, progress);
+        rows++;
+    }
+    raxStop(&it);
+
+    raxStart(&it, store->fulltext_indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) {
+        FullTextIndex *idx = it.data;
+        RedisModule_ReplyWithArray(ctx, 6);
+        RedisModule_ReplyWithStringBuffer(ctx, store->label, strlen(store->label));
+        RedisModule_ReplyWithStringBuffer(ctx, idx->property, strlen(idx->property));
+        RedisModule_ReplyWithSimpleString(ctx, entity_type);
+        RedisModule_ReplyWithSimpleString(ctx, "fulltext");
+        RedisModule_ReplyWithSimpleString(ctx, "ready");
+        RedisModule_ReplyWithDouble(ctx, 100);
+        rows++;
+    }
+    raxStop(&it);
+
+    raxStart(&it, store->geo_indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) {
+        GeoIndex *idx = it.data;
+        RedisModule_ReplyWithArray(ctx, 6);
+        RedisModule_ReplyWithStringBuffer(ctx, store->label, strlen(store->label));
+        RedisModule_ReplyWithStringBuffer(ctx, idx->lat_property, strlen(idx->lat_property));
+        RedisModule_ReplyWithSimpleString(ctx, entity_type);
+        RedisModule_ReplyWithSimpleString(ctx, "geo");
+        RedisModule_ReplyWithSimpleString(ctx, "ready");
+        RedisModule_ReplyWithDouble(ctx, 100);
+        rows++;
+    }
+    raxStop(&it);
+
+    return rows;
+}
+
+/* Lists graph's indices and their build progress
+ * Args:
+ * argv[1] graph name */
+int MGraph_Indexes(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    if(argc != 2) return RedisModule_WrongArity(ctx);
+
+    const char *graphName;
+    RMUtil_ParseArgs(argv, argc, 1, "c", &graphName);
+
+    size_t node_stores_len = 128;   /* Limit number of labels we'll consider. */
+    LabelStore *node_stores[128];
+    size_t edge_stores_len = 128;
+    LabelStore *edge_stores[128];
+    LabelStore_Get_ALL(ctx, STORE_NODE, graphName, node_stores, &node_stores_len);
+    LabelStore_Get_ALL(ctx, STORE_EDGE, graphName, edge_stores, &edge_stores_len);
+    if(node_stores_len > 128) node_stores_len = 128;
+    if(edge_stores_len > 128) edge_stores_len = 128;
+
+    /* Progress is updated by index builders. */
+    IndexBuilder_AcquireWriteLock();
+    long rows = 0;
+    RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
+    for(int i = 0; i < node_stores_len; i++) {
+        if(!node_stores[i]->label) continue; /* No label, (this is 'ALL' store). */
+        rows += _MGraph_ReplyWithStoreIndices(ctx, node_stores[i], "node");
+    }
+    for(int i = 0; i < edge_stores_len; i++) {
+        if(!edge_stores[i]->label) continue;
+        rows += _MGraph_ReplyWithStoreIndices(ctx, edge_stores[i], "relationship");
+    }
+    RedisModule_ReplySetArrayLength(ctx, rows);
+    IndexBuilder_ReleaseWriteLock();
+
+    return REDISMODULE_OK;
+}
+
+/* Reports graph's plan cache usage
+ * Args:
+ * argv[1] graph name */
+int MGraph_PlanCache(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    if(argc != 2) return RedisModule_WrongArity(ctx);
+
+    const char *graphName;
+    RMUtil_ParseArgs(argv, argc, 1, "c", &graphName);
+    PlanCache *cache = PlanCache_Get(graphName);
+
+    RedisModule_ReplyWithArray(ctx, 8);
+    RedisModule_ReplyWithSimpleString(ctx, "hits");
+    RedisModule_ReplyWithLongLong(ctx, cache->hits);
+    RedisModule_ReplyWithSimpleString(ctx, "misses");
+    RedisModule_ReplyWithLongLong(ctx, cache->misses);
+    RedisModule_ReplyWithSimpleString(ctx, "entries");
+    RedisModule_ReplyWithLongLong(ctx, raxSize(cache->entries));
+    RedisModule_ReplyWithSimpleString(ctx, "capacity");
+    RedisModule_ReplyWithLongLong(ctx, cache->capacity);
     return REDISMODULE_OK;
 }
 
@@ -252,9 +589,29 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
         return REDISMODULE_ERR;
     }
 
+    if(RedisModule_CreateCommand(ctx, "graph.PREPARE", MGraph_Prepare, "readonly", 1, 1, 1) == REDISMODULE_ERR) {
+        return REDISMODULE_ERR;
+    }
+
+    if(RedisModule_CreateCommand(ctx, "graph.EXECUTE", MGraph_Execute, "write", 1, 1, 1) == REDISMODULE_ERR) {
+        return REDISMODULE_ERR;
+    }
+
+    if(RedisModule_CreateCommand(ctx, "graph.DEALLOCATE", MGraph_Deallocate, "readonly", 1, 1, 1) == REDISMODULE_ERR) {
+        return REDISMODULE_ERR;
+    }
+
     if(RedisModule_CreateCommand(ctx, "graph.EXPLAIN", MGraph_Explain, "write", 1, 1, 1) == REDISMODULE_ERR) {
         return REDISMODULE_ERR;
     }
 
+    if(RedisModule_CreateCommand(ctx, "graph.INDEXES", MGraph_Indexes, "readonly", 1, 1, 1) == REDISMODULE_ERR) {
+        return REDISMODULE_ERR;
+    }
+
+    if(RedisModule_CreateCommand(ctx, "graph.PLANCACHE", MGraph_PlanCache, "readonly", 1, 1, 1) == REDISMODULE_ERR) {
+        return REDISMODULE_ERR;
+    }
+
     return REDISMODULE_OK;
 }
@@ -38,6 +38,37 @@ AST_FilterNode* New_AST_ConstantPredicateNode(const char* alias, const char* pro
 	return n;
 }
 
+AST_FilterNode* New_AST_DistancePredicateNode(const char* alias, const char* latProperty, const char* lonProperty, double lat, double lon, int op, double distance) {
+	AST_FilterNode *n = malloc(sizeof(AST_FilterNode));
+	n->t = N_PRED;
+
+	n->pn.t = N_DISTANCE;
+	n->pn.alias = strdup(alias);
+	n->pn.property = strdup(latProperty);
+	n->pn.distance.lon_property = strdup(lonProperty);
+	n->pn.distance.lat = lat;
+	n->pn.distance.lon = lon;
+
+	n->pn.op = op;
+	n->pn.constVal = SI_DoubleVal(distance);
+
+	return n;
+}
+
+AST_FilterNode* New_AST_IdPredicateNode(const char* alias, int op, long int id) {
+	AST_FilterNode *n = malloc(sizeof(AST_FilterNode));
+	n->t = N_PRED;
+
+	n->pn.t = N_ID;
+	n->pn.alias = strdup(alias);
+	n->pn.property = NULL;
+
+	n->pn.op = op;
+	n->pn.constVal = SI_LongVal(id);
+
+	return n;
+}
+
 AST_FilterNode *New_AST_ConditionNode(AST_FilterNode *left, int op, AST_FilterNode *right) {
   AST_FilterNode *n = malloc(sizeof(AST_FilterNode));
   n->t = N_COND;
@@ -68,7 +99,13 @@ void FreePredicateNode(AST_PredicateNode* predicateNode) {
 		}
 	}
 
-	// TODO: Should I free constVal?
+	if(predicateNode->t == N_DISTANCE) {
+		free(predicateNode->distance.lon_property);
+	}
+
+	if(predicateNode->t == N_CONSTANT) {
+		SIValue_Free(&predicateNode->constVal);
+	}
 }
 
 void Free_AST_FilterNode(AST_FilterNode* filterNode) {
@@ -84,6 +121,7 @@ void Free_AST_FilterNode(AST_FilterNode* filterNode) {
 			Free_AST_FilterNode(filterNode->cn.right);
 			break;
 	}
+	free(filterNode);
 }
 
 AST_LinkEntity* New_AST_LinkEntity(char *alias, char *label, Vector *properties, AST_LinkDirection dir) {
@@ -150,10 +188,12 @@ AST_MatchNode* New_AST_MatchNode(Vector *elements) {
 }
 
 void Free_AST_MatchNode(AST_MatchNode *matchNode) {
+	if(!matchNode) return;
+
 	for(int i = 0; i < Vector_Size(matchNode->graphEntities); i++) {
-		GraphEntity *ge;
+		AST_GraphEntity *ge;
 		Vector_Get(matchNode->graphEntities, i, &ge);
-		FreeGraphEntity(ge);
+		Free_AST_GraphEntity(ge);
 	}
 
 	Vector_Free(matchNode->graphEntities);
@@ -172,13 +212,28 @@ AST_SetNode* New_AST_SetNode(Vector *elements) {
 	return set_node;
 }
 
+void Free_AST_SetNode(AST_SetNode *setNode) {
+	if(!setNode) return;
+
+	for(int i = 0; i < Vector_Size(setNode->set_elements); i++) {
+		AST_SetElement *element;
+		Vector_Get(setNode->set_elements, i, &element);
+		Free_AST_Variable(element->entity);
+		Free_AST_ArithmeticExpressionNode(element->exp);
+		free(element);
+	}
+
+	Vector_Free(setNode->set_elements);
+	free(setNode);
+}
+
 void Free_AST_CreateNode(AST_CreateNode *createNode) {
 	if(!createNode) return;
 	
 	for(int i = 0; i < Vector_Size(createNode->graphEntities); i++) {
-		GraphEntity *ge;
+		AST_GraphEntity *ge;
 		Vector_Get(createNode->graphEntities, i, &ge);
-		FreeGraphEntity(ge);
+		Free_AST_GraphEntity(ge);
 	}
 
 	Vector_Free(createNode->graphEntities);
@@ -218,6 +273,8 @@ AST_ReturnNode* New_AST_ReturnNode(Vector *returnElements, int distinct) {
 }
 
 void Free_AST_ReturnNode(AST_ReturnNode *returnNode) {
+	if(!returnNode) return;
+
 	for (int i = 0; i < Vector_Size(returnNode->returnElements); i++) {
 		AST_ReturnElementNode *node;
 		Vector_Get(returnNode->returnElements, i, &node);
@@ -253,7 +310,9 @@ void Free_AST_ReturnElementNode(AST_ReturnElementNode *returnElementNode) {
 AST_QueryExpressionNode* New_AST_QueryExpressionNode(AST_MatchNode *matchNode, AST_WhereNode *whereNode,
 												     AST_CreateNode *createNode, AST_SetNode *setNode,
 													 AST_DeleteNode *deleteNode, AST_ReturnNode *returnNode,
-													 AST_OrderNode *orderNode, AST_LimitNode *limitNode) {
+													 AST_OrderNode *orderNode, AST_SkipNode *skipNode,
+													 AST_LimitNode *limitNode, AST_CallNode *callNode,
+													 AST_IndexNode *indexNode) {
 	AST_QueryExpressionNode *queryExpressionNode = (AST_QueryExpressionNode*)malloc(sizeof(AST_QueryExpressionNode));
 	
 	queryExpressionNode->matchNode = matchNode;
@@ -263,7 +322,10 @@ AST_QueryExpressionNode* New_AST_QueryExpressionNode(AST_MatchNode *matchNode, A
 	queryExpressionNode->deleteNode = deleteNode;
 	queryExpressionNode->returnNode = returnNode;
 	queryExpressionNode->orderNode = orderNode;
+	queryExpressionNode->skipNode = skipNode;
 	queryExpressionNode->limitNode = limitNode;
+	queryExpressionNode->callNode = callNode;
+	queryExpressionNode->indexNode = indexNode;
 
 	return queryExpressionNode;
 }
@@ -271,10 +333,15 @@ AST_QueryExpressionNode* New_AST_QueryExpressionNode(AST_MatchNode *matchNode, A
 void Free_AST_QueryExpressionNode(AST_QueryExpressionNode *queryExpressionNode) {
 	Free_AST_MatchNode(queryExpressionNode->matchNode);
 	Free_AST_CreateNode(queryExpressionNode->createNode);
+	Free_AST_SetNode(queryExpressionNode->setNode);
 	Free_AST_DeleteNode(queryExpressionNode->deleteNode);
 	Free_AST_WhereNode(queryExpressionNode->whereNode);
 	Free_AST_ReturnNode(queryExpressionNode->returnNode);
 	Free_AST_OrderNode(queryExpressionNode->orderNode);
+	Free_AST_SkipNode(queryExpressionNode->skipNode);
+	Free_AST_LimitNode(queryExpressionNode->limitNode);
+	Free_AST_CallNode(queryExpressionNode->callNode);
+	Free_AST_IndexNode(queryExpressionNode->indexNode);
 	free(queryExpressionNode);
 }
 
@@ -370,6 +437,76 @@ AST_Validation _Validate_RETURN_Clause(const AST_QueryExpressionNode* ast, char
 	return AST_VALID;
 }
 
+AST_IndexNode* New_AST_IndexNode(const char *label, const char *property, AST_GraphEntityType entity_type, AST_IndexOpType operation) {
+	AST_IndexNode *indexNode = (AST_IndexNode*)malloc(sizeof(AST_IndexNode));
+	indexNode->label = strdup(label);
+	indexNode->property = strdup(property);
+	indexNode->entity_type = entity_type;
+	indexNode->operation = operation;
+	return indexNode;
+}
+
+void Free_AST_IndexNode(AST_IndexNode *indexNode) {
+	if(!indexNode) return;
+	free(indexNode->label);
+	free(indexNode->property);
+	free(indexNode);
+}
+
+/* Checks procedure exists and is called with the right arguments. */
+AST_Validation _Validate_CALL_Clause(const AST_QueryExpressionNode* ast, char **reason) {
+	if (!ast->callNode) {
+		return AST_VALID;
+	}
+
+	const AST_CallNode *call = ast->callNode;
+	int expected_args;
+	int max_yields;
+
+	if (strcmp(call->procedure, PROC_FULLTEXT_CREATE_NODE_INDEX) == 0) {
+		/* (label, property) */
+		expected_args = 2;
+		max_yields = 0;
+	} else if (strcmp(call->procedure, PROC_SPATIAL_CREATE_NODE_INDEX) == 0) {
+		/* (label, latitude property, longitude property) */
+		expected_args = 3;
+		max_yields = 0;
+	} else if (strcmp(call->procedure, PROC_FULLTEXT_QUERY_NODES) == 0) {
+		/* (label, property, query) YIELD node, score */
+		expected_args = 3;
+		max_yields = 2;
+	} else {
+		asprintf(reason, "Unknown procedure %s", call->procedure);
+		return AST_INVALID;
+	}
+
+	if (Vector_Size(call->args) != expected_args) {
+		asprintf(reason, "Procedure %s expects %d arguments", call->procedure, expected_args);
+		return AST_INVALID;
+	}
+
+	for (int i = 0; i < Vector_Size(call->args); i++) {
+		SIValue *arg;
+		Vector_Get(call->args, i, &arg);
+		if (arg->type != T_STRING) {
+			asprintf(reason, "Procedure %s expects string arguments", call->procedure);
+			return AST_INVALID;
+		}
+	}
+
+	if (call->yields && Vector_Size(call->yields) > max_yields) {
+		asprintf(reason, "Procedure %s yields at most %d values", call->procedure, max_yields);
+		return AST_INVALID;
+	}
+
+	if (max_yields == 0 && (ast->whereNode || ast->returnNode)) {
+		asprintf(reason, "Procedure %s does not yield any values", call->procedure);
+		return AST_INVALID;
+	}
+
+	return AST_VALID;
+}
+
 AST_Validation _Validate_Aliases_In_Match_Clause(const Vector* aliasesToCheck, 
 										         const Vector* matchAliases, 
 										         char** undefined_alias) {
@@ -401,8 +538,17 @@ AST_Validation _Validate_Aliases_In_Match_Clause(const Vector* aliasesToCheck,
 }
 
 AST_Validation Validate_AST(const AST_QueryExpressionNode* ast, char **reason) {
-	/* AST must include either a MATCH or CREATE clause. */
-	if(ast->matchNode == NULL && ast->createNode == NULL) {
+	if(_Validate_CALL_Clause(ast, reason) != AST_VALID) {
+		return AST_INVALID;
+	}
+
+	/* AST must include either a MATCH or CREATE clause,
+	 * CALL clauses which yield entities introduce a MATCH clause. */
+	if(ast->indexNode != NULL) {
+		return AST_VALID;
+	}
+
+	if(ast->matchNode == NULL && ast->createNode == NULL && ast->callNode == NULL) {
 		*reason = "Query must specify either MATCH or CREATE clause.";
 		return AST_INVALID;
 	}
@@ -529,6 +675,50 @@ void Free_AST_LimitNode(AST_LimitNode* limitNode) {
 	}
 }
 
+AST_SkipNode* New_AST_SkipNode(int skip) {
+	AST_SkipNode* skipNode = (AST_SkipNode*)malloc(sizeof(AST_SkipNode));
+	skipNode->skip = skip;
+	return skipNode;
+}
+
+void Free_AST_SkipNode(AST_SkipNode* skipNode) {
+	if(skipNode) {
+		free(skipNode);
+	}
+}
+
+AST_CallNode* New_AST_CallNode(char *procedure, Vector *args, Vector *yields) {
+	AST_CallNode *callNode = (AST_CallNode*)malloc(sizeof(AST_CallNode));
+	callNode->procedure = procedure;
+	callNode->args = args;
+	callNode->yields = yields;
+	return callNode;
+}
+
+void Free_AST_CallNode(AST_CallNode *callNode) {
+	if(!callNode) return;
+
+	for(int i = 0; i < Vector_Size(callNode->args); i++) {
+		SIValue *arg;
+		Vector_Get(callNode->args, i, &arg);
+		SIValue_Free(arg);
+		free(arg);
+	}
+	Vector_Free(callNode->args);
+
+	if(callNode->yields) {
+		for(int i = 0; i < Vector_Size(callNode->yields); i++) {
+			char *yield;
+			Vector_Get(callNode->yields, i, &yield);
+			free(yield);
+		}
+		Vector_Free(callNode->yields);
+	}
+
+	free(callNode->procedure);
+	free(callNode);
+}
+
 AST_ArithmeticExpressionNode* New_AST_AR_EXP_ConstOperandNode(SIValue constant) {
 	AST_ArithmeticExpressionNode *node = malloc(sizeof(AST_ArithmeticExpressionNode));
 	node->type = AST_AR_EXP_OPERAND;
@@ -574,6 +764,8 @@ void Free_AST_ArithmeticExpressionNode(AST_ArithmeticExpressionNode *arExpNode)
 		if(arExpNode->operand.type == AST_AR_EXP_VARIADIC) {
 			free(arExpNode->operand.variadic.alias);
 			free(arExpNode->operand.variadic.property);
+		} else {
+			SIValue_Free(&arExpNode->operand.constant);
 		}
 	}
 	/* Finaly we can free the node. */
@@ -597,3 +789,105 @@ void _Get_All_Aliases_From_Expression(const AST_ArithmeticExpressionNode *exp, V
         }
     }
 }
+
+void _AST_CollectParam(SIValue *value, Vector *params) {
+	if(value->type != T_PARAM) return;
+	AST_Param *param = malloc(sizeof(AST_Param));
+	param->name = strdup(value->stringval);
+	param->value = value;
+	Vector_Push(params, param);
+}
+
+void _AST_CollectExpressionParams(AST_ArithmeticExpressionNode *exp, Vector *params) {
+	if(exp->type == AST_AR_EXP_OPERAND) {
+		if(exp->operand.type == AST_AR_EXP_CONSTANT) _AST_CollectParam(&exp->operand.constant, params);
+		return;
+	}
+	for(int i = 0; i < Vector_Size(exp->op.args); i++) {
+		AST_ArithmeticExpressionNode *arg;
+		Vector_Get(exp->op.args, i, &arg);
+		_AST_CollectExpressionParams(arg, params);
+	}
+}
+
+void _AST_CollectFilterParams(AST_FilterNode *filter, Vector *params) {
+	if(filter->t == N_COND) {
+		_AST_CollectFilterParams(filter->cn.left, params);
+		_AST_CollectFilterParams(filter->cn.right, params);
+	} else if(filter->pn.t == N_CONSTANT) {
+		_AST_CollectParam(&filter->pn.constVal, params);
+	}
+}
+
+void _AST_CollectEntitiesParams(Vector *entities, Vector *params) {
+	for(int i = 0; i < Vector_Size(entities); i++) {
+		AST_GraphEntity *entity;
+		Vector_Get(entities, i, &entity);
+		if(entity->properties == NULL) continue;
+		/* Properties alternate between keys and values. */
+		for(int j = 1; j < Vector_Size(entity->properties); j += 2) {
+			SIValue *value;
+			Vector_Get(entity->properties, j, &value);
+			_AST_CollectParam(value, params);
+		}
+	}
+}
+
+Vector* AST_CollectParams(AST_QueryExpressionNode *ast) {
+	Vector *params = NewVector(AST_Param*, 0);
+
+	if(ast->matchNode) _AST_CollectEntitiesParams(ast->matchNode->graphEntities, params);
+	if(ast->createNode) _AST_CollectEntitiesParams(ast->createNode->graphEntities, params);
+	if(ast->whereNode) _AST_CollectFilterParams(ast->whereNode->filters, params);
+
+	for(int i = 0; ast->setNode && i < Vector_Size(ast->setNode->set_elements); i++) {
+		AST_SetElement *element;
+		Vector_Get(ast->setNode->set_elements, i, &element);
+		_AST_CollectExpressionParams(element->exp, params);
+	}
+
+	for(int i = 0; ast->returnNode && i < Vector_Size(ast->returnNode->returnElements); i++) {
+		AST_ReturnElementNode *element;
+		Vector_Get(ast->returnNode->returnElements, i, &element);
+		_AST_CollectExpressionParams(element->exp, params);
+	}
+
+	for(int i = 0; ast->callNode && ast->callNode->args && i < Vector_Size(ast->callNode->args); i++) {
+		SIValue *arg;
+		Vector_Get(ast->callNode->args, i, &arg);
+		_AST_CollectParam(arg, params);
+	}
+
+	return params;
+}
+
+AST_Validation AST_BindParams(Vector *params, char **names, SIValue *values, int count, char **reason) {
+	for(int i = 0; i < Vector_Size(params); i++) {
+		AST_Param *param;
+		Vector_Get(params, i, &param);
+
+		int found = -1;
+		for(int j = 0; j < count; j++) {
+			if(strcmp(names[j], param->name) == 0) found = j;
+		}
+		if(found == -1) {
+			asprintf(reason, "Missing value for parameter $%s", param->name);
+			return AST_INVALID;
+		}
+
+		/* Placeholder's name is copied by param, previously bound values are owned by AST. */
+		SIValue_Free(param->value);
+		*param->value = SI_Clone(values[found]);
+	}
+	return AST_VALID;
+}
+
+void AST_FreeParams(Vector *params) {
+	for(int i = 0; i < Vector_Size(params); i++) {
+		AST_Param *param;
+		Vector_Get(params, i, &param);
+		free(param->name);
+		free(param);
+	}
+	Vector_Free(params);
+}
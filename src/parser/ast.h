@@ -23,6 +23,8 @@ typedef enum {
 typedef enum {
 	N_CONSTANT,
 	N_VARYING,
+	N_DISTANCE,
+	N_ID,
 } AST_CompareValueType;
 
 typedef enum {
@@ -35,6 +37,10 @@ typedef enum {
 	N_ALIAS
 } AST_ColumnNodeType;
 
+typedef enum {
+	CREATE_INDEX,
+} AST_IndexOpType;
+
 typedef enum {
 	AST_VALID,
 	AST_INVALID
@@ -69,9 +75,14 @@ typedef struct {
 			char *property;
 		} nodeVal;
 	};
-	AST_CompareValueType t; // Comapred value type, constant/node
+	struct {
+		char *lon_property;	// Node longitude property, property holds latitude
+		double lat;			// Origin latitude
+		double lon;			// Origin longitude
+	} distance;				// distance(n.lat, n.lon, lat, lon) op constVal
+	AST_CompareValueType t; // Comapred value type, constant/node/distance/id
 	char *alias;		// Node alias
-	char *property; 	// Node property
+	char *property; 	// Node property, NULL for id predicates
 	int op;				// Type of comparison
 } AST_PredicateNode;
 
@@ -163,6 +174,22 @@ typedef struct {
 	int limit;
 } AST_LimitNode;
 
+typedef struct {
+	int skip;
+} AST_SkipNode;
+
+/* Built-in procedures, invoked via CALL. */
+#define PROC_FULLTEXT_CREATE_NODE_INDEX "db.idx.fulltext.createNodeIndex"
+#define PROC_FULLTEXT_QUERY_NODES "db.idx.fulltext.queryNodes"
+#define PROC_FULLTEXT_SCORE_PROPERTY "score"	/* Property holding a match relevance score. */
+#define PROC_SPATIAL_CREATE_NODE_INDEX "db.idx.spatial.createNodeIndex"
+
+typedef struct {
+	char *procedure;	/* Procedure name, e.g. db.idx.fulltext.queryNodes */
+	Vector *args;		/* Vector of SIValue pointers, procedure arguments. */
+	Vector *yields;		/* Vector of char pointers, aliases given to procedure outputs. */
+} AST_CallNode;
+
 typedef struct {
 	char *alias; 		// Alias given to this return element (using the AS keyword)
 	AST_ArithmeticExpressionNode *exp;
@@ -179,6 +206,13 @@ typedef struct {
 	AST_ColumnNodeType type;
 } AST_ColumnNode;
 
+typedef struct {
+	char *label;			/* Indexed label or relationship type. */
+	char *property;			/* Indexed property. */
+	AST_GraphEntityType entity_type;	/* Indexing nodes or edges. */
+	AST_IndexOpType operation;
+} AST_IndexNode;
+
 typedef struct {
 	AST_MatchNode *matchNode;
 	AST_CreateNode *createNode;
@@ -187,9 +221,18 @@ typedef struct {
 	AST_WhereNode *whereNode;
 	AST_ReturnNode *returnNode;
 	AST_OrderNode *orderNode;
+	AST_SkipNode *skipNode;
 	AST_LimitNode *limitNode;
+	AST_CallNode *callNode;
+	AST_IndexNode *indexNode;
 } AST_QueryExpressionNode;
 
+/* A parameter placeholder within the AST, e.g. $name. */
+typedef struct {
+	char *name;
+	SIValue *value;		/* AST slot holding the placeholder, overwritten once bound. */
+} AST_Param;
+
 AST_NodeEntity* New_AST_NodeEntity(char *alias, char *label, Vector *properties);
 AST_LinkEntity* New_AST_LinkEntity(char *alias, char *relationship, Vector *properties, AST_LinkDirection dir);
 AST_MatchNode* New_AST_MatchNode(Vector *elements);
@@ -198,6 +241,8 @@ AST_SetNode* New_AST_SetNode(Vector *elements);
 AST_DeleteNode* New_AST_DeleteNode(Vector *elements);
 AST_FilterNode* New_AST_ConstantPredicateNode(const char *alias, const char *property, int op, SIValue value);
 AST_FilterNode* New_AST_VaryingPredicateNode(const char *lAlias, const char *lProperty, int op, const char *rAlias, const char *rProperty);
+AST_FilterNode* New_AST_DistancePredicateNode(const char *alias, const char *latProperty, const char *lonProperty, double lat, double lon, int op, double distance);
+AST_FilterNode* New_AST_IdPredicateNode(const char *alias, int op, long int id);
 AST_FilterNode* New_AST_ConditionNode(AST_FilterNode *left, int op, AST_FilterNode *right);
 /* Arithmetic expression */
 AST_ArithmeticExpressionNode* New_AST_AR_EXP_VariableOperandNode(char* alias, char *property);
@@ -216,10 +261,15 @@ AST_ColumnNode* AST_ColumnNodeFromVariable(const AST_Variable *variable);
 AST_ColumnNode* AST_ColumnNodeFromAlias(const char *alias);
 AST_Variable* New_AST_Variable(const char *alias, const char *property);
 AST_LimitNode* New_AST_LimitNode(int limit);
+AST_SkipNode* New_AST_SkipNode(int skip);
+AST_CallNode* New_AST_CallNode(char *procedure, Vector *args, Vector *yields);
+AST_IndexNode* New_AST_IndexNode(const char *label, const char *property, AST_GraphEntityType entity_type, AST_IndexOpType operation);
 AST_QueryExpressionNode* New_AST_QueryExpressionNode(AST_MatchNode *matchNode, AST_WhereNode *whereNode,
 													 AST_CreateNode *createNode, AST_SetNode *setNode,
 													 AST_DeleteNode *deleteNode, AST_ReturnNode *returnNode,
-													 AST_OrderNode *orderNode, AST_LimitNode *limitNode);
+													 AST_OrderNode *orderNode, AST_SkipNode *skipNode,
+													 AST_LimitNode *limitNode, AST_CallNode *callNode,
+													 AST_IndexNode *indexNode);
 
 /* AST Validations */
 AST_Validation _Validate_MATCH_Clause(const AST_QueryExpressionNode* ast, char **reason);
@@ -228,21 +278,37 @@ AST_Validation _Validate_CREATE_Clause(const AST_QueryExpressionNode* ast, char
 AST_Validation _Validate_SET_Clause(const AST_QueryExpressionNode* ast, char **reason);
 AST_Validation _Validate_DELETE_Clause(const AST_QueryExpressionNode* ast, char **reason);
 AST_Validation _Validate_RETURN_Clause(const AST_QueryExpressionNode* ast, char **reason);
+AST_Validation _Validate_CALL_Clause(const AST_QueryExpressionNode* ast, char **reason);
 AST_Validation _Validate_Aliases_In_Match_Clause(const Vector* aliasesToCheck, 
 												 const Vector* elementsToCheckAgainst, 
 												 char** undefined_alias);
 AST_Validation Validate_AST(const AST_QueryExpressionNode* ast, char **reason);
 
+/* Collects the parameter placeholders within ast,
+ * returns a vector of AST_Param pointers. */
+Vector* AST_CollectParams(AST_QueryExpressionNode *ast);
+
+/* Binds each placeholder to the value of its named parameter, a placeholder
+ * can be bound over and over, the AST keeps its own copy of each value.
+ * Returns AST_INVALID and sets reason if a parameter's value is missing. */
+AST_Validation AST_BindParams(Vector *params, char **names, SIValue *values, int count, char **reason);
+
+void AST_FreeParams(Vector *params);
+
 void Free_AST_Variable(AST_Variable *v);
 void Free_AST_ColumnNode(AST_ColumnNode *node);
 void Free_AST_MatchNode(AST_MatchNode *matchNode);
 void Free_AST_CreateNode(AST_CreateNode *createNode);
+void Free_AST_SetNode(AST_SetNode *setNode);
 void Free_AST_DeleteNode(AST_DeleteNode *deleteNode);
 void Free_AST_WhereNode(AST_WhereNode *whereNode);
 void Free_AST_FilterNode(AST_FilterNode *filterNode);
 void Free_AST_ReturnNode(AST_ReturnNode *returnNode);
 void Free_AST_OrderNode(AST_OrderNode *orderNode);
 void Free_AST_LimitNode(AST_LimitNode *limitNode);
+void Free_AST_SkipNode(AST_SkipNode *skipNode);
+void Free_AST_CallNode(AST_CallNode *callNode);
+void Free_AST_IndexNode(AST_IndexNode *indexNode);
 void Free_AST_ReturnElementNode(AST_ReturnElementNode *returnElementNode);
 void Free_AST_ArithmeticExpressionNode(AST_ArithmeticExpressionNode *arExpNode);
 void Free_AST_GraphEntity(AST_GraphEntity *entity);
@@ -29,14 +29,16 @@
 	#include <stdlib.h>
 	#include <stdio.h>
 	#include <assert.h>
+	#include <string.h>
 	#include "token.h"	
 	#include "grammar.h"
 	#include "ast.h"
 	#include "parse.h"
+	#include "parser_common.h"
 	#include "../value.h"
 
 	void yyerror(char *s);
-#line 40 "grammar.c"
+#line 42 "grammar.c"
 /**************** End of %include directives **********************************/
 /* These constants specify the various numeric values for terminal symbols
 ** in a format understandable to "makeheaders".  This section is blank unless
@@ -98,32 +100,38 @@
 #endif
 /************* Begin control #defines *****************************************/
 #define YYCODETYPE unsigned char
-#define YYNOCODE 75
+#define YYNOCODE 95
 #define YYACTIONTYPE unsigned short int
 #define ParseTOKENTYPE Token
 typedef union {
   int yyinit;
   ParseTOKENTYPE yy0;
-  int yy8;
-  AST_OrderNode* yy12;
-  AST_MatchNode* yy17;
-  AST_NodeEntity* yy21;
-  AST_ReturnElementNode* yy26;
-  AST_DeleteNode * yy31;
-  AST_ArithmeticExpressionNode* yy42;
-  AST_WhereNode* yy59;
-  AST_SetElement* yy68;
-  AST_ReturnNode* yy72;
-  AST_Variable* yy76;
-  SIValue yy86;
-  AST_ColumnNode* yy90;
-  AST_FilterNode* yy102;
-  AST_CreateNode* yy104;
-  Vector* yy114;
-  AST_LinkEntity* yy117;
-  AST_QueryExpressionNode* yy118;
-  AST_SetNode* yy132;
-  AST_LimitNode* yy139;
+  AST_MatchNode* yy5;
+  AST_WhereNode* yy7;
+  AST_IndexNode* yy8;
+  AST_DeleteNode * yy15;
+  AST_SetElement* yy16;
+  AST_CreateNode* yy20;
+  double yy32;
+  AST_ArithmeticExpressionNode* yy34;
+  Vector* yy42;
+  SIValue yy46;
+  AST_LinkEntity* yy53;
+  AST_SkipNode* yy59;
+  AST_NodeEntity* yy81;
+  AST_ReturnElementNode* yy86;
+  int yy92;
+  AST_ColumnNode* yy98;
+  AST_SetNode* yy120;
+  AST_CallNode* yy124;
+  AST_ReturnNode* yy140;
+  AST_QueryExpressionNode* yy142;
+  AST_LimitNode* yy147;
+  int64_t yy149;
+  char* yy169;
+  AST_FilterNode* yy170;
+  AST_OrderNode* yy176;
+  AST_Variable* yy188;
 } YYMINORTYPE;
 #ifndef YYSTACKDEPTH
 #define YYSTACKDEPTH 100
@@ -132,17 +140,17 @@ typedef union {
 #define ParseARG_PDECL , parseCtx *ctx 
 #define ParseARG_FETCH  parseCtx *ctx  = yypParser->ctx 
 #define ParseARG_STORE yypParser->ctx  = ctx 
-#define YYNSTATE             99
-#define YYNRULE              82
-#define YYNTOKEN             43
-#define YY_MAX_SHIFT         98
-#define YY_MIN_SHIFTREDUCE   154
-#define YY_MAX_SHIFTREDUCE   235
-#define YY_ERROR_ACTION      236
-#define YY_ACCEPT_ACTION     237
-#define YY_NO_ACTION         238
-#define YY_MIN_REDUCE        239
-#define YY_MAX_REDUCE        320
+#define YYNSTATE             155
+#define YYNRULE              113
+#define YYNTOKEN             52
+#define YY_MAX_SHIFT         154
+#define YY_MIN_SHIFTREDUCE   235
+#define YY_MAX_SHIFTREDUCE   347
+#define YY_ERROR_ACTION      348
+#define YY_ACCEPT_ACTION     349
+#define YY_NO_ACTION         350
+#define YY_MIN_REDUCE        351
+#define YY_MAX_REDUCE        463
 /************* End control #defines *******************************************/
 
 /* Define the yytestcase() macro to be a no-op if is not already defined
@@ -208,100 +216,137 @@ typedef union {
 **  yy_default[]       Default action for each state.
 **
 *********** Begin parsing tables **********************************************/
-#define YY_ACTTAB_COUNT (240)
+#define YY_ACTTAB_COUNT (341)
 static const YYACTIONTYPE yy_action[] = {
- /*     0 */   277,   98,  237,   49,   59,  245,   11,    9,    8,    7,
- /*    10 */   251,   71,  223,  224,  227,  225,  226,   61,   10,  294,
- /*    20 */    51,   95,   59,   11,    9,    8,    7,   37,  293,   48,
- /*    30 */     2,   93,  284,  242,   45,   61,   10,  229,   20,  231,
- /*    40 */   232,  234,  235,  228,   59,   34,   11,    9,    8,    7,
- /*    50 */   305,   92,  294,   51,   85,  229,   24,  231,  232,  234,
- /*    60 */   235,  293,   59,  202,   91,  284,  303,  294,   52,   15,
- /*    70 */    14,   79,   33,   13,   15,   66,  293,  229,   81,  231,
- /*    80 */   232,  234,  235,  294,   51,   63,   64,   72,  250,   71,
- /*    90 */    29,  253,  293,  294,   54,  229,  283,  231,  232,  234,
- /*   100 */   235,   55,  293,   42,  294,   53,   30,   60,   75,  294,
- /*   110 */   291,  294,  290,  293,   40,  279,  294,   62,  293,  305,
- /*   120 */   293,  294,   50,  294,   58,  293,   25,   27,   19,  173,
- /*   130 */   293,   90,  293,   77,   56,  304,   29,  253,   31,   40,
- /*   140 */    83,   32,  253,   68,   26,  193,   40,  216,  217,   78,
- /*   150 */    89,    3,   25,   27,    8,    7,   40,  230,    6,   57,
- /*   160 */   233,   94,   84,  207,   70,   23,   40,   73,   74,   76,
- /*   170 */    86,   80,   82,  273,   88,   87,  254,   96,  244,   43,
- /*   180 */    97,    1,   46,   44,   28,   47,  240,   12,   18,   27,
- /*   190 */    65,  191,   21,   67,  174,   69,    5,   17,  180,  178,
- /*   200 */   183,   35,  184,   36,   16,  182,  179,  181,  176,   38,
- /*   210 */   177,   39,   22,    4,   41,  175,  201,  186,  213,  239,
- /*   220 */   238,  238,  238,  238,  238,  238,  238,  238,   94,  238,
- /*   230 */   238,  238,  238,  238,  238,  238,  238,  238,  238,  222,
+ /*     0 */    94,  405,   91,  375,   86,  109,  154,  349,   70,  376,
+ /*    10 */   357,  145,  334,  335,  338,  336,  337,   34,  360,   88,
+ /*    20 */    10,   38,   41,  381,   86,  334,  335,  338,  336,  337,
+ /*    30 */    11,    9,    8,    7,   33,  342,  426,   72,    2,   88,
+ /*    40 */    10,  108,  425,   86,   23,  340,  326,  343,  303,  345,
+ /*    50 */   346,  347,   86,  339,  150,  342,  148,  416,  122,  334,
+ /*    60 */   335,  338,  336,  337,  140,  340,  339,  343,  437,  345,
+ /*    70 */   346,  347,  437,  105,  342,   15,   14,   33,   11,    9,
+ /*    80 */     8,    7,  132,  342,  340,  120,  343,   47,  345,  346,
+ /*    90 */   347,   77,  436,  340,   59,  343,  435,  345,  346,  347,
+ /*   100 */   339,  426,   75,  426,   72,  426,   72,  425,   29,  425,
+ /*   110 */   144,  425,  444,   80,  147,   11,    9,    8,    7,   81,
+ /*   120 */    17,   16,   59,   87,  415,  146,  416,  426,   73,  426,
+ /*   130 */    74,  426,  423,  425,   52,  425,   56,  425,   51,  426,
+ /*   140 */   422,  426,   89,  130,   42,  425,   22,  425,  426,   71,
+ /*   150 */   426,   85,  106,   69,  425,   59,  425,  407,  354,   65,
+ /*   160 */   330,   53,  332,   41,  381,  127,  365,  126,  138,   43,
+ /*   170 */    35,   39,  134,  317,  318,  110,  366,  126,   44,  381,
+ /*   180 */    59,   40,   83,   36,   12,  111,  402,   37,  104,   90,
+ /*   190 */   294,  331,  100,  333,  118,  293,   25,   35,   39,  123,
+ /*   200 */   117,  136,    8,    7,  341,    6,  344,    3,  107,  445,
+ /*   210 */    76,  308,  149,  411,  408,   61,  133,   84,  139,  263,
+ /*   220 */    93,   45,  255,   78,  370,  153,  358,   48,  152,  151,
+ /*   230 */    49,    1,  270,  125,   50,   59,   32,  128,  129,  131,
+ /*   240 */   141,  356,  135,  137,  401,   62,  382,   63,   40,  142,
+ /*   250 */    64,  256,  352,   66,  143,   13,   24,   67,  264,   68,
+ /*   260 */    92,   46,   95,  253,   96,   39,   98,   99,  102,   97,
+ /*   270 */   101,  252,  103,   79,   21,  327,   19,   30,   28,   31,
+ /*   280 */   112,  115,    5,  113,  114,  277,  116,   82,  288,  124,
+ /*   290 */   290,   26,  271,   20,  119,  121,   54,  325,  351,  280,
+ /*   300 */   350,   55,  281,  279,   57,   58,  278,  275,  273,  274,
+ /*   310 */    27,    4,  276,   60,  272,  350,  302,  350,  350,  314,
+ /*   320 */   283,  350,  350,  350,  350,  350,  350,  149,  350,  350,
+ /*   330 */   350,  350,   18,  350,  350,  350,  350,  350,  350,  350,
+ /*   340 */   323,
 };
 static const YYCODETYPE yy_lookahead[] = {
- /*     0 */    66,   44,   45,   46,    4,   48,    3,    4,    5,    6,
- /*    10 */    56,   57,    7,    8,    9,   10,   11,   17,   18,   57,
- /*    20 */    58,   17,    4,    3,    4,    5,    6,    4,   66,   48,
- /*    30 */    30,   69,   70,   52,   53,   17,   18,   37,   68,   39,
- /*    40 */    40,   41,   42,   38,    4,   22,    3,    4,    5,    6,
- /*    50 */    57,   31,   57,   58,   66,   37,   18,   39,   40,   41,
- /*    60 */    42,   66,    4,   20,   69,   70,   73,   57,   58,   13,
- /*    70 */    14,   63,   16,   12,   13,   17,   66,   37,   63,   39,
- /*    80 */    40,   41,   42,   57,   58,   54,   67,   55,   56,   57,
- /*    90 */    59,   60,   66,   57,   58,   37,   70,   39,   40,   41,
- /*   100 */    42,   67,   66,   61,   57,   58,   17,   71,   19,   57,
- /*   110 */    58,   57,   58,   66,   25,   67,   57,   58,   66,   57,
- /*   120 */    66,   57,   58,   57,   58,   66,    1,    2,   15,   17,
- /*   130 */    66,   54,   66,   19,   72,   73,   59,   60,   17,   25,
- /*   140 */    19,   59,   60,   17,   18,   20,   25,   34,   35,   63,
- /*   150 */    19,   18,    1,    2,    5,    6,   25,   37,   15,   67,
- /*   160 */    40,   28,   63,   20,   62,   23,   25,   64,   63,   63,
- /*   170 */    17,   64,   63,   65,   63,   65,   60,   32,   51,   50,
- /*   180 */    36,   29,   50,   49,   27,   49,   51,   47,   15,    2,
- /*   190 */    28,   17,   17,   28,   17,   15,    7,   15,    4,   20,
- /*   200 */    24,   17,   24,   17,   33,   24,   21,   24,   20,   17,
- /*   210 */    20,   15,   19,   15,   17,   20,   17,   26,   17,    0,
- /*   220 */    74,   74,   74,   74,   74,   74,   74,   74,   28,   74,
- /*   230 */    74,   74,   74,   74,   74,   74,   74,   74,   74,   37,
- /*   240 */    74,   74,   74,   74,   74,   74,   74,   74,   74,   74,
- /*   250 */    74,   74,   74,   74,   74,   74,   74,   74,   74,   74,
- /*   260 */    74,   74,   74,   74,   74,   74,   74,   74,   74,   74,
- /*   270 */    74,   74,   74,   74,   74,   74,   74,   74,   74,   74,
- /*   280 */    74,   74,   74,
+ /*     0 */    72,   75,   74,   75,    4,    4,   53,   54,   55,   75,
+ /*    10 */    57,   66,    7,    8,    9,   10,   11,   64,   65,   19,
+ /*    20 */    20,   85,   77,   78,    4,    7,    8,    9,   10,   11,
+ /*    30 */     3,    4,    5,    6,   20,   35,   69,   70,   38,   19,
+ /*    40 */    20,   36,   75,    4,   85,   45,   45,   47,   21,   49,
+ /*    50 */    50,   51,    4,   48,   19,   35,   89,   90,   19,    7,
+ /*    60 */     8,    9,   10,   11,   75,   45,   48,   47,   69,   49,
+ /*    70 */    50,   51,   69,   16,   35,   12,   13,   20,    3,    4,
+ /*    80 */     5,    6,   18,   35,   45,   33,   47,   24,   49,   50,
+ /*    90 */    51,   92,   93,   45,   30,   47,   93,   49,   50,   51,
+ /*   100 */    48,   69,   70,   69,   70,   69,   70,   75,   85,   75,
+ /*   110 */    18,   75,   87,   88,   39,    3,    4,    5,    6,    4,
+ /*   120 */    13,   14,   30,   91,   90,   89,   90,   69,   70,   69,
+ /*   130 */    70,   69,   70,   75,   27,   75,    4,   75,   56,   69,
+ /*   140 */    70,   69,   70,   18,   19,   75,   15,   75,   69,   70,
+ /*   150 */    69,   70,   66,   57,   75,   30,   75,   86,   62,   63,
+ /*   160 */    45,   29,   47,   77,   78,   67,   68,   69,   18,   19,
+ /*   170 */     1,    2,   81,   42,   43,   86,   68,   69,   77,   78,
+ /*   180 */    30,   32,   19,   20,   20,   86,   37,   15,   18,   25,
+ /*   190 */    21,   45,   22,   47,   20,   23,   21,    1,    2,   25,
+ /*   200 */    25,   81,    5,    6,   45,   15,   47,   20,   84,   87,
+ /*   210 */    84,   21,   25,   84,   87,   79,   81,   84,   81,   19,
+ /*   220 */    76,   26,   19,   71,   73,   44,   61,   60,   46,   40,
+ /*   230 */    59,   37,   19,   80,   58,   30,   22,   82,   81,   81,
+ /*   240 */    19,   61,   82,   81,   83,   60,   78,   59,   32,   83,
+ /*   250 */    58,   19,   61,   60,   81,   56,   15,   59,   19,   58,
+ /*   260 */    15,   21,   19,   21,   20,    2,   19,   18,   20,   23,
+ /*   270 */    19,   21,   19,   17,   15,   45,   22,   15,   21,   15,
+ /*   280 */    19,   15,    7,   25,   19,    4,   19,   19,   19,   15,
+ /*   290 */    35,   19,   19,   15,   34,   25,   19,   45,    0,   23,
+ /*   300 */    94,   19,   23,   23,   19,   15,   23,   21,   21,   21,
+ /*   310 */    18,   15,   28,   19,   21,   94,   19,   94,   94,   19,
+ /*   320 */    31,   94,   94,   94,   94,   94,   94,   25,   94,   94,
+ /*   330 */    94,   94,   41,   94,   94,   94,   94,   94,   94,   94,
+ /*   340 */    45,   94,   94,   94,   94,   94,   94,   94,   94,   94,
+ /*   350 */    94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
+ /*   360 */    94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
+ /*   370 */    94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
+ /*   380 */    94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
+ /*   390 */    94,   94,   94,
 };
-#define YY_SHIFT_COUNT    (98)
+#define YY_SHIFT_COUNT    (154)
 #define YY_SHIFT_MIN      (0)
-#define YY_SHIFT_MAX      (219)
+#define YY_SHIFT_MAX      (302)
 static const unsigned short int yy_shift_ofst[] = {
- /*     0 */    61,    0,   18,   18,   18,   18,   18,   18,   18,   18,
- /*    10 */    18,   18,   56,   38,    4,   38,    4,    4,   38,    4,
- /*    20 */    58,    5,   40,   89,  121,  126,  126,  126,  126,   23,
- /*    30 */   114,  131,   23,  112,  142,  141,  141,  142,  141,  153,
- /*    40 */   153,  141,   38,  144,  145,  152,  144,  145,  152,  157,
- /*    50 */    43,   20,    3,    3,    3,  125,  113,  151,  149,  120,
- /*    60 */   143,  133,  149,  173,  187,  174,  162,  175,  165,  177,
- /*    70 */   180,  189,  182,  194,  176,  184,  178,  186,  181,  183,
- /*    80 */   185,  179,  188,  192,  190,  196,  193,  191,  195,  197,
- /*    90 */   173,  198,  199,  198,  201,  200,  171,  202,  219,
+ /*     0 */    63,    0,   20,   20,   20,   20,   20,   20,   20,   20,
+ /*    10 */    20,   20,   48,  107,   57,   14,   35,   14,   35,    1,
+ /*    20 */    35,   14,   35,   39,   48,    5,   52,   48,   18,  115,
+ /*    30 */   115,  115,  125,  150,  149,  163,  163,    1,    1,  163,
+ /*    40 */   163,  132,   64,   92,  132,  200,  195,  203,  181,  182,
+ /*    50 */   189,  194,  213,  214,  205,  205,  214,  205,  221,  221,
+ /*    60 */   205,   14,  181,  182,  189,  194,  181,  182,  189,  194,
+ /*    70 */   216,   27,   75,  112,  112,  112,  169,  131,  164,  170,
+ /*    80 */   172,  146,  175,  174,  196,  197,  159,  190,  187,  197,
+ /*    90 */   232,  241,  239,  245,  240,  242,  243,  244,  246,  247,
+ /*   100 */   249,  250,  251,  248,  253,  256,  259,  263,  254,  230,
+ /*   110 */   257,  262,  264,  261,  258,  265,  266,  267,  268,  255,
+ /*   120 */   260,  269,  270,  272,  273,  274,  275,  278,  281,  276,
+ /*   130 */   277,  279,  282,  280,  283,  284,  286,  287,  285,  288,
+ /*   140 */   290,  292,  289,  293,  294,  259,  296,  297,  296,  300,
+ /*   150 */   302,  291,  252,  295,  298,
 };
-#define YY_REDUCE_COUNT (49)
-#define YY_REDUCE_MIN   (-66)
-#define YY_REDUCE_MAX   (140)
+#define YY_REDUCE_COUNT (70)
+#define YY_REDUCE_MIN   (-74)
+#define YY_REDUCE_MAX   (201)
 static const short yy_reduce_ofst[] = {
- /*     0 */   -43,  -38,   -5,   36,   26,   10,   47,   52,   54,   59,
- /*    10 */    64,   66,  -19,   31,   32,   77,   62,  -46,   82,   -7,
- /*    20 */   -66,  -30,  -12,    8,   15,   19,   34,   48,   92,   42,
- /*    30 */    86,   99,   42,  102,  103,  105,  106,  107,  109,  108,
- /*    40 */   110,  111,  116,  127,  129,  134,  135,  132,  136,  140,
+ /*     0 */   -47,  -33,   36,   32,   34,   58,   60,   62,   70,   72,
+ /*    10 */    79,   81,  -72,   96,  -55,   86,   98,  -55,   -1,   25,
+ /*    20 */   108,  101,    3,  -74,  -66,  -64,  -41,  -11,   23,   71,
+ /*    30 */    89,   99,   91,  120,   82,  124,  126,  122,  127,  129,
+ /*    40 */   133,  136,  135,  137,  136,  144,  151,  152,  165,  167,
+ /*    50 */   171,  176,  153,  155,  157,  158,  160,  162,  161,  166,
+ /*    60 */   173,  168,  180,  185,  188,  192,  191,  193,  198,  201,
+ /*    70 */   199,
 };
 static const YYACTIONTYPE yy_default[] = {
- /*     0 */   247,  236,  236,  236,  236,  236,  236,  236,  236,  236,
- /*    10 */   236,  236,  247,  236,  236,  236,  236,  236,  236,  236,
- /*    20 */   236,  236,  236,  270,  270,  236,  236,  236,  236,  255,
- /*    30 */   270,  270,  256,  236,  236,  270,  270,  236,  270,  236,
- /*    40 */   236,  270,  236,  306,  299,  243,  306,  299,  241,  274,
- /*    50 */   236,  285,  252,  295,  296,  236,  300,  275,  288,  236,
- /*    60 */   236,  297,  289,  246,  280,  236,  236,  236,  236,  236,
- /*    70 */   257,  236,  249,  236,  236,  236,  236,  236,  236,  236,
- /*    80 */   236,  236,  236,  236,  236,  272,  236,  236,  236,  236,
- /*    90 */   248,  282,  236,  281,  236,  297,  236,  236,  236,
+ /*     0 */   362,  348,  348,  348,  348,  348,  348,  348,  348,  348,
+ /*    10 */   348,  348,  373,  362,  348,  348,  348,  348,  348,  348,
+ /*    20 */   348,  348,  348,  348,  348,  348,  348,  348,  348,  348,
+ /*    30 */   348,  348,  398,  398,  359,  348,  348,  348,  348,  348,
+ /*    40 */   348,  383,  398,  398,  384,  348,  377,  348,  438,  440,
+ /*    50 */   431,  348,  348,  348,  398,  398,  348,  398,  348,  348,
+ /*    60 */   398,  348,  438,  440,  431,  355,  438,  440,  431,  353,
+ /*    70 */   402,  348,  417,  367,  427,  428,  348,  432,  348,  348,
+ /*    80 */   348,  348,  348,  348,  403,  420,  348,  348,  429,  421,
+ /*    90 */   348,  374,  348,  378,  348,  348,  348,  348,  348,  348,
+ /*   100 */   348,  348,  348,  348,  348,  348,  361,  412,  348,  348,
+ /*   110 */   348,  348,  348,  348,  348,  348,  348,  348,  348,  348,
+ /*   120 */   348,  348,  348,  348,  348,  385,  348,  364,  348,  348,
+ /*   130 */   348,  348,  348,  348,  348,  348,  348,  348,  348,  348,
+ /*   140 */   400,  348,  348,  348,  348,  363,  414,  348,  413,  348,
+ /*   150 */   429,  348,  348,  348,  348,
 };
 /********** End of lemon-generated parsing tables *****************************/
 
@@ -423,64 +468,84 @@ static const char *const yyTokenName[] = {
   /*   13 */ "CREATE",
   /*   14 */ "SET",
   /*   15 */ "COMMA",
-  /*   16 */ "DELETE",
-  /*   17 */ "UQSTRING",
-  /*   18 */ "LEFT_PARENTHESIS",
-  /*   19 */ "COLON",
-  /*   20 */ "RIGHT_PARENTHESIS",
-  /*   21 */ "RIGHT_ARROW",
-  /*   22 */ "LEFT_ARROW",
-  /*   23 */ "LEFT_BRACKET",
-  /*   24 */ "RIGHT_BRACKET",
-  /*   25 */ "LEFT_CURLY_BRACKET",
-  /*   26 */ "RIGHT_CURLY_BRACKET",
-  /*   27 */ "WHERE",
-  /*   28 */ "DOT",
-  /*   29 */ "RETURN",
-  /*   30 */ "DISTINCT",
-  /*   31 */ "AS",
-  /*   32 */ "ORDER",
-  /*   33 */ "BY",
-  /*   34 */ "ASC",
-  /*   35 */ "DESC",
-  /*   36 */ "LIMIT",
-  /*   37 */ "INTEGER",
-  /*   38 */ "NE",
-  /*   39 */ "STRING",
-  /*   40 */ "FLOAT",
-  /*   41 */ "TRUE",
-  /*   42 */ "FALSE",
-  /*   43 */ "error",
-  /*   44 */ "expr",
-  /*   45 */ "query",
-  /*   46 */ "matchClause",
-  /*   47 */ "whereClause",
-  /*   48 */ "createClause",
-  /*   49 */ "returnClause",
-  /*   50 */ "orderClause",
-  /*   51 */ "limitClause",
-  /*   52 */ "deleteClause",
-  /*   53 */ "setClause",
-  /*   54 */ "chains",
-  /*   55 */ "setList",
-  /*   56 */ "setElement",
-  /*   57 */ "variable",
-  /*   58 */ "arithmetic_expression",
-  /*   59 */ "chain",
-  /*   60 */ "node",
-  /*   61 */ "link",
-  /*   62 */ "deleteExpression",
-  /*   63 */ "properties",
-  /*   64 */ "edge",
-  /*   65 */ "mapLiteral",
-  /*   66 */ "value",
-  /*   67 */ "cond",
-  /*   68 */ "relation",
-  /*   69 */ "returnElements",
-  /*   70 */ "returnElement",
-  /*   71 */ "arithmetic_expression_list",
-  /*   72 */ "columnNameList",
-  /*   73 */ "columnName",
+  /*   16 */ "INDEX",
+  /*   17 */ "ON",
+  /*   18 */ "COLON",
+  /*   19 */ "UQSTRING",
+  /*   20 */ "LEFT_PARENTHESIS",
+  /*   21 */ "RIGHT_PARENTHESIS",
+  /*   22 */ "LEFT_BRACKET",
+  /*   23 */ "RIGHT_BRACKET",
+  /*   24 */ "CALL",
+  /*   25 */ "DOT",
+  /*   26 */ "YIELD",
+  /*   27 */ "DELETE",
+  /*   28 */ "RIGHT_ARROW",
+  /*   29 */ "LEFT_ARROW",
+  /*   30 */ "LEFT_CURLY_BRACKET",
+  /*   31 */ "RIGHT_CURLY_BRACKET",
+  /*   32 */ "WHERE",
+  /*   33 */ "STARTS",
+  /*   34 */ "WITH",
+  /*   35 */ "STRING",
+  /*   36 */ "IN",
+  /*   37 */ "RETURN",
+  /*   38 */ "DISTINCT",
+  /*   39 */ "AS",
+  /*   40 */ "ORDER",
+  /*   41 */ "BY",
+  /*   42 */ "ASC",
+  /*   43 */ "DESC",
+  /*   44 */ "LIMIT",
+  /*   45 */ "INTEGER",
+  /*   46 */ "SKIP",
+  /*   47 */ "FLOAT",
+  /*   48 */ "NE",
+  /*   49 */ "TRUE",
+  /*   50 */ "FALSE",
+  /*   51 */ "PARAM",
+  /*   52 */ "error",
+  /*   53 */ "expr",
+  /*   54 */ "query",
+  /*   55 */ "matchClause",
+  /*   56 */ "whereClause",
+  /*   57 */ "createClause",
+  /*   58 */ "returnClause",
+  /*   59 */ "orderClause",
+  /*   60 */ "skipClause",
+  /*   61 */ "limitClause",
+  /*   62 */ "deleteClause",
+  /*   63 */ "setClause",
+  /*   64 */ "callClause",
+  /*   65 */ "indexClause",
+  /*   66 */ "chains",
+  /*   67 */ "setList",
+  /*   68 */ "setElement",
+  /*   69 */ "variable",
+  /*   70 */ "arithmetic_expression",
+  /*   71 */ "procedureName",
+  /*   72 */ "procedureArgs",
+  /*   73 */ "yieldClause",
+  /*   74 */ "valueList",
+  /*   75 */ "value",
+  /*   76 */ "yieldList",
+  /*   77 */ "chain",
+  /*   78 */ "node",
+  /*   79 */ "link",
+  /*   80 */ "deleteExpression",
+  /*   81 */ "properties",
+  /*   82 */ "edge",
+  /*   83 */ "mapLiteral",
+  /*   84 */ "cond",
+  /*   85 */ "relation",
+  /*   86 */ "coordinate",
+  /*   87 */ "entityId",
+  /*   88 */ "entityIdList",
+  /*   89 */ "returnElements",
+  /*   90 */ "returnElement",
+  /*   91 */ "arithmetic_expression_list",
+  /*   92 */ "columnNameList",
+  /*   93 */ "columnName",
 };
 #endif /* defined(YYCOVERAGE) || !defined(NDEBUG) */
 
@@ -489,87 +554,118 @@ static const char *const yyTokenName[] = {
 */
 static const char *const yyRuleName[] = {
  /*   0 */ "query ::= expr",
- /*   1 */ "expr ::= matchClause whereClause createClause returnClause orderClause limitClause",
+ /*   1 */ "expr ::= matchClause whereClause createClause returnClause orderClause skipClause limitClause",
  /*   2 */ "expr ::= matchClause whereClause createClause",
  /*   3 */ "expr ::= matchClause whereClause deleteClause",
  /*   4 */ "expr ::= matchClause whereClause setClause",
- /*   5 */ "expr ::= matchClause whereClause setClause returnClause orderClause limitClause",
+ /*   5 */ "expr ::= matchClause whereClause setClause returnClause orderClause skipClause limitClause",
  /*   6 */ "expr ::= createClause",
- /*   7 */ "matchClause ::= MATCH chains",
- /*   8 */ "createClause ::=",
- /*   9 */ "createClause ::= CREATE chains",
- /*  10 */ "setClause ::= SET setList",
- /*  11 */ "setList ::= setElement",
- /*  12 */ "setList ::= setList COMMA setElement",
- /*  13 */ "setElement ::= variable EQ arithmetic_expression",
- /*  14 */ "chain ::= node",
- /*  15 */ "chain ::= chain link node",
- /*  16 */ "chains ::= chain",
- /*  17 */ "chains ::= chains COMMA chain",
- /*  18 */ "deleteClause ::= DELETE deleteExpression",
- /*  19 */ "deleteExpression ::= UQSTRING",
- /*  20 */ "deleteExpression ::= deleteExpression COMMA UQSTRING",
- /*  21 */ "node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS",
- /*  22 */ "node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS",
- /*  23 */ "node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS",
- /*  24 */ "node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS",
- /*  25 */ "link ::= DASH edge RIGHT_ARROW",
- /*  26 */ "link ::= LEFT_ARROW edge DASH",
- /*  27 */ "edge ::= LEFT_BRACKET properties RIGHT_BRACKET",
- /*  28 */ "edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET",
- /*  29 */ "edge ::= LEFT_BRACKET COLON UQSTRING properties RIGHT_BRACKET",
- /*  30 */ "edge ::= LEFT_BRACKET UQSTRING COLON UQSTRING properties RIGHT_BRACKET",
- /*  31 */ "properties ::=",
- /*  32 */ "properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET",
- /*  33 */ "mapLiteral ::= UQSTRING COLON value",
- /*  34 */ "mapLiteral ::= UQSTRING COLON value COMMA mapLiteral",
- /*  35 */ "whereClause ::=",
- /*  36 */ "whereClause ::= WHERE cond",
- /*  37 */ "cond ::= UQSTRING DOT UQSTRING relation UQSTRING DOT UQSTRING",
- /*  38 */ "cond ::= UQSTRING DOT UQSTRING relation value",
- /*  39 */ "cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS",
- /*  40 */ "cond ::= cond AND cond",
- /*  41 */ "cond ::= cond OR cond",
- /*  42 */ "returnClause ::= RETURN returnElements",
- /*  43 */ "returnClause ::= RETURN DISTINCT returnElements",
- /*  44 */ "returnElements ::= returnElements COMMA returnElement",
- /*  45 */ "returnElements ::= returnElement",
- /*  46 */ "returnElement ::= arithmetic_expression",
- /*  47 */ "returnElement ::= arithmetic_expression AS UQSTRING",
- /*  48 */ "arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS",
- /*  49 */ "arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression",
- /*  50 */ "arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression",
- /*  51 */ "arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression",
- /*  52 */ "arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression",
- /*  53 */ "arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS",
- /*  54 */ "arithmetic_expression ::= value",
- /*  55 */ "arithmetic_expression ::= variable",
- /*  56 */ "arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression",
- /*  57 */ "arithmetic_expression_list ::= arithmetic_expression",
- /*  58 */ "variable ::= UQSTRING",
- /*  59 */ "variable ::= UQSTRING DOT UQSTRING",
- /*  60 */ "orderClause ::=",
- /*  61 */ "orderClause ::= ORDER BY columnNameList",
- /*  62 */ "orderClause ::= ORDER BY columnNameList ASC",
- /*  63 */ "orderClause ::= ORDER BY columnNameList DESC",
- /*  64 */ "columnNameList ::= columnNameList COMMA columnName",
- /*  65 */ "columnNameList ::= columnName",
- /*  66 */ "columnName ::= variable",
- /*  67 */ "limitClause ::=",
- /*  68 */ "limitClause ::= LIMIT INTEGER",
- /*  69 */ "relation ::= EQ",
- /*  70 */ "relation ::= GT",
- /*  71 */ "relation ::= LT",
- /*  72 */ "relation ::= LE",
- /*  73 */ "relation ::= GE",
- /*  74 */ "relation ::= NE",
- /*  75 */ "value ::= INTEGER",
- /*  76 */ "value ::= DASH INTEGER",
- /*  77 */ "value ::= STRING",
- /*  78 */ "value ::= FLOAT",
- /*  79 */ "value ::= DASH FLOAT",
- /*  80 */ "value ::= TRUE",
- /*  81 */ "value ::= FALSE",
+ /*   7 */ "expr ::= callClause whereClause returnClause orderClause skipClause limitClause",
+ /*   8 */ "expr ::= callClause",
+ /*   9 */ "expr ::= indexClause",
+ /*  10 */ "matchClause ::= MATCH chains",
+ /*  11 */ "createClause ::=",
+ /*  12 */ "createClause ::= CREATE chains",
+ /*  13 */ "setClause ::= SET setList",
+ /*  14 */ "setList ::= setElement",
+ /*  15 */ "setList ::= setList COMMA setElement",
+ /*  16 */ "setElement ::= variable EQ arithmetic_expression",
+ /*  17 */ "indexClause ::= CREATE INDEX ON COLON UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS",
+ /*  18 */ "indexClause ::= CREATE INDEX ON LEFT_BRACKET COLON UQSTRING RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS",
+ /*  19 */ "callClause ::= CALL procedureName LEFT_PARENTHESIS procedureArgs RIGHT_PARENTHESIS yieldClause",
+ /*  20 */ "procedureName ::= UQSTRING",
+ /*  21 */ "procedureName ::= procedureName DOT UQSTRING",
+ /*  22 */ "procedureArgs ::=",
+ /*  23 */ "procedureArgs ::= valueList",
+ /*  24 */ "valueList ::= value",
+ /*  25 */ "valueList ::= valueList COMMA value",
+ /*  26 */ "yieldClause ::=",
+ /*  27 */ "yieldClause ::= YIELD yieldList",
+ /*  28 */ "yieldList ::= UQSTRING",
+ /*  29 */ "yieldList ::= yieldList COMMA UQSTRING",
+ /*  30 */ "chain ::= node",
+ /*  31 */ "chain ::= chain link node",
+ /*  32 */ "chains ::= chain",
+ /*  33 */ "chains ::= chains COMMA chain",
+ /*  34 */ "deleteClause ::= DELETE deleteExpression",
+ /*  35 */ "deleteExpression ::= UQSTRING",
+ /*  36 */ "deleteExpression ::= deleteExpression COMMA UQSTRING",
+ /*  37 */ "node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS",
+ /*  38 */ "node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS",
+ /*  39 */ "node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS",
+ /*  40 */ "node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS",
+ /*  41 */ "link ::= DASH edge RIGHT_ARROW",
+ /*  42 */ "link ::= LEFT_ARROW edge DASH",
+ /*  43 */ "edge ::= LEFT_BRACKET properties RIGHT_BRACKET",
+ /*  44 */ "edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET",
+ /*  45 */ "edge ::= LEFT_BRACKET COLON UQSTRING properties RIGHT_BRACKET",
+ /*  46 */ "edge ::= LEFT_BRACKET UQSTRING COLON UQSTRING properties RIGHT_BRACKET",
+ /*  47 */ "properties ::=",
+ /*  48 */ "properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET",
+ /*  49 */ "mapLiteral ::= UQSTRING COLON value",
+ /*  50 */ "mapLiteral ::= UQSTRING COLON value COMMA mapLiteral",
+ /*  51 */ "whereClause ::=",
+ /*  52 */ "whereClause ::= WHERE cond",
+ /*  53 */ "cond ::= UQSTRING DOT UQSTRING relation UQSTRING DOT UQSTRING",
+ /*  54 */ "cond ::= UQSTRING DOT UQSTRING relation value",
+ /*  55 */ "cond ::= UQSTRING DOT UQSTRING STARTS WITH STRING",
+ /*  56 */ "cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING DOT UQSTRING COMMA UQSTRING DOT UQSTRING COMMA coordinate COMMA coordinate RIGHT_PARENTHESIS relation coordinate",
+ /*  57 */ "cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS relation entityId",
+ /*  58 */ "cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS IN LEFT_BRACKET entityIdList RIGHT_BRACKET",
+ /*  59 */ "cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS",
+ /*  60 */ "cond ::= cond AND cond",
+ /*  61 */ "cond ::= cond OR cond",
+ /*  62 */ "returnClause ::= RETURN returnElements",
+ /*  63 */ "returnClause ::= RETURN DISTINCT returnElements",
+ /*  64 */ "returnElements ::= returnElements COMMA returnElement",
+ /*  65 */ "returnElements ::= returnElement",
+ /*  66 */ "returnElement ::= arithmetic_expression",
+ /*  67 */ "returnElement ::= arithmetic_expression AS UQSTRING",
+ /*  68 */ "arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS",
+ /*  69 */ "arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression",
+ /*  70 */ "arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression",
+ /*  71 */ "arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression",
+ /*  72 */ "arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression",
+ /*  73 */ "arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS",
+ /*  74 */ "arithmetic_expression ::= value",
+ /*  75 */ "arithmetic_expression ::= variable",
+ /*  76 */ "arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression",
+ /*  77 */ "arithmetic_expression_list ::= arithmetic_expression",
+ /*  78 */ "variable ::= UQSTRING",
+ /*  79 */ "variable ::= UQSTRING DOT UQSTRING",
+ /*  80 */ "orderClause ::=",
+ /*  81 */ "orderClause ::= ORDER BY columnNameList",
+ /*  82 */ "orderClause ::= ORDER BY columnNameList ASC",
+ /*  83 */ "orderClause ::= ORDER BY columnNameList DESC",
+ /*  84 */ "columnNameList ::= columnNameList COMMA columnName",
+ /*  85 */ "columnNameList ::= columnName",
+ /*  86 */ "columnName ::= variable",
+ /*  87 */ "limitClause ::=",
+ /*  88 */ "limitClause ::= LIMIT INTEGER",
+ /*  89 */ "skipClause ::=",
+ /*  90 */ "skipClause ::= SKIP INTEGER",
+ /*  91 */ "entityId ::= INTEGER",
+ /*  92 */ "entityId ::= DASH INTEGER",
+ /*  93 */ "entityIdList ::= entityId",
+ /*  94 */ "entityIdList ::= entityIdList COMMA entityId",
+ /*  95 */ "coordinate ::= INTEGER",
+ /*  96 */ "coordinate ::= DASH INTEGER",
+ /*  97 */ "coordinate ::= FLOAT",
+ /*  98 */ "coordinate ::= DASH FLOAT",
+ /*  99 */ "relation ::= EQ",
+ /* 100 */ "relation ::= GT",
+ /* 101 */ "relation ::= LT",
+ /* 102 */ "relation ::= LE",
+ /* 103 */ "relation ::= GE",
+ /* 104 */ "relation ::= NE",
+ /* 105 */ "value ::= INTEGER",
+ /* 106 */ "value ::= DASH INTEGER",
+ /* 107 */ "value ::= STRING",
+ /* 108 */ "value ::= FLOAT",
+ /* 109 */ "value ::= DASH FLOAT",
+ /* 110 */ "value ::= TRUE",
+ /* 111 */ "value ::= FALSE",
+ /* 112 */ "value ::= PARAM",
 };
 #endif /* NDEBUG */
 
@@ -690,11 +786,11 @@ static void yy_destructor(
     ** inside the C code.
     */
 /********* Begin destructor definitions ***************************************/
-    case 67: /* cond */
+    case 84: /* cond */
 {
-#line 251 "grammar.y"
- Free_AST_FilterNode((yypminor->yy102)); 
-#line 698 "grammar.c"
+#line 334 "grammar.y"
+ Free_AST_FilterNode((yypminor->yy170)); 
+#line 794 "grammar.c"
 }
       break;
 /********* End destructor definitions *****************************************/
@@ -989,88 +1085,119 @@ static const struct {
   YYCODETYPE lhs;       /* Symbol on the left-hand side of the rule */
   signed char nrhs;     /* Negative of the number of RHS symbols in the rule */
 } yyRuleInfo[] = {
-  {   45,   -1 }, /* (0) query ::= expr */
-  {   44,   -6 }, /* (1) expr ::= matchClause whereClause createClause returnClause orderClause limitClause */
-  {   44,   -3 }, /* (2) expr ::= matchClause whereClause createClause */
-  {   44,   -3 }, /* (3) expr ::= matchClause whereClause deleteClause */
-  {   44,   -3 }, /* (4) expr ::= matchClause whereClause setClause */
-  {   44,   -6 }, /* (5) expr ::= matchClause whereClause setClause returnClause orderClause limitClause */
-  {   44,   -1 }, /* (6) expr ::= createClause */
-  {   46,   -2 }, /* (7) matchClause ::= MATCH chains */
-  {   48,    0 }, /* (8) createClause ::= */
-  {   48,   -2 }, /* (9) createClause ::= CREATE chains */
-  {   53,   -2 }, /* (10) setClause ::= SET setList */
-  {   55,   -1 }, /* (11) setList ::= setElement */
-  {   55,   -3 }, /* (12) setList ::= setList COMMA setElement */
-  {   56,   -3 }, /* (13) setElement ::= variable EQ arithmetic_expression */
-  {   59,   -1 }, /* (14) chain ::= node */
-  {   59,   -3 }, /* (15) chain ::= chain link node */
-  {   54,   -1 }, /* (16) chains ::= chain */
-  {   54,   -3 }, /* (17) chains ::= chains COMMA chain */
-  {   52,   -2 }, /* (18) deleteClause ::= DELETE deleteExpression */
-  {   62,   -1 }, /* (19) deleteExpression ::= UQSTRING */
-  {   62,   -3 }, /* (20) deleteExpression ::= deleteExpression COMMA UQSTRING */
-  {   60,   -6 }, /* (21) node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
-  {   60,   -5 }, /* (22) node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
-  {   60,   -4 }, /* (23) node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
-  {   60,   -3 }, /* (24) node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
-  {   61,   -3 }, /* (25) link ::= DASH edge RIGHT_ARROW */
-  {   61,   -3 }, /* (26) link ::= LEFT_ARROW edge DASH */
-  {   64,   -3 }, /* (27) edge ::= LEFT_BRACKET properties RIGHT_BRACKET */
-  {   64,   -4 }, /* (28) edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
-  {   64,   -5 }, /* (29) edge ::= LEFT_BRACKET COLON UQSTRING properties RIGHT_BRACKET */
-  {   64,   -6 }, /* (30) edge ::= LEFT_BRACKET UQSTRING COLON UQSTRING properties RIGHT_BRACKET */
-  {   63,    0 }, /* (31) properties ::= */
-  {   63,   -3 }, /* (32) properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
-  {   65,   -3 }, /* (33) mapLiteral ::= UQSTRING COLON value */
-  {   65,   -5 }, /* (34) mapLiteral ::= UQSTRING COLON value COMMA mapLiteral */
-  {   47,    0 }, /* (35) whereClause ::= */
-  {   47,   -2 }, /* (36) whereClause ::= WHERE cond */
-  {   67,   -7 }, /* (37) cond ::= UQSTRING DOT UQSTRING relation UQSTRING DOT UQSTRING */
-  {   67,   -5 }, /* (38) cond ::= UQSTRING DOT UQSTRING relation value */
-  {   67,   -3 }, /* (39) cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
-  {   67,   -3 }, /* (40) cond ::= cond AND cond */
-  {   67,   -3 }, /* (41) cond ::= cond OR cond */
-  {   49,   -2 }, /* (42) returnClause ::= RETURN returnElements */
-  {   49,   -3 }, /* (43) returnClause ::= RETURN DISTINCT returnElements */
-  {   69,   -3 }, /* (44) returnElements ::= returnElements COMMA returnElement */
-  {   69,   -1 }, /* (45) returnElements ::= returnElement */
-  {   70,   -1 }, /* (46) returnElement ::= arithmetic_expression */
-  {   70,   -3 }, /* (47) returnElement ::= arithmetic_expression AS UQSTRING */
-  {   58,   -3 }, /* (48) arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
-  {   58,   -3 }, /* (49) arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
-  {   58,   -3 }, /* (50) arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
-  {   58,   -3 }, /* (51) arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
-  {   58,   -3 }, /* (52) arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
-  {   58,   -4 }, /* (53) arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
-  {   58,   -1 }, /* (54) arithmetic_expression ::= value */
-  {   58,   -1 }, /* (55) arithmetic_expression ::= variable */
-  {   71,   -3 }, /* (56) arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
-  {   71,   -1 }, /* (57) arithmetic_expression_list ::= arithmetic_expression */
-  {   57,   -1 }, /* (58) variable ::= UQSTRING */
-  {   57,   -3 }, /* (59) variable ::= UQSTRING DOT UQSTRING */
-  {   50,    0 }, /* (60) orderClause ::= */
-  {   50,   -3 }, /* (61) orderClause ::= ORDER BY columnNameList */
-  {   50,   -4 }, /* (62) orderClause ::= ORDER BY columnNameList ASC */
-  {   50,   -4 }, /* (63) orderClause ::= ORDER BY columnNameList DESC */
-  {   72,   -3 }, /* (64) columnNameList ::= columnNameList COMMA columnName */
-  {   72,   -1 }, /* (65) columnNameList ::= columnName */
-  {   73,   -1 }, /* (66) columnName ::= variable */
-  {   51,    0 }, /* (67) limitClause ::= */
-  {   51,   -2 }, /* (68) limitClause ::= LIMIT INTEGER */
-  {   68,   -1 }, /* (69) relation ::= EQ */
-  {   68,   -1 }, /* (70) relation ::= GT */
-  {   68,   -1 }, /* (71) relation ::= LT */
-  {   68,   -1 }, /* (72) relation ::= LE */
-  {   68,   -1 }, /* (73) relation ::= GE */
-  {   68,   -1 }, /* (74) relation ::= NE */
-  {   66,   -1 }, /* (75) value ::= INTEGER */
-  {   66,   -2 }, /* (76) value ::= DASH INTEGER */
-  {   66,   -1 }, /* (77) value ::= STRING */
-  {   66,   -1 }, /* (78) value ::= FLOAT */
-  {   66,   -2 }, /* (79) value ::= DASH FLOAT */
-  {   66,   -1 }, /* (80) value ::= TRUE */
-  {   66,   -1 }, /* (81) value ::= FALSE */
+  {   54,   -1 }, /* (0) query ::= expr */
+  {   53,   -7 }, /* (1) expr ::= matchClause whereClause createClause returnClause orderClause skipClause limitClause */
+  {   53,   -3 }, /* (2) expr ::= matchClause whereClause createClause */
+  {   53,   -3 }, /* (3) expr ::= matchClause whereClause deleteClause */
+  {   53,   -3 }, /* (4) expr ::= matchClause whereClause setClause */
+  {   53,   -7 }, /* (5) expr ::= matchClause whereClause setClause returnClause orderClause skipClause limitClause */
+  {   53,   -1 }, /* (6) expr ::= createClause */
+  {   53,   -6 }, /* (7) expr ::= callClause whereClause returnClause orderClause skipClause limitClause */
+  {   53,   -1 }, /* (8) expr ::= callClause */
+  {   53,   -1 }, /* (9) expr ::= indexClause */
+  {   55,   -2 }, /* (10) matchClause ::= MATCH chains */
+  {   57,    0 }, /* (11) createClause ::= */
+  {   57,   -2 }, /* (12) createClause ::= CREATE chains */
+  {   63,   -2 }, /* (13) setClause ::= SET setList */
+  {   67,   -1 }, /* (14) setList ::= setElement */
+  {   67,   -3 }, /* (15) setList ::= setList COMMA setElement */
+  {   68,   -3 }, /* (16) setElement ::= variable EQ arithmetic_expression */
+  {   65,   -8 }, /* (17) indexClause ::= CREATE INDEX ON COLON UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS */
+  {   65,  -10 }, /* (18) indexClause ::= CREATE INDEX ON LEFT_BRACKET COLON UQSTRING RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS */
+  {   64,   -6 }, /* (19) callClause ::= CALL procedureName LEFT_PARENTHESIS procedureArgs RIGHT_PARENTHESIS yieldClause */
+  {   71,   -1 }, /* (20) procedureName ::= UQSTRING */
+  {   71,   -3 }, /* (21) procedureName ::= procedureName DOT UQSTRING */
+  {   72,    0 }, /* (22) procedureArgs ::= */
+  {   72,   -1 }, /* (23) procedureArgs ::= valueList */
+  {   74,   -1 }, /* (24) valueList ::= value */
+  {   74,   -3 }, /* (25) valueList ::= valueList COMMA value */
+  {   73,    0 }, /* (26) yieldClause ::= */
+  {   73,   -2 }, /* (27) yieldClause ::= YIELD yieldList */
+  {   76,   -1 }, /* (28) yieldList ::= UQSTRING */
+  {   76,   -3 }, /* (29) yieldList ::= yieldList COMMA UQSTRING */
+  {   77,   -1 }, /* (30) chain ::= node */
+  {   77,   -3 }, /* (31) chain ::= chain link node */
+  {   66,   -1 }, /* (32) chains ::= chain */
+  {   66,   -3 }, /* (33) chains ::= chains COMMA chain */
+  {   62,   -2 }, /* (34) deleteClause ::= DELETE deleteExpression */
+  {   80,   -1 }, /* (35) deleteExpression ::= UQSTRING */
+  {   80,   -3 }, /* (36) deleteExpression ::= deleteExpression COMMA UQSTRING */
+  {   78,   -6 }, /* (37) node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
+  {   78,   -5 }, /* (38) node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
+  {   78,   -4 }, /* (39) node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
+  {   78,   -3 }, /* (40) node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
+  {   79,   -3 }, /* (41) link ::= DASH edge RIGHT_ARROW */
+  {   79,   -3 }, /* (42) link ::= LEFT_ARROW edge DASH */
+  {   82,   -3 }, /* (43) edge ::= LEFT_BRACKET properties RIGHT_BRACKET */
+  {   82,   -4 }, /* (44) edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
+  {   82,   -5 }, /* (45) edge ::= LEFT_BRACKET COLON UQSTRING properties RIGHT_BRACKET */
+  {   82,   -6 }, /* (46) edge ::= LEFT_BRACKET UQSTRING COLON UQSTRING properties RIGHT_BRACKET */
+  {   81,    0 }, /* (47) properties ::= */
+  {   81,   -3 }, /* (48) properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
+  {   83,   -3 }, /* (49) mapLiteral ::= UQSTRING COLON value */
+  {   83,   -5 }, /* (50) mapLiteral ::= UQSTRING COLON value COMMA mapLiteral */
+  {   56,    0 }, /* (51) whereClause ::= */
+  {   56,   -2 }, /* (52) whereClause ::= WHERE cond */
+  {   84,   -7 }, /* (53) cond ::= UQSTRING DOT UQSTRING relation UQSTRING DOT UQSTRING */
+  {   84,   -5 }, /* (54) cond ::= UQSTRING DOT UQSTRING relation value */
+  {   84,   -6 }, /* (55) cond ::= UQSTRING DOT UQSTRING STARTS WITH STRING */
+  {   84,  -16 }, /* (56) cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING DOT UQSTRING COMMA UQSTRING DOT UQSTRING COMMA coordinate COMMA coordinate RIGHT_PARENTHESIS relation coordinate */
+  {   84,   -6 }, /* (57) cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS relation entityId */
+  {   84,   -8 }, /* (58) cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS IN LEFT_BRACKET entityIdList RIGHT_BRACKET */
+  {   84,   -3 }, /* (59) cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
+  {   84,   -3 }, /* (60) cond ::= cond AND cond */
+  {   84,   -3 }, /* (61) cond ::= cond OR cond */
+  {   58,   -2 }, /* (62) returnClause ::= RETURN returnElements */
+  {   58,   -3 }, /* (63) returnClause ::= RETURN DISTINCT returnElements */
+  {   89,   -3 }, /* (64) returnElements ::= returnElements COMMA returnElement */
+  {   89,   -1 }, /* (65) returnElements ::= returnElement */
+  {   90,   -1 }, /* (66) returnElement ::= arithmetic_expression */
+  {   90,   -3 }, /* (67) returnElement ::= arithmetic_expression AS UQSTRING */
+  {   70,   -3 }, /* (68) arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
+  {   70,   -3 }, /* (69) arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
+  {   70,   -3 }, /* (70) arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
+  {   70,   -3 }, /* (71) arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
+  {   70,   -3 }, /* (72) arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
+  {   70,   -4 }, /* (73) arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
+  {   70,   -1 }, /* (74) arithmetic_expression ::= value */
+  {   70,   -1 }, /* (75) arithmetic_expression ::= variable */
+  {   91,   -3 }, /* (76) arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
+  {   91,   -1 }, /* (77) arithmetic_expression_list ::= arithmetic_expression */
+  {   69,   -1 }, /* (78) variable ::= UQSTRING */
+  {   69,   -3 }, /* (79) variable ::= UQSTRING DOT UQSTRING */
+  {   59,    0 }, /* (80) orderClause ::= */
+  {   59,   -3 }, /* (81) orderClause ::= ORDER BY columnNameList */
+  {   59,   -4 }, /* (82) orderClause ::= ORDER BY columnNameList ASC */
+  {   59,   -4 }, /* (83) orderClause ::= ORDER BY columnNameList DESC */
+  {   92,   -3 }, /* (84) columnNameList ::= columnNameList COMMA columnName */
+  {   92,   -1 }, /* (85) columnNameList ::= columnName */
+  {   93,   -1 }, /* (86) columnName ::= variable */
+  {   61,    0 }, /* (87) limitClause ::= */
+  {   61,   -2 }, /* (88) limitClause ::= LIMIT INTEGER */
+  {   60,    0 }, /* (89) skipClause ::= */
+  {   60,   -2 }, /* (90) skipClause ::= SKIP INTEGER */
+  {   87,   -1 }, /* (91) entityId ::= INTEGER */
+  {   87,   -2 }, /* (92) entityId ::= DASH INTEGER */
+  {   88,   -1 }, /* (93) entityIdList ::= entityId */
+  {   88,   -3 }, /* (94) entityIdList ::= entityIdList COMMA entityId */
+  {   86,   -1 }, /* (95) coordinate ::= INTEGER */
+  {   86,   -2 }, /* (96) coordinate ::= DASH INTEGER */
+  {   86,   -1 }, /* (97) coordinate ::= FLOAT */
+  {   86,   -2 }, /* (98) coordinate ::= DASH FLOAT */
+  {   85,   -1 }, /* (99) relation ::= EQ */
+  {   85,   -1 }, /* (100) relation ::= GT */
+  {   85,   -1 }, /* (101) relation ::= LT */
+  {   85,   -1 }, /* (102) relation ::= LE */
+  {   85,   -1 }, /* (103) relation ::= GE */
+  {   85,   -1 }, /* (104) relation ::= NE */
+  {   75,   -1 }, /* (105) value ::= INTEGER */
+  {   75,   -2 }, /* (106) value ::= DASH INTEGER */
+  {   75,   -1 }, /* (107) value ::= STRING */
+  {   75,   -1 }, /* (108) value ::= FLOAT */
+  {   75,   -2 }, /* (109) value ::= DASH FLOAT */
+  {   75,   -1 }, /* (110) value ::= TRUE */
+  {   75,   -1 }, /* (111) value ::= FALSE */
+  {   75,   -1 }, /* (112) value ::= PARAM */
 };
 
 static void yy_accept(yyParser*);  /* Forward Declaration */
@@ -1151,639 +1278,874 @@ static void yy_reduce(
 /********** Begin reduce actions **********************************************/
         YYMINORTYPE yylhsminor;
       case 0: /* query ::= expr */
-#line 35 "grammar.y"
-{ ctx->root = yymsp[0].minor.yy118; }
-#line 1157 "grammar.c"
-        break;
-      case 1: /* expr ::= matchClause whereClause createClause returnClause orderClause limitClause */
 #line 37 "grammar.y"
+{ ctx->root = yymsp[0].minor.yy142; }
+#line 1284 "grammar.c"
+        break;
+      case 1: /* expr ::= matchClause whereClause createClause returnClause orderClause skipClause limitClause */
+#line 39 "grammar.y"
 {
-	yylhsminor.yy118 = New_AST_QueryExpressionNode(yymsp[-5].minor.yy17, yymsp[-4].minor.yy59, yymsp[-3].minor.yy104, NULL, NULL, yymsp[-2].minor.yy72, yymsp[-1].minor.yy12, yymsp[0].minor.yy139);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(yymsp[-6].minor.yy5, yymsp[-5].minor.yy7, yymsp[-4].minor.yy20, NULL, NULL, yymsp[-3].minor.yy140, yymsp[-2].minor.yy176, yymsp[-1].minor.yy59, yymsp[0].minor.yy147, NULL, NULL);
 }
-#line 1164 "grammar.c"
-  yymsp[-5].minor.yy118 = yylhsminor.yy118;
+#line 1291 "grammar.c"
+  yymsp[-6].minor.yy142 = yylhsminor.yy142;
         break;
       case 2: /* expr ::= matchClause whereClause createClause */
-#line 41 "grammar.y"
+#line 43 "grammar.y"
 {
-	yylhsminor.yy118 = New_AST_QueryExpressionNode(yymsp[-2].minor.yy17, yymsp[-1].minor.yy59, yymsp[0].minor.yy104, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(yymsp[-2].minor.yy5, yymsp[-1].minor.yy7, yymsp[0].minor.yy20, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1172 "grammar.c"
-  yymsp[-2].minor.yy118 = yylhsminor.yy118;
+#line 1299 "grammar.c"
+  yymsp[-2].minor.yy142 = yylhsminor.yy142;
         break;
       case 3: /* expr ::= matchClause whereClause deleteClause */
-#line 45 "grammar.y"
+#line 47 "grammar.y"
 {
-	yylhsminor.yy118 = New_AST_QueryExpressionNode(yymsp[-2].minor.yy17, yymsp[-1].minor.yy59, NULL, NULL, yymsp[0].minor.yy31, NULL, NULL, NULL);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(yymsp[-2].minor.yy5, yymsp[-1].minor.yy7, NULL, NULL, yymsp[0].minor.yy15, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1180 "grammar.c"
-  yymsp[-2].minor.yy118 = yylhsminor.yy118;
+#line 1307 "grammar.c"
+  yymsp[-2].minor.yy142 = yylhsminor.yy142;
         break;
       case 4: /* expr ::= matchClause whereClause setClause */
-#line 49 "grammar.y"
+#line 51 "grammar.y"
 {
-	yylhsminor.yy118 = New_AST_QueryExpressionNode(yymsp[-2].minor.yy17, yymsp[-1].minor.yy59, NULL, yymsp[0].minor.yy132, NULL, NULL, NULL, NULL);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(yymsp[-2].minor.yy5, yymsp[-1].minor.yy7, NULL, yymsp[0].minor.yy120, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1188 "grammar.c"
-  yymsp[-2].minor.yy118 = yylhsminor.yy118;
+#line 1315 "grammar.c"
+  yymsp[-2].minor.yy142 = yylhsminor.yy142;
         break;
-      case 5: /* expr ::= matchClause whereClause setClause returnClause orderClause limitClause */
-#line 53 "grammar.y"
+      case 5: /* expr ::= matchClause whereClause setClause returnClause orderClause skipClause limitClause */
+#line 55 "grammar.y"
 {
-	yylhsminor.yy118 = New_AST_QueryExpressionNode(yymsp[-5].minor.yy17, yymsp[-4].minor.yy59, NULL, yymsp[-3].minor.yy132, NULL, yymsp[-2].minor.yy72, yymsp[-1].minor.yy12, yymsp[0].minor.yy139);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(yymsp[-6].minor.yy5, yymsp[-5].minor.yy7, NULL, yymsp[-4].minor.yy120, NULL, yymsp[-3].minor.yy140, yymsp[-2].minor.yy176, yymsp[-1].minor.yy59, yymsp[0].minor.yy147, NULL, NULL);
 }
-#line 1196 "grammar.c"
-  yymsp[-5].minor.yy118 = yylhsminor.yy118;
+#line 1323 "grammar.c"
+  yymsp[-6].minor.yy142 = yylhsminor.yy142;
         break;
       case 6: /* expr ::= createClause */
-#line 57 "grammar.y"
+#line 59 "grammar.y"
 {
-	yylhsminor.yy118 = New_AST_QueryExpressionNode(NULL, NULL, yymsp[0].minor.yy104, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(NULL, NULL, yymsp[0].minor.yy20, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1204 "grammar.c"
-  yymsp[0].minor.yy118 = yylhsminor.yy118;
+#line 1331 "grammar.c"
+  yymsp[0].minor.yy142 = yylhsminor.yy142;
         break;
-      case 7: /* matchClause ::= MATCH chains */
+      case 7: /* expr ::= callClause whereClause returnClause orderClause skipClause limitClause */
 #line 63 "grammar.y"
 {
-	yymsp[-1].minor.yy17 = New_AST_MatchNode(yymsp[0].minor.yy114);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(NULL, yymsp[-4].minor.yy7, NULL, NULL, NULL, yymsp[-3].minor.yy140, yymsp[-2].minor.yy176, yymsp[-1].minor.yy59, yymsp[0].minor.yy147, yymsp[-5].minor.yy124, NULL);
 }
-#line 1212 "grammar.c"
+#line 1339 "grammar.c"
+  yymsp[-5].minor.yy142 = yylhsminor.yy142;
         break;
-      case 8: /* createClause ::= */
-#line 70 "grammar.y"
+      case 8: /* expr ::= callClause */
+#line 67 "grammar.y"
 {
-	yymsp[1].minor.yy104 = NULL;
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy124, NULL);
 }
-#line 1219 "grammar.c"
+#line 1347 "grammar.c"
+  yymsp[0].minor.yy142 = yylhsminor.yy142;
         break;
-      case 9: /* createClause ::= CREATE chains */
-#line 74 "grammar.y"
+      case 9: /* expr ::= indexClause */
+#line 71 "grammar.y"
 {
-	yymsp[-1].minor.yy104 = New_AST_CreateNode(yymsp[0].minor.yy114);
+	yylhsminor.yy142 = New_AST_QueryExpressionNode(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy8);
 }
-#line 1226 "grammar.c"
+#line 1355 "grammar.c"
+  yymsp[0].minor.yy142 = yylhsminor.yy142;
         break;
-      case 10: /* setClause ::= SET setList */
-#line 79 "grammar.y"
+      case 10: /* matchClause ::= MATCH chains */
+#line 77 "grammar.y"
 {
-	yymsp[-1].minor.yy132 = New_AST_SetNode(yymsp[0].minor.yy114);
+	yymsp[-1].minor.yy5 = New_AST_MatchNode(yymsp[0].minor.yy42);
 }
-#line 1233 "grammar.c"
+#line 1363 "grammar.c"
         break;
-      case 11: /* setList ::= setElement */
+      case 11: /* createClause ::= */
 #line 84 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(AST_SetElement*, 1);
-	Vector_Push(yylhsminor.yy114, yymsp[0].minor.yy68);
+	yymsp[1].minor.yy20 = NULL;
 }
-#line 1241 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1370 "grammar.c"
         break;
-      case 12: /* setList ::= setList COMMA setElement */
+      case 12: /* createClause ::= CREATE chains */
 #line 88 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[0].minor.yy68);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	yymsp[-1].minor.yy20 = New_AST_CreateNode(yymsp[0].minor.yy42);
 }
-#line 1250 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1377 "grammar.c"
         break;
-      case 13: /* setElement ::= variable EQ arithmetic_expression */
-#line 94 "grammar.y"
+      case 13: /* setClause ::= SET setList */
+#line 93 "grammar.y"
 {
-	yylhsminor.yy68 = New_AST_SetElement(yymsp[-2].minor.yy76, yymsp[0].minor.yy42);
+	yymsp[-1].minor.yy120 = New_AST_SetNode(yymsp[0].minor.yy42);
 }
-#line 1258 "grammar.c"
-  yymsp[-2].minor.yy68 = yylhsminor.yy68;
+#line 1384 "grammar.c"
         break;
-      case 14: /* chain ::= node */
-#line 100 "grammar.y"
+      case 14: /* setList ::= setElement */
+#line 98 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(AST_GraphEntity*, 1);
-	Vector_Push(yylhsminor.yy114, yymsp[0].minor.yy21);
+	yylhsminor.yy42 = NewVector(AST_SetElement*, 1);
+	Vector_Push(yylhsminor.yy42, yymsp[0].minor.yy16);
 }
-#line 1267 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1392 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 15: /* chain ::= chain link node */
-#line 105 "grammar.y"
+      case 15: /* setList ::= setList COMMA setElement */
+#line 102 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[-1].minor.yy117);
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[0].minor.yy21);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[0].minor.yy16);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
 }
-#line 1277 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1401 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 16: /* chains ::= chain */
-#line 112 "grammar.y"
+      case 16: /* setElement ::= variable EQ arithmetic_expression */
+#line 108 "grammar.y"
 {
-	yylhsminor.yy114 = yymsp[0].minor.yy114;
+	yylhsminor.yy16 = New_AST_SetElement(yymsp[-2].minor.yy188, yymsp[0].minor.yy34);
 }
-#line 1285 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1409 "grammar.c"
+  yymsp[-2].minor.yy16 = yylhsminor.yy16;
         break;
-      case 17: /* chains ::= chains COMMA chain */
-#line 116 "grammar.y"
+      case 17: /* indexClause ::= CREATE INDEX ON COLON UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS */
+#line 114 "grammar.y"
 {
-	for(int i = 0; i < Vector_Size(yymsp[0].minor.yy114); i++) {
-		AST_GraphEntity *entity;
-		Vector_Get(yymsp[0].minor.yy114, i, &entity);
-		Vector_Push(yymsp[-2].minor.yy114, entity);
-	}
-	Vector_Free(yymsp[0].minor.yy114);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	yymsp[-7].minor.yy8 = New_AST_IndexNode(yymsp[-3].minor.yy0.strval, yymsp[-1].minor.yy0.strval, N_ENTITY, CREATE_INDEX);
 }
-#line 1299 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1417 "grammar.c"
         break;
-      case 18: /* deleteClause ::= DELETE deleteExpression */
-#line 129 "grammar.y"
+      case 18: /* indexClause ::= CREATE INDEX ON LEFT_BRACKET COLON UQSTRING RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS */
+#line 119 "grammar.y"
 {
-	yymsp[-1].minor.yy31 = New_AST_DeleteNode(yymsp[0].minor.yy114);
+	yymsp[-9].minor.yy8 = New_AST_IndexNode(yymsp[-4].minor.yy0.strval, yymsp[-1].minor.yy0.strval, N_LINK, CREATE_INDEX);
 }
-#line 1307 "grammar.c"
+#line 1424 "grammar.c"
         break;
-      case 19: /* deleteExpression ::= UQSTRING */
-#line 135 "grammar.y"
+      case 19: /* callClause ::= CALL procedureName LEFT_PARENTHESIS procedureArgs RIGHT_PARENTHESIS yieldClause */
+#line 125 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(char*, 1);
-	Vector_Push(yylhsminor.yy114, yymsp[0].minor.yy0.strval);
+	yymsp[-5].minor.yy124 = New_AST_CallNode(yymsp[-4].minor.yy169, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
 }
-#line 1315 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1431 "grammar.c"
         break;
-      case 20: /* deleteExpression ::= deleteExpression COMMA UQSTRING */
-#line 140 "grammar.y"
+      case 20: /* procedureName ::= UQSTRING */
+#line 130 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[0].minor.yy0.strval);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	yylhsminor.yy169 = yymsp[0].minor.yy0.strval;
 }
-#line 1324 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1438 "grammar.c"
+  yymsp[0].minor.yy169 = yylhsminor.yy169;
         break;
-      case 21: /* node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
-#line 148 "grammar.y"
+      case 21: /* procedureName ::= procedureName DOT UQSTRING */
+#line 134 "grammar.y"
 {
-	yymsp[-5].minor.yy21 = New_AST_NodeEntity(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy114);
+	asprintf(&yylhsminor.yy169, "%s.%s", yymsp[-2].minor.yy169, yymsp[0].minor.yy0.strval);
+	free(yymsp[-2].minor.yy169);
+	free(yymsp[0].minor.yy0.strval);
 }
-#line 1332 "grammar.c"
+#line 1448 "grammar.c"
+  yymsp[-2].minor.yy169 = yylhsminor.yy169;
         break;
-      case 22: /* node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
-#line 153 "grammar.y"
+      case 22: /* procedureArgs ::= */
+#line 142 "grammar.y"
 {
-	yymsp[-4].minor.yy21 = New_AST_NodeEntity(NULL, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy114);
+	yymsp[1].minor.yy42 = NewVector(SIValue*, 0);
 }
-#line 1339 "grammar.c"
+#line 1456 "grammar.c"
+        break;
+      case 23: /* procedureArgs ::= valueList */
+      case 32: /* chains ::= chain */ yytestcase(yyruleno==32);
+#line 145 "grammar.y"
+{
+	yylhsminor.yy42 = yymsp[0].minor.yy42;
+}
+#line 1464 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 23: /* node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
-#line 158 "grammar.y"
+      case 24: /* valueList ::= value */
+#line 150 "grammar.y"
 {
-	yymsp[-3].minor.yy21 = New_AST_NodeEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy114);
+	yylhsminor.yy42 = NewVector(SIValue*, 1);
+	SIValue *val = malloc(sizeof(SIValue));
+	*val = yymsp[0].minor.yy46;
+	Vector_Push(yylhsminor.yy42, val);
 }
-#line 1346 "grammar.c"
+#line 1475 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 24: /* node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
-#line 163 "grammar.y"
+      case 25: /* valueList ::= valueList COMMA value */
+#line 156 "grammar.y"
 {
-	yymsp[-2].minor.yy21 = New_AST_NodeEntity(NULL, NULL, yymsp[-1].minor.yy114);
+	SIValue *val = malloc(sizeof(SIValue));
+	*val = yymsp[0].minor.yy46;
+	Vector_Push(yymsp[-2].minor.yy42, val);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
 }
-#line 1353 "grammar.c"
+#line 1486 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 25: /* link ::= DASH edge RIGHT_ARROW */
-#line 170 "grammar.y"
+      case 26: /* yieldClause ::= */
+      case 47: /* properties ::= */ yytestcase(yyruleno==47);
+#line 164 "grammar.y"
 {
-	yymsp[-2].minor.yy117 = yymsp[-1].minor.yy117;
-	yymsp[-2].minor.yy117->direction = N_LEFT_TO_RIGHT;
+	yymsp[1].minor.yy42 = NULL;
 }
-#line 1361 "grammar.c"
+#line 1495 "grammar.c"
         break;
-      case 26: /* link ::= LEFT_ARROW edge DASH */
+      case 27: /* yieldClause ::= YIELD yieldList */
+#line 167 "grammar.y"
+{
+	yymsp[-1].minor.yy42 = yymsp[0].minor.yy42;
+}
+#line 1502 "grammar.c"
+        break;
+      case 28: /* yieldList ::= UQSTRING */
+      case 35: /* deleteExpression ::= UQSTRING */ yytestcase(yyruleno==35);
+#line 172 "grammar.y"
+{
+	yylhsminor.yy42 = NewVector(char*, 1);
+	Vector_Push(yylhsminor.yy42, yymsp[0].minor.yy0.strval);
+}
+#line 1511 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
+        break;
+      case 29: /* yieldList ::= yieldList COMMA UQSTRING */
+      case 36: /* deleteExpression ::= deleteExpression COMMA UQSTRING */ yytestcase(yyruleno==36);
 #line 176 "grammar.y"
 {
-	yymsp[-2].minor.yy117 = yymsp[-1].minor.yy117;
-	yymsp[-2].minor.yy117->direction = N_RIGHT_TO_LEFT;
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
 }
-#line 1369 "grammar.c"
+#line 1521 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 27: /* edge ::= LEFT_BRACKET properties RIGHT_BRACKET */
+      case 30: /* chain ::= node */
 #line 183 "grammar.y"
-{ 
-	yymsp[-2].minor.yy117 = New_AST_LinkEntity(NULL, NULL, yymsp[-1].minor.yy114, N_DIR_UNKNOWN);
+{
+	yylhsminor.yy42 = NewVector(AST_GraphEntity*, 1);
+	Vector_Push(yylhsminor.yy42, yymsp[0].minor.yy81);
 }
-#line 1376 "grammar.c"
+#line 1530 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 28: /* edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
+      case 31: /* chain ::= chain link node */
 #line 188 "grammar.y"
+{
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[-1].minor.yy53);
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[0].minor.yy81);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
+}
+#line 1540 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
+        break;
+      case 33: /* chains ::= chains COMMA chain */
+#line 199 "grammar.y"
+{
+	for(int i = 0; i < Vector_Size(yymsp[0].minor.yy42); i++) {
+		AST_GraphEntity *entity;
+		Vector_Get(yymsp[0].minor.yy42, i, &entity);
+		Vector_Push(yymsp[-2].minor.yy42, entity);
+	}
+	Vector_Free(yymsp[0].minor.yy42);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
+}
+#line 1554 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
+        break;
+      case 34: /* deleteClause ::= DELETE deleteExpression */
+#line 212 "grammar.y"
+{
+	yymsp[-1].minor.yy15 = New_AST_DeleteNode(yymsp[0].minor.yy42);
+}
+#line 1562 "grammar.c"
+        break;
+      case 37: /* node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
+#line 231 "grammar.y"
+{
+	yymsp[-5].minor.yy81 = New_AST_NodeEntity(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy42);
+}
+#line 1569 "grammar.c"
+        break;
+      case 38: /* node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
+#line 236 "grammar.y"
+{
+	yymsp[-4].minor.yy81 = New_AST_NodeEntity(NULL, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy42);
+}
+#line 1576 "grammar.c"
+        break;
+      case 39: /* node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
+#line 241 "grammar.y"
+{
+	yymsp[-3].minor.yy81 = New_AST_NodeEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy42);
+}
+#line 1583 "grammar.c"
+        break;
+      case 40: /* node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
+#line 246 "grammar.y"
+{
+	yymsp[-2].minor.yy81 = New_AST_NodeEntity(NULL, NULL, yymsp[-1].minor.yy42);
+}
+#line 1590 "grammar.c"
+        break;
+      case 41: /* link ::= DASH edge RIGHT_ARROW */
+#line 253 "grammar.y"
+{
+	yymsp[-2].minor.yy53 = yymsp[-1].minor.yy53;
+	yymsp[-2].minor.yy53->direction = N_LEFT_TO_RIGHT;
+}
+#line 1598 "grammar.c"
+        break;
+      case 42: /* link ::= LEFT_ARROW edge DASH */
+#line 259 "grammar.y"
+{
+	yymsp[-2].minor.yy53 = yymsp[-1].minor.yy53;
+	yymsp[-2].minor.yy53->direction = N_RIGHT_TO_LEFT;
+}
+#line 1606 "grammar.c"
+        break;
+      case 43: /* edge ::= LEFT_BRACKET properties RIGHT_BRACKET */
+#line 266 "grammar.y"
 { 
-	yymsp[-3].minor.yy117 = New_AST_LinkEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy114, N_DIR_UNKNOWN);
+	yymsp[-2].minor.yy53 = New_AST_LinkEntity(NULL, NULL, yymsp[-1].minor.yy42, N_DIR_UNKNOWN);
 }
-#line 1383 "grammar.c"
+#line 1613 "grammar.c"
         break;
-      case 29: /* edge ::= LEFT_BRACKET COLON UQSTRING properties RIGHT_BRACKET */
-#line 193 "grammar.y"
+      case 44: /* edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
+#line 271 "grammar.y"
 { 
-	yymsp[-4].minor.yy117 = New_AST_LinkEntity(NULL, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy114, N_DIR_UNKNOWN);
+	yymsp[-3].minor.yy53 = New_AST_LinkEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy42, N_DIR_UNKNOWN);
 }
-#line 1390 "grammar.c"
+#line 1620 "grammar.c"
         break;
-      case 30: /* edge ::= LEFT_BRACKET UQSTRING COLON UQSTRING properties RIGHT_BRACKET */
-#line 198 "grammar.y"
+      case 45: /* edge ::= LEFT_BRACKET COLON UQSTRING properties RIGHT_BRACKET */
+#line 276 "grammar.y"
 { 
-	yymsp[-5].minor.yy117 = New_AST_LinkEntity(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy114, N_DIR_UNKNOWN);
+	yymsp[-4].minor.yy53 = New_AST_LinkEntity(NULL, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy42, N_DIR_UNKNOWN);
 }
-#line 1397 "grammar.c"
+#line 1627 "grammar.c"
         break;
-      case 31: /* properties ::= */
-#line 204 "grammar.y"
-{
-	yymsp[1].minor.yy114 = NULL;
+      case 46: /* edge ::= LEFT_BRACKET UQSTRING COLON UQSTRING properties RIGHT_BRACKET */
+#line 281 "grammar.y"
+{ 
+	yymsp[-5].minor.yy53 = New_AST_LinkEntity(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy42, N_DIR_UNKNOWN);
 }
-#line 1404 "grammar.c"
+#line 1634 "grammar.c"
         break;
-      case 32: /* properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
-#line 208 "grammar.y"
+      case 48: /* properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
+#line 291 "grammar.y"
 {
-	yymsp[-2].minor.yy114 = yymsp[-1].minor.yy114;
+	yymsp[-2].minor.yy42 = yymsp[-1].minor.yy42;
 }
-#line 1411 "grammar.c"
+#line 1641 "grammar.c"
         break;
-      case 33: /* mapLiteral ::= UQSTRING COLON value */
-#line 214 "grammar.y"
+      case 49: /* mapLiteral ::= UQSTRING COLON value */
+#line 297 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(SIValue*, 2);
+	yylhsminor.yy42 = NewVector(SIValue*, 2);
 
 	SIValue *key = malloc(sizeof(SIValue));
 	*key = SI_StringVal(yymsp[-2].minor.yy0.strval);
 
-	Vector_Push(yylhsminor.yy114, key);
+	Vector_Push(yylhsminor.yy42, key);
 
 	SIValue *val = malloc(sizeof(SIValue));
-	*val = yymsp[0].minor.yy86;
-	Vector_Push(yylhsminor.yy114, val);
+	*val = yymsp[0].minor.yy46;
+	Vector_Push(yylhsminor.yy42, val);
 }
-#line 1427 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1657 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 34: /* mapLiteral ::= UQSTRING COLON value COMMA mapLiteral */
-#line 227 "grammar.y"
+      case 50: /* mapLiteral ::= UQSTRING COLON value COMMA mapLiteral */
+#line 310 "grammar.y"
 {
 	SIValue *key = malloc(sizeof(SIValue));
 	*key = SI_StringVal(yymsp[-4].minor.yy0.strval);
 
-	Vector_Push(yymsp[0].minor.yy114, key);
+	Vector_Push(yymsp[0].minor.yy42, key);
 
 	SIValue *val = malloc(sizeof(SIValue));
-	*val = yymsp[-2].minor.yy86;
-	Vector_Push(yymsp[0].minor.yy114, val);
+	*val = yymsp[-2].minor.yy46;
+	Vector_Push(yymsp[0].minor.yy42, val);
 	
-	yylhsminor.yy114 = yymsp[0].minor.yy114;
+	yylhsminor.yy42 = yymsp[0].minor.yy42;
 }
-#line 1444 "grammar.c"
-  yymsp[-4].minor.yy114 = yylhsminor.yy114;
+#line 1674 "grammar.c"
+  yymsp[-4].minor.yy42 = yylhsminor.yy42;
         break;
-      case 35: /* whereClause ::= */
-#line 242 "grammar.y"
+      case 51: /* whereClause ::= */
+#line 325 "grammar.y"
 { 
-	yymsp[1].minor.yy59 = NULL;
+	yymsp[1].minor.yy7 = NULL;
 }
-#line 1452 "grammar.c"
+#line 1682 "grammar.c"
         break;
-      case 36: /* whereClause ::= WHERE cond */
-#line 245 "grammar.y"
+      case 52: /* whereClause ::= WHERE cond */
+#line 328 "grammar.y"
 {
-	yymsp[-1].minor.yy59 = New_AST_WhereNode(yymsp[0].minor.yy102);
+	yymsp[-1].minor.yy7 = New_AST_WhereNode(yymsp[0].minor.yy170);
 }
-#line 1459 "grammar.c"
+#line 1689 "grammar.c"
         break;
-      case 37: /* cond ::= UQSTRING DOT UQSTRING relation UQSTRING DOT UQSTRING */
-#line 254 "grammar.y"
-{ yylhsminor.yy102 = New_AST_VaryingPredicateNode(yymsp[-6].minor.yy0.strval, yymsp[-4].minor.yy0.strval, yymsp[-3].minor.yy8, yymsp[-2].minor.yy0.strval, yymsp[0].minor.yy0.strval); }
-#line 1464 "grammar.c"
-  yymsp[-6].minor.yy102 = yylhsminor.yy102;
+      case 53: /* cond ::= UQSTRING DOT UQSTRING relation UQSTRING DOT UQSTRING */
+#line 337 "grammar.y"
+{ yylhsminor.yy170 = New_AST_VaryingPredicateNode(yymsp[-6].minor.yy0.strval, yymsp[-4].minor.yy0.strval, yymsp[-3].minor.yy92, yymsp[-2].minor.yy0.strval, yymsp[0].minor.yy0.strval); }
+#line 1694 "grammar.c"
+  yymsp[-6].minor.yy170 = yylhsminor.yy170;
         break;
-      case 38: /* cond ::= UQSTRING DOT UQSTRING relation value */
-#line 257 "grammar.y"
-{ yylhsminor.yy102 = New_AST_ConstantPredicateNode(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy8, yymsp[0].minor.yy86); }
-#line 1470 "grammar.c"
-  yymsp[-4].minor.yy102 = yylhsminor.yy102;
+      case 54: /* cond ::= UQSTRING DOT UQSTRING relation value */
+#line 340 "grammar.y"
+{ yylhsminor.yy170 = New_AST_ConstantPredicateNode(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy92, yymsp[0].minor.yy46); }
+#line 1700 "grammar.c"
+  yymsp[-4].minor.yy170 = yylhsminor.yy170;
+        break;
+      case 55: /* cond ::= UQSTRING DOT UQSTRING STARTS WITH STRING */
+#line 342 "grammar.y"
+{ yylhsminor.yy170 = New_AST_ConstantPredicateNode(yymsp[-5].minor.yy0.strval, yymsp[-3].minor.yy0.strval, STARTS, SI_StringVal(yymsp[0].minor.yy0.strval)); }
+#line 1706 "grammar.c"
+  yymsp[-5].minor.yy170 = yylhsminor.yy170;
+        break;
+      case 56: /* cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING DOT UQSTRING COMMA UQSTRING DOT UQSTRING COMMA coordinate COMMA coordinate RIGHT_PARENTHESIS relation coordinate */
+#line 343 "grammar.y"
+{
+	/* distance(n.lat, n.lon, lat, lon) op meters, both properties must belong to the same node. */
+	if(strcasecmp(yymsp[-15].minor.yy0.strval, "distance") != 0 || strcmp(yymsp[-13].minor.yy0.strval, yymsp[-9].minor.yy0.strval) != 0) {
+		char buf[256];
+		snprintf(buf, 256, "Unsupported predicate %s(%s.%s, %s.%s, ...)\n", yymsp[-15].minor.yy0.strval, yymsp[-13].minor.yy0.strval, yymsp[-11].minor.yy0.strval, yymsp[-9].minor.yy0.strval, yymsp[-7].minor.yy0.strval);
+		ctx->ok = 0;
+		ctx->errorMsg = strdup(buf);
+	}
+	yylhsminor.yy170 = New_AST_DistancePredicateNode(yymsp[-13].minor.yy0.strval, yymsp[-11].minor.yy0.strval, yymsp[-7].minor.yy0.strval, yymsp[-5].minor.yy32, yymsp[-3].minor.yy32, yymsp[-1].minor.yy92, yymsp[0].minor.yy32);
+}
+#line 1721 "grammar.c"
+  yymsp[-15].minor.yy170 = yylhsminor.yy170;
         break;
-      case 39: /* cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
-#line 258 "grammar.y"
-{ yymsp[-2].minor.yy102 = yymsp[-1].minor.yy102; }
-#line 1476 "grammar.c"
+      case 57: /* cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS relation entityId */
+#line 354 "grammar.y"
+{
+	if(strcasecmp(yymsp[-5].minor.yy0.strval, "id") != 0) {
+		char buf[256];
+		snprintf(buf, 256, "Unsupported predicate %s(%s)\n", yymsp[-5].minor.yy0.strval, yymsp[-3].minor.yy0.strval);
+		ctx->ok = 0;
+		ctx->errorMsg = strdup(buf);
+	}
+	yylhsminor.yy170 = New_AST_IdPredicateNode(yymsp[-3].minor.yy0.strval, yymsp[-1].minor.yy92, yymsp[0].minor.yy149);
+}
+#line 1735 "grammar.c"
+  yymsp[-5].minor.yy170 = yylhsminor.yy170;
         break;
-      case 40: /* cond ::= cond AND cond */
-#line 259 "grammar.y"
-{ yylhsminor.yy102 = New_AST_ConditionNode(yymsp[-2].minor.yy102, AND, yymsp[0].minor.yy102); }
-#line 1481 "grammar.c"
-  yymsp[-2].minor.yy102 = yylhsminor.yy102;
+      case 58: /* cond ::= UQSTRING LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS IN LEFT_BRACKET entityIdList RIGHT_BRACKET */
+#line 364 "grammar.y"
+{
+	if(strcasecmp(yymsp[-7].minor.yy0.strval, "id") != 0) {
+		char buf[256];
+		snprintf(buf, 256, "Unsupported predicate %s(%s)\n", yymsp[-7].minor.yy0.strval, yymsp[-5].minor.yy0.strval);
+		ctx->ok = 0;
+		ctx->errorMsg = strdup(buf);
+	}
+	yylhsminor.yy170 = NULL;
+	for(int i = 0; i < Vector_Size(yymsp[-1].minor.yy42); i++) {
+		int64_t *id;
+		Vector_Get(yymsp[-1].minor.yy42, i, &id);
+		AST_FilterNode *pred = New_AST_IdPredicateNode(yymsp[-5].minor.yy0.strval, EQ, *id);
+		yylhsminor.yy170 = (yylhsminor.yy170 == NULL) ? pred : New_AST_ConditionNode(yylhsminor.yy170, OR, pred);
+		free(id);
+	}
+	Vector_Free(yymsp[-1].minor.yy42);
+}
+#line 1757 "grammar.c"
+  yymsp[-7].minor.yy170 = yylhsminor.yy170;
+        break;
+      case 59: /* cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
+#line 381 "grammar.y"
+{ yymsp[-2].minor.yy170 = yymsp[-1].minor.yy170; }
+#line 1763 "grammar.c"
         break;
-      case 41: /* cond ::= cond OR cond */
-#line 260 "grammar.y"
-{ yylhsminor.yy102 = New_AST_ConditionNode(yymsp[-2].minor.yy102, OR, yymsp[0].minor.yy102); }
-#line 1487 "grammar.c"
-  yymsp[-2].minor.yy102 = yylhsminor.yy102;
+      case 60: /* cond ::= cond AND cond */
+#line 382 "grammar.y"
+{ yylhsminor.yy170 = New_AST_ConditionNode(yymsp[-2].minor.yy170, AND, yymsp[0].minor.yy170); }
+#line 1768 "grammar.c"
+  yymsp[-2].minor.yy170 = yylhsminor.yy170;
+        break;
+      case 61: /* cond ::= cond OR cond */
+#line 383 "grammar.y"
+{ yylhsminor.yy170 = New_AST_ConditionNode(yymsp[-2].minor.yy170, OR, yymsp[0].minor.yy170); }
+#line 1774 "grammar.c"
+  yymsp[-2].minor.yy170 = yylhsminor.yy170;
         break;
-      case 42: /* returnClause ::= RETURN returnElements */
-#line 265 "grammar.y"
+      case 62: /* returnClause ::= RETURN returnElements */
+#line 388 "grammar.y"
 {
-	yymsp[-1].minor.yy72 = New_AST_ReturnNode(yymsp[0].minor.yy114, 0);
+	yymsp[-1].minor.yy140 = New_AST_ReturnNode(yymsp[0].minor.yy42, 0);
 }
-#line 1495 "grammar.c"
+#line 1782 "grammar.c"
         break;
-      case 43: /* returnClause ::= RETURN DISTINCT returnElements */
-#line 268 "grammar.y"
+      case 63: /* returnClause ::= RETURN DISTINCT returnElements */
+#line 391 "grammar.y"
 {
-	yymsp[-2].minor.yy72 = New_AST_ReturnNode(yymsp[0].minor.yy114, 1);
+	yymsp[-2].minor.yy140 = New_AST_ReturnNode(yymsp[0].minor.yy42, 1);
 }
-#line 1502 "grammar.c"
+#line 1789 "grammar.c"
         break;
-      case 44: /* returnElements ::= returnElements COMMA returnElement */
-#line 275 "grammar.y"
+      case 64: /* returnElements ::= returnElements COMMA returnElement */
+#line 398 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[0].minor.yy26);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[0].minor.yy86);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
 }
-#line 1510 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1797 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 45: /* returnElements ::= returnElement */
-#line 280 "grammar.y"
+      case 65: /* returnElements ::= returnElement */
+#line 403 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(AST_ReturnElementNode*, 1);
-	Vector_Push(yylhsminor.yy114, yymsp[0].minor.yy26);
+	yylhsminor.yy42 = NewVector(AST_ReturnElementNode*, 1);
+	Vector_Push(yylhsminor.yy42, yymsp[0].minor.yy86);
 }
-#line 1519 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1806 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 46: /* returnElement ::= arithmetic_expression */
-#line 287 "grammar.y"
+      case 66: /* returnElement ::= arithmetic_expression */
+#line 410 "grammar.y"
 {
-	yylhsminor.yy26 = New_AST_ReturnElementNode(yymsp[0].minor.yy42, NULL);
+	yylhsminor.yy86 = New_AST_ReturnElementNode(yymsp[0].minor.yy34, NULL);
 }
-#line 1527 "grammar.c"
-  yymsp[0].minor.yy26 = yylhsminor.yy26;
+#line 1814 "grammar.c"
+  yymsp[0].minor.yy86 = yylhsminor.yy86;
         break;
-      case 47: /* returnElement ::= arithmetic_expression AS UQSTRING */
-#line 292 "grammar.y"
+      case 67: /* returnElement ::= arithmetic_expression AS UQSTRING */
+#line 415 "grammar.y"
 {
-	yylhsminor.yy26 = New_AST_ReturnElementNode(yymsp[-2].minor.yy42, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy86 = New_AST_ReturnElementNode(yymsp[-2].minor.yy34, yymsp[0].minor.yy0.strval);
 }
-#line 1535 "grammar.c"
-  yymsp[-2].minor.yy26 = yylhsminor.yy26;
+#line 1822 "grammar.c"
+  yymsp[-2].minor.yy86 = yylhsminor.yy86;
         break;
-      case 48: /* arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
-#line 299 "grammar.y"
+      case 68: /* arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
+#line 422 "grammar.y"
 {
-	yymsp[-2].minor.yy42 = yymsp[-1].minor.yy42;
+	yymsp[-2].minor.yy34 = yymsp[-1].minor.yy34;
 }
-#line 1543 "grammar.c"
+#line 1830 "grammar.c"
         break;
-      case 49: /* arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
-#line 311 "grammar.y"
+      case 69: /* arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
+#line 434 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy42);
-	Vector_Push(args, yymsp[0].minor.yy42);
-	yylhsminor.yy42 = New_AST_AR_EXP_OpNode("ADD", args);
+	Vector_Push(args, yymsp[-2].minor.yy34);
+	Vector_Push(args, yymsp[0].minor.yy34);
+	yylhsminor.yy34 = New_AST_AR_EXP_OpNode("ADD", args);
 }
-#line 1553 "grammar.c"
-  yymsp[-2].minor.yy42 = yylhsminor.yy42;
+#line 1840 "grammar.c"
+  yymsp[-2].minor.yy34 = yylhsminor.yy34;
         break;
-      case 50: /* arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
-#line 318 "grammar.y"
+      case 70: /* arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
+#line 441 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy42);
-	Vector_Push(args, yymsp[0].minor.yy42);
-	yylhsminor.yy42 = New_AST_AR_EXP_OpNode("SUB", args);
+	Vector_Push(args, yymsp[-2].minor.yy34);
+	Vector_Push(args, yymsp[0].minor.yy34);
+	yylhsminor.yy34 = New_AST_AR_EXP_OpNode("SUB", args);
 }
-#line 1564 "grammar.c"
-  yymsp[-2].minor.yy42 = yylhsminor.yy42;
+#line 1851 "grammar.c"
+  yymsp[-2].minor.yy34 = yylhsminor.yy34;
         break;
-      case 51: /* arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
-#line 325 "grammar.y"
+      case 71: /* arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
+#line 448 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy42);
-	Vector_Push(args, yymsp[0].minor.yy42);
-	yylhsminor.yy42 = New_AST_AR_EXP_OpNode("MUL", args);
+	Vector_Push(args, yymsp[-2].minor.yy34);
+	Vector_Push(args, yymsp[0].minor.yy34);
+	yylhsminor.yy34 = New_AST_AR_EXP_OpNode("MUL", args);
 }
-#line 1575 "grammar.c"
-  yymsp[-2].minor.yy42 = yylhsminor.yy42;
+#line 1862 "grammar.c"
+  yymsp[-2].minor.yy34 = yylhsminor.yy34;
         break;
-      case 52: /* arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
-#line 332 "grammar.y"
+      case 72: /* arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
+#line 455 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy42);
-	Vector_Push(args, yymsp[0].minor.yy42);
-	yylhsminor.yy42 = New_AST_AR_EXP_OpNode("DIV", args);
+	Vector_Push(args, yymsp[-2].minor.yy34);
+	Vector_Push(args, yymsp[0].minor.yy34);
+	yylhsminor.yy34 = New_AST_AR_EXP_OpNode("DIV", args);
 }
-#line 1586 "grammar.c"
-  yymsp[-2].minor.yy42 = yylhsminor.yy42;
+#line 1873 "grammar.c"
+  yymsp[-2].minor.yy34 = yylhsminor.yy34;
         break;
-      case 53: /* arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
-#line 340 "grammar.y"
+      case 73: /* arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
+#line 463 "grammar.y"
 {
-	yylhsminor.yy42 = New_AST_AR_EXP_OpNode(yymsp[-3].minor.yy0.strval, yymsp[-1].minor.yy114);
+	yylhsminor.yy34 = New_AST_AR_EXP_OpNode(yymsp[-3].minor.yy0.strval, yymsp[-1].minor.yy42);
 }
-#line 1594 "grammar.c"
-  yymsp[-3].minor.yy42 = yylhsminor.yy42;
+#line 1881 "grammar.c"
+  yymsp[-3].minor.yy34 = yylhsminor.yy34;
         break;
-      case 54: /* arithmetic_expression ::= value */
-#line 345 "grammar.y"
+      case 74: /* arithmetic_expression ::= value */
+#line 468 "grammar.y"
 {
-	yylhsminor.yy42 = New_AST_AR_EXP_ConstOperandNode(yymsp[0].minor.yy86);
+	yylhsminor.yy34 = New_AST_AR_EXP_ConstOperandNode(yymsp[0].minor.yy46);
 }
-#line 1602 "grammar.c"
-  yymsp[0].minor.yy42 = yylhsminor.yy42;
+#line 1889 "grammar.c"
+  yymsp[0].minor.yy34 = yylhsminor.yy34;
         break;
-      case 55: /* arithmetic_expression ::= variable */
-#line 350 "grammar.y"
+      case 75: /* arithmetic_expression ::= variable */
+#line 473 "grammar.y"
 {
-	yylhsminor.yy42 = New_AST_AR_EXP_VariableOperandNode(yymsp[0].minor.yy76->alias, yymsp[0].minor.yy76->property);
+	yylhsminor.yy34 = New_AST_AR_EXP_VariableOperandNode(yymsp[0].minor.yy188->alias, yymsp[0].minor.yy188->property);
 }
-#line 1610 "grammar.c"
-  yymsp[0].minor.yy42 = yylhsminor.yy42;
+#line 1897 "grammar.c"
+  yymsp[0].minor.yy34 = yylhsminor.yy34;
         break;
-      case 56: /* arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
-#line 356 "grammar.y"
+      case 76: /* arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
+#line 479 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[0].minor.yy42);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[0].minor.yy34);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
 }
-#line 1619 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1906 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 57: /* arithmetic_expression_list ::= arithmetic_expression */
-#line 360 "grammar.y"
+      case 77: /* arithmetic_expression_list ::= arithmetic_expression */
+#line 483 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(AST_ArithmeticExpressionNode*, 1);
-	Vector_Push(yylhsminor.yy114, yymsp[0].minor.yy42);
+	yylhsminor.yy42 = NewVector(AST_ArithmeticExpressionNode*, 1);
+	Vector_Push(yylhsminor.yy42, yymsp[0].minor.yy34);
 }
-#line 1628 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1915 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 58: /* variable ::= UQSTRING */
-#line 367 "grammar.y"
+      case 78: /* variable ::= UQSTRING */
+#line 490 "grammar.y"
 {
-	yylhsminor.yy76 = New_AST_Variable(yymsp[0].minor.yy0.strval, NULL);
+	yylhsminor.yy188 = New_AST_Variable(yymsp[0].minor.yy0.strval, NULL);
 }
-#line 1636 "grammar.c"
-  yymsp[0].minor.yy76 = yylhsminor.yy76;
+#line 1923 "grammar.c"
+  yymsp[0].minor.yy188 = yylhsminor.yy188;
         break;
-      case 59: /* variable ::= UQSTRING DOT UQSTRING */
-#line 371 "grammar.y"
+      case 79: /* variable ::= UQSTRING DOT UQSTRING */
+#line 494 "grammar.y"
 {
-	yylhsminor.yy76 = New_AST_Variable(yymsp[-2].minor.yy0.strval, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy188 = New_AST_Variable(yymsp[-2].minor.yy0.strval, yymsp[0].minor.yy0.strval);
 }
-#line 1644 "grammar.c"
-  yymsp[-2].minor.yy76 = yylhsminor.yy76;
+#line 1931 "grammar.c"
+  yymsp[-2].minor.yy188 = yylhsminor.yy188;
         break;
-      case 60: /* orderClause ::= */
-#line 377 "grammar.y"
+      case 80: /* orderClause ::= */
+#line 500 "grammar.y"
 {
-	yymsp[1].minor.yy12 = NULL;
+	yymsp[1].minor.yy176 = NULL;
 }
-#line 1652 "grammar.c"
+#line 1939 "grammar.c"
         break;
-      case 61: /* orderClause ::= ORDER BY columnNameList */
-#line 380 "grammar.y"
+      case 81: /* orderClause ::= ORDER BY columnNameList */
+#line 503 "grammar.y"
 {
-	yymsp[-2].minor.yy12 = New_AST_OrderNode(yymsp[0].minor.yy114, ORDER_DIR_ASC);
+	yymsp[-2].minor.yy176 = New_AST_OrderNode(yymsp[0].minor.yy42, ORDER_DIR_ASC);
 }
-#line 1659 "grammar.c"
+#line 1946 "grammar.c"
         break;
-      case 62: /* orderClause ::= ORDER BY columnNameList ASC */
-#line 383 "grammar.y"
+      case 82: /* orderClause ::= ORDER BY columnNameList ASC */
+#line 506 "grammar.y"
 {
-	yymsp[-3].minor.yy12 = New_AST_OrderNode(yymsp[-1].minor.yy114, ORDER_DIR_ASC);
+	yymsp[-3].minor.yy176 = New_AST_OrderNode(yymsp[-1].minor.yy42, ORDER_DIR_ASC);
 }
-#line 1666 "grammar.c"
+#line 1953 "grammar.c"
         break;
-      case 63: /* orderClause ::= ORDER BY columnNameList DESC */
-#line 386 "grammar.y"
+      case 83: /* orderClause ::= ORDER BY columnNameList DESC */
+#line 509 "grammar.y"
 {
-	yymsp[-3].minor.yy12 = New_AST_OrderNode(yymsp[-1].minor.yy114, ORDER_DIR_DESC);
+	yymsp[-3].minor.yy176 = New_AST_OrderNode(yymsp[-1].minor.yy42, ORDER_DIR_DESC);
 }
-#line 1673 "grammar.c"
+#line 1960 "grammar.c"
         break;
-      case 64: /* columnNameList ::= columnNameList COMMA columnName */
-#line 391 "grammar.y"
+      case 84: /* columnNameList ::= columnNameList COMMA columnName */
+#line 514 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy114, yymsp[0].minor.yy90);
-	yylhsminor.yy114 = yymsp[-2].minor.yy114;
+	Vector_Push(yymsp[-2].minor.yy42, yymsp[0].minor.yy98);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
 }
-#line 1681 "grammar.c"
-  yymsp[-2].minor.yy114 = yylhsminor.yy114;
+#line 1968 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 65: /* columnNameList ::= columnName */
-#line 395 "grammar.y"
+      case 85: /* columnNameList ::= columnName */
+#line 518 "grammar.y"
 {
-	yylhsminor.yy114 = NewVector(AST_ColumnNode*, 1);
-	Vector_Push(yylhsminor.yy114, yymsp[0].minor.yy90);
+	yylhsminor.yy42 = NewVector(AST_ColumnNode*, 1);
+	Vector_Push(yylhsminor.yy42, yymsp[0].minor.yy98);
 }
-#line 1690 "grammar.c"
-  yymsp[0].minor.yy114 = yylhsminor.yy114;
+#line 1977 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 66: /* columnName ::= variable */
-#line 401 "grammar.y"
+      case 86: /* columnName ::= variable */
+#line 524 "grammar.y"
 {
-	if(yymsp[0].minor.yy76->property != NULL) {
-		yylhsminor.yy90 = AST_ColumnNodeFromVariable(yymsp[0].minor.yy76);
+	if(yymsp[0].minor.yy188->property != NULL) {
+		yylhsminor.yy98 = AST_ColumnNodeFromVariable(yymsp[0].minor.yy188);
 	} else {
-		yylhsminor.yy90 = AST_ColumnNodeFromAlias(yymsp[0].minor.yy76->alias);
+		yylhsminor.yy98 = AST_ColumnNodeFromAlias(yymsp[0].minor.yy188->alias);
 	}
 
-	Free_AST_Variable(yymsp[0].minor.yy76);
+	Free_AST_Variable(yymsp[0].minor.yy188);
 }
-#line 1704 "grammar.c"
-  yymsp[0].minor.yy90 = yylhsminor.yy90;
+#line 1991 "grammar.c"
+  yymsp[0].minor.yy98 = yylhsminor.yy98;
         break;
-      case 67: /* limitClause ::= */
-#line 413 "grammar.y"
+      case 87: /* limitClause ::= */
+#line 536 "grammar.y"
 {
-	yymsp[1].minor.yy139 = NULL;
+	yymsp[1].minor.yy147 = NULL;
 }
-#line 1712 "grammar.c"
+#line 1999 "grammar.c"
         break;
-      case 68: /* limitClause ::= LIMIT INTEGER */
-#line 416 "grammar.y"
+      case 88: /* limitClause ::= LIMIT INTEGER */
+#line 539 "grammar.y"
 {
-	yymsp[-1].minor.yy139 = New_AST_LimitNode(yymsp[0].minor.yy0.intval);
+	yymsp[-1].minor.yy147 = New_AST_LimitNode(yymsp[0].minor.yy0.intval);
 }
-#line 1719 "grammar.c"
+#line 2006 "grammar.c"
         break;
-      case 69: /* relation ::= EQ */
-#line 422 "grammar.y"
-{ yymsp[0].minor.yy8 = EQ; }
-#line 1724 "grammar.c"
-        break;
-      case 70: /* relation ::= GT */
-#line 423 "grammar.y"
-{ yymsp[0].minor.yy8 = GT; }
-#line 1729 "grammar.c"
-        break;
-      case 71: /* relation ::= LT */
-#line 424 "grammar.y"
-{ yymsp[0].minor.yy8 = LT; }
-#line 1734 "grammar.c"
-        break;
-      case 72: /* relation ::= LE */
-#line 425 "grammar.y"
-{ yymsp[0].minor.yy8 = LE; }
-#line 1739 "grammar.c"
-        break;
-      case 73: /* relation ::= GE */
-#line 426 "grammar.y"
-{ yymsp[0].minor.yy8 = GE; }
-#line 1744 "grammar.c"
-        break;
-      case 74: /* relation ::= NE */
-#line 427 "grammar.y"
-{ yymsp[0].minor.yy8 = NE; }
-#line 1749 "grammar.c"
-        break;
-      case 75: /* value ::= INTEGER */
-#line 438 "grammar.y"
-{  yylhsminor.yy86 = SI_DoubleVal(yymsp[0].minor.yy0.intval); }
-#line 1754 "grammar.c"
-  yymsp[0].minor.yy86 = yylhsminor.yy86;
+      case 89: /* skipClause ::= */
+#line 545 "grammar.y"
+{
+	yymsp[1].minor.yy59 = NULL;
+}
+#line 2013 "grammar.c"
         break;
-      case 76: /* value ::= DASH INTEGER */
-#line 439 "grammar.y"
-{  yymsp[-1].minor.yy86 = SI_DoubleVal(-yymsp[0].minor.yy0.intval); }
-#line 1760 "grammar.c"
+      case 90: /* skipClause ::= SKIP INTEGER */
+#line 548 "grammar.y"
+{
+	yymsp[-1].minor.yy59 = New_AST_SkipNode(yymsp[0].minor.yy0.intval);
+}
+#line 2020 "grammar.c"
         break;
-      case 77: /* value ::= STRING */
-#line 440 "grammar.y"
-{  yylhsminor.yy86 = SI_StringVal(yymsp[0].minor.yy0.strval); }
-#line 1765 "grammar.c"
-  yymsp[0].minor.yy86 = yylhsminor.yy86;
+      case 91: /* entityId ::= INTEGER */
+#line 554 "grammar.y"
+{ yylhsminor.yy149 = yymsp[0].minor.yy0.intval; }
+#line 2025 "grammar.c"
+  yymsp[0].minor.yy149 = yylhsminor.yy149;
         break;
-      case 78: /* value ::= FLOAT */
-#line 441 "grammar.y"
-{  yylhsminor.yy86 = SI_DoubleVal(yymsp[0].minor.yy0.dval); }
-#line 1771 "grammar.c"
-  yymsp[0].minor.yy86 = yylhsminor.yy86;
+      case 92: /* entityId ::= DASH INTEGER */
+#line 555 "grammar.y"
+{ yymsp[-1].minor.yy149 = -yymsp[0].minor.yy0.intval; }
+#line 2031 "grammar.c"
         break;
-      case 79: /* value ::= DASH FLOAT */
-#line 442 "grammar.y"
-{  yymsp[-1].minor.yy86 = SI_DoubleVal(-yymsp[0].minor.yy0.dval); }
-#line 1777 "grammar.c"
+      case 93: /* entityIdList ::= entityId */
+#line 558 "grammar.y"
+{
+	yylhsminor.yy42 = NewVector(int64_t*, 1);
+	int64_t *id = malloc(sizeof(int64_t));
+	*id = yymsp[0].minor.yy149;
+	Vector_Push(yylhsminor.yy42, id);
+}
+#line 2041 "grammar.c"
+  yymsp[0].minor.yy42 = yylhsminor.yy42;
         break;
-      case 80: /* value ::= TRUE */
-#line 443 "grammar.y"
-{ yymsp[0].minor.yy86 = SI_BoolVal(1); }
-#line 1782 "grammar.c"
+      case 94: /* entityIdList ::= entityIdList COMMA entityId */
+#line 564 "grammar.y"
+{
+	int64_t *id = malloc(sizeof(int64_t));
+	*id = yymsp[0].minor.yy149;
+	Vector_Push(yymsp[-2].minor.yy42, id);
+	yylhsminor.yy42 = yymsp[-2].minor.yy42;
+}
+#line 2052 "grammar.c"
+  yymsp[-2].minor.yy42 = yylhsminor.yy42;
         break;
-      case 81: /* value ::= FALSE */
-#line 444 "grammar.y"
-{ yymsp[0].minor.yy86 = SI_BoolVal(0); }
-#line 1787 "grammar.c"
+      case 95: /* coordinate ::= INTEGER */
+#line 572 "grammar.y"
+{ yylhsminor.yy32 = yymsp[0].minor.yy0.intval; }
+#line 2058 "grammar.c"
+  yymsp[0].minor.yy32 = yylhsminor.yy32;
+        break;
+      case 96: /* coordinate ::= DASH INTEGER */
+#line 573 "grammar.y"
+{ yymsp[-1].minor.yy32 = -yymsp[0].minor.yy0.intval; }
+#line 2064 "grammar.c"
+        break;
+      case 97: /* coordinate ::= FLOAT */
+#line 574 "grammar.y"
+{ yylhsminor.yy32 = yymsp[0].minor.yy0.dval; }
+#line 2069 "grammar.c"
+  yymsp[0].minor.yy32 = yylhsminor.yy32;
+        break;
+      case 98: /* coordinate ::= DASH FLOAT */
+#line 575 "grammar.y"
+{ yymsp[-1].minor.yy32 = -yymsp[0].minor.yy0.dval; }
+#line 2075 "grammar.c"
+        break;
+      case 99: /* relation ::= EQ */
+#line 578 "grammar.y"
+{ yymsp[0].minor.yy92 = EQ; }
+#line 2080 "grammar.c"
+        break;
+      case 100: /* relation ::= GT */
+#line 579 "grammar.y"
+{ yymsp[0].minor.yy92 = GT; }
+#line 2085 "grammar.c"
+        break;
+      case 101: /* relation ::= LT */
+#line 580 "grammar.y"
+{ yymsp[0].minor.yy92 = LT; }
+#line 2090 "grammar.c"
+        break;
+      case 102: /* relation ::= LE */
+#line 581 "grammar.y"
+{ yymsp[0].minor.yy92 = LE; }
+#line 2095 "grammar.c"
+        break;
+      case 103: /* relation ::= GE */
+#line 582 "grammar.y"
+{ yymsp[0].minor.yy92 = GE; }
+#line 2100 "grammar.c"
+        break;
+      case 104: /* relation ::= NE */
+#line 583 "grammar.y"
+{ yymsp[0].minor.yy92 = NE; }
+#line 2105 "grammar.c"
+        break;
+      case 105: /* value ::= INTEGER */
+#line 594 "grammar.y"
+{  yylhsminor.yy46 = SI_DoubleVal(yymsp[0].minor.yy0.intval); }
+#line 2110 "grammar.c"
+  yymsp[0].minor.yy46 = yylhsminor.yy46;
+        break;
+      case 106: /* value ::= DASH INTEGER */
+#line 595 "grammar.y"
+{  yymsp[-1].minor.yy46 = SI_DoubleVal(-yymsp[0].minor.yy0.intval); }
+#line 2116 "grammar.c"
+        break;
+      case 107: /* value ::= STRING */
+#line 596 "grammar.y"
+{  yylhsminor.yy46 = SI_StringVal(yymsp[0].minor.yy0.strval); }
+#line 2121 "grammar.c"
+  yymsp[0].minor.yy46 = yylhsminor.yy46;
+        break;
+      case 108: /* value ::= FLOAT */
+#line 597 "grammar.y"
+{  yylhsminor.yy46 = SI_DoubleVal(yymsp[0].minor.yy0.dval); }
+#line 2127 "grammar.c"
+  yymsp[0].minor.yy46 = yylhsminor.yy46;
+        break;
+      case 109: /* value ::= DASH FLOAT */
+#line 598 "grammar.y"
+{  yymsp[-1].minor.yy46 = SI_DoubleVal(-yymsp[0].minor.yy0.dval); }
+#line 2133 "grammar.c"
+        break;
+      case 110: /* value ::= TRUE */
+#line 599 "grammar.y"
+{ yymsp[0].minor.yy46 = SI_BoolVal(1); }
+#line 2138 "grammar.c"
+        break;
+      case 111: /* value ::= FALSE */
+#line 600 "grammar.y"
+{ yymsp[0].minor.yy46 = SI_BoolVal(0); }
+#line 2143 "grammar.c"
+        break;
+      case 112: /* value ::= PARAM */
+#line 601 "grammar.y"
+{ yylhsminor.yy46 = SI_ParamVal(yymsp[0].minor.yy0.strval); }
+#line 2148 "grammar.c"
+  yymsp[0].minor.yy46 = yylhsminor.yy46;
         break;
       default:
         break;
@@ -1841,14 +2203,14 @@ static void yy_syntax_error(
   ParseARG_FETCH;
 #define TOKEN yyminor
 /************ Begin %syntax_error code ****************************************/
-#line 22 "grammar.y"
+#line 24 "grammar.y"
 
 	char buf[256];
 	snprintf(buf, 256, "Syntax error at offset %d near '%s'\n", TOKEN.pos, TOKEN.s);
 
 	ctx->ok = 0;
 	ctx->errorMsg = strdup(buf);
-#line 1852 "grammar.c"
+#line 2214 "grammar.c"
 /************ End %syntax_error code ******************************************/
   ParseARG_STORE; /* Suppress warning about unused %extra_argument variable */
 }
@@ -2062,7 +2424,7 @@ void Parse(
 #endif
   return;
 }
-#line 446 "grammar.y"
+#line 603 "grammar.y"
 
 
 	/* Definitions of flex stuff */
@@ -2094,4 +2456,19 @@ void Parse(
 		}
 		return ctx.root;
 	}
-#line 2098 "grammar.c"
+
+	void Query_Tokenize(const char *q, size_t len, TokenCallback cb, void *udata) {
+		yycolumn = 1;
+		yy_scan_bytes(q, len);
+		int t = 0;
+		while( (t = yylex()) != 0) {
+			cb(t, &tok, udata);
+			free(tok.s);
+			tok.s = NULL;
+			if(t == UQSTRING || t == STRING || t == PARAM) {
+				free(tok.strval);
+				tok.strval = NULL;
+			}
+		}
+	}
+#line 2475 "grammar.c"
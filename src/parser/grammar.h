@@ -13,30 +13,39 @@
 #define CREATE                          13
 #define SET                             14
 #define COMMA                           15
-#define DELETE                          16
-#define UQSTRING                        17
-#define LEFT_PARENTHESIS                18
-#define COLON                           19
-#define RIGHT_PARENTHESIS               20
-#define RIGHT_ARROW                     21
-#define LEFT_ARROW                      22
-#define LEFT_BRACKET                    23
-#define RIGHT_BRACKET                   24
-#define LEFT_CURLY_BRACKET              25
-#define RIGHT_CURLY_BRACKET             26
-#define WHERE                           27
-#define DOT                             28
-#define RETURN                          29
-#define DISTINCT                        30
-#define AS                              31
-#define ORDER                           32
-#define BY                              33
-#define ASC                             34
-#define DESC                            35
-#define LIMIT                           36
-#define INTEGER                         37
-#define NE                              38
-#define STRING                          39
-#define FLOAT                           40
-#define TRUE                            41
-#define FALSE                           42
+#define INDEX                           16
+#define ON                              17
+#define COLON                           18
+#define UQSTRING                        19
+#define LEFT_PARENTHESIS                20
+#define RIGHT_PARENTHESIS               21
+#define LEFT_BRACKET                    22
+#define RIGHT_BRACKET                   23
+#define CALL                            24
+#define DOT                             25
+#define YIELD                           26
+#define DELETE                          27
+#define RIGHT_ARROW                     28
+#define LEFT_ARROW                      29
+#define LEFT_CURLY_BRACKET              30
+#define RIGHT_CURLY_BRACKET             31
+#define WHERE                           32
+#define STARTS                          33
+#define WITH                            34
+#define STRING                          35
+#define IN                              36
+#define RETURN                          37
+#define DISTINCT                        38
+#define AS                              39
+#define ORDER                           40
+#define BY                              41
+#define ASC                             42
+#define DESC                            43
+#define LIMIT                           44
+#define INTEGER                         45
+#define SKIP                            46
+#define FLOAT                           47
+#define NE                              48
+#define TRUE                            49
+#define FALSE                           50
+#define PARAM                           51
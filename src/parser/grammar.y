@@ -10,10 +10,12 @@
 	#include <stdlib.h>
 	#include <stdio.h>
 	#include <assert.h>
+	#include <string.h>
 	#include "token.h"	
 	#include "grammar.h"
 	#include "ast.h"
 	#include "parse.h"
+	#include "parser_common.h"
 	#include "../value.h"
 
 	void yyerror(char *s);
@@ -34,28 +36,40 @@
 
 query ::= expr(A). { ctx->root = A; }
 
-expr(A) ::= matchClause(B) whereClause(C) createClause(D) returnClause(E) orderClause(F) limitClause(G). {
-	A = New_AST_QueryExpressionNode(B, C, D, NULL, NULL, E, F, G);
+expr(A) ::= matchClause(B) whereClause(C) createClause(D) returnClause(E) orderClause(F) skipClause(S) limitClause(G). {
+	A = New_AST_QueryExpressionNode(B, C, D, NULL, NULL, E, F, S, G, NULL, NULL);
 }
 
 expr(A) ::= matchClause(B) whereClause(C) createClause(D). {
-	A = New_AST_QueryExpressionNode(B, C, D, NULL, NULL, NULL, NULL, NULL);
+	A = New_AST_QueryExpressionNode(B, C, D, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 expr(A) ::= matchClause(B) whereClause(C) deleteClause(D). {
-	A = New_AST_QueryExpressionNode(B, C, NULL, NULL, D, NULL, NULL, NULL);
+	A = New_AST_QueryExpressionNode(B, C, NULL, NULL, D, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 expr(A) ::= matchClause(B) whereClause(C) setClause(D). {
-	A = New_AST_QueryExpressionNode(B, C, NULL, D, NULL, NULL, NULL, NULL);
+	A = New_AST_QueryExpressionNode(B, C, NULL, D, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
-expr(A) ::= matchClause(B) whereClause(C) setClause(D) returnClause(E) orderClause(F) limitClause(G). {
-	A = New_AST_QueryExpressionNode(B, C, NULL, D, NULL, E, F, G);
+expr(A) ::= matchClause(B) whereClause(C) setClause(D) returnClause(E) orderClause(F) skipClause(S) limitClause(G). {
+	A = New_AST_QueryExpressionNode(B, C, NULL, D, NULL, E, F, S, G, NULL, NULL);
 }
 
 expr(A) ::= createClause(B). {
-	A = New_AST_QueryExpressionNode(NULL, NULL, B, NULL, NULL, NULL, NULL, NULL);
+	A = New_AST_QueryExpressionNode(NULL, NULL, B, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+}
+
+expr(A) ::= callClause(B) whereClause(C) returnClause(D) orderClause(E) skipClause(S) limitClause(F). {
+	A = New_AST_QueryExpressionNode(NULL, C, NULL, NULL, NULL, D, E, S, F, B, NULL);
+}
+
+expr(A) ::= callClause(B). {
+	A = New_AST_QueryExpressionNode(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, B, NULL);
+}
+
+expr(A) ::= indexClause(B). {
+	A = New_AST_QueryExpressionNode(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, B);
 }
 
 %type matchClause { AST_MatchNode* }
@@ -95,6 +109,75 @@ setElement(A) ::= variable(B) EQ arithmetic_expression(C). {
 	A = New_AST_SetElement(B, C);
 }
 
+%type indexClause { AST_IndexNode* }
+// CREATE INDEX ON :person(name)
+indexClause(A) ::= CREATE INDEX ON COLON UQSTRING(B) LEFT_PARENTHESIS UQSTRING(C) RIGHT_PARENTHESIS. {
+	A = New_AST_IndexNode(B.strval, C.strval, N_ENTITY, CREATE_INDEX);
+}
+
+// CREATE INDEX ON [:paid](ts)
+indexClause(A) ::= CREATE INDEX ON LEFT_BRACKET COLON UQSTRING(B) RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING(C) RIGHT_PARENTHESIS. {
+	A = New_AST_IndexNode(B.strval, C.strval, N_LINK, CREATE_INDEX);
+}
+
+%type callClause { AST_CallNode* }
+// CALL db.idx.fulltext.queryNodes('Product', 'name', 'shoe*') YIELD node, score
+callClause(A) ::= CALL procedureName(B) LEFT_PARENTHESIS procedureArgs(C) RIGHT_PARENTHESIS yieldClause(D). {
+	A = New_AST_CallNode(B, C, D);
+}
+
+%type procedureName {char*}
+procedureName(A) ::= UQSTRING(B). {
+	A = B.strval;
+}
+// db.idx.fulltext
+procedureName(A) ::= procedureName(B) DOT UQSTRING(C). {
+	asprintf(&A, "%s.%s", B, C.strval);
+	free(B);
+	free(C.strval);
+}
+
+%type procedureArgs {Vector*}
+// No arguments.
+procedureArgs(A) ::= . {
+	A = NewVector(SIValue*, 0);
+}
+procedureArgs(A) ::= valueList(B). {
+	A = B;
+}
+
+%type valueList {Vector*}
+valueList(A) ::= value(B). {
+	A = NewVector(SIValue*, 1);
+	SIValue *val = malloc(sizeof(SIValue));
+	*val = B;
+	Vector_Push(A, val);
+}
+valueList(A) ::= valueList(B) COMMA value(C). {
+	SIValue *val = malloc(sizeof(SIValue));
+	*val = C;
+	Vector_Push(B, val);
+	A = B;
+}
+
+%type yieldClause {Vector*}
+yieldClause(A) ::= . {
+	A = NULL;
+}
+yieldClause(A) ::= YIELD yieldList(B). {
+	A = B;
+}
+
+%type yieldList {Vector*}
+yieldList(A) ::= UQSTRING(B). {
+	A = NewVector(char*, 1);
+	Vector_Push(A, B.strval);
+}
+yieldList(A) ::= yieldList(B) COMMA UQSTRING(C). {
+	Vector_Push(B, C.strval);
+	A = B;
+}
+
 %type chain {Vector*}
 
 chain(A) ::= node(B). {
@@ -255,6 +338,46 @@ cond(A) ::= UQSTRING(B) DOT UQSTRING(C) relation(D) UQSTRING(E) DOT UQSTRING(F).
 // me.age > 30
 // TODO: change value to arithmetic_expression.
 cond(A) ::= UQSTRING(B) DOT UQSTRING(C) relation(D) value(E). { A = New_AST_ConstantPredicateNode(B.strval, C.strval, D, E); }
+// me.name STARTS WITH "Ji"
+cond(A) ::= UQSTRING(B) DOT UQSTRING(C) STARTS WITH STRING(D). { A = New_AST_ConstantPredicateNode(B.strval, C.strval, STARTS, SI_StringVal(D.strval)); }
+cond(A) ::= UQSTRING(B) LEFT_PARENTHESIS UQSTRING(C) DOT UQSTRING(D) COMMA UQSTRING(E) DOT UQSTRING(F) COMMA coordinate(G) COMMA coordinate(H) RIGHT_PARENTHESIS relation(I) coordinate(J). {
+	/* distance(n.lat, n.lon, lat, lon) op meters, both properties must belong to the same node. */
+	if(strcasecmp(B.strval, "distance") != 0 || strcmp(C.strval, E.strval) != 0) {
+		char buf[256];
+		snprintf(buf, 256, "Unsupported predicate %s(%s.%s, %s.%s, ...)\n", B.strval, C.strval, D.strval, E.strval, F.strval);
+		ctx->ok = 0;
+		ctx->errorMsg = strdup(buf);
+	}
+	A = New_AST_DistancePredicateNode(C.strval, D.strval, F.strval, G, H, I, J);
+}
+// id(n) = 12
+cond(A) ::= UQSTRING(B) LEFT_PARENTHESIS UQSTRING(C) RIGHT_PARENTHESIS relation(D) entityId(E). {
+	if(strcasecmp(B.strval, "id") != 0) {
+		char buf[256];
+		snprintf(buf, 256, "Unsupported predicate %s(%s)\n", B.strval, C.strval);
+		ctx->ok = 0;
+		ctx->errorMsg = strdup(buf);
+	}
+	A = New_AST_IdPredicateNode(C.strval, D, E);
+}
+// id(n) IN [12, 14], a disjunction of id equalities.
+cond(A) ::= UQSTRING(B) LEFT_PARENTHESIS UQSTRING(C) RIGHT_PARENTHESIS IN LEFT_BRACKET entityIdList(D) RIGHT_BRACKET. {
+	if(strcasecmp(B.strval, "id") != 0) {
+		char buf[256];
+		snprintf(buf, 256, "Unsupported predicate %s(%s)\n", B.strval, C.strval);
+		ctx->ok = 0;
+		ctx->errorMsg = strdup(buf);
+	}
+	A = NULL;
+	for(int i = 0; i < Vector_Size(D); i++) {
+		int64_t *id;
+		Vector_Get(D, i, &id);
+		AST_FilterNode *pred = New_AST_IdPredicateNode(C.strval, EQ, *id);
+		A = (A == NULL) ? pred : New_AST_ConditionNode(A, OR, pred);
+		free(id);
+	}
+	Vector_Free(D);
+}
 cond(A) ::= LEFT_PARENTHESIS cond(B) RIGHT_PARENTHESIS. { A = B; }
 cond(A) ::= cond(B) AND cond(C). { A = New_AST_ConditionNode(B, AND, C); }
 cond(A) ::= cond(B) OR cond(C). { A = New_AST_ConditionNode(B, OR, C); }
@@ -417,6 +540,39 @@ limitClause(A) ::= LIMIT INTEGER(B). {
 	A = New_AST_LimitNode(B.intval);
 }
 
+%type skipClause {AST_SkipNode*}
+
+skipClause(A) ::= . {
+	A = NULL;
+}
+skipClause(A) ::= SKIP INTEGER(B). {
+	A = New_AST_SkipNode(B.intval);
+}
+
+
+%type entityId {int64_t}
+entityId(A) ::= INTEGER(B). { A = B.intval; }
+entityId(A) ::= DASH INTEGER(B). { A = -B.intval; }
+
+%type entityIdList {Vector*}
+entityIdList(A) ::= entityId(B). {
+	A = NewVector(int64_t*, 1);
+	int64_t *id = malloc(sizeof(int64_t));
+	*id = B;
+	Vector_Push(A, id);
+}
+entityIdList(A) ::= entityIdList(B) COMMA entityId(C). {
+	int64_t *id = malloc(sizeof(int64_t));
+	*id = C;
+	Vector_Push(B, id);
+	A = B;
+}
+
+%type coordinate {double}
+coordinate(A) ::= INTEGER(B). { A = B.intval; }
+coordinate(A) ::= DASH INTEGER(B). { A = -B.intval; }
+coordinate(A) ::= FLOAT(B). { A = B.dval; }
+coordinate(A) ::= DASH FLOAT(B). { A = -B.dval; }
 
 %type relation {int}
 relation(A) ::= EQ. { A = EQ; }
@@ -442,6 +598,7 @@ value(A) ::= FLOAT(B). {  A = SI_DoubleVal(B.dval); }
 value(A) ::= DASH FLOAT(B). {  A = SI_DoubleVal(-B.dval); }
 value(A) ::= TRUE. { A = SI_BoolVal(1); }
 value(A) ::= FALSE. { A = SI_BoolVal(0); }
+value(A) ::= PARAM(B). { A = SI_ParamVal(B.strval); }
 
 %code {
 
@@ -474,4 +631,19 @@ value(A) ::= FALSE. { A = SI_BoolVal(0); }
 		}
 		return ctx.root;
 	}
+
+	void Query_Tokenize(const char *q, size_t len, TokenCallback cb, void *udata) {
+		yycolumn = 1;
+		yy_scan_bytes(q, len);
+		int t = 0;
+		while( (t = yylex()) != 0) {
+			cb(t, &tok, udata);
+			free(tok.s);
+			tok.s = NULL;
+			if(t == UQSTRING || t == STRING || t == PARAM) {
+				free(tok.strval);
+				tok.strval = NULL;
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -375,8 +375,8 @@ static void yy_fatal_error (yyconst char msg[]  );
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 45
-#define YY_END_OF_BUFFER 46
+#define YY_NUM_RULES 54
+#define YY_END_OF_BUFFER 55
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -384,21 +384,24 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_accept[116] =
+static yyconst flex_int16_t yy_accept[145] =
     {   0,
-        0,    0,   46,   45,   43,   44,   45,   45,   45,   23,
-       24,   41,   42,   22,   37,   39,   40,   19,   38,   36,
-       34,   35,   20,   20,   20,   20,   20,   20,   20,   20,
-       20,   20,   20,   20,   20,   25,   26,   27,   28,   43,
-       33,    0,   21,    0,    0,    0,   31,   18,    0,   19,
-       32,   30,   29,   20,   20,   10,   14,   20,   20,   20,
-       20,   20,   20,    2,   20,   20,   20,   20,    0,   21,
-        0,    0,   21,    0,    1,   15,   20,   20,   20,   20,
-       20,   20,   20,   20,   20,    9,   20,   20,   20,   20,
-       16,   20,   20,   20,   20,   20,   20,    3,   20,   20,
-
-       20,   20,    4,   17,    5,   13,   20,   12,    6,    7,
-       20,    8,   20,   11,    0
+        0,    0,   55,   54,   52,   53,   54,   54,   54,   54,
+       32,   33,   50,   51,   31,   46,   48,   49,   27,   47,
+       45,   43,   44,   29,   29,   29,   29,   29,   29,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   34,   35,
+       36,   37,   52,   42,    0,   30,    0,   28,    0,   30,
+        0,   40,   26,    0,   27,   41,   39,   38,   29,   29,
+       10,   14,   29,   29,   29,   29,   29,   25,   29,   29,
+       24,    2,   29,   29,   29,   29,   29,   29,   29,   29,
+        0,   30,    0,   28,    0,   30,    0,    1,   15,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   29,   29,
+
+        9,   29,   29,   29,   29,   29,   29,   19,   29,   29,
+       16,   29,   29,   29,   29,   29,   29,   29,   18,   29,
+        3,   29,   22,   29,   29,   29,   29,    4,   23,   17,
+        5,   13,   29,   29,   12,   20,    6,    7,   29,    8,
+       21,   29,   11,    0
     } ;
 
 static yyconst YY_CHAR yy_ec[256] =
@@ -406,17 +409,17 @@ static yyconst YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1,    1,    1,    1,    2,    3,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    4,    5,    1,    1,    1,    1,    6,    7,
-        8,    9,   10,   11,   12,   13,   14,   15,   15,   15,
-       15,   15,   15,   15,   15,   15,   15,   16,    1,   17,
-       18,   19,    1,    1,   20,   21,   22,   23,   24,   25,
-       26,   27,   28,   26,   26,   29,   30,   31,   32,   26,
-       26,   33,   34,   35,   36,   26,   37,   26,   38,   26,
-       39,   40,   41,    1,   26,    1,   42,   43,   44,   45,
-
-       46,   47,   26,   48,   49,   26,   26,   50,   51,   52,
-       53,   26,   26,   54,   55,   56,   57,   26,   58,   26,
-       59,   26,   60,    1,   61,    1,    1,    1,    1,    1,
+        1,    2,    4,    5,    1,    6,    1,    1,    7,    8,
+        9,   10,   11,   12,   13,   14,   15,   16,   16,   16,
+       16,   16,   16,   16,   16,   16,   16,   17,    1,   18,
+       19,   20,    1,    1,   21,   22,   23,   24,   25,   26,
+       27,   28,   29,   27,   30,   31,   32,   33,   34,   35,
+       27,   36,   37,   38,   39,   27,   40,   41,   42,   27,
+       43,   44,   45,    1,   27,    1,   21,   22,   23,   24,
+
+       25,   26,   27,   28,   29,   27,   30,   31,   32,   33,
+       34,   35,   27,   36,   37,   38,   39,   27,   40,   41,
+       42,   27,   46,    1,   47,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -433,119 +436,157 @@ static yyconst YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static yyconst YY_CHAR yy_meta[62] =
+static yyconst YY_CHAR yy_meta[48] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    1,    1,    2,    1,    1,    1,    1,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    1,    1,
-        1,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    1,
-        1
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1
     } ;
 
-static yyconst flex_uint16_t yy_base[121] =
+static yyconst flex_uint16_t yy_base[145] =
     {   0,
-        0,    0,  204,  229,  201,  229,  184,   57,   58,  229,
-      229,  229,  229,  229,  182,  182,  229,   50,  229,   54,
-      229,  141,   36,   30,   36,   47,    0,   53,   50,   59,
-       48,   58,   59,   52,   59,  229,  229,  229,  229,  152,
-      229,   69,  229,   89,   70,   74,  229,  136,   72,   98,
-      229,  229,  229,    0,   77,   81,    0,   84,   83,   81,
-       87,   88,   84,   97,   88,   89,   90,   97,  122,  123,
-      129,  125,  135,  143,    0,    0,  115,  124,  128,  117,
-      119,  127,  134,  134,  124,    0,  140,  128,  131,  132,
-        0,  140,  147,  142,  152,  151,  152,    0,  166,  167,
-
-      168,  163,    0,    0,    0,    0,  164,    0,    0,    0,
-      174,    0,  164,    0,  229,  220,  222,   82,  224,  226
+        0,    0,  392,    0,   46,    0,   30,   49,   76,  118,
+        0,    0,    0,    0,    0,  146,  151,    0,  154,    0,
+      156,    0,  152,  160,  170,  183,  180,  130,  153,  144,
+      149,  158,  175,  155,  185,  170,  185,  187,    0,    0,
+        0,    0,    0,    0,    0,    0,  225,  257,    0,    0,
+      299,    0,    0,    0,    0,    0,    0,    0,    0,  193,
+      195,    0,  189,  196,  316,  187,  197,  250,  243,  238,
+        0,  253,  264,  310,  320,  329,  312,  327,  316,  330,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  325,
+      336,  333,  336,  322,  324,  337,  334,  341,  340,  327,
+
+        0,  332,  332,  344,  334,  343,  341,    0,  335,  336,
+        0,  346,  351,  336,  340,  351,  344,  345,    0,  344,
+        0,  358,    0,  360,  360,  361,  354,    0,    0,    0,
+        0,    0,  355,  352,    0,    0,    0,    0,  367,    0,
+        0,  353,    0,  393
     } ;
 
-static yyconst flex_int16_t yy_def[121] =
+static yyconst flex_int16_t yy_def[145] =
     {   0,
-      115,    1,  115,  115,  115,  115,  115,  116,  117,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  118,  118,  118,  118,  118,  118,  118,  118,
-      118,  118,  118,  118,  118,  115,  115,  115,  115,  115,
-      115,  116,  115,  119,  117,  120,  115,  115,  115,  115,
-      115,  115,  115,  118,  118,  118,  118,  118,  118,  118,
-      118,  118,  118,  118,  118,  118,  118,  118,  116,  116,
-      119,  117,  117,  120,  118,  118,  118,  118,  118,  118,
-      118,  118,  118,  118,  118,  118,  118,  118,  118,  118,
-      118,  118,  118,  118,  118,  118,  118,  118,  118,  118,
-
-      118,  118,  118,  118,  118,  118,  118,  118,  118,  118,
-      118,  118,  118,  118,    0,  115,  115,  115,  115,  115
+      144,    1,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,   24,   25,   25,   25,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,  144,  144,
+      144,  144,    5,  144,    8,  144,    8,  144,   10,  144,
+       10,  144,   17,   17,   19,  144,  144,  144,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+        8,    8,   47,   48,   10,   10,   51,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,   28,   28,   28,   28,   28,   28,   28,
+       28,   28,   28,    0
     } ;
 
-static yyconst flex_uint16_t yy_nxt[291] =
+static yyconst flex_uint16_t yy_nxt[441] =
     {   0,
         4,    5,    6,    7,    8,    9,   10,   11,   12,   13,
        14,   15,   16,   17,   18,   19,   20,   21,   22,   23,
-       24,   25,   26,   27,   28,   27,   27,   27,   29,   30,
-       27,   31,   32,   33,   34,   27,   35,   27,   36,    4,
-       37,   23,   24,   25,   26,   27,   28,   27,   27,   29,
-       30,   27,   31,   32,   33,   34,   27,   35,   27,   38,
-       39,   43,   49,   43,   50,   51,   55,   57,   58,   56,
-       59,   52,   61,   43,   60,   43,   45,   62,   63,   73,
-       64,   65,   66,   54,   67,   68,   48,   55,   57,   58,
-       56,   42,   59,   70,   61,   60,   44,   46,   62,   75,
-
-       63,   64,   76,   65,   66,   67,   68,   77,   44,   46,
-       49,   78,   50,   74,   80,   81,   79,   82,   83,   84,
-       88,   75,   85,   86,   76,   87,   43,   43,   71,   77,
-       43,   42,   78,   70,   89,   80,   81,   79,   82,   83,
-       43,   84,   88,   85,   86,   45,   87,   90,   73,   91,
-       48,   92,   93,   40,   94,   95,   89,   96,   53,   97,
-       99,   44,   44,   98,   46,  100,  101,  102,   71,   90,
-      103,   91,   92,   93,   46,   94,  104,   95,  105,   96,
-       97,   99,   74,  106,  107,   98,  100,  101,  102,  108,
-      109,  110,  103,  111,  112,  113,   48,  104,  114,  105,
-
-       47,   41,   40,  115,  106,  107,  115,  115,  115,  115,
-      115,  108,  109,  110,  111,  112,  115,  113,  115,  114,
-       42,   42,   45,   45,   69,   69,   72,   72,    3,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115
+       24,   25,   26,   27,   28,   29,   28,   28,   30,   28,
+       31,   32,   28,   33,   28,   34,   35,   36,   28,   37,
+       28,   38,   39,    4,   40,   41,   42,   43,   44,   45,
+       45,   45,   45,   46,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   47,   45,   45,   45,   48,   48,   48,   48,
+
+       48,   48,   48,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   48,   48,   48,   48,   48,   49,   49,
+       49,   49,   49,   49,   50,   49,   49,   49,   49,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   49,   49,   49,   49,   49,   49,   49,   49,   49,
+       49,   51,   49,   49,   49,   52,   53,   54,   56,   55,
+       58,   59,   59,   67,   57,   59,   68,   69,   70,   73,
+       59,   59,   59,   59,   59,   59,   59,   59,   59,   59,
+       59,   59,   60,   59,   59,   59,   61,   59,   59,   59,
+
+       59,   59,   59,   63,   65,   77,   59,   71,   66,   74,
+       72,   62,   78,   79,   75,   80,   88,   89,   64,   90,
+       91,   59,   76,   94,   59,   81,   81,   95,   81,   82,
+       81,   81,   81,   81,   81,   81,   81,   81,   81,   81,
+       81,   81,   81,   81,   81,   81,   81,   81,   81,   81,
+       81,   81,   81,   81,   81,   81,   81,   81,   81,   81,
+       81,   81,   81,   81,   81,   81,   81,   81,   83,   81,
+       81,   81,   84,   96,   97,   98,   99,   84,   84,   84,
+       84,   84,   84,   84,   84,   84,   84,   84,   84,   84,
+       84,   84,   84,   84,   84,   84,   84,   84,   84,   85,
+
+       85,  100,   85,   85,   85,   86,   85,   85,   85,   85,
+       85,   85,   85,   85,   85,   85,   85,   85,   85,   85,
+       85,   85,   85,   85,   85,   85,   85,   85,   85,   85,
+       85,   85,   85,   85,   85,   85,   85,   85,   85,   85,
+       85,   85,   87,   85,   85,   85,   92,  101,  102,  103,
+      104,  105,   93,  106,  107,  108,  109,  110,  111,  112,
+      113,  114,  115,  116,  117,  118,  119,  120,  121,  122,
+      123,  124,  125,  126,  127,  128,  129,  130,  131,  132,
+      133,  134,  135,  136,  137,  138,  139,  140,  141,  142,
+      143,  144,    3,  144,  144,  144,  144,  144,  144,  144,
+
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144
     } ;
 
-static yyconst flex_int16_t yy_chk[291] =
+static yyconst flex_int16_t yy_chk[441] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    8,   18,    9,   18,   20,   23,   24,   25,   23,
-       26,   20,   28,   42,   26,   45,   46,   29,   30,   46,
-       31,   32,   33,  118,   34,   35,   49,   23,   24,   25,
-       23,   44,   26,   44,   28,   26,    8,    9,   29,   55,
-
-       30,   31,   56,   32,   33,   34,   35,   58,   42,   45,
-       50,   59,   50,   46,   60,   61,   59,   62,   63,   64,
-       68,   55,   65,   66,   56,   67,   69,   70,   44,   58,
-       72,   71,   59,   71,   77,   60,   61,   59,   62,   63,
-       73,   64,   68,   65,   66,   74,   67,   78,   74,   79,
-       48,   80,   81,   40,   82,   83,   77,   84,   22,   85,
-       88,   69,   70,   87,   72,   89,   90,   92,   71,   78,
-       93,   79,   80,   81,   73,   82,   94,   83,   95,   84,
-       85,   88,   74,   96,   97,   87,   89,   90,   92,   99,
-      100,  101,   93,  102,  107,  111,   16,   94,  113,   95,
-
-       15,    7,    5,    3,   96,   97,    0,    0,    0,    0,
-        0,   99,  100,  101,  102,  107,    0,  111,    0,  113,
-      116,  116,  117,  117,  119,  119,  120,  120,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115,
-      115,  115,  115,  115,  115,  115,  115,  115,  115,  115
+        1,    1,    1,    1,    1,    1,    1,    5,    7,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    9,    9,    9,    9,
+
+        9,    9,    9,    9,    9,    9,    9,    9,    9,    9,
+        9,    9,    9,    9,    9,    9,    9,    9,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   16,   17,   19,   21,   19,
+       23,   28,   24,   29,   21,   24,   30,   31,   32,   34,
+       24,   24,   24,   24,   24,   24,   24,   24,   24,   24,
+       24,   24,   24,   24,   24,   24,   24,   24,   24,   24,
+
+       24,   24,   25,   26,   27,   36,   25,   33,   27,   35,
+       33,   25,   37,   37,   35,   38,   60,   61,   26,   63,
+       64,   27,   35,   66,   26,   47,   47,   67,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   47,   47,
+       47,   47,   48,   68,   69,   70,   72,   48,   48,   48,
+       48,   48,   48,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   48,   48,   48,   48,   48,   48,   51,
+
+       51,   73,   51,   51,   51,   51,   51,   51,   51,   51,
+       51,   51,   51,   51,   51,   51,   51,   51,   51,   51,
+       51,   51,   51,   51,   51,   51,   51,   51,   51,   51,
+       51,   51,   51,   51,   51,   51,   51,   51,   51,   51,
+       51,   51,   51,   51,   51,   51,   65,   74,   75,   76,
+       77,   78,   65,   79,   80,   90,   91,   92,   93,   94,
+       95,   96,   97,   98,   99,  100,  102,  103,  104,  105,
+      106,  107,  109,  110,  112,  113,  114,  115,  116,  117,
+      118,  120,  122,  124,  125,  126,  127,  133,  134,  139,
+      142,    3,  144,  144,  144,  144,  144,  144,  144,  144,
+
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144,
+      144,  144,  144,  144,  144,  144,  144,  144,  144,  144
     } ;
 
 static yy_state_type yy_last_accepting_state;
@@ -579,7 +620,7 @@ int yycolumn = 1;
 #define YY_USER_ACTION yycolumn += yyleng; \
     tok.pos = yycolumn; \
     tok.s = strdup(yytext);
-#line 583 "lex.yy.c"
+#line 624 "lex.yy.c"
 
 #define INITIAL 0
 
@@ -800,7 +841,7 @@ YY_DECL
 #line 19 "lexer.l"
 
 
-#line 804 "lex.yy.c"
+#line 845 "lex.yy.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -827,13 +868,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 116 )
+				if ( yy_current_state >= 145 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 229 );
+		while ( yy_base[yy_current_state] != 393 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -944,32 +985,80 @@ YY_RULE_SETUP
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
+#line 38 "lexer.l"
+{ return SKIP; }
+	YY_BREAK
+case 19:
+YY_RULE_SETUP
+#line 39 "lexer.l"
+{ return CALL; }
+	YY_BREAK
+case 20:
+YY_RULE_SETUP
 #line 40 "lexer.l"
+{ return YIELD; }
+	YY_BREAK
+case 21:
+YY_RULE_SETUP
+#line 41 "lexer.l"
+{ return STARTS; }
+	YY_BREAK
+case 22:
+YY_RULE_SETUP
+#line 42 "lexer.l"
+{ return WITH; }
+	YY_BREAK
+case 23:
+YY_RULE_SETUP
+#line 43 "lexer.l"
+{ return INDEX; }
+	YY_BREAK
+case 24:
+YY_RULE_SETUP
+#line 44 "lexer.l"
+{ return ON; }
+	YY_BREAK
+case 25:
+YY_RULE_SETUP
+#line 45 "lexer.l"
+{ return IN; }
+	YY_BREAK
+case 26:
+YY_RULE_SETUP
+#line 48 "lexer.l"
 {
 	tok.dval = atof(yytext);
 	return FLOAT; 
 }
 	YY_BREAK
-case 19:
+case 27:
 YY_RULE_SETUP
-#line 45 "lexer.l"
+#line 53 "lexer.l"
 {
-  tok.intval = atoi(yytext); 
+  tok.intval = atoll(yytext); 
   return INTEGER;
 }
 	YY_BREAK
-case 20:
+case 28:
 YY_RULE_SETUP
-#line 50 "lexer.l"
+#line 58 "lexer.l"
+{
+  	tok.strval = strdup(yytext+1);
+  	return PARAM; // Query parameter placeholder, e.g. $name.
+}
+	YY_BREAK
+case 29:
+YY_RULE_SETUP
+#line 63 "lexer.l"
 {
   	tok.strval = strdup(yytext);
   	return UQSTRING; // Unqueoted string, used for entity alias, prop name and labels.
 }
 	YY_BREAK
-case 21:
-/* rule 21 can match eol */
+case 30:
+/* rule 30 can match eol */
 YY_RULE_SETUP
-#line 55 "lexer.l"
+#line 68 "lexer.l"
 {
   /* String literals, with escape sequences - enclosed by "" or '' */
   *(yytext+strlen(yytext)-1) = '\0';
@@ -977,128 +1066,128 @@ YY_RULE_SETUP
   return STRING;
 }
 	YY_BREAK
-case 22:
+case 31:
 YY_RULE_SETUP
-#line 62 "lexer.l"
+#line 75 "lexer.l"
 { return COMMA; }
 	YY_BREAK
-case 23:
+case 32:
 YY_RULE_SETUP
-#line 63 "lexer.l"
+#line 76 "lexer.l"
 { return LEFT_PARENTHESIS; }
 	YY_BREAK
-case 24:
+case 33:
 YY_RULE_SETUP
-#line 64 "lexer.l"
+#line 77 "lexer.l"
 { return RIGHT_PARENTHESIS; }
 	YY_BREAK
-case 25:
+case 34:
 YY_RULE_SETUP
-#line 65 "lexer.l"
+#line 78 "lexer.l"
 { return LEFT_BRACKET; }
 	YY_BREAK
-case 26:
+case 35:
 YY_RULE_SETUP
-#line 66 "lexer.l"
+#line 79 "lexer.l"
 { return RIGHT_BRACKET; }
 	YY_BREAK
-case 27:
+case 36:
 YY_RULE_SETUP
-#line 67 "lexer.l"
+#line 80 "lexer.l"
 { return LEFT_CURLY_BRACKET; }
 	YY_BREAK
-case 28:
+case 37:
 YY_RULE_SETUP
-#line 68 "lexer.l"
+#line 81 "lexer.l"
 { return RIGHT_CURLY_BRACKET; }
 	YY_BREAK
-case 29:
+case 38:
 YY_RULE_SETUP
-#line 69 "lexer.l"
+#line 82 "lexer.l"
 { return GE; }
 	YY_BREAK
-case 30:
+case 39:
 YY_RULE_SETUP
-#line 70 "lexer.l"
+#line 83 "lexer.l"
 { return LE; }
 	YY_BREAK
-case 31:
+case 40:
 YY_RULE_SETUP
-#line 71 "lexer.l"
+#line 84 "lexer.l"
 { return RIGHT_ARROW; }
 	YY_BREAK
-case 32:
+case 41:
 YY_RULE_SETUP
-#line 72 "lexer.l"
+#line 85 "lexer.l"
 { return LEFT_ARROW; }
 	YY_BREAK
-case 33:
+case 42:
 YY_RULE_SETUP
-#line 73 "lexer.l"
+#line 86 "lexer.l"
 {  return NE; }
 	YY_BREAK
-case 34:
+case 43:
 YY_RULE_SETUP
-#line 74 "lexer.l"
+#line 87 "lexer.l"
 { return EQ; }
 	YY_BREAK
-case 35:
+case 44:
 YY_RULE_SETUP
-#line 75 "lexer.l"
+#line 88 "lexer.l"
 { return GT; }
 	YY_BREAK
-case 36:
+case 45:
 YY_RULE_SETUP
-#line 76 "lexer.l"
+#line 89 "lexer.l"
 { return LT; }
 	YY_BREAK
-case 37:
+case 46:
 YY_RULE_SETUP
-#line 77 "lexer.l"
+#line 90 "lexer.l"
 { return DASH; }
 	YY_BREAK
-case 38:
+case 47:
 YY_RULE_SETUP
-#line 78 "lexer.l"
+#line 91 "lexer.l"
 { return COLON; }
 	YY_BREAK
-case 39:
+case 48:
 YY_RULE_SETUP
-#line 79 "lexer.l"
+#line 92 "lexer.l"
 { return DOT; }
 	YY_BREAK
-case 40:
+case 49:
 YY_RULE_SETUP
-#line 80 "lexer.l"
+#line 93 "lexer.l"
 { return DIV; }
 	YY_BREAK
-case 41:
+case 50:
 YY_RULE_SETUP
-#line 81 "lexer.l"
+#line 94 "lexer.l"
 { return MUL; }
 	YY_BREAK
-case 42:
+case 51:
 YY_RULE_SETUP
-#line 82 "lexer.l"
+#line 95 "lexer.l"
 { return ADD; }
 	YY_BREAK
-case 43:
+case 52:
 YY_RULE_SETUP
-#line 84 "lexer.l"
+#line 97 "lexer.l"
 /* ignore whitespace */
 	YY_BREAK
-case 44:
-/* rule 44 can match eol */
+case 53:
+/* rule 53 can match eol */
 YY_RULE_SETUP
-#line 85 "lexer.l"
+#line 98 "lexer.l"
 { yycolumn = 1; } /* ignore whitespace */
 	YY_BREAK
-case 45:
+case 54:
 YY_RULE_SETUP
-#line 87 "lexer.l"
+#line 100 "lexer.l"
 ECHO;
 	YY_BREAK
-#line 1102 "lex.yy.c"
+#line 1191 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1391,7 +1480,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 116 )
+			if ( yy_current_state >= 145 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1419,11 +1508,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 116 )
+		if ( yy_current_state >= 145 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 115);
+	yy_is_jam = (yy_current_state == 144);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2099,8 +2188,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 87 "lexer.l"
-
+#line 100 "lexer.l"
 
 
 /**
@@ -2,6 +2,13 @@
 #define __PARSER_COMMON_H__
 #include <stdlib.h>
 #include "ast.h"
+#include "token.h"
+
+/* Invoked for each token scanned, token strings are freed once it returns. */
+typedef void (*TokenCallback)(int type, const Token *t, void *udata);
 
 AST_QueryExpressionNode *Query_Parse(const char *q, size_t len, char **err);
+
+/* Scans q, passing each of its tokens to cb. */
+void Query_Tokenize(const char *q, size_t len, TokenCallback cb, void *udata);
 #endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "plan_cache.h"
+#include "parser/grammar.h"
+#include "parser/parser_common.h"
+#include "stores/store.h"
+#include <string.h>
+#include <strings.h>
+
+/* Caches by graph name. */
+static rax *__caches = NULL;
+
+/* Token scanned off a query, token's strings are owned. */
+typedef struct {
+    int type;
+    char *s;
+    char *strval;
+    int64_t intval;
+    double dval;
+} _ScannedToken;
+
+typedef struct {
+    _ScannedToken *tokens;
+    int count;
+    int cap;
+} _ScannedQuery;
+
+static void _PlanCache_CollectToken(int type, const Token *t, void *udata) {
+    _ScannedQuery *q = (_ScannedQuery*)udata;
+    if(q->count == q->cap) {
+        q->cap = (q->cap) ? q->cap * 2 : 32;
+        q->tokens = realloc(q->tokens, sizeof(_ScannedToken) * q->cap);
+    }
+    _ScannedToken *st = &q->tokens[q->count++];
+    st->type = type;
+    st->s = strdup(t->s);
+    st->strval = (type == STRING || type == UQSTRING) ? strdup(t->strval) : NULL;
+    st->intval = t->intval;
+    st->dval = t->dval;
+}
+
+static int _PlanCache_IsLiteral(int type) {
+    return (type == INTEGER || type == FLOAT || type == STRING);
+}
+
+/* Token can end an operand, a following dash is a subtraction. */
+static int _PlanCache_EndsOperand(int type) {
+    return (_PlanCache_IsLiteral(type) || type == UQSTRING || type == PARAM ||
+            type == TRUE || type == FALSE || type == RIGHT_PARENTHESIS);
+}
+
+static int _PlanCache_IsRelation(int type) {
+    return (type == EQ || type == NE || type == LT || type == GT || type == LE || type == GE);
+}
+
+/* Literal starting at position i is part of the query's structure
+ * rather than a value, LIMIT 10, SKIP 5, STARTS WITH 'a', id(n) = 3. */
+static int _PlanCache_FixedLiteral(const _ScannedQuery *q, int i) {
+    /* Negative literal, -5. */
+    if(i > 0 && q->tokens[i - 1].type == DASH && (i < 2 || !_PlanCache_EndsOperand(q->tokens[i - 2].type))) i--;
+    int prev = (i > 0) ? q->tokens[i - 1].type : 0;
+    if(prev == LIMIT || prev == SKIP || prev == WITH) return 1;
+    /* Right hand side of id(n) and distance(...) predicates. */
+    return (_PlanCache_IsRelation(prev) && i > 1 && q->tokens[i - 2].type == RIGHT_PARENTHESIS);
+}
+
+int PlanCache_ReservedParam(const char *name) {
+    return (strncmp(name, PLAN_CACHE_PARAM_PREFIX, strlen(PLAN_CACHE_PARAM_PREFIX)) == 0);
+}
+
+void PlanCache_Normalize(const char *query, NormalizedQuery *nq) {
+    _ScannedQuery q = {.tokens = NULL, .count = 0, .cap = 0};
+    Query_Tokenize(query, strlen(query), _PlanCache_CollectToken, &q);
+
+    nq->text = sdsempty();
+    nq->names = NULL;
+    nq->values = NULL;
+    nq->count = 0;
+
+    /* Procedure arguments are validated by type, leave them be,
+     * a reserved parameter would alias a lifted literal. */
+    int lift = 1;
+    for(int i = 0; i < q.count; i++) {
+        if(q.tokens[i].type == CALL) lift = 0;
+        if(q.tokens[i].type == PARAM && PlanCache_ReservedParam(q.tokens[i].s + 1)) lift = 0;
+    }
+
+    int in_list = 0;        /* Within id(n) IN [...] */
+    int distance_depth = 0; /* Parentheses nesting within distance(...) */
+    for(int i = 0; i < q.count; i++) {
+        _ScannedToken *t = &q.tokens[i];
+        int prev = (i > 0) ? q.tokens[i - 1].type : 0;
+
+        if(t->type == LEFT_BRACKET && prev == IN) in_list = 1;
+        else if(t->type == RIGHT_BRACKET) in_list = 0;
+
+        if(distance_depth) {
+            if(t->type == LEFT_PARENTHESIS) distance_depth++;
+            else if(t->type == RIGHT_PARENTHESIS) distance_depth--;
+        } else if(t->type == LEFT_PARENTHESIS && prev == UQSTRING &&
+                  strcasecmp(q.tokens[i - 1].strval, "distance") == 0) {
+            distance_depth = 1;
+        }
+
+        /* A dash which doesn't follow an operand negates the literal following it. */
+        _ScannedToken *literal = t;
+        if(t->type == DASH && !_PlanCache_EndsOperand(prev) &&
+           i + 1 < q.count && q.tokens[i + 1].type != STRING) {
+            literal = &q.tokens[i + 1];
+        }
+
+        if(i > 0) nq->text = sdscat(nq->text, " ");
+
+        if(!lift || in_list || distance_depth || !_PlanCache_IsLiteral(literal->type) ||
+           _PlanCache_FixedLiteral(&q, i)) {
+            nq->text = sdscat(nq->text, t->s);
+            continue;
+        }
+
+        SIValue v;
+        if(literal->type == STRING) v = SI_StringVal(literal->strval);
+        else if(literal->type == INTEGER) v = SI_DoubleVal(literal->intval);
+        else v = SI_DoubleVal(literal->dval);
+        if(literal != t) {
+            v.doubleval = -v.doubleval;
+            i++;
+        }
+
+        nq->names = realloc(nq->names, sizeof(char*) * (nq->count + 1));
+        nq->values = realloc(nq->values, sizeof(SIValue) * (nq->count + 1));
+        asprintf(&nq->names[nq->count], PLAN_CACHE_PARAM_PREFIX "%d", nq->count);
+        nq->values[nq->count] = v;
+        nq->text = sdscatprintf(nq->text, "$%s", nq->names[nq->count]);
+        nq->count++;
+    }
+
+    for(int i = 0; i < q.count; i++) {
+        free(q.tokens[i].s);
+        free(q.tokens[i].strval);
+    }
+    free(q.tokens);
+}
+
+void NormalizedQuery_Free(NormalizedQuery *nq) {
+    for(int i = 0; i < nq->count; i++) {
+        free(nq->names[i]);
+        SIValue_Free(&nq->values[i]);
+    }
+    free(nq->names);
+    free(nq->values);
+    sdsfree(nq->text);
+}
+
+PlanCache* NewPlanCache(const char *graph_name, size_t capacity) {
+    PlanCache *cache = calloc(1, sizeof(PlanCache));
+    cache->graph_name = strdup(graph_name);
+    cache->entries = raxNew();
+    cache->capacity = capacity;
+    return cache;
+}
+
+PlanCache* PlanCache_Get(const char *graph_name) {
+    if(__caches == NULL) __caches = raxNew();
+
+    PlanCache *cache = raxFind(__caches, (unsigned char *)graph_name, strlen(graph_name));
+    if(cache == raxNotFound) {
+        cache = NewPlanCache(graph_name, PLAN_CACHE_CAPACITY);
+        raxInsert(__caches, (unsigned char *)graph_name, strlen(graph_name), cache, NULL);
+    }
+    return cache;
+}
+
+void PlanCache_Remove(const char *graph_name) {
+    if(__caches == NULL) return;
+
+    PlanCache *cache;
+    if(raxRemove(__caches, (unsigned char *)graph_name, strlen(graph_name), (void**)&cache)) {
+        PlanCache_Free(cache);
+    }
+}
+
+static void _PlanCacheEntry_Free(PlanCacheEntry *entry) {
+    if(entry->ast) {
+        AST_FreeParams(entry->params);
+        Free_AST_QueryExpressionNode(entry->ast);
+    }
+    free(entry->key);
+    free(entry);
+}
+
+static void _PlanCache_Unlink(PlanCache *cache, PlanCacheEntry *entry) {
+    if(entry->prev) entry->prev->next = entry->next;
+    else cache->head = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void _PlanCache_PushFront(PlanCache *cache, PlanCacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if(cache->head) cache->head->prev = entry;
+    cache->head = entry;
+    if(cache->tail == NULL) cache->tail = entry;
+}
+
+static void _PlanCache_Evict(PlanCache *cache, PlanCacheEntry *entry) {
+    _PlanCache_Unlink(cache, entry);
+    raxRemove(cache->entries, (unsigned char *)entry->key, strlen(entry->key), NULL);
+    _PlanCacheEntry_Free(entry);
+}
+
+PlanCacheEntry* PlanCache_Lookup(PlanCache *cache, const char *key) {
+    PlanCacheEntry *entry = raxFind(cache->entries, (unsigned char *)key, strlen(key));
+    if(entry == raxNotFound) {
+        cache->misses++;
+        return NULL;
+    }
+
+    /* Collapsed nodes were expanded against a previous schema. */
+    if(entry->schema_version != LabelStore_SchemaVersion(cache->graph_name)) {
+        _PlanCache_Evict(cache, entry);
+        cache->misses++;
+        return NULL;
+    }
+
+    _PlanCache_Unlink(cache, entry);
+    _PlanCache_PushFront(cache, entry);
+    if(entry->ast) cache->hits++;
+    else cache->misses++;
+    return entry;
+}
+
+PlanCacheEntry* PlanCache_Insert(PlanCache *cache, const char *key, AST_QueryExpressionNode *ast) {
+    PlanCacheEntry *entry = raxFind(cache->entries, (unsigned char *)key, strlen(key));
+    if(entry != raxNotFound) _PlanCache_Evict(cache, entry);
+    if(cache->tail && raxSize(cache->entries) >= cache->capacity) _PlanCache_Evict(cache, cache->tail);
+
+    entry = malloc(sizeof(PlanCacheEntry));
+    entry->key = strdup(key);
+    entry->ast = ast;
+    entry->params = (ast) ? AST_CollectParams(ast) : NULL;
+    entry->schema_version = LabelStore_SchemaVersion(cache->graph_name);
+    _PlanCache_PushFront(cache, entry);
+    raxInsert(cache->entries, (unsigned char *)entry->key, strlen(entry->key), entry, NULL);
+    return entry;
+}
+
+void PlanCache_Free(PlanCache *cache) {
+    PlanCacheEntry *entry = cache->head;
+    while(entry) {
+        PlanCacheEntry *next = entry->next;
+        _PlanCacheEntry_Free(entry);
+        entry = next;
+    }
+    raxFree(cache->entries);
+    free(cache->graph_name);
+    free(cache);
+}
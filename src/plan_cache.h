@@ -0,0 +1,75 @@
+#ifndef __PLAN_CACHE_H
+#define __PLAN_CACHE_H
+
+#include <stdint.h>
+#include "value.h"
+#include "parser/ast.h"
+#include "rmutil/vector.h"
+#include "rmutil/sds.h"
+#include "dep/rax/rax.h"
+
+/* Number of queries cached per graph. */
+#define PLAN_CACHE_CAPACITY 64
+
+/* Implicit parameters are named PLAN_CACHE_PARAM_PREFIX followed by their position,
+ * parameters of this prefix are reserved. */
+#define PLAN_CACHE_PARAM_PREFIX "__p"
+
+/* Query text with its literals lifted into implicit parameters,
+ * queries differing only by their literals normalize to the same text. */
+typedef struct {
+    sds text;           /* Tokens separated by spaces, lifted literals replaced by $__pN. */
+    char **names;       /* Implicit parameters names, __p0, __p1... */
+    SIValue *values;    /* Lifted literals, numbers are doubles. */
+    int count;          /* Number of lifted literals. */
+} NormalizedQuery;
+
+typedef struct PlanCacheEntry {
+    char *key;                      /* Normalized query text. */
+    AST_QueryExpressionNode *ast;   /* Validated AST, NULL if normalized text isn't a valid query. */
+    Vector *params;                 /* AST_Param pointers, implicit and explicit placeholders. */
+    uint64_t schema_version;        /* Schema version ast was built against. */
+    struct PlanCacheEntry *prev;
+    struct PlanCacheEntry *next;
+} PlanCacheEntry;
+
+/* Least recently used cache of validated ASTs, keyed by normalized query text. */
+typedef struct {
+    char *graph_name;       /* Graph whose queries are cached. */
+    rax *entries;           /* Entries keyed by normalized query text. */
+    PlanCacheEntry *head;   /* Most recently used entry. */
+    PlanCacheEntry *tail;   /* Least recently used entry, evicted first. */
+    size_t capacity;        /* Maximum number of entries. */
+    uint64_t hits;          /* Lookups served by a cached AST. */
+    uint64_t misses;        /* Lookups which required parsing. */
+} PlanCache;
+
+/* Lifts query's literals into implicit parameters, literals which shape the query
+ * e.g. LIMIT, SKIP, entity ids and distance coordinates are left in place,
+ * queries calling a procedure or referring to a reserved parameter are left as is. */
+void PlanCache_Normalize(const char *query, NormalizedQuery *nq);
+
+/* Returns 1 if name is reserved for implicit parameters. */
+int PlanCache_ReservedParam(const char *name);
+
+void NormalizedQuery_Free(NormalizedQuery *nq);
+
+PlanCache* NewPlanCache(const char *graph_name, size_t capacity);
+
+/* Returns graph's cache, created on first access. */
+PlanCache* PlanCache_Get(const char *graph_name);
+
+/* Drops graph's cache. */
+void PlanCache_Remove(const char *graph_name);
+
+/* Returns the entry cached under key, NULL if there's none or if the graph's schema
+ * changed since it was cached, updates hit and miss counters. */
+PlanCacheEntry* PlanCache_Lookup(PlanCache *cache, const char *key);
+
+/* Caches ast under key, evicting the least recently used entry if cache is full,
+ * a NULL ast marks key as uncacheable, takes ownership of ast. */
+PlanCacheEntry* PlanCache_Insert(PlanCache *cache, const char *key, AST_QueryExpressionNode *ast);
+
+void PlanCache_Free(PlanCache *cache);
+
+#endif
@@ -0,0 +1,105 @@
+#include "prepared_statement.h"
+#include "stores/store.h"
+#include "dep/rax/rax.h"
+#include <string.h>
+
+/* Statements by graph name and query text. */
+static rax *__statements = NULL;
+/* Statements by id, deallocated statements leave a NULL behind. */
+static Vector *__statements_by_id = NULL;
+
+/* Statement key, graph name followed by query text, separated by a null byte. */
+static size_t _PreparedStatement_Key(const char *graph_name, const char *query, char **key) {
+    size_t graph_name_len = strlen(graph_name);
+    size_t query_len = strlen(query);
+    size_t key_len = graph_name_len + 1 + query_len;
+    *key = malloc(key_len);
+    memcpy(*key, graph_name, graph_name_len + 1);
+    memcpy(*key + graph_name_len + 1, query, query_len);
+    return key_len;
+}
+
+PreparedStatement* PreparedStatement_Lookup(const char *graph_name, const char *query) {
+    if(__statements == NULL) return NULL;
+
+    char *key;
+    size_t key_len = _PreparedStatement_Key(graph_name, query, &key);
+    PreparedStatement *stmt = raxFind(__statements, (unsigned char *)key, key_len);
+    free(key);
+    return (stmt == raxNotFound) ? NULL : stmt;
+}
+
+PreparedStatement* PreparedStatement_Register(const char *graph_name, const char *query,
+                                              AST_QueryExpressionNode *ast) {
+    if(__statements == NULL) {
+        __statements = raxNew();
+        __statements_by_id = NewVector(PreparedStatement*, 16);
+    }
+
+    PreparedStatement *stmt = malloc(sizeof(PreparedStatement));
+    stmt->id = Vector_Size(__statements_by_id);
+    stmt->graph_name = strdup(graph_name);
+    stmt->query = strdup(query);
+    stmt->ast = ast;
+    stmt->params = AST_CollectParams(ast);
+    stmt->schema_version = LabelStore_SchemaVersion(stmt->graph_name);
+    Vector_Push(__statements_by_id, stmt);
+
+    char *key;
+    size_t key_len = _PreparedStatement_Key(graph_name, query, &key);
+    raxInsert(__statements, (unsigned char *)key, key_len, stmt, NULL);
+    free(key);
+    return stmt;
+}
+
+PreparedStatement* PreparedStatement_Get(long long id) {
+    if(__statements_by_id == NULL || id < 0 || id >= Vector_Size(__statements_by_id)) return NULL;
+    PreparedStatement *stmt;
+    Vector_Get(__statements_by_id, id, &stmt);
+    return stmt;
+}
+
+int PreparedStatement_Stale(const PreparedStatement *stmt) {
+    return stmt->schema_version != LabelStore_SchemaVersion(stmt->graph_name);
+}
+
+void PreparedStatement_Reprepare(PreparedStatement *stmt, AST_QueryExpressionNode *ast) {
+    AST_FreeParams(stmt->params);
+    Free_AST_QueryExpressionNode(stmt->ast);
+    stmt->ast = ast;
+    stmt->params = AST_CollectParams(ast);
+    stmt->schema_version = LabelStore_SchemaVersion(stmt->graph_name);
+}
+
+static void _PreparedStatement_Free(PreparedStatement *stmt) {
+    char *key;
+    size_t key_len = _PreparedStatement_Key(stmt->graph_name, stmt->query, &key);
+    raxRemove(__statements, (unsigned char *)key, key_len, NULL);
+    free(key);
+
+    /* Vector_Put skips NULL elements, clear slot through a pointer. */
+    PreparedStatement *none = NULL;
+    __vector_PutPtr(__statements_by_id, stmt->id, &none);
+    AST_FreeParams(stmt->params);
+    Free_AST_QueryExpressionNode(stmt->ast);
+    free(stmt->graph_name);
+    free(stmt->query);
+    free(stmt);
+}
+
+int PreparedStatement_Deallocate(long long id) {
+    PreparedStatement *stmt = PreparedStatement_Get(id);
+    if(!stmt) return 0;
+    _PreparedStatement_Free(stmt);
+    return 1;
+}
+
+void PreparedStatement_RemoveGraph(const char *graph_name) {
+    if(__statements_by_id == NULL) return;
+
+    for(int i = 0; i < Vector_Size(__statements_by_id); i++) {
+        PreparedStatement *stmt;
+        Vector_Get(__statements_by_id, i, &stmt);
+        if(stmt && strcmp(stmt->graph_name, graph_name) == 0) _PreparedStatement_Free(stmt);
+    }
+}
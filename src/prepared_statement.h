@@ -0,0 +1,45 @@
+#ifndef __PREPARED_STATEMENT_H
+#define __PREPARED_STATEMENT_H
+
+#include <stdint.h>
+#include "parser/ast.h"
+#include "rmutil/vector.h"
+
+/* PreparedStatement
+ * A query parsed and validated once, executed many times
+ * with different values bound to its parameters. */
+typedef struct {
+    long long id;               /* Handle given to clients. */
+    char *graph_name;           /* Graph statement was prepared against. */
+    char *query;                /* Query text, replicated along with parameters. */
+    AST_QueryExpressionNode *ast;
+    Vector *params;             /* AST_Param pointers, ast's placeholders. */
+    uint64_t schema_version;    /* Schema version ast was built against. */
+} PreparedStatement;
+
+/* Returns the statement previously prepared for query against graph, NULL if none. */
+PreparedStatement* PreparedStatement_Lookup(const char *graph_name, const char *query);
+
+/* Registers ast, parsed from query, as a statement prepared against graph,
+ * takes ownership of ast. */
+PreparedStatement* PreparedStatement_Register(const char *graph_name, const char *query,
+                                              AST_QueryExpressionNode *ast);
+
+/* Returns the statement identified by id, NULL if there's no such statement. */
+PreparedStatement* PreparedStatement_Get(long long id);
+
+/* Returns 1 if the graph's labels, properties or indices changed since statement's AST was built. */
+int PreparedStatement_Stale(const PreparedStatement *stmt);
+
+/* Replaces statement's AST by ast, reparsed against the current schema,
+ * takes ownership of ast. */
+void PreparedStatement_Reprepare(PreparedStatement *stmt, AST_QueryExpressionNode *ast);
+
+/* Frees the statement identified by id, its handle isn't reused,
+ * returns 0 if there's no such statement. */
+int PreparedStatement_Deallocate(long long id);
+
+/* Frees every statement prepared against graph. */
+void PreparedStatement_RemoveGraph(const char *graph_name);
+
+#endif
@@ -35,8 +35,9 @@ void BuildGraph(Graph *graph, Vector *entities) {
                 Vector_Get(entity->properties, prop_idx, &key);
                 Vector_Get(entity->properties, prop_idx+1, &value);
                 char *k = strdup(key->stringval);
-                /* TODO: clone value. */
-                Node_Add_Properties(n, 1, &k, value);
+                /* Entities created from pattern outlive the AST's values, which may be rebound. */
+                SIValue v = SI_Clone(*value);
+                Node_Add_Properties(n, 1, &k, &v);
             }
         }
 
@@ -80,8 +81,9 @@ void BuildGraph(Graph *graph, Vector *entities) {
                 Vector_Get(entity->properties, prop_idx, &key);
                 Vector_Get(entity->properties, prop_idx+1, &value);
                 char *k = strdup(key->stringval);
-                /* TODO: clone value. */
-                Edge_Add_Properties(e, 1, &k, value);
+                /* Entities created from pattern outlive the AST's values, which may be rebound. */
+                SIValue v = SI_Clone(*value);
+                Edge_Add_Properties(e, 1, &k, &v);
             }
         }
 
@@ -214,24 +216,27 @@ void ReturnClause_ExpandCollapsedNodes(RedisModuleCtx *ctx, AST_QueryExpressionN
 
             /* Collapsed entity has a label. */
             if(collapsed_entity->label) {
-                LabelStore *store = LabelStore_Get(ctx, store_type, graphName, collapsed_entity->label);
-                raxStart(&it, store->stats.properties);
-                raxSeek(&it, "^", NULL, 0);
-                while(raxNext(&it)) {
-                    prop = it.key;
-                    prop_len = it.key_len;
+                LabelStore *store = LabelStore_Lookup(ctx, store_type, graphName, collapsed_entity->label);
+                /* Label without entities has no properties. */
+                if(store) {
+                    raxStart(&it, store->stats.properties);
+                    raxSeek(&it, "^", NULL, 0);
+                    while(raxNext(&it)) {
+                        prop = it.key;
+                        prop_len = it.key_len;
 
-                    prop[prop_len] = 0;
-                    /* Create a new return element foreach property. */
-                    AST_ArithmeticExpressionNode *expanded_exp =
-                        New_AST_AR_EXP_VariableOperandNode(collapsed_entity->alias, (char*)prop);
+                        prop[prop_len] = 0;
+                        /* Create a new return element foreach property. */
+                        AST_ArithmeticExpressionNode *expanded_exp =
+                            New_AST_AR_EXP_VariableOperandNode(collapsed_entity->alias, (char*)prop);
 
-                    AST_ReturnElementNode *retElem =
-                        New_AST_ReturnElementNode(expanded_exp, ret_elem->alias);
+                        AST_ReturnElementNode *retElem =
+                            New_AST_ReturnElementNode(expanded_exp, ret_elem->alias);
 
-                    Vector_Push(expandReturnElements, retElem);
+                        Vector_Push(expandReturnElements, retElem);
+                    }
+                    raxStop(&it);
                 }
-                raxStop(&it);
             } else {
                 /* Entity does have a label.
                  * We don't have a choice but to retrieve all know properties. */
@@ -337,7 +342,7 @@ void inlineProperties(AST_QueryExpressionNode *ast) {
             const char *alias = entity->alias;
             const char *property = key->stringval;
 
-            AST_FilterNode *filterNode = New_AST_ConstantPredicateNode(alias, property, EQ, *val);
+            AST_FilterNode *filterNode = New_AST_ConstantPredicateNode(alias, property, EQ, SI_Clone(*val));
             
             /* Create WHERE clause if missing. */
             if(ast->whereNode == NULL) {
@@ -352,8 +357,78 @@ void inlineProperties(AST_QueryExpressionNode *ast) {
     }
 }
 
+/* Full-text query procedure yields a node and its score,
+ * introduce a MATCH clause holding both, where score is represented
+ * by a placeholder node, populated by the full-text scan operation. */
+void _desugarFullTextQuery(AST_QueryExpressionNode *ast) {
+    AST_CallNode *call = ast->callNode;
+    SIValue *label;
+
+    /* Invalid call, let validation report. */
+    if(Vector_Size(call->args) != 3) return;
+    Vector_Get(call->args, 0, &label);
+    if(label->type != T_STRING) return;
+
+    /* Default yields: node, score. */
+    if(call->yields == NULL) {
+        call->yields = NewVector(char*, 2);
+        Vector_Push(call->yields, strdup("node"));
+        Vector_Push(call->yields, strdup("score"));
+    }
+
+    /* A standalone call returns every yielded value. */
+    if(ast->returnNode == NULL) {
+        Vector *elements = NewVector(AST_ReturnElementNode*, Vector_Size(call->yields));
+        for(int i = 0; i < Vector_Size(call->yields); i++) {
+            char *yield;
+            Vector_Get(call->yields, i, &yield);
+            Vector_Push(elements, New_AST_ReturnElementNode(New_AST_AR_EXP_VariableOperandNode(yield, NULL), NULL));
+        }
+        ast->returnNode = New_AST_ReturnNode(elements, 0);
+    }
+
+    char *node_alias;
+    Vector *entities = NewVector(AST_GraphEntity*, Vector_Size(call->yields));
+    Vector_Get(call->yields, 0, &node_alias);
+    Vector_Push(entities, New_AST_NodeEntity(node_alias, label->stringval, NULL));
+
+    if(Vector_Size(call->yields) > 1) {
+        char *score_alias;
+        Vector_Get(call->yields, 1, &score_alias);
+        Vector_Push(entities, New_AST_NodeEntity(score_alias, NULL, NULL));
+
+        /* Return score's value rather than a collapsed entity. */
+        for(int i = 0; ast->returnNode && i < Vector_Size(ast->returnNode->returnElements); i++) {
+            AST_ReturnElementNode *ret_elem;
+            Vector_Get(ast->returnNode->returnElements, i, &ret_elem);
+            AST_ArithmeticExpressionNode *exp = ret_elem->exp;
+            if(exp->type == AST_AR_EXP_OPERAND &&
+               exp->operand.type == AST_AR_EXP_VARIADIC &&
+               exp->operand.variadic.property == NULL &&
+               strcmp(exp->operand.variadic.alias, score_alias) == 0) {
+                exp->operand.variadic.property = strdup(PROC_FULLTEXT_SCORE_PROPERTY);
+                if(ret_elem->alias == NULL) ret_elem->alias = strdup(score_alias);
+            }
+        }
+    }
+
+    ast->matchNode = New_AST_MatchNode(entities);
+}
+
+void desugarCallClause(AST_QueryExpressionNode *ast) {
+    if(!ast->callNode || ast->matchNode) return;
+
+    if(strcmp(ast->callNode->procedure, PROC_FULLTEXT_QUERY_NODES) == 0) {
+        _desugarFullTextQuery(ast);
+    }
+}
+
 int Query_Modifies_KeySpace(const AST_QueryExpressionNode *ast) {
-    return (ast->createNode != NULL || ast->deleteNode != NULL);
+    return (ast->createNode != NULL || ast->deleteNode != NULL || ast->setNode != NULL ||
+            ast->indexNode != NULL ||
+            (ast->callNode != NULL &&
+             (strcmp(ast->callNode->procedure, PROC_FULLTEXT_CREATE_NODE_INDEX) == 0 ||
+              strcmp(ast->callNode->procedure, PROC_SPATIAL_CREATE_NODE_INDEX) == 0)));
 }
 
 AST_QueryExpressionNode* ParseQuery(const char *query, size_t qLen, char **errMsg) {
@@ -364,6 +439,7 @@ AST_QueryExpressionNode* ParseQuery(const char *query, size_t qLen, char **errMs
     }
     
     /* Modify AST. */
+    desugarCallClause(ast);
     nameAnonymousNodes(ast);
     inlineProperties(ast);
 
@@ -6,13 +6,41 @@ Record* NewRecord(size_t len) {
     Record *r = (Record*)malloc(sizeof(Record));
     r->len = len;
     r->values = malloc(sizeof(SIValue) * len);
+    r->entities = NULL;
+    r->pool = NULL;
     return r;
 }
 
-/* Creates a new result-set record from an aggregated group. */
-Record* Record_FromGroup(const ResultSetHeader *resultset_header, const Group *g) {
-    Record *r = NewRecord(resultset_header->columns_len);
-    
+RecordPool* NewRecordPool(size_t len) {
+    RecordPool *pool = malloc(sizeof(RecordPool));
+    pool->len = len;
+    pool->arena = NewArena(ARENA_BLOCK_SIZE);
+    pool->released = NULL;
+    pool->released_count = 0;
+    pool->released_cap = 0;
+    return pool;
+}
+
+Record* RecordPool_GetRecord(RecordPool *pool) {
+    if(pool->released_count > 0) return pool->released[--pool->released_count];
+
+    /* Record and its values share a single allocation. */
+    Record *r = Arena_Alloc(pool->arena, sizeof(Record) + sizeof(SIValue) * pool->len);
+    r->len = pool->len;
+    r->values = (SIValue*)(r + 1);
+    r->entities = NULL;
+    r->pool = pool;
+    return r;
+}
+
+void RecordPool_Free(RecordPool *pool) {
+    Arena_Free(pool->arena);
+    free(pool->released);
+    free(pool);
+}
+
+/* Populates a result-set record from an aggregated group. */
+void Record_FromGroup(Record *r, const ResultSetHeader *resultset_header, const Group *g) {
     int key_idx = 0;
     int agg_idx = 0;
 
@@ -29,14 +57,16 @@ Record* Record_FromGroup(const ResultSetHeader *resultset_header, const Group *g
             key_idx++;
         }
     }
-
-    return r;
 }
 
 size_t Record_ToString(const Record *record, char **record_str) {
     return SIValue_StringConcat(record->values, record->len, record_str);
 }
 
+size_t Record_ToStringBuffer(const Record *record, char **buf, size_t *cap) {
+    return SIValue_StringConcatBuffer(record->values, record->len, buf, cap);
+}
+
 int Records_Compare(const Record *A, const Record *B, int* compareIndices, size_t compareIndicesLen) {
     SIValue aValue;
     SIValue bValue;
@@ -61,6 +91,19 @@ int Records_Compare(const Record *A, const Record *B, int* compareIndices, size_
 /* Frees given record. */
 void Record_Free(Record *r) {
     if(r == NULL) return;
+    free(r->entities);
+    r->entities = NULL;
+
+    RecordPool *pool = r->pool;
+    if(pool) {
+        if(pool->released_count == pool->released_cap) {
+            pool->released_cap = (pool->released_cap) ? pool->released_cap * 2 : 16;
+            pool->released = realloc(pool->released, sizeof(Record*) * pool->released_cap);
+        }
+        pool->released[pool->released_count++] = r;
+        return;
+    }
+
     free(r->values);
     free(r);
 }
@@ -5,26 +5,52 @@
 #include "../parser/ast.h"
 #include "../grouping/group.h"
 #include "../graph/graph.h"
+#include "../util/arena.h"
+
+struct RecordPool;
 
 typedef struct {
     unsigned int len;
     SIValue *values;
+    GraphEntity **entities;     /* Entities values yet to be evaluated read, NULL if none. */
+    struct RecordPool *pool;    /* Pool record was drawn from, NULL if record was allocated on its own. */
 } Record;
 
+/* Hands out records of a fixed length carved out of an arena,
+ * freed records are recycled, all records are released along with the pool. */
+typedef struct RecordPool {
+    Arena *arena;
+    size_t len;             /* Number of values each record holds. */
+    Record **released;      /* Freed records, ready for reuse. */
+    size_t released_count;
+    size_t released_cap;
+} RecordPool;
+
 /* Creates a new record which will hold len elements. */
 Record* NewRecord(size_t len);
 
-/* Creates a new record from an aggregated group. */
-Record* Record_FromGroup(const ResultSetHeader *resultset_header, const Group *g);
+RecordPool* NewRecordPool(size_t len);
+
+/* Returns a record holding pool->len elements. */
+Record* RecordPool_GetRecord(RecordPool *pool);
+
+/* Frees pool along with every record drawn from it. */
+void RecordPool_Free(RecordPool *pool);
+
+/* Populates r, holding a value per column, from an aggregated group. */
+void Record_FromGroup(Record *r, const ResultSetHeader *resultset_header, const Group *g);
 
 /* Get a string representation of record. */
 size_t Record_ToString(const Record *record, char **record_str);
 
+/* Writes record's string representation into *buf, growing it beyond *cap if needed. */
+size_t Record_ToStringBuffer(const Record *record, char **buf, size_t *cap);
+
 /* Compares the two records, using the values at given indeces
  * Returns 1 if A >= B, -1 if A <= B, 0 if A = B */
 int Records_Compare(const Record *A, const Record *B, int *compareIndices, size_t compareIndicesLen);
 
-/* Frees given record. */
+/* Frees given record, pooled records are returned to their pool. */
 void Record_Free(Record *r);
 
 #endif
\ No newline at end of file
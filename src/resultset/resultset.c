@@ -16,12 +16,10 @@ int _heap_elem_compare(const void * A, const void * B, const void *udata) {
 /* Checks if we've already seen given records
  * Returns 1 if the string did not exist otherwise 0. */
 int __encounteredRecord(ResultSet* set, const Record* record) {
-    char *str;
-    uint16_t len = Record_ToString(record, &str);
+    size_t len = Record_ToStringBuffer(record, &set->buffer, &set->buffer_cap);
 
     // Returns 1 if the string did NOT exist otherwise 0
-    int newRecord = raxInsert(set->trie, (unsigned char *)str, len, NULL, NULL);
-    free(str);
+    int newRecord = raxInsert(set->trie, (unsigned char *)set->buffer, len, NULL, NULL);
     return !newRecord;
 }
 
@@ -147,7 +145,8 @@ char *ResultSetHeader_ToString(const ResultSetHeader *header, size_t *strLen) {
         }
     }
 
-    str[len-1] = 0;
+    /* Discard last delimiter, header might have no columns. */
+    if(len > 0) str[len-1] = 0;
     if(strLen != NULL) {
         *strLen = len;
     }
@@ -174,16 +173,21 @@ ResultSet* NewResultSet(AST_QueryExpressionNode* ast) {
     set->aggregated = ReturnClause_ContainsAggregation(ast);
     set->ordered = (ast->orderNode != NULL);
     set->limit = RESULTSET_UNLIMITED;
+    set->skip = 0;
+    set->skipped = 0;
     set->direction =  DIR_ASC;
     set->distinct = (ast->returnNode && ast->returnNode->distinct);
     set->header = NewResultSetHeader(ast);
-    set->records = NewVector(Record*, 0);
+    set->record_pool = NewRecordPool(set->header->columns_len);
+    set->buffer = NULL;
+    set->buffer_cap = 0;
     set->labels_added = 0;
     set->nodes_created = 0;
     set->properties_set = 0;
     set->relationships_created = 0;
     set->nodes_deleted = 0;
     set->relationships_deleted = 0;
+    set->indices_created = 0;
 
     if(set->ordered && ast->orderNode->direction == ORDER_DIR_DESC) {
         set->direction = DIR_DESC;
@@ -193,6 +197,10 @@ ResultSet* NewResultSet(AST_QueryExpressionNode* ast) {
         set->limit = ast->limitNode->limit;
     }
 
+    if(ast->skipNode != NULL) {
+        set->skip = ast->skipNode->skip;
+    }
+
     if(set->limit != RESULTSET_UNLIMITED && set->ordered) {
         set->heap = heap_new(_heap_elem_compare, set);
     }
@@ -205,6 +213,11 @@ ResultSet* NewResultSet(AST_QueryExpressionNode* ast) {
     return set;
 }
 
+Record* ResultSet_NewRecord(ResultSet* set, size_t len) {
+    if(len == set->record_pool->len) return RecordPool_GetRecord(set->record_pool);
+    return NewRecord(len);
+}
+
 int ResultSet_AddRecord(ResultSet* set, Record* record) {
     if(ResultSet_Full(set)) {
         return RESULTSET_FULL;
@@ -218,15 +231,22 @@ int ResultSet_AddRecord(ResultSet* set, Record* record) {
     }
 
     if(set->ordered && set->limit != RESULTSET_UNLIMITED) {
-        if(heap_count(set->heap) < set->limit) {
+        /* Heap holds skipped records as well, as they're only known once sorted. */
+        if(heap_count(set->heap) < set->skip + set->limit) {
             /* There's room in heap for record */
             heap_offer(&set->heap, record);
         } else {
             if(_heap_elem_compare(heap_peek(set->heap), record, set) == 1) {
-                heap_poll(set->heap);
+                Record_Free(heap_poll(set->heap));
                 heap_offer(&set->heap, record);
+            } else {
+                Record_Free(record);
             }
         }
+    } else if(!set->ordered && set->skipped < set->skip) {
+        /* Records arrive in their final order, leading ones are omitted. */
+        set->skipped++;
+        Record_Free(record);
     } else {
         /* Not using a heap and there's room for record. */
         Vector_Push(set->records, record);
@@ -244,6 +264,35 @@ int ResultSet_Full(const ResultSet* set) {
     }
 }
 
+void ResultSet_MarkPresorted(ResultSet* set) {
+    if(set->heap) {
+        heap_free(set->heap);
+        set->heap = NULL;
+    }
+    /* Records are kept in arrival order. */
+    set->ordered = 0;
+}
+
+void ResultSet_ForEachRecord(ResultSet* set, void (*f)(Record*, void*), void *udata) {
+    for(int i = 0; i < Vector_Size(set->records); i++) {
+        Record *record;
+        Vector_Get(set->records, i, &record);
+        f(record, udata);
+    }
+
+    if(set->heap == NULL) return;
+
+    /* Heap is emptied and refilled, f must not modify compared values. */
+    int count = heap_count(set->heap);
+    Record **records = malloc(sizeof(Record*) * count);
+    for(int i = 0; i < count; i++) records[i] = heap_poll(set->heap);
+    for(int i = 0; i < count; i++) {
+        f(records[i], udata);
+        heap_offer(&set->heap, records[i]);
+    }
+    free(records);
+}
+
 void _aggregateResultSet(RedisModuleCtx* ctx, ResultSet* set) {
     char *key;
     Group *group;
@@ -253,7 +302,8 @@ void _aggregateResultSet(RedisModuleCtx* ctx, ResultSet* set) {
     /* Scan entire groups cache. */
     while(CacheGroupIterNext(&iter, &key, &group) != 0) {
         /* Construct response */
-        Record* record = Record_FromGroup(set->header, group);
+        Record* record = RecordPool_GetRecord(set->record_pool);
+        Record_FromGroup(record, set->header, group);
         if(ResultSet_AddRecord(set, record) == RESULTSET_FULL) {
             break;
         }
@@ -297,6 +347,7 @@ void _ResultSet_ReplayStats(RedisModuleCtx* ctx, ResultSet* set) {
     if(set->relationships_created > 0) resultset_size++;
     if(set->nodes_deleted > 0) resultset_size++;
     if(set->relationships_deleted > 0) resultset_size++;
+    if(set->indices_created > 0) resultset_size++;
 
     RedisModule_ReplyWithArray(ctx, resultset_size);
 
@@ -329,6 +380,11 @@ void _ResultSet_ReplayStats(RedisModuleCtx* ctx, ResultSet* set) {
         sprintf(buff, "Relationships deleted: %d", set->relationships_deleted);
         RedisModule_ReplyWithSimpleString(ctx, (const char*)buff);
     }
+
+    if(set->indices_created > 0) {
+        sprintf(buff, "Indices created: %d", set->indices_created);
+        RedisModule_ReplyWithSimpleString(ctx, (const char*)buff);
+    }
 }
 
 void ResultSet_Replay(RedisModuleCtx* ctx, ResultSet* set) {
@@ -338,12 +394,20 @@ void ResultSet_Replay(RedisModuleCtx* ctx, ResultSet* set) {
     
     /* Header row. */
     size_t resultset_size = 1;
+    size_t record_count;
 
     if(set->ordered && set->limit != RESULTSET_UNLIMITED) {
-        resultset_size += heap_count(set->heap);
+        record_count = heap_count(set->heap);
     } else {
-        resultset_size += Vector_Size(set->records);
+        record_count = Vector_Size(set->records);
+    }
+
+    /* Ordered records are skipped once sorted. */
+    size_t skip = 0;
+    if(set->ordered) {
+        skip = (set->skip < record_count) ? set->skip : record_count;
     }
+    resultset_size += record_count - skip;
     
     /* Resultset + statistics. */
     RedisModule_ReplyWithArray(ctx, 2);
@@ -358,37 +422,29 @@ void ResultSet_Replay(RedisModuleCtx* ctx, ResultSet* set) {
     RedisModule_ReplyWithStringBuffer(ctx, str_header, str_header_len);
     free(str_header);
 
-    char *str_record = NULL;
     if(set->ordered) {
         if(set->limit != RESULTSET_UNLIMITED) {
-            /* Responses need to be reversed. */
-            Vector *reversedResultSet = NewVector(char*, heap_count(set->heap));
+            /* Responses need to be reversed, pop records off heap. */
+            Record **reversed = malloc(sizeof(Record*) * record_count);
+            for(int i = 0; i < record_count; i++) reversed[i] = heap_poll(set->heap);
 
-            /* Pop items from heap */
-            while(heap_count(set->heap) > 0) {
-                Record* record = heap_poll(set->heap);
-                str_record_len = Record_ToString(record, &str_record);
-                Vector_Push(reversedResultSet, str_record);
-
-                /* Free record here, as it was removed from set heap. */
-                Record_Free(record);
-            }
             /* Replay elements in reversed order */
-            for(int i = Vector_Size(reversedResultSet)-1; i >= 0; i--) {
-                Vector_Get(reversedResultSet, i, &str_record);
-                RedisModule_ReplyWithStringBuffer(ctx, str_record, strlen(str_record));
-                free(str_record);
+            for(int i = record_count-1-skip; i >= 0; i--) {
+                str_record_len = Record_ToStringBuffer(reversed[i], &set->buffer, &set->buffer_cap);
+                RedisModule_ReplyWithStringBuffer(ctx, set->buffer, str_record_len);
             }
-            Vector_Free(reversedResultSet);
+
+            /* Free records here, as they were removed from set heap. */
+            for(int i = 0; i < record_count; i++) Record_Free(reversed[i]);
+            free(reversed);
         } else {
             /* ordered, not limited, sort. */
             Record **sorted_records = _sortResultSet(set, set->records);
 
-            for(int i = Vector_Size(set->records)-1; i >=0;  i--) {
+            for(int i = Vector_Size(set->records)-1-skip; i >=0;  i--) {
                 Record* record = sorted_records[i];
-                str_record_len = Record_ToString(record, &str_record);
-                RedisModule_ReplyWithStringBuffer(ctx, str_record, str_record_len);
-                free(str_record);
+                str_record_len = Record_ToStringBuffer(record, &set->buffer, &set->buffer_cap);
+                RedisModule_ReplyWithStringBuffer(ctx, set->buffer, str_record_len);
             }
             free(sorted_records);
         }
@@ -397,9 +453,8 @@ void ResultSet_Replay(RedisModuleCtx* ctx, ResultSet* set) {
             Record* record = NULL;
             Vector_Get(set->records, i, &record);
             
-            str_record_len = Record_ToString(record, &str_record);
-            RedisModule_ReplyWithStringBuffer(ctx, str_record, str_record_len);
-            free(str_record);
+            str_record_len = Record_ToStringBuffer(record, &set->buffer, &set->buffer_cap);
+            RedisModule_ReplyWithStringBuffer(ctx, set->buffer, str_record_len);
         }
     }
 
@@ -429,6 +484,9 @@ void ResultSet_Free(RedisModuleCtx *ctx, ResultSet *set) {
             raxFree(set->trie);
         }
 
+        /* Pooled records are released all at once. */
+        RecordPool_Free(set->record_pool);
+        free(set->buffer);
         ResultSetHeader_Free(set->header);
         free(set);
     }
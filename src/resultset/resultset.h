@@ -22,10 +22,15 @@ typedef struct {
     rax* trie;                  /* When using distinct, used to identify unique records. */
     AST_QueryExpressionNode* ast;
     ResultSetHeader* header;    /* Describes how records should look like. */
+    RecordPool* record_pool;    /* Records of header's length, released along with result set. */
+    char* buffer;               /* Scratch buffer, holds a record's string representation. */
+    size_t buffer_cap;          /* Buffer capacity. */
     int aggregated;             /* Rather or not this is an aggregated result set. */
     int ordered;                /* Rather or not this result set is ordered. */
     int direction;              /* Sort direction ASC/DESC. */
     int limit;                  /* Max number of records in result-set. */
+    int skip;                   /* Number of leading records omitted from result-set. */
+    int skipped;                /* Number of records omitted so far. */
     int distinct;               /* Rather or not each record is unique. */
     int labels_added;           /* Number of labels added as part of a create query. */
     int nodes_created;          /* Number of nodes created as part of a create query. */
@@ -33,16 +38,30 @@ typedef struct {
     int relationships_created;  /* Number of edges created as part of a create query. */
     int nodes_deleted;          /* Number of nodes removed as part of a delete query.*/
     int relationships_deleted;  /* Number of edges removed as part of a delete query.*/
+    int indices_created;        /* Number of indices created as part of a procedure call. */
 } ResultSet;
 
 ResultSet* NewResultSet(AST_QueryExpressionNode* ast);
 
+/* Returns a record holding len values, records matching
+ * the result set header's length are drawn from its pool. */
+Record* ResultSet_NewRecord(ResultSet* set, size_t len);
+
 int ResultSet_AddRecord(ResultSet* set, Record *record);
 
 void ResultSet_Free(RedisModuleCtx* ctx, ResultSet* set);
 
+/* Returns 1 once no further record can make it into the result set,
+ * in which case there's no need to produce any more records. */
 int ResultSet_Full(const ResultSet* set);
 
+/* Records are added in the requested order, no need to sort them,
+ * result set is full once limit is reached. */
+void ResultSet_MarkPresorted(ResultSet* set);
+
+/* Applies f to every record held by result set. */
+void ResultSet_ForEachRecord(ResultSet* set, void (*f)(Record*, void*), void *udata);
+
 void ResultSet_Replay(RedisModuleCtx* ctx, ResultSet* set);
 
 #endif
\ No newline at end of file
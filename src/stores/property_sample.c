@@ -0,0 +1,105 @@
+#include "property_sample.h"
+#include <string.h>
+#include "../value_cmp.h"
+#include "../parser/grammar.h"
+#include "../graph/graph_entity.h"
+
+static void _PropertySample_Add(PropertySample *sample, const GraphEntity *entity, const char *property) {
+    SIValue *v = GraphEntity_Get_Property(entity, property);
+    sample->values[sample->count++] = (v == PROPERTY_NOTFOUND) ? SI_NullVal() : SI_Clone(*v);
+}
+
+PropertySample* NewPropertySample(rax *entities, const char *property, uint64_t writes) {
+    uint64_t cardinality = raxSize(entities);
+    size_t size = (cardinality < PROPERTY_SAMPLE_SIZE) ? cardinality : PROPERTY_SAMPLE_SIZE;
+
+    PropertySample *sample = malloc(sizeof(PropertySample));
+    sample->values = malloc(sizeof(SIValue) * (size ? size : 1));
+    sample->count = 0;
+    sample->writes = writes;
+
+    raxIterator it;
+    raxStart(&it, entities);
+    raxSeek(&it, "^", NULL, 0);
+    if(cardinality <= PROPERTY_SAMPLE_SIZE) {
+        while(raxNext(&it)) _PropertySample_Add(sample, it.data, property);
+    } else {
+        /* Random walk doesn't populate the iterator's data, look entity up by key. */
+        while(sample->count < size && raxRandomWalk(&it, 0)) {
+            GraphEntity *entity = raxFind(entities, it.key, it.key_len);
+            if(entity != raxNotFound) _PropertySample_Add(sample, entity, property);
+        }
+    }
+    raxStop(&it);
+
+    return sample;
+}
+
+int PropertySample_Stale(const PropertySample *sample, uint64_t writes, uint64_t cardinality) {
+    uint64_t threshold = cardinality * PROPERTY_SAMPLE_REFRESH_RATIO;
+    if(threshold < PROPERTY_SAMPLE_REFRESH_MIN) threshold = PROPERTY_SAMPLE_REFRESH_MIN;
+    return (writes - sample->writes) >= threshold;
+}
+
+/* Evaluates value op constant the way filters do,
+ * values of mismatching types never satisfy a predicate. */
+static int _PropertySample_Satisfies(SIValue *value, int op, const SIValue *constant) {
+    int equals;
+    int rel;
+
+    if(value->type == T_NULL) return 0;
+
+    if(value->type == T_STRING && constant->type == T_STRING) {
+        if(op == STARTS) {
+            return strncmp(value->stringval, constant->stringval, strlen(constant->stringval)) == 0;
+        }
+        rel = cmp_string(value, (SIValue *)constant);
+    } else if((value->type & SI_NUMERIC) && (constant->type & SI_NUMERIC)) {
+        double a, b;
+        SIValue_ToDouble(value, &a);
+        SIValue_ToDouble((SIValue *)constant, &b);
+        rel = (a > b) - (a < b);
+    } else if(value->type == T_BOOL && constant->type == T_BOOL) {
+        rel = (value->boolval != 0) - (constant->boolval != 0);
+    } else {
+        return 0;
+    }
+
+    equals = (rel == 0);
+    switch(op) {
+        case EQ:
+            return equals;
+        case NE:
+            return !equals;
+        case GT:
+            return rel > 0;
+        case GE:
+            return rel >= 0;
+        case LT:
+            return rel < 0;
+        case LE:
+            return rel <= 0;
+        default:
+            return 0;
+    }
+}
+
+double PropertySample_Selectivity(const PropertySample *sample, int op, const SIValue *constant) {
+    if(sample->count == 0) return -1;
+
+    size_t matches = 0;
+    for(size_t i = 0; i < sample->count; i++) {
+        if(_PropertySample_Satisfies(&sample->values[i], op, constant)) matches++;
+    }
+
+    /* A predicate no sampled entity satisfies is assumed to match
+     * half an entity rather than none, keeping estimates comparable. */
+    if(matches == 0) return 0.5 / sample->count;
+    return (double)matches / sample->count;
+}
+
+void PropertySample_Free(PropertySample *sample) {
+    for(size_t i = 0; i < sample->count; i++) SIValue_Free(&sample->values[i]);
+    free(sample->values);
+    free(sample);
+}
@@ -0,0 +1,33 @@
+#ifndef __PROPERTY_SAMPLE_H__
+#define __PROPERTY_SAMPLE_H__
+
+#include <stdint.h>
+#include "../value.h"
+#include "../dep/rax/rax.h"
+
+#define PROPERTY_SAMPLE_SIZE 256            /* Max number of entities sampled. */
+#define PROPERTY_SAMPLE_REFRESH_MIN 64      /* Min number of writes before a sample is retaken. */
+#define PROPERTY_SAMPLE_REFRESH_RATIO 0.1   /* Sample is retaken once writes exceed this fraction of entities. */
+
+/* Values of a single property, taken from a random sample of entities. */
+typedef struct {
+    SIValue *values;    /* Sampled values, null for entities missing the property. */
+    size_t count;       /* Number of sampled entities. */
+    uint64_t writes;    /* Store's write count at the time sample was taken. */
+} PropertySample;
+
+/* Samples property from entities, a rax of graph entities,
+ * every entity is sampled if there are no more than PROPERTY_SAMPLE_SIZE,
+ * otherwise entities are picked by a random walk. */
+PropertySample* NewPropertySample(rax *entities, const char *property, uint64_t writes);
+
+/* Checks if sample is outdated, given store's current write count and size. */
+int PropertySample_Stale(const PropertySample *sample, uint64_t writes, uint64_t cardinality);
+
+/* Estimates the fraction of entities for which property op constant holds,
+ * returns a negative value if sample is empty. */
+double PropertySample_Selectivity(const PropertySample *sample, int op, const SIValue *constant);
+
+void PropertySample_Free(PropertySample *sample);
+
+#endif
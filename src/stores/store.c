@@ -2,22 +2,75 @@
 #include "../rmutil/util.h"
 #include "../rmutil/strings.h"
 #include "../dep/rax/rax_type.h"
+#include "../index/index_builder.h"
+
+/* Schema versions by graph name, a graph's version is bumped whenever one of its
+ * labels, properties or indices is introduced or removed.
+ * Versions outlive their graph's stores, such that a recreated graph doesn't reuse them. */
+static rax *__schema_versions = NULL;
+
+static uint64_t *_LabelStore_SchemaVersionCounter(const char *graph) {
+    if(__schema_versions == NULL) __schema_versions = raxNew();
+
+    uint64_t *version = raxFind(__schema_versions, (unsigned char *)graph, strlen(graph));
+    if(version == raxNotFound) {
+        version = calloc(1, sizeof(uint64_t));
+        raxInsert(__schema_versions, (unsigned char *)graph, strlen(graph), version, NULL);
+    }
+    return version;
+}
+
+uint64_t LabelStore_SchemaVersion(const char *graph) {
+    if(__schema_versions == NULL) return 0;
+    uint64_t *version = raxFind(__schema_versions, (unsigned char *)graph, strlen(graph));
+    return (version == raxNotFound) ? 0 : *version;
+}
 
 /* Creates a new LabelStore. */
-LabelStore *__new_Store(const char *label) {
+LabelStore *__new_Store(const char *graph, const char *label) {
     LabelStore *store = calloc(1, sizeof(LabelStore));
+    store->schema_version = _LabelStore_SchemaVersionCounter(graph);
     store->items = raxNew();
     store->stats.properties = raxNew();
+    store->stats.samples = raxNew();
+    store->indices = raxNew();
+    store->fulltext_indices = raxNew();
+    store->geo_indices = raxNew();
     if(label) store->label = strdup(label);
+    (*store->schema_version)++;
 
     return store;
 }
 
 void LabelStore_Free(LabelStore *store) {
+    /* Indices still being built are released by their builder. */
+    IndexBuilder_AcquireWriteLock();
+    raxIterator it;
+    raxStart(&it, store->indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) Index_Free(it.data);
+    raxStop(&it);
+    raxFree(store->indices);
+
+    raxStart(&it, store->fulltext_indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) FullTextIndex_Free(it.data);
+    raxStop(&it);
+    raxFree(store->fulltext_indices);
+
+    raxStart(&it, store->geo_indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) GeoIndex_Free(it.data);
+    raxStop(&it);
+    raxFree(store->geo_indices);
+
     raxFree(store->items);
     raxFree(store->stats.properties);
+    raxFreeWithCallback(store->stats.samples, (void (*)(void*))PropertySample_Free);
     if(store->label) free(store->label);
     free(store);
+    (*store->schema_version)++;
+    IndexBuilder_ReleaseWriteLock();
 }
 
 int LabelStore_Id(char **id, LabelStoreType type, const char *graph, const char *label) {
@@ -54,7 +107,7 @@ LabelStore *LabelStore_Get(RedisModuleCtx *ctx, LabelStoreType type, const char
     RedisModule_FreeString(ctx, rmStoreId);
 
 	if (RedisModule_KeyType(key) == REDISMODULE_KEYTYPE_EMPTY) {
-		store = __new_Store(label);
+		store = __new_Store(graph, label);
 		RedisModule_ModuleTypeSetValue(key, RaxRedisModuleType, store);
 	}
 
@@ -63,6 +116,25 @@ LabelStore *LabelStore_Get(RedisModuleCtx *ctx, LabelStoreType type, const char
 	return store;
 }
 
+LabelStore *LabelStore_Lookup(RedisModuleCtx *ctx, LabelStoreType type, const char *graph, const char* label) {
+    char *strKey;
+    LabelStore_Id(&strKey, type, graph, label);
+
+    RedisModuleString *rmStoreId = RedisModule_CreateString(ctx, strKey, strlen(strKey));
+    free(strKey);
+
+    /* Opening a missing key for reading doesn't create it. */
+    RedisModuleKey *key = RedisModule_OpenKey(ctx, rmStoreId, REDISMODULE_READ);
+    RedisModule_FreeString(ctx, rmStoreId);
+
+    LabelStore *store = NULL;
+    if(RedisModule_KeyType(key) != REDISMODULE_KEYTYPE_EMPTY) {
+        store = RedisModule_ModuleTypeGetValue(key);
+    }
+    RedisModule_CloseKey(key);
+    return store;
+}
+
 /* Get all stores of given type. */
 void LabelStore_Get_ALL(RedisModuleCtx *ctx, LabelStoreType type, const char *graph, LabelStore **stores, size_t *stores_len) {
     char *pattern;
@@ -106,18 +178,152 @@ void LabelStore_Insert(LabelStore *store, char *id, GraphEntity *entity) {
             int prop_count = entity->prop_count;
             for(int idx = 0; idx < prop_count; idx++) {
                 char *prop_name = entity->properties[idx].name;
-                raxInsert(store->stats.properties, (unsigned char *)prop_name, strlen(prop_name), NULL, NULL);
+                if(raxInsert(store->stats.properties, (unsigned char *)prop_name, strlen(prop_name), NULL, NULL)) {
+                    (*store->schema_version)++;
+                }
             }
         }
+        LabelStore_IndexEntity(store, entity);
     }
 }
 
 int LabelStore_Remove(LabelStore *store, char *id) {
-    return raxRemove(store->items, (unsigned char *)id, strlen(id), NULL);
+    GraphEntity *entity;
+    int removed = raxRemove(store->items, (unsigned char *)id, strlen(id), (void**)&entity);
+    if(removed) LabelStore_UnindexEntity(store, entity);
+    return removed;
+}
+
+Index *LabelStore_GetIndex(const LabelStore *store, const char *property) {
+    Index *idx = raxFind(store->indices, (unsigned char *)property, strlen(property));
+    return (idx == raxNotFound) ? NULL : idx;
+}
+
+Index *LabelStore_AddIndex(LabelStore *store, LabelStoreType type, const char *property) {
+    if(LabelStore_GetIndex(store, property) != NULL) return NULL;
+
+    Index *idx = (type == STORE_EDGE) ? NewEdgeIndex(property) : NewIndex(property);
+    raxInsert(store->indices, (unsigned char *)property, strlen(property), idx, NULL);
+    (*store->schema_version)++;
+
+    /* Index existing entities in the background. */
+    IndexBuilder_AcquireWriteLock();
+    IndexBuilder_Start(idx, store->items);
+    IndexBuilder_ReleaseWriteLock();
+
+    return idx;
+}
+
+FullTextIndex *LabelStore_GetFullTextIndex(const LabelStore *store, const char *property) {
+    FullTextIndex *idx = raxFind(store->fulltext_indices, (unsigned char *)property, strlen(property));
+    return (idx == raxNotFound) ? NULL : idx;
+}
+
+FullTextIndex *LabelStore_AddFullTextIndex(LabelStore *store, const char *property) {
+    if(LabelStore_GetFullTextIndex(store, property) != NULL) return NULL;
+
+    FullTextIndex *idx = NewFullTextIndex(property);
+    raxInsert(store->fulltext_indices, (unsigned char *)property, strlen(property), idx, NULL);
+    (*store->schema_version)++;
+
+    /* Index existing entities. */
+    raxIterator it;
+    raxStart(&it, store->items);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) FullTextIndex_Insert(idx, it.data);
+    raxStop(&it);
+
+    return idx;
+}
+
+GeoIndex *LabelStore_GetGeoIndex(const LabelStore *store, const char *lat_property, const char *lon_property) {
+    GeoIndex *idx = raxFind(store->geo_indices, (unsigned char *)lat_property, strlen(lat_property));
+    if(idx == raxNotFound) return NULL;
+    if(lon_property && strcmp(idx->lon_property, lon_property) != 0) return NULL;
+    return idx;
+}
+
+GeoIndex *LabelStore_AddGeoIndex(LabelStore *store, const char *lat_property, const char *lon_property) {
+    if(LabelStore_GetGeoIndex(store, lat_property, NULL) != NULL) return NULL;
+
+    GeoIndex *idx = NewGeoIndex(lat_property, lon_property);
+    raxInsert(store->geo_indices, (unsigned char *)lat_property, strlen(lat_property), idx, NULL);
+    (*store->schema_version)++;
+
+    /* Index existing entities. */
+    raxIterator it;
+    raxStart(&it, store->items);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) GeoIndex_Insert(idx, it.data);
+    raxStop(&it);
+
+    return idx;
+}
+
+PropertySample *LabelStore_GetPropertySample(LabelStore *store, const char *property) {
+    PropertySample *sample = raxFind(store->stats.samples, (unsigned char *)property, strlen(property));
+    if(sample != raxNotFound) {
+        if(!PropertySample_Stale(sample, store->stats.writes, raxSize(store->items))) return sample;
+        PropertySample_Free(sample);
+    }
+
+    sample = NewPropertySample(store->items, property, store->stats.writes);
+    raxInsert(store->stats.samples, (unsigned char *)property, strlen(property), sample, NULL);
+    return sample;
+}
+
+void LabelStore_IndexEntity(LabelStore *store, GraphEntity *entity) {
+    store->stats.writes++;
+
+    raxIterator it;
+    raxStart(&it, store->indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) Index_Insert(it.data, entity);
+    raxStop(&it);
+
+    if(raxSize(store->fulltext_indices) > 0) {
+        raxStart(&it, store->fulltext_indices);
+        raxSeek(&it, "^", NULL, 0);
+        while(raxNext(&it)) FullTextIndex_Insert(it.data, entity);
+        raxStop(&it);
+    }
+
+    if(raxSize(store->geo_indices) > 0) {
+        raxStart(&it, store->geo_indices);
+        raxSeek(&it, "^", NULL, 0);
+        while(raxNext(&it)) GeoIndex_Insert(it.data, entity);
+        raxStop(&it);
+    }
+}
+
+void LabelStore_UnindexEntity(LabelStore *store, GraphEntity *entity) {
+    store->stats.writes++;
+
+    raxIterator it;
+    raxStart(&it, store->indices);
+    raxSeek(&it, "^", NULL, 0);
+    while(raxNext(&it)) Index_Remove(it.data, entity);
+    raxStop(&it);
+
+    if(raxSize(store->fulltext_indices) > 0) {
+        raxStart(&it, store->fulltext_indices);
+        raxSeek(&it, "^", NULL, 0);
+        while(raxNext(&it)) FullTextIndex_Remove(it.data, entity);
+        raxStop(&it);
+    }
+
+    if(raxSize(store->geo_indices) > 0) {
+        raxStart(&it, store->geo_indices);
+        raxSeek(&it, "^", NULL, 0);
+        while(raxNext(&it)) GeoIndex_Remove(it.data, entity);
+        raxStop(&it);
+    }
 }
 
 void LabelStore_Scan(LabelStore *store, LabelStoreIterator *it) {
-    raxStart(it, store->items);
+    static rax *empty = NULL;
+    if(empty == NULL) empty = raxNew();
+    raxStart(it, store ? store->items : empty);
     raxSeek(it, "^", NULL, 0);
 }
 
@@ -4,6 +4,10 @@
 #include "../redismodule.h"
 #include "../graph/graph_entity.h"
 #include "../dep/rax/rax.h"
+#include "../index/index.h"
+#include "../index/fulltext_index.h"
+#include "../index/geo_index.h"
+#include "property_sample.h"
 
 #define LABELSTORE_PREFIX "redis_graph_store"
 
@@ -15,12 +19,18 @@ typedef enum {
 /* Keeps track on label schema. */
 typedef struct {
   rax *properties;  /* Entities under this Label, have a subset of properties */
+  rax *samples;     /* Sampled property values, keyed by property name. */
+  uint64_t writes;  /* Number of entity insertions, updates and removals. */
 } LabelStatistics;
 
 typedef struct {
   rax *items;
   LabelStatistics stats;
   char *label;
+  rax *indices;           /* Ordered property indices, keyed by property name. */
+  rax *fulltext_indices;  /* Full-text indices, keyed by property name. */
+  rax *geo_indices;       /* Geospatial indices, keyed by latitude property name. */
+  uint64_t *schema_version; /* Schema version of the graph holding this store. */
 } LabelStore;
 
 typedef raxIterator LabelStoreIterator;
@@ -31,6 +41,9 @@ int LabelStore_Id(char **id, LabelStoreType type, const char *graph, const char
 /* Get a label store. */
 LabelStore *LabelStore_Get(RedisModuleCtx *ctx, LabelStoreType type, const char *graph, const char* label);
 
+/* Get a label store without creating it, returns NULL if store doesn't exist. */
+LabelStore *LabelStore_Lookup(RedisModuleCtx *ctx, LabelStoreType type, const char *graph, const char* label);
+
 /* Get all stores of given type. */
 void LabelStore_Get_ALL(RedisModuleCtx *ctx, LabelStoreType type, const char *graph, LabelStore **stores, size_t *stores_len);
 
@@ -43,9 +56,46 @@ void LabelStore_Insert(LabelStore *store, char *id, GraphEntity *entity);
 /* Removes entity with ID. */
 int LabelStore_Remove(LabelStore *store, char *id);
 
-/* Scans through the entire store. */
+/* Get ordered index over property, returns NULL if property isn't indexed. */
+Index *LabelStore_GetIndex(const LabelStore *store, const char *property);
+
+/* Creates an ordered index over property, entities within the store are
+ * indexed on a background thread, the index can't serve queries until built,
+ * edge stores also order each node's outgoing edges by property,
+ * returns NULL if property is already indexed. */
+Index *LabelStore_AddIndex(LabelStore *store, LabelStoreType type, const char *property);
+
+/* Get full-text index over property, returns NULL if property isn't indexed. */
+FullTextIndex *LabelStore_GetFullTextIndex(const LabelStore *store, const char *property);
+
+/* Creates a full-text index over property and indexes every entity within the store,
+ * returns NULL if property is already indexed. */
+FullTextIndex *LabelStore_AddFullTextIndex(LabelStore *store, const char *property);
+
+/* Get geospatial index over lat_property, lon_property pair, returns NULL if pair isn't indexed,
+ * a NULL lon_property matches any index over lat_property. */
+GeoIndex *LabelStore_GetGeoIndex(const LabelStore *store, const char *lat_property, const char *lon_property);
+
+/* Creates a geospatial index over lat_property, lon_property and indexes every entity within the store,
+ * returns NULL if lat_property is already geo indexed. */
+GeoIndex *LabelStore_AddGeoIndex(LabelStore *store, const char *lat_property, const char *lon_property);
+
+/* Get a sample of property's values, resampled once enough writes were made to the store. */
+PropertySample *LabelStore_GetPropertySample(LabelStore *store, const char *property);
+
+/* Adds entity to each of the store's indices. */
+void LabelStore_IndexEntity(LabelStore *store, GraphEntity *entity);
+
+/* Removes entity from each of the store's indices. */
+void LabelStore_UnindexEntity(LabelStore *store, GraphEntity *entity);
+
+/* Scans through the entire store, a NULL store is scanned as an empty store. */
 void LabelStore_Scan(LabelStore *store, LabelStoreIterator *it);
 
+/* Returns a counter which changes whenever one of graph's labels, properties
+ * or indices is introduced or removed. */
+uint64_t LabelStore_SchemaVersion(const char *graph);
+
 /* Free store. */
 void LabelStore_Free(LabelStore *store);
 
@@ -0,0 +1,60 @@
+#include "arena.h"
+#include <string.h>
+
+/* Allocations are aligned for pointers, integers and doubles. */
+#define ARENA_ALIGNMENT 8
+
+static ArenaBlock* _Arena_NewBlock(size_t size) {
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + size);
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+Arena* NewArena(size_t block_size) {
+    Arena *arena = malloc(sizeof(Arena));
+    arena->block_size = block_size;
+    arena->blocks = _Arena_NewBlock(block_size);
+    return arena;
+}
+
+void* Arena_Alloc(Arena *arena, size_t size) {
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    ArenaBlock *block = arena->blocks;
+    if(block->size - block->used < size) {
+        /* Oversized allocations get a block of their own. */
+        block = _Arena_NewBlock(size > arena->block_size ? size : arena->block_size);
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void *p = block->data + block->used;
+    block->used += size;
+    return p;
+}
+
+char* Arena_Strdup(Arena *arena, const char *s) {
+    size_t len = strlen(s) + 1;
+    char *copy = Arena_Alloc(arena, len);
+    memcpy(copy, s, len);
+    return copy;
+}
+
+void Arena_Reset(Arena *arena) {
+    ArenaBlock *block = arena->blocks;
+    while(block->next) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    block->used = 0;
+    arena->blocks = block;
+}
+
+void Arena_Free(Arena *arena) {
+    Arena_Reset(arena);
+    free(arena->blocks);
+    free(arena);
+}
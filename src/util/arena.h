@@ -0,0 +1,35 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stdlib.h>
+
+/* Default size of an arena's block. */
+#define ARENA_BLOCK_SIZE 16384
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;    /* Number of bytes block can hold. */
+    size_t used;    /* Number of bytes handed out. */
+    char data[];
+} ArenaBlock;
+
+/* Arena, a bump allocator, memory handed out is released all at once. */
+typedef struct {
+    ArenaBlock *blocks;     /* Most recent block first. */
+    size_t block_size;      /* Minimum size of a new block. */
+} Arena;
+
+Arena* NewArena(size_t block_size);
+
+/* Allocates size bytes, 8 bytes aligned, memory is released along with the arena. */
+void* Arena_Alloc(Arena *arena, size_t size);
+
+/* Copies s into the arena. */
+char* Arena_Strdup(Arena *arena, const char *s);
+
+/* Releases every allocation, keeping the first block for reuse. */
+void Arena_Reset(Arena *arena);
+
+void Arena_Free(Arena *arena);
+
+#endif
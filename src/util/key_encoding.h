@@ -0,0 +1,18 @@
+#ifndef __KEY_ENCODING_H__
+#define __KEY_ENCODING_H__
+
+#include <stdint.h>
+
+/* Length of an encoded uint64. */
+#define KEY_ENCODING_UINT64_LEN 8
+
+/* Encodes v as a big endian key into buf, which must hold KEY_ENCODING_UINT64_LEN bytes,
+ * encoded values compare bytewise in the same order as the original values. */
+static inline void KeyEncoding_Uint64(uint64_t v, unsigned char *buf) {
+    for(int i = KEY_ENCODING_UINT64_LEN - 1; i >= 0; i--) {
+        buf[i] = v & 0xFF;
+        v >>= 8;
+    }
+}
+
+#endif
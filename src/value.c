@@ -57,11 +57,17 @@ SIValue SI_Clone(SIValue v) {
     return SI_InfVal();
   case T_NEGINF:
     return SI_NegativeInfVal();
+  case T_PARAM:
+    return SI_ParamVal(strdup(v.stringval));
   case T_NULL:
     return SI_NullVal();
   }
 }
 
+SIValue SI_ParamVal(char *name) {
+  return (SIValue){.stringval = name, .type = T_PARAM};
+}
+
 SIValue SI_InfVal() { return (SIValue){.intval = 0, .type = T_INF}; }
 SIValue SI_NegativeInfVal() { return (SIValue){.intval = 0, .type = T_NEGINF}; }
 
@@ -76,7 +82,7 @@ inline int SIValue_IsNullPtr(SIValue *v) {
 }
 
 void SIValue_Free(SIValue *v) {
-  if (v->type == T_STRING) {
+  if (v->type == T_STRING || v->type == T_PARAM) {
     free(v->stringval);
     v->stringval = NULL;
   }
@@ -215,6 +221,9 @@ int SIValue_ToString(SIValue v, char *buf, size_t len) {
   case T_NEGINF:
     bytes_written = snprintf(buf, len, "-inf");
     break;
+  case T_PARAM:
+    bytes_written = snprintf(buf, len, "$%s", v.stringval);
+    break;
   case T_NULL:
   default:
     bytes_written = snprintf(buf, len, "NULL");
@@ -380,6 +389,12 @@ void SIValue_FromString(SIValue *v, char *s) {
 }
 
 size_t SIValue_StringConcat(SIValue* strings, unsigned int string_count, char** concat) {
+  size_t cap = 0;
+  *concat = NULL;
+  return SIValue_StringConcatBuffer(strings, string_count, concat, &cap);
+}
+
+size_t SIValue_StringConcatBuffer(SIValue* strings, unsigned int string_count, char** concat, size_t *cap) {
   int i;
 
   size_t offset = 0, length = 0;
@@ -394,14 +409,18 @@ size_t SIValue_StringConcat(SIValue* strings, unsigned int string_count, char**
 
   /* Account for delimiters and NULL terminating byte. */
   length += string_count + 1;
-  *concat = malloc(length * sizeof(char));
+  if(*cap < length) {
+    *concat = realloc(*concat, length * sizeof(char));
+    *cap = length;
+  }
 
   for(i = 0; i < string_count; i++) {
     offset += SIValue_ToString(strings[i], (*concat) + offset, length - offset - 1);
     (*concat)[offset++] = ',';
   }
-  /* Backtrack once. */
-  (*concat)[-- offset] = '\0';
+  /* Backtrack once, no delimiter to discard if there are no strings. */
+  if(offset > 0) offset--;
+  (*concat)[offset] = '\0';
 
   /* Discard last delimiter. */
   return offset;
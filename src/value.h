@@ -24,6 +24,9 @@ typedef enum {
   T_INF = 0x100,
   T_NEGINF = 0x200,
 
+  // query parameter placeholder, stringval holds parameter's name:
+  T_PARAM = 0x400,
+
 } SIType;
 
 #define SI_NUMERIC (T_INT32 | T_INT64 | T_UINT | T_FLOAT | T_DOUBLE)
@@ -75,6 +78,9 @@ int SIValue_IsNullPtr(SIValue *v);
 SIValue SI_InfVal();
 SIValue SI_NegativeInfVal();
 int SIValue_IsInf(SIValue *v);
+
+/* Placeholder for the value of parameter name, takes ownership of name. */
+SIValue SI_ParamVal(char *name);
 int SIValue_IsNegativeInf(SIValue *v);
 
 /*
@@ -99,6 +105,10 @@ void SIValue_FromString(SIValue *v, char *s);
 /* Concats strings as a comma seperated string. */
 size_t SIValue_StringConcat(SIValue* strings, unsigned int string_count, char** concat);
 
+/* Concats strings as a comma seperated string into *buf,
+ * buf is reallocated if its capacity, *cap, is insufficient. */
+size_t SIValue_StringConcatBuffer(SIValue* strings, unsigned int string_count, char** buf, size_t *cap);
+
 void SIValue_Print(FILE *outstream, SIValue *v);
 
 #endif
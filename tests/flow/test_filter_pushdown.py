@@ -0,0 +1,79 @@
+import os
+import sys
+import unittest
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "filter_pushdown"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class FilterPushdownFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("""CREATE (x:reader {name:'x', age:30}), (y:reader {name:'y', age:20}), (z:reader {name:'z', age:40}),
+                                    (d:book {name:'d', year:2000}), (e:book {name:'e', year:2010}),
+                                    (x)-[:wrote]->(d), (x)-[:wrote]->(e), (y)-[:read {stars:5}]->(d),
+                                    (z)-[:read {stars:2}]->(d), (y)-[:read {stars:4}]->(e)""")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    def _plan(self, query):
+        return redis_con.execute_command("GRAPH.EXPLAIN", graph_name, query)
+
+    # Scans evaluate predicates over the entity they bind.
+    def test01_scan_predicate(self):
+        global redis_graph
+        query = "MATCH (a:reader) WHERE a.age > 25 RETURN a.name ORDER BY a.name"
+        plan = self._plan(query)
+        self.assertIn("Node By Label Scan | filtered", plan)
+        self.assertNotIn("Filter", plan)
+
+        actual_result = redis_graph.query(query)
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [['x'], ['z']])
+
+    # Expansions evaluate predicates over the edge they traverse.
+    def test02_expansion_predicate(self):
+        global redis_graph
+        query = "MATCH (a:reader)-[r:read]->(b) WHERE r.stars > 3 RETURN a.name, b.name ORDER BY a.name, b.name"
+        plan = self._plan(query)
+        self.assertIn("Expand All | filtered", plan)
+        self.assertNotIn("Filter", plan)
+
+        actual_result = redis_graph.query(query)
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [['y', 'd'], ['y', 'e']])
+
+    # Predicates over both sides of a hash join are evaluated on the joined records.
+    def test03_hash_join_predicate(self):
+        global redis_graph
+        query = """MATCH (a:reader)-[:wrote]->(b), (r:reader)-[:read]->(b) WHERE r.age > a.age
+                   RETURN a.name, r.name, b.name ORDER BY r.name, b.name"""
+        plan = self._plan(query).split("\n")
+        filter_line = [line for line in plan if line.strip() == "Filter"]
+        join_line = [line for line in plan if line.strip().startswith("Hash Join")]
+        self.assertEqual(len(filter_line), 1)
+        self.assertEqual(len(join_line), 1)
+        # Join is the filter's child.
+        self.assertEqual(plan.index(join_line[0]), plan.index(filter_line[0]) + 1)
+        self.assertGreater(len(join_line[0]) - len(join_line[0].lstrip()),
+                           len(filter_line[0]) - len(filter_line[0].lstrip()))
+        self.assertNotIn("filtered", "\n".join(plan))
+
+        actual_result = redis_graph.query(query)
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [['x', 'z', 'd']])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,49 @@
+import os
+import sys
+import unittest
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "fulltext"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class FullTextFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("""CREATE (:product {name:'red'}), (:product {name:'red red shoe'}),
+                                    (:product {name:'red shoe'}), (:product {name:'blue'})""")
+        redis_graph.query("CALL db.idx.fulltext.createNodeIndex('product', 'name')")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    # Each match keeps its own score when only the top records are kept.
+    def test01_ordered_scores(self):
+        global redis_graph
+        query = "CALL db.idx.fulltext.queryNodes('product', 'name', 'red') YIELD node, score RETURN node.name, score"
+        actual_result = redis_graph.query(query)
+        expected = sorted(self._skip_header_row(actual_result.result_set))
+        self.assertEqual(len(expected), 3)
+        # Repeated term scores higher.
+        scores = dict((row[0], float(row[1])) for row in expected)
+        self.assertGreater(scores['red red shoe'], scores['red shoe'])
+
+        actual_result = redis_graph.query(query + " ORDER BY node.name LIMIT 5")
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, expected)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,74 @@
+import os
+import sys
+import unittest
+import redis as redis_py
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "plan_cache"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class PlanCacheFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("CREATE (:thing {v:1, s:'a'}), (:thing {v:2, s:'b'})")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    # Queries differing only by their literals share a cached AST,
+    # rebinding it must not affect values previously assigned.
+    def test01_cached_updates(self):
+        global redis_graph
+        redis_graph.query("MATCH (n:thing) WHERE n.v = 1 SET n.s = 'ONE'")
+        redis_graph.query("MATCH (n:thing) WHERE n.v = 2 SET n.s = 'TWO'")
+
+        actual_result = redis_graph.query("MATCH (n:thing) WHERE n.v = 1 RETURN n.s")
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['ONE']])
+
+        actual_result = redis_graph.query("MATCH (n:thing) WHERE n.v = 2 RETURN n.s")
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['TWO']])
+
+        # Second update and second read were served by cached ASTs.
+        stats = redis_con.execute_command("GRAPH.PLANCACHE", graph_name)
+        self.assertEqual(stats[1], 2)
+
+    # Implicit parameters can't be shadowed by explicit ones.
+    def test02_reserved_params(self):
+        query = "MATCH (n:thing) WHERE n.s = $__p0 AND n.v = 1 RETURN n.v"
+        with self.assertRaises(redis_py.exceptions.ResponseError):
+            redis_con.execute_command("GRAPH.QUERY", graph_name, query, "PARAMS", "__p0", "'TWO'")
+        with self.assertRaises(redis_py.exceptions.ResponseError):
+            redis_con.execute_command("GRAPH.QUERY", graph_name, query)
+
+    # Schema changes to one graph don't invalidate another graph's cache.
+    def test03_other_graph_schema(self):
+        global redis_graph
+        query = "MATCH (n:thing) WHERE n.v = 1 RETURN n.s"
+        redis_graph.query(query)
+        hits = redis_con.execute_command("GRAPH.PLANCACHE", graph_name)[1]
+
+        other_graph = Graph("plan_cache_other", redis_con)
+        other_graph.query("CREATE (:other {x:1})")
+        other_graph.query("CREATE INDEX ON :other(x)")
+
+        redis_graph.query(query)
+        self.assertEqual(redis_con.execute_command("GRAPH.PLANCACHE", graph_name)[1], hits + 1)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,138 @@
+import os
+import sys
+import unittest
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "planner"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class PlannerFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("CREATE (:person {name:'roi'})-[:knows]->(:person {name:'ailon'})")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    # Planning and running read-only queries over labels
+    # which don't exist doesn't create their stores.
+    def test01_missing_label(self):
+        global redis_graph
+        keys = sorted(redis_con.keys('*'))
+
+        actual_result = redis_graph.query("MATCH (n:missing) WHERE n.v > 1 RETURN n.v")
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [])
+        actual_result = redis_graph.query("MATCH (n:missing) RETURN n ORDER BY n.v")
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [])
+        actual_result = redis_graph.query("MATCH (n:missing) RETURN count(n)")
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [['0.000000']])
+
+        self.assertEqual(sorted(redis_con.keys('*')), keys)
+
+    # Every branch of a star pattern is matched,
+    # aggregations over either branch see each combination.
+    def test02_star_pattern(self):
+        global redis_graph
+        redis_graph.query("""CREATE (a:employee {name:'a'}), (b1:employee {name:'b1'}), (b2:employee {name:'b2'}),
+                             (c1:company {name:'c1', size:10}), (c2:company {name:'c2', size:5}),
+                             (a)-[:colleague]->(b1), (a)-[:colleague]->(b2),
+                             (a)-[:works]->(c1), (a)-[:works]->(c2)""")
+
+        query = """MATCH (a:employee)-[:colleague]->(b), (a)-[:works]->(c)
+                   RETURN a.name, count(b), count(c), sum(c.size)"""
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['a', '4.000000', '4.000000', '30.000000']])
+
+        query = """MATCH (a:employee)-[:colleague]->(b), (a)-[:works]->(c)
+                   RETURN b.name, c.name ORDER BY b.name, c.name"""
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['b1', 'c1'], ['b1', 'c2'], ['b2', 'c1'], ['b2', 'c2']])
+
+    # Comma separated paths sharing a node are joined on it,
+    # whether or not the node ends both paths.
+    def test03_shared_node(self):
+        global redis_graph
+        redis_graph.query("""CREATE (x:reader {name:'x'}), (y:reader {name:'y'}), (z:reader {name:'z'}),
+                             (d:book {name:'d'}), (e:book {name:'e'}), (f:genre {name:'f'}),
+                             (x)-[:wrote]->(d), (x)-[:wrote]->(e), (d)-[:tagged]->(f),
+                             (y)-[:read]->(d), (z)-[:read]->(d), (y)-[:read]->(e)""")
+
+        query = """MATCH (a:reader)-[:wrote]->(b), (r:reader)-[:read]->(b)
+                   RETURN a.name, r.name, b.name ORDER BY r.name, b.name"""
+        plan = redis_con.execute_command("GRAPH.EXPLAIN", graph_name, query)
+        self.assertIn("Hash Join", plan)
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['x', 'y', 'd'], ['x', 'y', 'e'], ['x', 'z', 'd']])
+
+        query = """MATCH (a:reader)-[:wrote]->(b)-[:tagged]->(g), (r:reader)-[:read]->(b)
+                   RETURN r.name, g.name ORDER BY r.name"""
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['y', 'f'], ['z', 'f']])
+
+        query = """MATCH (a:reader)-[:wrote]->(b), (r:reader)-[:read]->(b), (s:reader)-[:read]->(b)
+                   RETURN b.name, r.name, s.name ORDER BY b.name, r.name, s.name"""
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['d', 'y', 'y'], ['d', 'y', 'z'], ['d', 'z', 'y'],
+                                      ['d', 'z', 'z'], ['e', 'y', 'y']])
+
+    # Nodes closing a cycle are bound by a leapfrog join,
+    # every parallel edge is matched and acyclic branches are expanded past the join.
+    def test04_cyclic_patterns(self):
+        global redis_graph
+        redis_graph.query("""CREATE (a:member {name:'a'}), (b:member {name:'b'}), (c:member {name:'c'}),
+                             (d:member {name:'d'}), (l:member {name:'l'}), (x:city {name:'x'}),
+                             (a)-[:follows]->(b), (b)-[:follows]->(c), (a)-[:follows]->(c),
+                             (c)-[:follows]->(d), (a)-[:follows]->(d), (l)-[:follows]->(l), (a)-[:lives]->(x)""")
+        # Parallel edge.
+        redis_graph.query("MATCH (b:member {name:'b'}), (c:member {name:'c'}) CREATE (b)-[:follows]->(c)")
+
+        # Triangle.
+        query = """MATCH (a:member)-[:follows]->(b)-[:follows]->(c), (a)-[:follows]->(c)
+                   RETURN a.name, b.name, c.name ORDER BY a.name, b.name, c.name"""
+        plan = redis_con.execute_command("GRAPH.EXPLAIN", graph_name, query)
+        self.assertIn("Leapfrog Join", plan)
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['a', 'b', 'c'], ['a', 'b', 'c'], ['a', 'c', 'd'], ['l', 'l', 'l']])
+
+        # 4-cycle with a chord.
+        query = """MATCH (a:member)-[:follows]->(b)-[:follows]->(c)-[:follows]->(d), (a)-[:follows]->(d), (a)-[:follows]->(c)
+                   RETURN a.name, b.name, c.name, d.name ORDER BY a.name"""
+        plan = redis_con.execute_command("GRAPH.EXPLAIN", graph_name, query)
+        self.assertEqual(plan.count("Leapfrog Join"), 2)
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['a', 'b', 'c', 'd'], ['a', 'b', 'c', 'd'], ['l', 'l', 'l', 'l']])
+
+        # Self loop.
+        actual_result = redis_graph.query("MATCH (a:member)-[:follows]->(a) RETURN a.name")
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [['l']])
+
+        # Cycle and an acyclic branch.
+        query = """MATCH (a:member)-[:follows]->(b)-[:follows]->(c), (a)-[:follows]->(c), (a)-[:lives]->(x)
+                   RETURN a.name, b.name, c.name, x.name ORDER BY b.name, c.name"""
+        actual_result = redis_graph.query(query)
+        result_set = self._skip_header_row(actual_result.result_set)
+        self.assertEqual(result_set, [['a', 'b', 'c', 'x'], ['a', 'b', 'c', 'x'], ['a', 'c', 'd', 'x']])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,64 @@
+import os
+import sys
+import unittest
+import redis as redis_py
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "prepared_statements"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class PreparedStatementsFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("CREATE (:person {name:'a'})")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    def _execute(self, handle):
+        result = redis_con.execute_command("GRAPH.EXECUTE", graph_name, handle)
+        return result[0]
+
+    # Statement is prepared again once the schema changed.
+    def test01_schema_change(self):
+        handle = redis_con.execute_command("GRAPH.PREPARE", graph_name, "MATCH (n:person) RETURN n")
+        self.assertEqual(self._execute(handle), ['n.name', 'a'])
+
+        redis_graph.query("CREATE (:person {name:'b', age:3})")
+        self.assertEqual(self._execute(handle), ['n.age,n.name', 'NULL,a', '3.000000,b'])
+
+    def test02_deallocate(self):
+        handle = redis_con.execute_command("GRAPH.PREPARE", graph_name, "MATCH (n:person) RETURN n.name")
+        self.assertEqual(redis_con.execute_command("GRAPH.DEALLOCATE", graph_name, handle), 'OK')
+
+        with self.assertRaises(redis_py.exceptions.ResponseError):
+            self._execute(handle)
+
+        # Handles aren't reused.
+        new_handle = redis_con.execute_command("GRAPH.PREPARE", graph_name, "MATCH (n:person) RETURN n.name")
+        self.assertNotEqual(new_handle, handle)
+
+    # Statements are dropped along with their graph.
+    def test03_delete_graph(self):
+        handle = redis_con.execute_command("GRAPH.PREPARE", graph_name, "MATCH (n:person) RETURN n.name")
+        redis_con.execute_command("GRAPH.DELETE", graph_name)
+
+        with self.assertRaises(redis_py.exceptions.ResponseError):
+            self._execute(handle)
+
+if __name__ == '__main__':
+    unittest.main()
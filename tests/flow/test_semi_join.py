@@ -0,0 +1,72 @@
+import os
+import sys
+import unittest
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "semi_join"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class SemiJoinFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("""CREATE (a:user {name:'a', v:1}), (b:user {name:'b', v:2}),
+                                    (c:user {name:'c', v:3}), (d:user {name:'d', v:4}),
+                                    (a)-[:follows {w:1}]->(b), (a)-[:follows {w:2}]->(c), (a)-[:follows {w:3}]->(d),
+                                    (b)-[:follows {w:1}]->(c), (c)-[:follows {w:5}]->(a)""")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    def _plan(self, query):
+        return redis_con.execute_command("GRAPH.EXPLAIN", graph_name, query)
+
+    def _rows(self, query):
+        return self._skip_header_row(redis_graph.query(query).result_set)
+
+    # Semi expansions return the distinct records the full expansion does.
+    def test01_distinct_results(self):
+        global redis_graph
+        queries = ["MATCH (a:user)-[:follows]->(b) RETURN DISTINCT a.name",
+                   "MATCH (a:user)-[:follows]->(b)-[:follows]->(c) RETURN DISTINCT a.name",
+                   "MATCH (a:user)-[:follows]->(b)-[:follows]->(c) RETURN DISTINCT b.name"]
+        for query in queries:
+            self.assertIn("Semi Expand", self._plan(query))
+            # Without DISTINCT every match is expanded.
+            full_query = query.replace("DISTINCT ", "")
+            self.assertNotIn("Semi Expand", self._plan(full_query))
+
+            expected = sorted(set(tuple(row) for row in self._rows(full_query)))
+            actual = sorted(tuple(row) for row in self._rows(query))
+            self.assertEqual(actual, expected)
+
+    # Expansions whose neighbor or edge is used beyond checking for a match are expanded in full.
+    def test02_used_expansion(self):
+        global redis_graph
+        queries = ["MATCH (a:user)-[:follows]->(b) WHERE b.v > 2 RETURN DISTINCT a.name",
+                   "MATCH (a:user)-[r:follows]->(b) WHERE r.w > 2 RETURN DISTINCT a.name",
+                   "MATCH (a:user)-[:follows]->(b) WHERE b.v > a.v RETURN DISTINCT a.name",
+                   "MATCH (a:user)-[:follows]->(b) RETURN DISTINCT a.name ORDER BY b",
+                   "MATCH (a:user)-[:follows]->(b) RETURN DISTINCT a.name, b.name",
+                   "MATCH (a:user)-[r:follows]->(b) RETURN DISTINCT a.name, r.w"]
+        for query in queries:
+            self.assertNotIn("Semi Expand", self._plan(query))
+
+        actual_result = redis_graph.query("MATCH (a:user)-[r:follows]->(b) WHERE r.w > 2 RETURN DISTINCT a.name")
+        self.assertEqual(self._skip_header_row(actual_result.result_set), [['a'], ['c']])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,73 @@
+import os
+import sys
+import unittest
+from redisgraph import Graph
+
+from .disposableredis import DisposableRedis
+from base import FlowTestsBase
+
+graph_name = "statistics_count"
+redis_graph = None
+redis_con = None
+
+def redis():
+    return DisposableRedis(loadmodule=os.path.dirname(os.path.abspath(__file__)) + '/../../src/redisgraph.so')
+
+class StatisticsCountFlowTest(FlowTestsBase):
+    @classmethod
+    def setUpClass(cls):
+        global redis_graph
+        global redis_con
+        cls.r = redis()
+        cls.r.start()
+        redis_con = cls.r.client()
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("""CREATE (a:person {name:'a'}), (b:person {name:'b'}), (c:person {name:'c'}),
+                                    (x:city {name:'x'}), (a)-[:knows]->(b), (b)-[:knows]->(c),
+                                    (c)-[:knows]->(c), (a)-[:lives]->(x)""")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.r.stop()
+
+    def _count(self, query, shortcut):
+        plan = redis_con.execute_command("GRAPH.EXPLAIN", graph_name, query)
+        if shortcut:
+            self.assertIn("Statistics Count", plan)
+        else:
+            self.assertNotIn("Statistics Count", plan)
+        actual_result = redis_graph.query(query)
+        return self._skip_header_row(actual_result.result_set)[0][0]
+
+    # Counts of entire stores are read off the store.
+    def test01_store_counts(self):
+        self.assertEqual(self._count("MATCH (n:person) RETURN count(n)", True), '3.000000')
+        self.assertEqual(self._count("MATCH (n) RETURN count(n)", True), '4.000000')
+        self.assertEqual(self._count("MATCH ()-[r:knows]->() RETURN count(r)", True), '3.000000')
+        self.assertEqual(self._count("MATCH ()-[r]->() RETURN count(r)", True), '4.000000')
+
+    def test02_missing_store(self):
+        self.assertEqual(self._count("MATCH (n:missing) RETURN count(n)", True), '0.000000')
+        self.assertEqual(self._count("MATCH ()-[r:missing]->() RETURN count(r)", True), '0.000000')
+
+    # Patterns which don't match every entity of a store are counted by matching.
+    def test03_constrained_patterns(self):
+        self.assertEqual(self._count("MATCH (a)-[r:knows]->(a) RETURN count(r)", False), '1.000000')
+        self.assertEqual(self._count("MATCH (a:person)-[r]->(b) RETURN count(r)", False), '4.000000')
+        self.assertEqual(self._count("MATCH (a)-[r]->(b:city) RETURN count(r)", False), '1.000000')
+        self.assertEqual(self._count("MATCH (n:person {name:'a'}) RETURN count(n)", False), '1.000000')
+
+    # Stores keep their counts up to date as entities are deleted.
+    def test04_delete(self):
+        redis_graph.query("MATCH (n:person {name:'b'}) DELETE n")
+        self.assertEqual(self._count("MATCH (n:person) RETURN count(n)", True), '2.000000')
+        self.assertEqual(self._count("MATCH (n) RETURN count(n)", True), '3.000000')
+        self.assertEqual(self._count("MATCH ()-[r:knows]->() RETURN count(r)", True), '1.000000')
+
+        redis_graph.query("MATCH (:person)-[r:lives]->() DELETE r")
+        self.assertEqual(self._count("MATCH ()-[r:lives]->() RETURN count(r)", True), '0.000000')
+        self.assertEqual(self._count("MATCH ()-[r]->() RETURN count(r)", True), '1.000000')
+        self.assertEqual(self._count("MATCH (a:person)-[r]->(b) RETURN count(r)", False), '1.000000')
+
+if __name__ == '__main__':
+    unittest.main()
@@ -159,6 +159,47 @@ void test_stdev() {
 
 }
 
+// Weighted aggregation equals aggregating each value weight times.
+void test_weighted() {
+    const char *funcs[5] = {"sum", "avg", "count", "max", "min"};
+    double values[3] = {2, 5, 3};
+    size_t weights[3] = {3, 1, 4};
+
+    for(int f = 0; f < 5; f++) {
+        AR_ExpNode *weighted = AR_EXP_NewOpNode((char*)funcs[f], 1);
+        AR_ExpNode *repeated = AR_EXP_NewOpNode((char*)funcs[f], 1);
+
+        for(int i = 0; i < 3; i++) {
+            weighted->op.children[0] = AR_EXP_NewConstOperandNode(SI_DoubleVal(values[i]));
+            repeated->op.children[0] = weighted->op.children[0];
+            AR_EXP_AggregateWeighted(weighted, weights[i]);
+            for(int j = 0; j < weights[i]; j++) AR_EXP_Aggregate(repeated);
+            AR_EXP_Free(weighted->op.children[0]);
+        }
+        weighted->op.child_count = 0;
+        repeated->op.child_count = 0;
+
+        AR_EXP_Reduce(weighted);
+        AR_EXP_Reduce(repeated);
+        _test_ar_func(weighted, AR_EXP_Evaluate(repeated));
+        AR_EXP_Free(weighted);
+        AR_EXP_Free(repeated);
+    }
+
+    // Functions lacking a weighted step are stepped repeatedly.
+    AR_ExpNode *weighted = AR_EXP_NewOpNode("stDevP", 1);
+    weighted->op.children[0] = AR_EXP_NewConstOperandNode(SI_DoubleVal(1));
+    AR_EXP_AggregateWeighted(weighted, 2);
+    AR_EXP_Free(weighted->op.children[0]);
+    weighted->op.children[0] = AR_EXP_NewConstOperandNode(SI_DoubleVal(4));
+    AR_EXP_AggregateWeighted(weighted, 2);
+    AR_EXP_Reduce(weighted);
+    assert(AR_EXP_Evaluate(weighted).doubleval == 1.5);
+    AR_EXP_Free(weighted);
+
+    printf("test_weighted - PASS!\n");
+}
+
 int main(int argc, char **argv) {
     AR_RegisterFuncs();
     Agg_RegisterFuncs();
@@ -166,6 +207,7 @@ int main(int argc, char **argv) {
     test_percentile_disc();
     test_percentile_cont();
     test_stdev();
+    test_weighted();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "assert.h"
+#include "../../src/util/arena.h"
+#include "../../src/resultset/record.h"
+
+void test_arena() {
+    Arena *arena = NewArena(64);
+
+    /* Allocations are aligned and don't overlap. */
+    char *a = Arena_Alloc(arena, 3);
+    char *b = Arena_Alloc(arena, 5);
+    assert((uintptr_t)a % 8 == 0 && (uintptr_t)b % 8 == 0);
+    assert(b >= a + 3);
+
+    /* Allocations exceeding block size get a block of their own. */
+    char *big = Arena_Alloc(arena, 1024);
+    memset(big, 1, 1024);
+
+    char *s = Arena_Strdup(arena, "arena");
+    assert(strcmp(s, "arena") == 0);
+
+    Arena_Reset(arena);
+    assert(arena->blocks->next == NULL);
+    assert(arena->blocks->used == 0);
+
+    Arena_Free(arena);
+}
+
+void test_record_pool() {
+    RecordPool *pool = NewRecordPool(3);
+
+    Record *r = RecordPool_GetRecord(pool);
+    assert(r->len == 3 && r->pool == pool);
+    r->values[2] = SI_DoubleVal(1);
+
+    /* Freed records are recycled. */
+    Record_Free(r);
+    assert(pool->released_count == 1);
+    assert(RecordPool_GetRecord(pool) == r);
+    assert(pool->released_count == 0);
+
+    Record *other = RecordPool_GetRecord(pool);
+    assert(other != r);
+
+    RecordPool_Free(pool);
+}
+
+int main(int argc, char **argv) {
+    test_arena();
+    test_record_pool();
+    printf("test_arena - PASS!\n");
+    return 0;
+}
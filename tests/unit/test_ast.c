@@ -13,6 +13,8 @@ void test_validate_set_clause() {
     AST_QueryExpressionNode* ast = ParseQuery(query, strlen(query), &errMsg);
     assert(ast != NULL);
     assert(_Validate_SET_Clause(ast, &undefined_alias) == AST_VALID);
+    // Updates are writes.
+    assert(Query_Modifies_KeySpace(ast));
 
     // invalid query
     query = "MATCH (n { name: 'Andres' }) SET n.surname = 'Taylor', m.middle_name = '23'";
@@ -99,10 +101,94 @@ void test_validate_return_clause() {
     free(undefined_alias);
 }
 
+void test_skip_limit_clause() {
+    char *errMsg = NULL;
+
+    char *query = "MATCH (n) RETURN n ORDER BY n.age SKIP 5 LIMIT 10";
+    AST_QueryExpressionNode* ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    assert(ast->skipNode != NULL && ast->skipNode->skip == 5);
+    assert(ast->limitNode != NULL && ast->limitNode->limit == 10);
+    Free_AST_QueryExpressionNode(ast);
+
+    query = "MATCH (n) RETURN n SKIP 3";
+    ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    assert(ast->skipNode != NULL && ast->skipNode->skip == 3);
+    assert(ast->limitNode == NULL);
+    Free_AST_QueryExpressionNode(ast);
+
+    // SKIP must precede LIMIT.
+    query = "MATCH (n) RETURN n LIMIT 3 SKIP 1";
+    ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast == NULL);
+    free(errMsg);
+}
+
+void test_params() {
+    char *errMsg = NULL;
+    char *reason = NULL;
+    char *query = "MATCH (n:person {name: $name}) WHERE n.age > $age RETURN n.name, $age";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+
+    // Inlined property, WHERE predicate, inlined predicate and return element.
+    Vector *params = AST_CollectParams(ast);
+    assert(Vector_Size(params) == 4);
+
+    char *names[2] = {"name", "age"};
+    SIValue values[2] = {SI_StringVal("Alice"), SI_DoubleVal(30)};
+    assert(AST_BindParams(params, names, values, 2, &reason) == AST_VALID);
+
+    AST_FilterNode *filters = ast->whereNode->filters;
+    assert(filters->t == N_COND);
+    assert(filters->cn.left->pn.constVal.type == T_DOUBLE);
+    assert(filters->cn.left->pn.constVal.doubleval == 30);
+    assert(strcmp(filters->cn.right->pn.constVal.stringval, "Alice") == 0);
+
+    // Placeholders can be rebound.
+    values[1] = SI_DoubleVal(40);
+    assert(AST_BindParams(params, names, values, 2, &reason) == AST_VALID);
+    assert(filters->cn.left->pn.constVal.doubleval == 40);
+
+    AST_ReturnElementNode *elem;
+    Vector_Get(ast->returnNode->returnElements, 1, &elem);
+    assert(elem->exp->operand.constant.doubleval == 40);
+
+    // Missing parameter.
+    assert(AST_BindParams(params, names, values, 1, &reason) == AST_INVALID);
+    assert(strcmp(reason, "Missing value for parameter $age") == 0);
+    free(reason);
+
+    SIValue_Free(&values[0]);
+    AST_FreeParams(params);
+}
+
+void test_standalone_call() {
+    char *errMsg = NULL;
+    char *reason = NULL;
+    char *query = "CALL db.idx.fulltext.queryNodes('prod', 'name', 'running')";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(Validate_AST(ast, &reason) == AST_VALID);
+
+    // Standalone call returns its default yields.
+    assert(ast->returnNode && Vector_Size(ast->returnNode->returnElements) == 2);
+    AST_ReturnElementNode *elem;
+    Vector_Get(ast->returnNode->returnElements, 0, &elem);
+    assert(strcmp(elem->exp->operand.variadic.alias, "node") == 0);
+    assert(elem->exp->operand.variadic.property == NULL);
+    Vector_Get(ast->returnNode->returnElements, 1, &elem);
+    assert(strcmp(elem->alias, "score") == 0);
+    Free_AST_QueryExpressionNode(ast);
+}
+
 int main(int argc, char **argv) {
     test_validate_set_clause();
 	test_validate_delete_clause();
     test_validate_return_clause();
+    test_skip_limit_clause();
+    test_params();
+    test_standalone_call();
 	printf("test_ast - PASS!\n");
     return 0;
 }
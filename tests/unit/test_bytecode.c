@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <string.h>
+#include "assert.h"
+#include "../../src/parser/grammar.h"
+#include "../../src/bytecode/bytecode.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/query_executor.h"
+
+AST_QueryExpressionNode* _parse(const char *query) {
+    char *errMsg = NULL;
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    return ast;
+}
+
+Node* _node(long int id, const char *name, double v, double lat) {
+    Node *n = NewNode(id, NULL);
+    char *keys[4] = {"name", "v", "lat", "lon"};
+    SIValue vals[4] = {SI_StringVal((char*)name), SI_DoubleVal(v), SI_DoubleVal(lat), SI_DoubleVal(34.8)};
+    Node_Add_Properties(n, 4, keys, vals);
+    return n;
+}
+
+/* Compiled filter agrees with the filter tree on every binding of a and b. */
+void _validate_filter(const char *query, Node **nodes, int node_count) {
+    AST_QueryExpressionNode *ast = _parse(query);
+    FT_FilterNode *tree = BuildFiltersTree(ast->whereNode->filters);
+
+    Graph *g = NewGraph();
+    Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "a");
+    Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "b");
+    BC_Program *program = BC_CompileFilter(tree, g);
+
+    int passes = 0;
+    for(int i = 0; i < node_count; i++) {
+        for(int j = 0; j < node_count; j++) {
+            g->nodes[0] = nodes[i];
+            g->nodes[1] = nodes[j];
+            int pass = applyFilters(g, tree);
+            assert(BC_ApplyFilter(program) == pass);
+            passes += pass;
+        }
+    }
+    /* Filter is neither always true nor always false. */
+    assert(passes > 0 && passes < node_count * node_count);
+
+    BC_Free(program);
+    FilterTree_Free(tree);
+    Free_AST_QueryExpressionNode(ast);
+}
+
+void test_filter() {
+    Node *nodes[4] = {_node(1, "roi", 1, 32.1), _node(2, "Ailon", 2, 32.2),
+                      _node(3, "Boaz", 3, 40), NewNode(INVALID_ENTITY_ID, NULL)};
+
+    _validate_filter("MATCH (a), (b) WHERE a.v > 1 RETURN a", nodes, 4);
+    _validate_filter("MATCH (a), (b) WHERE a.name = 'ROI' OR a.name < 'b' RETURN a", nodes, 4);
+    _validate_filter("MATCH (a), (b) WHERE a.name STARTS WITH 'B' RETURN a", nodes, 4);
+    _validate_filter("MATCH (a), (b) WHERE a.v >= b.v AND a.v < 3 RETURN a", nodes, 4);
+    _validate_filter("MATCH (a), (b) WHERE id(a) = 2 OR (id(b) <= 1 AND b.v = 1) RETURN a", nodes, 4);
+    _validate_filter("MATCH (a), (b) WHERE distance(a.lat, a.lon, 32.1, 34.8) < 20000 AND a.v < 7 RETURN a", nodes, 4);
+}
+
+/* Properties read by several predicates are loaded once per evaluation. */
+void test_filter_load_once() {
+    AST_QueryExpressionNode *ast = _parse("MATCH (a) WHERE a.v > 1 AND a.v < 3 RETURN a");
+    FT_FilterNode *tree = BuildFiltersTree(ast->whereNode->filters);
+    Graph *g = NewGraph();
+    Graph_AddNode(g, _node(1, "roi", 2, 0), "a");
+
+    BC_Program *program = BC_CompileFilter(tree, g);
+    assert(program->code[0].op == BC_LOAD_PROPERTY && program->code[1].op == BC_CMP_DOUBLE);
+    assert(program->code[2].op == BC_JUMP_IF_FALSE && program->code[2].target == 5);
+    assert(program->code[3].op == BC_LOAD_PROPERTY && program->code[3].dst == program->code[0].dst);
+    assert(BC_ApplyFilter(program) == FILTER_PASS);
+
+    BC_Free(program);
+    FilterTree_Free(tree);
+    Free_AST_QueryExpressionNode(ast);
+}
+
+/* Batch filtering selects the entities passing the filter tree, in order. */
+void _validate_batch(const char *query, Node **nodes, int node_count) {
+    AST_QueryExpressionNode *ast = _parse(query);
+    FT_FilterNode *tree = BuildFiltersTree(ast->whereNode->filters);
+    Graph *g = NewGraph();
+    Node *placeholder = NewNode(INVALID_ENTITY_ID, NULL);
+    Graph_AddNode(g, placeholder, "a");
+    GraphEntity **ref = (GraphEntity**)&g->nodes[0];
+    BC_Program *program = BC_CompileFilter(tree, g);
+
+    uint16_t selection[node_count];
+    int selected = BC_FilterBatch(program, ref, (GraphEntity**)nodes, node_count, selection);
+    assert(*ref == (GraphEntity*)placeholder);
+
+    int j = 0;
+    for(int i = 0; i < node_count; i++) {
+        g->nodes[0] = nodes[i];
+        if(applyFilters(g, tree) == FILTER_PASS) assert(selection[j++] == i);
+    }
+    assert(j == selected && selected > 0 && selected < node_count);
+
+    g->nodes[0] = placeholder;
+    BC_Free(program);
+    FilterTree_Free(tree);
+    Free_AST_QueryExpressionNode(ast);
+}
+
+void test_filter_batch() {
+    int node_count = 600;
+    Node *nodes[node_count];
+    for(int i = 0; i < node_count; i++) nodes[i] = _node(i, "roi", i % 7, 32.1);
+    /* Entities lacking the property fall back to the program. */
+    nodes[5] = NewNode(INVALID_ENTITY_ID, NULL);
+
+    /* Column wise comparison. */
+    _validate_batch("MATCH (a) WHERE a.v > 3 RETURN a", nodes, node_count);
+    _validate_batch("MATCH (a) WHERE a.v = 2 RETURN a", nodes, node_count);
+    _validate_batch("MATCH (a) WHERE a.v <= 1 RETURN a", nodes, node_count);
+    /* Program per entity. */
+    _validate_batch("MATCH (a) WHERE a.v > 1 AND a.v < 5 RETURN a", nodes, node_count);
+}
+
+void test_expression() {
+    AST_QueryExpressionNode *ast = _parse("MATCH (a) RETURN 1 + 2 * 3, a.v + a.v * 2, toUpper(a.name)");
+    Graph *g = NewGraph();
+    Graph_AddNode(g, _node(1, "roi", 2, 0), "a");
+
+    AST_ReturnElementNode *elem;
+    AR_ExpNode *exp;
+
+    /* Constants are folded. */
+    Vector_Get(ast->returnNode->returnElements, 0, &elem);
+    exp = AR_EXP_BuildFromAST(elem->exp, g);
+    BC_Program *program = BC_CompileExpression(exp);
+    assert(program->code_len == 1 && program->code[0].op == BC_RETURN);
+    assert(BC_Evaluate(program).doubleval == 7);
+    BC_Free(program);
+    AR_EXP_Free(exp);
+
+    /* a.v is loaded once. */
+    Vector_Get(ast->returnNode->returnElements, 1, &elem);
+    exp = AR_EXP_BuildFromAST(elem->exp, g);
+    program = BC_CompileExpression(exp);
+    assert(program->code[0].op == BC_LOAD_PROPERTY && program->code[1].op == BC_CALL);
+    assert(program->code[2].op == BC_CALL && program->code[3].op == BC_RETURN);
+    assert(BC_Evaluate(program).doubleval == 6);
+    assert(BC_Evaluate(program).doubleval == AR_EXP_Evaluate(exp).doubleval);
+    BC_Free(program);
+    AR_EXP_Free(exp);
+
+    Vector_Get(ast->returnNode->returnElements, 2, &elem);
+    exp = AR_EXP_BuildFromAST(elem->exp, g);
+    program = BC_CompileExpression(exp);
+    SIValue v = BC_Evaluate(program);
+    assert(strcmp(v.stringval, "ROI") == 0);
+    SIValue_Free(&v);
+    BC_Free(program);
+    AR_EXP_Free(exp);
+
+    Free_AST_QueryExpressionNode(ast);
+}
+
+int main(int argc, char **argv) {
+    AR_RegisterFuncs();
+    Agg_RegisterFuncs();
+    test_filter();
+    test_filter_load_once();
+    test_filter_batch();
+    test_expression();
+    printf("test_bytecode - PASS!\n");
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include "assert.h"
+#include "../../src/graph/graph.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_cache.h"
+
+/* Scan binding node x to count nodes derived from node p's id,
+ * x's ids are p's id * 10 + 0..count-1. */
+typedef struct {
+	OpBase op;
+	Node **x;
+	Node *_x;
+	Node **p;
+	Vector *nodes;		/* Nodes bound, cached records point to them. */
+	int count;
+	int position;
+	int passes;			/* Number of times the scan was started. */
+} DerivedScan;
+
+OpResult DerivedScanConsume(OpBase *opBase, Graph *graph) {
+	DerivedScan *op = (DerivedScan*)opBase;
+	if(op->position == 0) op->passes++;
+	if(op->position == op->count) return OP_DEPLETED;
+	Node *n = NewNode((*op->p)->id * 10 + op->position, NULL);
+	Vector_Push(op->nodes, n);
+	*op->x = n;
+	op->position++;
+	return OP_OK;
+}
+
+OpResult DerivedScanReset(OpBase *opBase) {
+	DerivedScan *op = (DerivedScan*)opBase;
+	op->position = 0;
+	*op->x = op->_x;
+	return OP_OK;
+}
+
+void DerivedScanFree(OpBase *opBase) {
+	DerivedScan *op = (DerivedScan*)opBase;
+	for(int i = 0; i < Vector_Size(op->nodes); i++) {
+		Node *n;
+		Vector_Get(op->nodes, i, &n);
+		FreeNode(n);
+	}
+	Vector_Free(op->nodes);
+	Vector_Free(op->op.modifies);
+	free(op);
+}
+
+DerivedScan* NewDerivedScan(Graph *g, int count) {
+	DerivedScan *op = calloc(1, sizeof(DerivedScan));
+	op->x = (Node**)Graph_GetEntityRef(g, "x");
+	op->_x = *op->x;
+	op->p = (Node**)Graph_GetEntityRef(g, "p");
+	op->count = count;
+	op->nodes = NewVector(Node*, count);
+
+	op->op.name = "Derived Scan";
+	op->op.consume = DerivedScanConsume;
+	op->op.reset = DerivedScanReset;
+	op->op.free = DerivedScanFree;
+	char *alias = "x";
+	op->op.modifies = NewVector(char*, 1);
+	Vector_Push(op->op.modifies, alias);
+	return op;
+}
+
+/* Binds p to id, consumes cache entirely and validates the records it produced. */
+void _consume_pass(OpNode *cache, Graph *g, long int id, int count) {
+	Graph_GetNodeByAlias(g, "p")->id = id;
+	ResetStream(cache);
+	int produced = 0;
+	while(OpNode_Consume(cache, g) == OP_OK) {
+		assert(produced < count);
+		assert(Graph_GetNodeByAlias(g, "x")->id == id * 10 + produced);
+		produced++;
+	}
+	assert(produced == count);
+}
+
+void test_cache() {
+	Graph *g = NewGraph();
+	Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "x");
+	Graph_AddNode(g, NewNode(1, NULL), "p");
+
+	char *param = "p";
+	Vector *params = NewVector(char*, 1);
+	Vector_Push(params, param);
+
+	DerivedScan *scan = NewDerivedScan(g, 3);
+	OpNode *stream = NewOpNode((OpBase*)scan);
+	/* Room for the entries of two distinct bindings of p. */
+	size_t entry_size = sizeof(CacheEntry) + sizeof(uint64_t) + 16 * sizeof(GraphEntity*);
+	OpNode *cache = NewOpNode(NewCacheOp(g, stream, params, entry_size * 2));
+	cache->children = malloc(sizeof(OpNode*));
+	cache->children[0] = stream;
+	cache->childCount = 1;
+
+	/* First pass consumes the stream, following passes replay it. */
+	_consume_pass(cache, g, 1, 3);
+	assert(scan->passes == 1);
+	_consume_pass(cache, g, 1, 3);
+	_consume_pass(cache, g, 1, 3);
+	assert(scan->passes == 1);
+
+	/* Each binding of p has its own entry. */
+	_consume_pass(cache, g, 2, 3);
+	assert(scan->passes == 2);
+	_consume_pass(cache, g, 1, 3);
+	_consume_pass(cache, g, 2, 3);
+	assert(scan->passes == 2);
+
+	/* A third binding evicts the least recently used entry, p = 1. */
+	_consume_pass(cache, g, 3, 3);
+	assert(scan->passes == 3);
+	_consume_pass(cache, g, 2, 3);
+	assert(scan->passes == 3);
+	_consume_pass(cache, g, 1, 3);
+	assert(scan->passes == 4);
+	assert(((Cache*)cache->operation)->memory <= entry_size * 2);
+
+	/* A pass exceeding the memory cap is streamed without being cached. */
+	OpNode_Free(cache);
+	scan = NewDerivedScan(g, 20);
+	stream = NewOpNode((OpBase*)scan);
+	cache = NewOpNode(NewCacheOp(g, stream, params, entry_size));
+	cache->children = malloc(sizeof(OpNode*));
+	cache->children[0] = stream;
+	cache->childCount = 1;
+
+	_consume_pass(cache, g, 4, 20);
+	_consume_pass(cache, g, 4, 20);
+	assert(scan->passes == 2);
+	assert(((Cache*)cache->operation)->memory == 0);
+
+	OpNode_Free(cache);
+	Vector_Free(params);
+}
+
+/* Cache without parameters, replays a single entry. */
+void test_cache_no_params() {
+	Graph *g = NewGraph();
+	Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "x");
+	Graph_AddNode(g, NewNode(5, NULL), "p");
+
+	DerivedScan *scan = NewDerivedScan(g, 4);
+	OpNode *stream = NewOpNode((OpBase*)scan);
+	OpNode *cache = NewOpNode(NewCacheOp(g, stream, NULL, CACHE_MEMORY_CAP));
+	cache->children = malloc(sizeof(OpNode*));
+	cache->children[0] = stream;
+	cache->childCount = 1;
+
+	for(int i = 0; i < 5; i++) _consume_pass(cache, g, 5, 4);
+	assert(scan->passes == 1);
+
+	/* Abandoning a pass midway drops its partial entry. */
+	OpNode_Free(cache);
+	scan = NewDerivedScan(g, 4);
+	stream = NewOpNode((OpBase*)scan);
+	cache = NewOpNode(NewCacheOp(g, stream, NULL, CACHE_MEMORY_CAP));
+	cache->children = malloc(sizeof(OpNode*));
+	cache->children[0] = stream;
+	cache->childCount = 1;
+
+	assert(OpNode_Consume(cache, g) == OP_OK);
+	assert(OpNode_Consume(cache, g) == OP_OK);
+	_consume_pass(cache, g, 5, 4);
+	assert(scan->passes == 2);
+	_consume_pass(cache, g, 5, 4);
+	assert(scan->passes == 2);
+
+	OpNode_Free(cache);
+}
+
+int main(int argc, char **argv) {
+	test_cache();
+	test_cache_no_params();
+	printf("test_cache - PASS!\n");
+	return 0;
+}
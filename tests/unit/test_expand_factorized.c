@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <string.h>
+#include "assert.h"
+#include "../../src/graph/graph.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/grouping/group_cache.h"
+#include "../../src/resultset/resultset.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_aggregate.h"
+#include "../../src/execution_plan/ops/op_expand_factorized.h"
+
+/* Scan binding node a to each of a fixed list of nodes. */
+typedef struct {
+    OpBase op;
+    Node **a;
+    Node *_a;
+    Node **nodes;
+    int count;
+    int position;
+} ListScan;
+
+OpResult ListScanConsume(OpBase *opBase, Graph *graph) {
+    ListScan *op = (ListScan*)opBase;
+    if(op->position == op->count) return OP_DEPLETED;
+    *op->a = op->nodes[op->position++];
+    return OP_OK;
+}
+
+OpResult ListScanReset(OpBase *opBase) {
+    ListScan *op = (ListScan*)opBase;
+    op->position = 0;
+    *op->a = op->_a;
+    return OP_OK;
+}
+
+void ListScanFree(OpBase *opBase) {
+    free(opBase);
+}
+
+OpBase* NewListScan(Graph *g, Node **nodes, int count) {
+    ListScan *op = calloc(1, sizeof(ListScan));
+    op->a = (Node**)Graph_GetEntityRef(g, "a");
+    op->_a = *op->a;
+    op->nodes = nodes;
+    op->count = count;
+    op->op.name = "List Scan";
+    op->op.consume = ListScanConsume;
+    op->op.reset = ListScanReset;
+    op->op.free = ListScanFree;
+    return (OpBase*)op;
+}
+
+Node* _named_node(long int id, const char *name) {
+    Node *n = NewNode(id, NULL);
+    char *keys[1] = {"name"};
+    SIValue vals[1] = {SI_StringVal((char*)name)};
+    Node_Add_Properties(n, 1, keys, vals);
+    return n;
+}
+
+Node* _valued_node(long int id, double v) {
+    Node *n = NewNode(id, NULL);
+    char *keys[1] = {"v"};
+    SIValue vals[1] = {SI_DoubleVal(v)};
+    Node_Add_Properties(n, 1, keys, vals);
+    return n;
+}
+
+void _connect(Node *src, Node *dest, const char *relationship) {
+    static long int edge_id = 100;
+    Node_ConnectNode(src, dest, NewEdge(edge_id++, src, dest, relationship));
+}
+
+/* Star pattern branches are aggregated without enumerating their cross product. */
+void test_expand_factorized() {
+    /* a1 -X-> b1, b2, b3, a1 -Y-> c1, c2
+     * a2 -X-> b1, a2 has no Y edges
+     * a3 -X-> b2, a3 -Y-> c1 */
+    Node *a[3] = {_named_node(1, "a1"), _named_node(2, "a2"), _named_node(3, "a3")};
+    Node *b[3] = {NewNode(4, NULL), NewNode(5, NULL), NewNode(6, NULL)};
+    Node *c[2] = {_valued_node(7, 1), _valued_node(8, 2)};
+    for(int i = 0; i < 3; i++) _connect(a[0], b[i], "X");
+    for(int i = 0; i < 2; i++) _connect(a[0], c[i], "Y");
+    _connect(a[1], b[0], "X");
+    _connect(a[2], b[1], "X");
+    _connect(a[2], c[0], "Y");
+
+    char *errMsg = NULL;
+    char *query = "MATCH (a)-[x:X]->(b), (a)-[y:Y]->(c) RETURN a.name, count(b), sum(c.v)";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    Graph *g = NewGraph();
+    BuildGraph(g, ast->matchNode->graphEntities);
+
+    Node **a_ref = (Node**)Graph_GetEntityRef(g, "a");
+    ExpandFactorized *x = (ExpandFactorized*)NewExpandFactorizedOp(a_ref, (Edge**)Graph_GetEntityRef(g, "x"),
+                                                                  (Node**)Graph_GetEntityRef(g, "b"), 0);
+    ExpandFactorized *y = (ExpandFactorized*)NewExpandFactorizedOp(a_ref, (Edge**)Graph_GetEntityRef(g, "y"),
+                                                                  (Node**)Graph_GetEntityRef(g, "c"), 0);
+    /* sum(c.v) reads c, count(b) doesn't read b. */
+    ExpandFactorized_Collect(y);
+
+    Aggregate *aggregate = NewAggregate(NULL, ast);
+    aggregate->branch_count = 2;
+    aggregate->branches = malloc(sizeof(ExpandFactorized*) * 2);
+    aggregate->branches[0] = y;
+    aggregate->branches[1] = x;
+    aggregate->agg_branches = malloc(sizeof(int) * 2);
+    aggregate->agg_branches[0] = -1;
+    aggregate->agg_branches[1] = 0;
+
+    OpNode *scan = NewOpNode(NewListScan(g, a, 3));
+    OpNode *x_node = NewOpNode((OpBase*)x);
+    OpNode *y_node = NewOpNode((OpBase*)y);
+    OpNode *root = NewOpNode((OpBase*)aggregate);
+    OpNode *chain[4] = {root, y_node, x_node, scan};
+    for(int i = 0; i < 3; i++) {
+        chain[i]->children = malloc(sizeof(OpNode*));
+        chain[i]->children[0] = chain[i + 1];
+        chain[i]->childCount = 1;
+        chain[i + 1]->parents = malloc(sizeof(OpNode*));
+        chain[i + 1]->parents[0] = chain[i];
+        chain[i + 1]->parentCount = 1;
+    }
+
+    ExecutionPlan plan = {.root = root, .graph = g};
+    ExecutionPlan_Execute(&plan);
+
+    /* Neighbors are restored once aggregated. */
+    assert(*(Node**)Graph_GetEntityRef(g, "c") == Graph_GetNodeByAlias(g, "c"));
+
+    ResultSetHeader *header = NewResultSet(ast)->header;
+    int groups = 0;
+    char *key;
+    Group *group;
+    CacheGroupIterator iter;
+    CacheGroupIter(&iter);
+    while(CacheGroupIterNext(&iter, &key, &group) != 0) {
+        Record *r = NewRecord(header->columns_len);
+        Record_FromGroup(r, header, group);
+        if(strcmp(r->values[0].stringval, "a1") == 0) {
+            assert(r->values[1].doubleval == 6);
+            assert(r->values[2].doubleval == 9);
+        } else {
+            /* a2 has no Y edges hence no match. */
+            assert(strcmp(r->values[0].stringval, "a3") == 0);
+            assert(r->values[1].doubleval == 1);
+            assert(r->values[2].doubleval == 1);
+        }
+        Record_Free(r);
+        groups++;
+    }
+    assert(groups == 2);
+}
+
+int main(int argc, char **argv) {
+    Agg_RegisterFuncs();
+    AR_RegisterFuncs();
+    InitGroupCache();
+    test_expand_factorized();
+    printf("test_expand_factorized - PASS!\n");
+    return 0;
+}
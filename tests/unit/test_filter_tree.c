@@ -4,6 +4,7 @@
 #include "../../src/rmutil/vector.h"
 #include "../../src/parser/grammar.h"
 #include "../../src/filter_tree/filter_tree.h"
+#include "../../src/query_executor.h"
 
 void compareFilterTreeVaryingNode(const FT_FilterNode *a, const FT_FilterNode *b) {
     assert(a->t == b->t);
@@ -42,7 +43,81 @@ void compareFilterTrees(const FT_FilterNode *a, const FT_FilterNode *b) {
     }
 }
 
+void test_id_filter() {
+    char *errMsg = NULL;
+    char *query = "MATCH (n) WHERE id(n) IN [1, 9223372036854775807] RETURN n";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+
+    /* IN list becomes a disjunction of id equalities. */
+    FT_FilterNode *tree = BuildFiltersTree(ast->whereNode->filters);
+    assert(tree->t == FT_N_COND && tree->cond.op == OR);
+    assert(tree->cond.left->pred.t == FT_N_ID);
+    assert(tree->cond.right->pred.constVal.longval == 9223372036854775807L);
+
+    Graph *g = NewGraph();
+    Node *n = NewNode(1, NULL);
+    Graph_AddNode(g, n, "n");
+    assert(applyFilters(g, tree) == FILTER_PASS);
+
+    n->id = 2;
+    assert(applyFilters(g, tree) == FILTER_FAIL);
+
+    n->id = 9223372036854775807L;
+    assert(applyFilters(g, tree) == FILTER_PASS);
+
+    FilterTree_Free(tree);
+
+    query = "MATCH (n) WHERE len(n) = 1 RETURN n";
+    assert(ParseQuery(query, strlen(query), &errMsg) == NULL);
+}
+
+void test_filter_reorder() {
+    char *errMsg = NULL;
+    char *query = "MATCH (n) WHERE n.age > 10 AND n.name = 'b' RETURN n";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    FT_FilterNode *tree = BuildFiltersTree(ast->whereNode->filters);
+    FT_FilterNode *age = tree->cond.left;
+    FT_FilterNode *name = tree->cond.right;
+
+    Graph *g = NewGraph();
+    Node *n = NewNode(1, NULL);
+    Graph_AddNode(g, n, "n");
+    char *keys[2] = {"age", "name"};
+    SIValue values[2] = {SI_DoubleVal(20), SI_StringVal("a")};
+    Node_Add_Properties(n, 2, keys, values);
+
+    /* Age always passes, name mostly fails, name should be evaluated first. */
+    for(int i = 0; i < 10; i++) assert(FilterTree_Apply(g, tree) == FILTER_FAIL);
+    assert(name->stats.evaluations == 10 && name->stats.passes == 0);
+    FilterTree_Reorder(tree);
+    assert(tree->cond.left == name && tree->cond.right == age);
+    assert(tree->stats.evaluations == 5);
+
+    /* Reordering doesn't change outcome. */
+    assert(FilterTree_Apply(g, tree) == FILTER_FAIL);
+    SIValue name_value = SI_StringVal("b");
+    GraphEntity_Update_Property((GraphEntity*)n, "name", &name_value);
+    assert(FilterTree_Apply(g, tree) == FILTER_PASS);
+
+    /* OR evaluates the child most likely to pass first. */
+    query = "MATCH (n) WHERE n.age < 10 OR n.name = 'b' RETURN n";
+    ast = ParseQuery(query, strlen(query), &errMsg);
+    FT_FilterNode *disjunction = BuildFiltersTree(ast->whereNode->filters);
+    name = disjunction->cond.right;
+    for(int i = 0; i < 10; i++) assert(FilterTree_Apply(g, disjunction) == FILTER_PASS);
+    FilterTree_Reorder(disjunction);
+    assert(disjunction->cond.left == name);
+    assert(FilterTree_Apply(g, disjunction) == FILTER_PASS);
+
+    FilterTree_Free(tree);
+    FilterTree_Free(disjunction);
+}
+
 int main(int argc, char **argv) {
+    test_id_filter();
+    test_filter_reorder();
 	printf("test_filter_tree - PASS!\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+#include "assert.h"
+#include "../../src/graph/node.h"
+#include "../../src/index/fulltext_index.h"
+
+Node* _new_product(long int id, char *name) {
+	Node *node = NewNode(id, "product");
+	char *keys[1] = {"name"};
+	SIValue vals[1] = {SI_StringVal(name)};
+	GraphEntity_Add_Properties((GraphEntity*)node, 1, keys, vals);
+	return node;
+}
+
+void test_tokenize() {
+	Vector *tokens = FullText_Tokenize("Red running-Shoes, size 42!");
+	const char *expected[5] = {"red", "running", "shoes", "size", "42"};
+
+	assert(Vector_Size(tokens) == 5);
+	for(int i = 0; i < 5; i++) {
+		char *token;
+		Vector_Get(tokens, i, &token);
+		assert(strcmp(token, expected[i]) == 0);
+		free(token);
+	}
+	Vector_Free(tokens);
+}
+
+void test_query() {
+	Node *nodes[4];
+	nodes[0] = _new_product(1, "Red running shoes");
+	nodes[1] = _new_product(2, "Blue running shirt");
+	nodes[2] = _new_product(3, "Shoe polish");
+	nodes[3] = _new_product(4, "Red red red hat");
+
+	FullTextIndex *idx = NewFullTextIndex("name");
+	for(int i = 0; i < 4; i++) FullTextIndex_Insert(idx, (GraphEntity*)nodes[i]);
+	assert(idx->doc_count == 4);
+
+	/* Exact term. */
+	FullTextResult *results;
+	size_t count = FullTextIndex_Query(idx, "running", &results);
+	assert(count == 2);
+	free(results);
+
+	/* All terms must match. */
+	count = FullTextIndex_Query(idx, "RUNNING shoes", &results);
+	assert(count == 1);
+	assert(results[0].entity->id == 1);
+	free(results);
+
+	/* Higher term frequency scores higher. */
+	count = FullTextIndex_Query(idx, "red", &results);
+	assert(count == 2);
+	assert(results[0].entity->id == 4);
+	assert(results[0].score > results[1].score);
+	free(results);
+
+	/* Prefix expansion. */
+	count = FullTextIndex_Query(idx, "sho*", &results);
+	assert(count == 2);
+	free(results);
+
+	/* Fuzzy expansion. */
+	count = FullTextIndex_Query(idx, "%shirts%", &results);
+	assert(count == 1);
+	assert(results[0].entity->id == 2);
+	free(results);
+
+	count = FullTextIndex_Query(idx, "%%shoos%%", &results);
+	assert(count == 2);
+	free(results);
+
+	count = FullTextIndex_Query(idx, "boots", &results);
+	assert(count == 0);
+
+	/* Removed entities are no longer reachable. */
+	FullTextIndex_Remove(idx, (GraphEntity*)nodes[0]);
+	assert(idx->doc_count == 3);
+	count = FullTextIndex_Query(idx, "running", &results);
+	assert(count == 1);
+	assert(results[0].entity->id == 2);
+	free(results);
+
+	FullTextIndex_Free(idx);
+	for(int i = 0; i < 4; i++) FreeNode(nodes[i]);
+}
+
+int main(int argc, char **argv) {
+	test_tokenize();
+	test_query();
+	printf("test_fulltext_index - PASS!\n");
+	return 0;
+}
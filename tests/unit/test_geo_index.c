@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <math.h>
+#include "assert.h"
+#include "../../src/graph/node.h"
+#include "../../src/index/geo_index.h"
+
+#define NODE_COUNT 5
+
+Node* _new_venue(long int id, double lat, double lon) {
+	Node *node = NewNode(id, "venue");
+	char *keys[2] = {"lat", "lon"};
+	SIValue values[2] = {SI_DoubleVal(lat), SI_DoubleVal(lon)};
+	GraphEntity_Add_Properties((GraphEntity*)node, 2, keys, values);
+	return node;
+}
+
+/* Counts entities within box, sums their ids. */
+int _scan(GeoIndex *idx, GeoBoundingBox box, long int *id_sum) {
+	int count = 0;
+	*id_sum = 0;
+	GeoIndexIterator iter;
+	GeoIndex_Scan(idx, box, &iter);
+	GraphEntity *e;
+	while((e = GeoIndexIterator_Next(&iter)) != NULL) {
+		*id_sum += e->id;
+		count++;
+	}
+	GeoIndexIterator_Free(&iter);
+	return count;
+}
+
+void test_distance() {
+	/* Paris to London, roughly 343km. */
+	double d = Geo_Distance(48.8566, 2.3522, 51.5074, -0.1278);
+	assert(fabs(d - 343500) < 1000);
+	assert(Geo_Distance(10, 10, 10, 10) == 0);
+
+	/* Radius box contains its circle. */
+	GeoBoundingBox box = Geo_RadiusBoundingBox(48.8566, 2.3522, 10000);
+	assert(Geo_Distance(48.8566, 2.3522, box.max_lat, 2.3522) >= 9999);
+	assert(Geo_Distance(48.8566, 2.3522, 48.8566, box.min_lon) >= 9999);
+
+	/* Box crossing the antimeridian spans every longitude. */
+	box = Geo_RadiusBoundingBox(0, 179.99, 10000);
+	assert(box.min_lon == -180 && box.max_lon == 180);
+}
+
+void test_geo_index() {
+	Node *nodes[NODE_COUNT];
+	nodes[0] = _new_venue(1, 48.8566, 2.3522);		/* Paris. */
+	nodes[1] = _new_venue(2, 48.8606, 2.3376);		/* Louvre. */
+	nodes[2] = _new_venue(3, 51.5074, -0.1278);		/* London. */
+	nodes[3] = _new_venue(4, -33.8688, 151.2093);	/* Sydney. */
+	nodes[4] = NewNode(5, "venue");					/* No location. */
+
+	GeoIndex *idx = NewGeoIndex("lat", "lon");
+	for(int i = 0; i < NODE_COUNT; i++) GeoIndex_Insert(idx, (GraphEntity*)nodes[i]);
+
+	long int id_sum;
+
+	/* Within 5km of Paris. */
+	GeoBoundingBox box = Geo_RadiusBoundingBox(48.8566, 2.3522, 5000);
+	assert(_scan(idx, box, &id_sum) == 2);
+	assert(id_sum == 3);
+
+	/* Western Europe. */
+	box = (GeoBoundingBox){.min_lat = 40, .min_lon = -5, .max_lat = 55, .max_lon = 10};
+	assert(_scan(idx, box, &id_sum) == 3);
+	assert(id_sum == 6);
+
+	/* Entire world. */
+	box = (GeoBoundingBox){.min_lat = -90, .min_lon = -180, .max_lat = 90, .max_lon = 180};
+	assert(_scan(idx, box, &id_sum) == 4);
+
+	/* Empty box. */
+	box = (GeoBoundingBox){.min_lat = 10, .min_lon = 0, .max_lat = 0, .max_lon = 10};
+	assert(_scan(idx, box, &id_sum) == 0);
+
+	/* Removal. */
+	GeoIndex_Remove(idx, (GraphEntity*)nodes[1]);
+	box = Geo_RadiusBoundingBox(48.8566, 2.3522, 5000);
+	assert(_scan(idx, box, &id_sum) == 1);
+	assert(id_sum == 1);
+
+	GeoIndex_Free(idx);
+	for(int i = 0; i < NODE_COUNT; i++) FreeNode(nodes[i]);
+}
+
+int main(int argc, char **argv) {
+	test_distance();
+	test_geo_index();
+	printf("test_geo_index - PASS!\n");
+	return 0;
+}
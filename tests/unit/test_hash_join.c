@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include "assert.h"
+#include "../../src/graph/graph.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_hash_join.h"
+
+/* Scan binding a pair of nodes from a fixed list of id pairs. */
+typedef struct {
+	OpBase op;
+	Node **first;
+	Node **second;
+	Node *_first;
+	Node *_second;
+	Node **nodes;		/* Nodes to bind, pairs. */
+	int count;			/* Number of pairs. */
+	int position;
+} PairScan;
+
+OpResult PairScanConsume(OpBase *opBase, Graph *graph) {
+	PairScan *op = (PairScan*)opBase;
+	if(op->position == op->count) return OP_DEPLETED;
+	*op->first = op->nodes[op->position * 2];
+	*op->second = op->nodes[op->position * 2 + 1];
+	op->position++;
+	return OP_OK;
+}
+
+OpResult PairScanReset(OpBase *opBase) {
+	PairScan *op = (PairScan*)opBase;
+	op->position = 0;
+	*op->first = op->_first;
+	*op->second = op->_second;
+	return OP_OK;
+}
+
+void PairScanFree(OpBase *opBase) {
+	PairScan *op = (PairScan*)opBase;
+	for(int i = 0; i < op->count * 2; i++) FreeNode(op->nodes[i]);
+	free(op->nodes);
+	Vector_Free(op->op.modifies);
+	free(op);
+}
+
+OpBase* NewPairScan(Graph *g, char *first, char *second, long int *ids, int count) {
+	PairScan *op = calloc(1, sizeof(PairScan));
+	op->first = (Node**)Graph_GetEntityRef(g, first);
+	op->second = (Node**)Graph_GetEntityRef(g, second);
+	op->_first = *op->first;
+	op->_second = *op->second;
+	op->count = count;
+	op->nodes = malloc(sizeof(Node*) * count * 2);
+	for(int i = 0; i < count * 2; i++) op->nodes[i] = NewNode(ids[i], NULL);
+
+	op->op.name = "Pair Scan";
+	op->op.consume = PairScanConsume;
+	op->op.reset = PairScanReset;
+	op->op.free = PairScanFree;
+	op->op.modifies = NewVector(char*, 2);
+	Vector_Push(op->op.modifies, first);
+	Vector_Push(op->op.modifies, second);
+	return (OpBase*)op;
+}
+
+void test_hash_join() {
+	Graph *g = NewGraph();
+	Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "a");
+	Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "b");
+	Graph_AddNode(g, NewNode(INVALID_ENTITY_ID, NULL), "x");
+
+	/* (a, x) pairs. */
+	long int probe_ids[] = {1, 100,
+							2, 200,
+							3, 100,
+							4, 300};
+	/* (b, x) pairs. */
+	long int build_ids[] = {10, 100,
+							20, 100,
+							30, 200,
+							40, 400};
+
+	OpNode *probe = NewOpNode(NewPairScan(g, "a", "x", probe_ids, 4));
+	OpNode *build = NewOpNode(NewPairScan(g, "b", "x", build_ids, 4));
+	OpNode *join = NewOpNode(NewHashJoinOp(g, build, (Node**)Graph_GetEntityRef(g, "x")));
+	/* Children are wired the way the planner does, build stream last. */
+	join->children = malloc(sizeof(OpNode*) * 2);
+	join->children[0] = probe;
+	join->children[1] = build;
+	join->childCount = 2;
+
+	/* Expected a, b, x triplets, in probe order. */
+	long int expected[][3] = {{1, 10, 100}, {1, 20, 100}, {2, 30, 200}, {3, 10, 100}, {3, 20, 100}};
+	int count = 0;
+	while(OpNode_Consume(join, g) == OP_OK) {
+		assert(count < 5);
+		assert(Graph_GetNodeByAlias(g, "a")->id == expected[count][0]);
+		assert(Graph_GetNodeByAlias(g, "b")->id == expected[count][1]);
+		assert(Graph_GetNodeByAlias(g, "x")->id == expected[count][2]);
+		count++;
+	}
+	assert(count == 5);
+
+	/* Join can be consumed again once reset. */
+	join->operation->reset(join->operation);
+	probe->operation->reset(probe->operation);
+	count = 0;
+	while(OpNode_Consume(join, g) == OP_OK) count++;
+	assert(count == 5);
+
+	join->operation->free(join->operation);
+	probe->operation->free(probe->operation);
+	build->operation->free(build->operation);
+	free(join->children);
+	free(join);
+	free(probe);
+	free(build);
+}
+
+int main(int argc, char **argv) {
+	test_hash_join();
+	printf("test_hash_join - PASS!\n");
+	return 0;
+}
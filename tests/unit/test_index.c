@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "assert.h"
+#include "../../src/graph/node.h"
+#include "../../src/graph/edge.h"
+#include "../../src/index/index.h"
+#include "../../src/index/index_builder.h"
+
+#define NODE_COUNT 6
+
+Node* _new_host(long int id, SIValue value) {
+	Node *node = NewNode(id, "host");
+	char *keys[1] = {"v"};
+	GraphEntity_Add_Properties((GraphEntity*)node, 1, keys, &value);
+	return node;
+}
+
+/* Counts entities visited by iterator, verifies ids are visited in order. */
+int _consume(IndexIterator *iter, const long int *expected_ids) {
+	int count = 0;
+	GraphEntity *e;
+	while((e = IndexIterator_Next(iter)) != NULL) {
+		if(expected_ids) assert(e->id == expected_ids[count]);
+		count++;
+	}
+	IndexIterator_Free(iter);
+	return count;
+}
+
+void test_index() {
+	Node *nodes[NODE_COUNT];
+	nodes[0] = _new_host(1, SI_StringVal("web-01"));
+	nodes[1] = _new_host(2, SI_StringVal("web-02"));
+	nodes[2] = _new_host(3, SI_StringVal("web"));
+	nodes[3] = _new_host(4, SI_StringVal("db-01"));
+	nodes[4] = _new_host(5, SI_DoubleVal(-2.5));
+	nodes[5] = _new_host(6, SI_DoubleVal(10));
+
+	Index *idx = NewIndex("v");
+	for(int i = 0; i < NODE_COUNT; i++) Index_Insert(idx, (GraphEntity*)nodes[i]);
+	assert(Index_Cardinality(idx) == NODE_COUNT);
+
+	IndexIterator iter;
+
+	/* Prefix scan, shorter strings come first. */
+	long int web_ids[3] = {3, 1, 2};
+	Index_ScanPrefix(idx, "web", &iter);
+	assert(_consume(&iter, web_ids) == 3);
+
+	Index_ScanPrefix(idx, "WEB", &iter);
+	assert(_consume(&iter, NULL) == 0);
+
+	Index_ScanPrefix(idx, "", &iter);
+	assert(_consume(&iter, NULL) == 4);
+
+	/* Numeric ranges, negative values precede positive ones. */
+	SIValue min = SI_DoubleVal(-3);
+	SIValue max = SI_DoubleVal(10);
+	long int numeric_ids[2] = {5, 6};
+	Index_ScanRange(idx, &min, 1, &max, 1, &iter);
+	assert(_consume(&iter, numeric_ids) == 2);
+
+	Index_ScanRange(idx, &min, 1, &max, 0, &iter);
+	assert(_consume(&iter, numeric_ids) == 1);
+
+	Index_ScanRange(idx, &max, 0, NULL, 0, &iter);
+	assert(_consume(&iter, NULL) == 0);
+
+	Index_ScanRange(idx, NULL, 0, &max, 1, &iter);
+	assert(_consume(&iter, numeric_ids) == 2);
+
+	/* Equality. */
+	SIValue ten = SI_IntVal(10);
+	Index_ScanRange(idx, &ten, 1, &ten, 1, &iter);
+	assert(_consume(&iter, &numeric_ids[1]) == 1);
+
+	/* String range. */
+	SIValue from = SI_StringVal("db");
+	SIValue to = SI_StringVal("web");
+	long int string_ids[2] = {4, 3};
+	Index_ScanRange(idx, &from, 1, &to, 1, &iter);
+	assert(_consume(&iter, string_ids) == 2);
+
+	/* Removal. */
+	Index_Remove(idx, (GraphEntity*)nodes[2]);
+	Index_ScanPrefix(idx, "web", &iter);
+	assert(_consume(&iter, &web_ids[1]) == 2);
+
+	Index_Free(idx);
+	for(int i = 0; i < NODE_COUNT; i++) FreeNode(nodes[i]);
+}
+
+void test_index_reverse() {
+	Node *nodes[5];
+	Index *idx = NewIndex("v");
+	for(int i = 0; i < 5; i++) {
+		nodes[i] = _new_host(i + 1, SI_DoubleVal(i * 10));
+		Index_Insert(idx, (GraphEntity*)nodes[i]);
+	}
+	assert(!Index_ContainsStrings(idx));
+
+	IndexIterator iter;
+
+	/* Unbounded scans cover every numeric value. */
+	long int asc_ids[5] = {1, 2, 3, 4, 5};
+	Index_ScanRange(idx, NULL, 0, NULL, 0, &iter);
+	assert(_consume(&iter, asc_ids) == 5);
+
+	long int desc_ids[5] = {5, 4, 3, 2, 1};
+	Index_ScanRangeReverse(idx, NULL, 0, NULL, 0, &iter);
+	assert(_consume(&iter, desc_ids) == 5);
+
+	SIValue min = SI_DoubleVal(10);
+	SIValue max = SI_DoubleVal(30);
+	Index_ScanRangeReverse(idx, &min, 1, &max, 1, &iter);
+	assert(_consume(&iter, &desc_ids[1]) == 3);
+
+	Index_ScanRangeReverse(idx, &min, 0, &max, 0, &iter);
+	assert(_consume(&iter, &desc_ids[2]) == 1);
+
+	Index_ScanRangeReverse(idx, NULL, 0, &max, 0, &iter);
+	assert(_consume(&iter, &desc_ids[2]) == 3);
+
+	Index_ScanRangeReverse(idx, &max, 0, NULL, 0, &iter);
+	assert(_consume(&iter, desc_ids) == 1);
+
+	Node *named = _new_host(6, SI_StringVal("web"));
+	Index_Insert(idx, (GraphEntity*)named);
+	assert(Index_ContainsStrings(idx));
+
+	/* Strings follow numbers, numeric scans skip them. */
+	Index_ScanRangeReverse(idx, NULL, 0, NULL, 0, &iter);
+	assert(_consume(&iter, desc_ids) == 5);
+
+	Index_Free(idx);
+	for(int i = 0; i < 5; i++) FreeNode(nodes[i]);
+	FreeNode(named);
+}
+
+Edge* _new_payment(long int id, Node *src, Node *dest, double ts) {
+	Edge *edge = NewEdge(id, src, dest, "paid");
+	char *keys[1] = {"ts"};
+	SIValue value = SI_DoubleVal(ts);
+	Edge_Add_Properties(edge, 1, keys, &value);
+	return edge;
+}
+
+void test_edge_index() {
+	Node *a = NewNode(1, "account");
+	Node *b = NewNode(2, "account");
+	Edge *edges[4];
+	edges[0] = _new_payment(10, a, b, 100);
+	edges[1] = _new_payment(11, a, b, 300);
+	edges[2] = _new_payment(12, b, a, 200);
+	edges[3] = _new_payment(13, a, b, 200);
+
+	Index *idx = NewEdgeIndex("ts");
+	for(int i = 0; i < 4; i++) Index_Insert(idx, (GraphEntity*)edges[i]);
+
+	IndexIterator iter;
+	SIValue min = SI_DoubleVal(150);
+
+	/* Globally ordered. */
+	long int global_ids[3] = {12, 13, 11};
+	Index_ScanRange(idx, &min, 0, NULL, 0, &iter);
+	assert(_consume(&iter, global_ids) == 3);
+
+	/* Per source node. */
+	long int a_ids[2] = {13, 11};
+	Index_ScanSourceRange(idx, a->id, &min, 0, NULL, 0, &iter);
+	assert(_consume(&iter, a_ids) == 2);
+
+	long int b_ids[1] = {12};
+	Index_ScanSourceRange(idx, b->id, &min, 0, NULL, 0, &iter);
+	assert(_consume(&iter, b_ids) == 1);
+
+	long int early_ids[1] = {10};
+	SIValue max = SI_DoubleVal(200);
+	Index_ScanSourceRange(idx, a->id, NULL, 0, &max, 0, &iter);
+	assert(_consume(&iter, early_ids) == 1);
+
+	/* Removal. */
+	Index_Remove(idx, (GraphEntity*)edges[3]);
+	Index_ScanSourceRange(idx, a->id, &min, 0, NULL, 0, &iter);
+	assert(_consume(&iter, &a_ids[1]) == 1);
+
+	Index_Free(idx);
+}
+
+void test_index_build() {
+	/* Enough entities to span multiple build batches. */
+	int count = INDEX_BUILDER_BATCH_SIZE * 2 + 10;
+	Node **nodes = malloc(sizeof(Node*) * (count + 1));
+	rax *items = raxNew();
+	char id[32];
+	for(int i = 0; i < count; i++) {
+		nodes[i] = _new_host(i, SI_DoubleVal(i));
+		int len = sprintf(id, "%d", i);
+		raxInsert(items, (unsigned char *)id, len, nodes[i], NULL);
+	}
+
+	Index *idx = NewIndex("v");
+	IndexBuilder_AcquireWriteLock();
+	IndexBuilder_Start(idx, items);
+	assert(!Index_IsReady(idx));
+
+	/* Writes performed during build are logged and applied at the end. */
+	Index_Remove(idx, (GraphEntity*)nodes[0]);
+	SIValue v = SI_DoubleVal(-1);
+	GraphEntity_Update_Property((GraphEntity*)nodes[0], "v", &v);
+	Index_Insert(idx, (GraphEntity*)nodes[0]);
+
+	nodes[count] = _new_host(count, SI_DoubleVal(count));
+	int len = sprintf(id, "%d", count);
+	raxInsert(items, (unsigned char *)id, len, nodes[count], NULL);
+	Index_Insert(idx, (GraphEntity*)nodes[count]);
+	IndexBuilder_ReleaseWriteLock();
+
+	while(!Index_IsReady(idx)) usleep(1000);
+	assert(idx->build_done >= idx->build_total);
+	assert(Index_Cardinality(idx) == count + 1);
+
+	IndexIterator iter;
+	SIValue zero = SI_DoubleVal(0);
+	Index_ScanRange(idx, NULL, 0, &zero, 1, &iter);
+	long int first_ids[1] = {0};
+	assert(_consume(&iter, first_ids) == 1);
+
+	SIValue last = SI_DoubleVal(count);
+	Index_ScanRange(idx, &last, 1, &last, 1, &iter);
+	long int last_ids[1] = {count};
+	assert(_consume(&iter, last_ids) == 1);
+
+	Index_Free(idx);
+	raxFree(items);
+	for(int i = 0; i <= count; i++) FreeNode(nodes[i]);
+	free(nodes);
+}
+
+int main(int argc, char **argv) {
+	test_index();
+	test_index_reverse();
+	test_edge_index();
+	test_index_build();
+	printf("test_index - PASS!\n");
+	return 0;
+}
@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include "assert.h"
+#include "../../src/graph/graph.h"
+#include "../../src/hexastore/hexastore.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_leapfrog_join.h"
+
+#define MAX_WIDTH 4
+
+/* Scan binding a tuple of nodes from a fixed list of tuples. */
+typedef struct {
+	OpBase op;
+	Node **refs[MAX_WIDTH];
+	Node *originals[MAX_WIDTH];
+	int width;			/* Number of nodes per tuple. */
+	Node **nodes;		/* Nodes to bind, tuples. */
+	int count;			/* Number of tuples. */
+	int position;
+} TupleScan;
+
+OpResult TupleScanConsume(OpBase *opBase, Graph *graph) {
+	TupleScan *op = (TupleScan*)opBase;
+	if(op->position == op->count) return OP_DEPLETED;
+	for(int i = 0; i < op->width; i++) *op->refs[i] = op->nodes[op->position * op->width + i];
+	op->position++;
+	return OP_OK;
+}
+
+OpResult TupleScanReset(OpBase *opBase) {
+	TupleScan *op = (TupleScan*)opBase;
+	op->position = 0;
+	for(int i = 0; i < op->width; i++) *op->refs[i] = op->originals[i];
+	return OP_OK;
+}
+
+void TupleScanFree(OpBase *opBase) {
+	TupleScan *op = (TupleScan*)opBase;
+	Vector_Free(op->op.modifies);
+	free(op);
+}
+
+OpBase* NewTupleScan(Graph *g, char **aliases, int width, Node **nodes, int count) {
+	TupleScan *op = calloc(1, sizeof(TupleScan));
+	op->width = width;
+	op->nodes = nodes;
+	op->count = count;
+	op->op.modifies = NewVector(char*, width);
+	for(int i = 0; i < width; i++) {
+		op->refs[i] = (Node**)Graph_GetEntityRef(g, aliases[i]);
+		op->originals[i] = *op->refs[i];
+		Vector_Push(op->op.modifies, aliases[i]);
+	}
+
+	op->op.name = "Tuple Scan";
+	op->op.consume = TupleScanConsume;
+	op->op.reset = TupleScanReset;
+	op->op.free = TupleScanFree;
+	return (OpBase*)op;
+}
+
+/* Data graph, nodes by id, every edge stored in the hexastore. */
+Node *nodes[16];
+HexaStore *hexastore;
+long int edge_id = 0;
+
+Edge* Connect(long int src, long int dest, const char *relationship) {
+	Edge *e = NewEdge(edge_id++, nodes[src], nodes[dest], relationship);
+	HexaStore_InsertAllPerm(hexastore, NewTriplet(nodes[src], e, nodes[dest]));
+	return e;
+}
+
+void BuildDataGraph() {
+	hexastore = _NewHexaStore();
+	for(int i = 0; i < 16; i++) nodes[i] = NewNode(i, (i < 12) ? "person" : "city");
+
+	/* Triangles 1, 2, 3 and 1, 2, 4. */
+	Connect(1, 2, "knows");
+	Connect(2, 3, "knows");
+	Connect(1, 3, "knows");
+	Connect(2, 4, "knows");
+	Connect(1, 4, "knows");
+	/* Wrong relationship type closes 1, 2, 5. */
+	Connect(2, 5, "knows");
+	Connect(1, 5, "likes");
+	/* Parallel edges close 6, 7, 8 twice. */
+	Connect(6, 7, "knows");
+	Connect(7, 8, "knows");
+	Connect(7, 8, "knows");
+	Connect(6, 8, "knows");
+	/* Self loop closes 9, 9, 9. */
+	Connect(9, 9, "knows");
+	/* 4-cycle 1, 2, 3, 10 with chord 1, 3. */
+	Connect(3, 10, "knows");
+	Connect(1, 10, "knows");
+	/* Labeled city 12 closes 1, 2, 12. */
+	Connect(2, 12, "knows");
+	Connect(1, 12, "knows");
+}
+
+/* Joins (a)-[:knows]->(b)-[:knows]->(c), (a)-[:knows]->(c) on c,
+ * given (a, b) pairs, each pair a match of (a)-[:knows]->(b). */
+void test_triangle() {
+	Graph *g = NewGraph();
+	Node *a = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *b = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *c = NewNode(INVALID_ENTITY_ID, "person");
+	Graph_AddNode(g, a, "a");
+	Graph_AddNode(g, b, "b");
+	Graph_AddNode(g, c, "c");
+	Edge *bc = NewEdge(INVALID_ENTITY_ID, b, c, "knows");
+	Edge *ac = NewEdge(INVALID_ENTITY_ID, a, c, "knows");
+	Graph_ConnectNodes(g, b, c, bc, "bc");
+	Graph_ConnectNodes(g, a, c, ac, "ac");
+
+	char *aliases[] = {"a", "b"};
+	Node *pairs[] = {nodes[1], nodes[2],
+					 nodes[6], nodes[7],
+					 nodes[9], nodes[9],
+					 nodes[2], nodes[3]};
+	OpNode *scan = NewOpNode(NewTupleScan(g, aliases, 2, pairs, 4));
+	Edge **edges[] = {Graph_GetEdgeRef(g, bc), Graph_GetEdgeRef(g, ac)};
+	OpNode *join = NewOpNode((OpBase*)NewLeapfrogJoin(hexastore, g, Graph_GetNodeRef(g, c), edges, 2));
+	join->children = malloc(sizeof(OpNode*));
+	join->children[0] = scan;
+	join->childCount = 1;
+
+	/* Expected a, b, c triplets, candidates in id order.
+	 * 5 is reached by a likes edge, 12 isn't a person,
+	 * 8 is reached by either of the parallel edges. */
+	long int expected[][3] = {{1, 2, 3}, {1, 2, 4}, {6, 7, 8}, {6, 7, 8}, {9, 9, 9}};
+	long int parallel[2];
+	int count = 0;
+	while(OpNode_Consume(join, g) == OP_OK) {
+		assert(count < 5);
+		assert(Graph_GetNodeByAlias(g, "a")->id == expected[count][0]);
+		assert(Graph_GetNodeByAlias(g, "b")->id == expected[count][1]);
+		assert(Graph_GetNodeByAlias(g, "c")->id == expected[count][2]);
+		Edge *bound_bc = Graph_GetEdgeByAlias(g, "bc");
+		Edge *bound_ac = Graph_GetEdgeByAlias(g, "ac");
+		assert(bound_bc->src->id == expected[count][1] && bound_bc->dest->id == expected[count][2]);
+		assert(bound_ac->src->id == expected[count][0] && bound_ac->dest->id == expected[count][2]);
+		if(expected[count][0] == 6) parallel[count - 2] = bound_bc->id;
+		count++;
+	}
+	assert(count == 5);
+	/* Each parallel edge is bound once. */
+	assert(parallel[0] != parallel[1]);
+
+	/* Join can be consumed again once reset. */
+	join->operation->reset(join->operation);
+	scan->operation->reset(scan->operation);
+	count = 0;
+	while(OpNode_Consume(join, g) == OP_OK) count++;
+	assert(count == 5);
+
+	join->operation->free(join->operation);
+	scan->operation->free(scan->operation);
+	free(join->children);
+	free(join);
+	free(scan);
+}
+
+/* Joins the 4-cycle (a)->(b)->(c)->(d), (a)->(d) with chord (a)->(c),
+ * given (a, c) pairs matching the chord, b is joined on a and c, d is then joined on c and a. */
+void test_chorded_cycle() {
+	Graph *g = NewGraph();
+	Node *a = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *b = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *c = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *d = NewNode(INVALID_ENTITY_ID, NULL);
+	Graph_AddNode(g, a, "a");
+	Graph_AddNode(g, b, "b");
+	Graph_AddNode(g, c, "c");
+	Graph_AddNode(g, d, "d");
+	Edge *ab = NewEdge(INVALID_ENTITY_ID, a, b, "knows");
+	Edge *bc = NewEdge(INVALID_ENTITY_ID, b, c, "knows");
+	Edge *cd = NewEdge(INVALID_ENTITY_ID, c, d, "knows");
+	Edge *ad = NewEdge(INVALID_ENTITY_ID, a, d, "knows");
+	Graph_ConnectNodes(g, a, b, ab, "ab");
+	Graph_ConnectNodes(g, b, c, bc, "bc");
+	Graph_ConnectNodes(g, c, d, cd, "cd");
+	Graph_ConnectNodes(g, a, d, ad, "ad");
+
+	char *aliases[] = {"a", "c"};
+	Node *pairs[] = {nodes[1], nodes[3],
+					 nodes[1], nodes[4],
+					 nodes[2], nodes[3]};
+	OpNode *scan = NewOpNode(NewTupleScan(g, aliases, 2, pairs, 3));
+	Edge **b_edges[] = {Graph_GetEdgeRef(g, ab), Graph_GetEdgeRef(g, bc)};
+	OpNode *join_b = NewOpNode((OpBase*)NewLeapfrogJoin(hexastore, g, Graph_GetNodeRef(g, b), b_edges, 2));
+	Edge **d_edges[] = {Graph_GetEdgeRef(g, cd), Graph_GetEdgeRef(g, ad)};
+	OpNode *join_d = NewOpNode((OpBase*)NewLeapfrogJoin(hexastore, g, Graph_GetNodeRef(g, d), d_edges, 2));
+	join_b->children = malloc(sizeof(OpNode*));
+	join_b->children[0] = scan;
+	join_b->childCount = 1;
+	join_d->children = malloc(sizeof(OpNode*));
+	join_d->children[0] = join_b;
+	join_d->childCount = 1;
+
+	/* (1, 4) has no d, 4 has no outgoing edges, (2, 3) has no b. */
+	int count = 0;
+	while(OpNode_Consume(join_d, g) == OP_OK) {
+		assert(Graph_GetNodeByAlias(g, "a")->id == 1);
+		assert(Graph_GetNodeByAlias(g, "b")->id == 2);
+		assert(Graph_GetNodeByAlias(g, "c")->id == 3);
+		assert(Graph_GetNodeByAlias(g, "d")->id == 10);
+		count++;
+	}
+	assert(count == 1);
+
+	join_d->operation->free(join_d->operation);
+	join_b->operation->free(join_b->operation);
+	scan->operation->free(scan->operation);
+	free(join_d->children);
+	free(join_b->children);
+	free(join_d);
+	free(join_b);
+	free(scan);
+}
+
+/* Joins (a)->(c)<-(b) where the scan also binds x, a node of an acyclic branch hanging off a,
+ * records of the branch are carried through the join. */
+void test_cycle_with_branch() {
+	Graph *g = NewGraph();
+	Node *a = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *b = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *c = NewNode(INVALID_ENTITY_ID, NULL);
+	Node *x = NewNode(INVALID_ENTITY_ID, NULL);
+	Graph_AddNode(g, a, "a");
+	Graph_AddNode(g, b, "b");
+	Graph_AddNode(g, c, "c");
+	Graph_AddNode(g, x, "x");
+	Edge *ac = NewEdge(INVALID_ENTITY_ID, a, c, "knows");
+	Edge *bc = NewEdge(INVALID_ENTITY_ID, b, c, "knows");
+	Graph_ConnectNodes(g, a, c, ac, "ac");
+	Graph_ConnectNodes(g, b, c, bc, "bc");
+
+	char *aliases[] = {"a", "b", "x"};
+	Node *tuples[] = {nodes[1], nodes[2], nodes[13],
+					  nodes[1], nodes[2], nodes[14],
+					  nodes[6], nodes[7], nodes[15]};
+	OpNode *scan = NewOpNode(NewTupleScan(g, aliases, 3, tuples, 3));
+	Edge **edges[] = {Graph_GetEdgeRef(g, ac), Graph_GetEdgeRef(g, bc)};
+	OpNode *join = NewOpNode((OpBase*)NewLeapfrogJoin(hexastore, g, Graph_GetNodeRef(g, c), edges, 2));
+	join->children = malloc(sizeof(OpNode*));
+	join->children[0] = scan;
+	join->childCount = 1;
+
+	/* Expected x, c pairs, candidates in id token order, 1 and 2 share 12, 3 and 4,
+	 * 5 is reached by a likes edge, 6 and 7 share 8 twice. */
+	long int expected[][2] = {{13, 12}, {13, 3}, {13, 4},
+							  {14, 12}, {14, 3}, {14, 4},
+							  {15, 8}, {15, 8}};
+	int count = 0;
+	while(OpNode_Consume(join, g) == OP_OK) {
+		assert(count < 8);
+		assert(Graph_GetNodeByAlias(g, "x")->id == expected[count][0]);
+		assert(Graph_GetNodeByAlias(g, "c")->id == expected[count][1]);
+		count++;
+	}
+	assert(count == 8);
+
+	join->operation->free(join->operation);
+	scan->operation->free(scan->operation);
+	free(join->children);
+	free(join);
+	free(scan);
+}
+
+int main(int argc, char **argv) {
+	BuildDataGraph();
+	test_triangle();
+	test_chorded_cycle();
+	test_cycle_with_branch();
+	printf("test_leapfrog_join - PASS!\n");
+	return 0;
+}
@@ -52,10 +52,45 @@ void test_node_edges() {
 	FreeEdge(edge);
 }
 
+void test_node_degree() {
+	Node *src = NewNode(1l, "city");
+	Node *dest = NewNode(2l, "city");
+	Edge *roads[3];
+	for(int i = 0; i < 3; i++) {
+		roads[i] = NewEdge(3l + i, src, dest, "road");
+		Node_ConnectNode(src, dest, roads[i]);
+	}
+	Edge *flight = NewEdge(6l, dest, src, "flight");
+	Node_ConnectNode(dest, src, flight);
+
+	assert(Node_OutDegree(src, "road") == 3);
+	assert(Node_InDegree(dest, "road") == 3);
+	assert(Node_InDegree(src, "road") == 0);
+	assert(Node_OutDegree(dest, "flight") == 1);
+	assert(Node_InDegree(src, "flight") == 1);
+	assert(Node_OutDegree(src, "rail") == 0);
+
+	/* Any relationship type. */
+	assert(Node_OutDegree(src, NULL) == 3);
+	assert(Node_InDegree(src, NULL) == 1);
+
+	/* Removing an edge. */
+	Node_UpdateDegree(src, "road", -1, 0);
+	Node_UpdateDegree(dest, "road", 0, -1);
+	assert(Node_OutDegree(src, "road") == 2);
+	assert(Node_InDegree(dest, "road") == 2);
+
+	FreeNode(src);
+	FreeNode(dest);
+	for(int i = 0; i < 3; i++) FreeEdge(roads[i]);
+	FreeEdge(flight);
+}
+
 int main(int argc, char **argv) {
 	test_node_creation();
     test_node_props();
 	test_node_edges();
+	test_node_degree();
 	printf("test_node - PASS!\n");
     return 0;
 }
\ No newline at end of file
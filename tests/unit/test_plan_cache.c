@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <string.h>
+#include "assert.h"
+#include "../../src/plan_cache.h"
+#include "../../src/query_executor.h"
+
+/* Normalizes query and validates the normalized text parses. */
+void _normalize(const char *query, NormalizedQuery *nq, const char *expected) {
+    PlanCache_Normalize(query, nq);
+    assert(strcmp(nq->text, expected) == 0);
+
+    char *errMsg = NULL;
+    AST_QueryExpressionNode *ast = ParseQuery(nq->text, sdslen(nq->text), &errMsg);
+    assert(ast != NULL);
+    Free_AST_QueryExpressionNode(ast);
+}
+
+void test_normalize() {
+    NormalizedQuery nq;
+
+    /* Literals are lifted, numbers as doubles. */
+    _normalize("MATCH (a:person {name: 'Roi'}) WHERE a.age > 30 AND a.w < -1.5 RETURN a.name",
+               &nq, "MATCH ( a : person { name : $__p0 } ) WHERE a . age > $__p1 AND a . w < $__p2 RETURN a . name");
+    assert(nq.count == 3);
+    assert(strcmp(nq.names[0], "__p0") == 0 && strcmp(nq.names[2], "__p2") == 0);
+    assert(nq.values[0].type == T_STRING && strcmp(nq.values[0].stringval, "Roi") == 0);
+    assert(nq.values[1].type == T_DOUBLE && nq.values[1].doubleval == 30);
+    assert(nq.values[2].type == T_DOUBLE && nq.values[2].doubleval == -1.5);
+
+    /* Queries differing only by their literals normalize alike. */
+    NormalizedQuery other;
+    PlanCache_Normalize("MATCH (a:person {name:\"Ailon\"}) WHERE a.age > 7 AND a.w < 2 RETURN a.name", &other);
+    assert(strcmp(nq.text, other.text) == 0);
+    NormalizedQuery_Free(&nq);
+    NormalizedQuery_Free(&other);
+
+    /* Subtraction isn't a negative literal. */
+    _normalize("MATCH (a) RETURN a.v - 2", &nq, "MATCH ( a ) RETURN a . v - $__p0");
+    assert(nq.count == 1 && nq.values[0].doubleval == 2);
+    NormalizedQuery_Free(&nq);
+
+    /* Literals shaping the query stay in place. */
+    _normalize("MATCH (a) WHERE id(a) = 3 AND a.name STARTS WITH 'R' RETURN a SKIP 1 LIMIT 10",
+               &nq, "MATCH ( a ) WHERE id ( a ) = 3 AND a . name STARTS WITH 'R' RETURN a SKIP 1 LIMIT 10");
+    assert(nq.count == 0);
+    NormalizedQuery_Free(&nq);
+
+    _normalize("MATCH (a) WHERE id(a) IN [1, 2] RETURN a",
+               &nq, "MATCH ( a ) WHERE id ( a ) IN [ 1 , 2 ] RETURN a");
+    assert(nq.count == 0);
+    NormalizedQuery_Free(&nq);
+
+    _normalize("MATCH (a) WHERE distance(a.lat, a.lon, 32.1, -34.8) < 1000 AND a.v = 1 RETURN a",
+               &nq, "MATCH ( a ) WHERE distance ( a . lat , a . lon , 32.1 , - 34.8 ) < 1000 AND a . v = $__p0 RETURN a");
+    assert(nq.count == 1);
+    NormalizedQuery_Free(&nq);
+
+    /* Procedure calls are left as is. */
+    PlanCache_Normalize("CALL db.idx.fulltext.queryNodes('person', 'name', 'roi')", &nq);
+    assert(nq.count == 0);
+    NormalizedQuery_Free(&nq);
+
+    /* Lifted literals don't alias reserved parameters. */
+    assert(PlanCache_ReservedParam("__p0") && PlanCache_ReservedParam("__param"));
+    assert(!PlanCache_ReservedParam("p0") && !PlanCache_ReservedParam("_p0"));
+    _normalize("MATCH (a) WHERE a.v = $__p0 AND a.w = 3 RETURN a",
+               &nq, "MATCH ( a ) WHERE a . v = $__p0 AND a . w = 3 RETURN a");
+    assert(nq.count == 0);
+    NormalizedQuery_Free(&nq);
+}
+
+AST_QueryExpressionNode* _parse(const char *query) {
+    char *errMsg = NULL;
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    return ast;
+}
+
+void test_plan_cache() {
+    PlanCache *cache = NewPlanCache("g", 2);
+    char *q0 = "MATCH ( a ) WHERE a . v = $__p0 RETURN a";
+    char *q1 = "MATCH ( a ) RETURN a . v + $__p0";
+    char *q2 = "MATCH ( a ) RETURN a";
+
+    assert(PlanCache_Lookup(cache, q0) == NULL);
+    PlanCacheEntry *e0 = PlanCache_Insert(cache, q0, _parse(q0));
+    assert(Vector_Size(e0->params) == 1);
+    assert(PlanCache_Lookup(cache, q0) == e0);
+    assert(cache->hits == 1 && cache->misses == 1);
+
+    /* Entries are reused with different bindings. */
+    char *names[1] = {"__p0"};
+    SIValue values[1] = {SI_DoubleVal(5)};
+    char *reason = NULL;
+    assert(AST_BindParams(e0->params, names, values, 1, &reason) == AST_VALID);
+    assert(e0->ast->whereNode->filters->pn.constVal.doubleval == 5);
+    values[0] = SI_StringVal("five");
+    assert(AST_BindParams(e0->params, names, values, 1, &reason) == AST_VALID);
+    assert(strcmp(e0->ast->whereNode->filters->pn.constVal.stringval, "five") == 0);
+    SIValue_Free(&values[0]);
+
+    /* Least recently used entry is evicted. */
+    PlanCache_Insert(cache, q1, _parse(q1));
+    assert(PlanCache_Lookup(cache, q0) == e0);
+    PlanCache_Insert(cache, q2, NULL);
+    assert(raxSize(cache->entries) == 2);
+    assert(PlanCache_Lookup(cache, q1) == NULL);
+    assert(PlanCache_Lookup(cache, q0) == e0);
+
+    /* Uncacheable queries count as misses. */
+    uint64_t misses = cache->misses;
+    PlanCacheEntry *e2 = PlanCache_Lookup(cache, q2);
+    assert(e2 != NULL && e2->ast == NULL);
+    assert(cache->misses == misses + 1);
+
+    /* Schema changes invalidate entries. */
+    e0->schema_version--;
+    assert(PlanCache_Lookup(cache, q0) == NULL);
+    assert(raxSize(cache->entries) == 1);
+
+    PlanCache_Free(cache);
+}
+
+int main(int argc, char **argv) {
+    test_normalize();
+    test_plan_cache();
+    printf("test_plan_cache - PASS!\n");
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <string.h>
+#include "assert.h"
+#include "../../src/graph/graph.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/resultset/resultset.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_produce_results.h"
+
+/* Scan binding node a to each of a fixed list of nodes. */
+typedef struct {
+    OpBase op;
+    Node **a;
+    Node *_a;
+    Node **nodes;
+    int count;
+    int position;
+} ListScan;
+
+OpResult ListScanConsume(OpBase *opBase, Graph *graph) {
+    ListScan *op = (ListScan*)opBase;
+    if(op->position == op->count) return OP_DEPLETED;
+    *op->a = op->nodes[op->position++];
+    return OP_OK;
+}
+
+OpResult ListScanReset(OpBase *opBase) {
+    ListScan *op = (ListScan*)opBase;
+    op->position = 0;
+    *op->a = op->_a;
+    return OP_OK;
+}
+
+void ListScanFree(OpBase *opBase) {
+    free(opBase);
+}
+
+OpBase* NewListScan(Graph *g, Node **nodes, int count) {
+    ListScan *op = calloc(1, sizeof(ListScan));
+    op->a = (Node**)Graph_GetEntityRef(g, "a");
+    op->_a = *op->a;
+    op->nodes = nodes;
+    op->count = count;
+    op->op.name = "List Scan";
+    op->op.consume = ListScanConsume;
+    op->op.reset = ListScanReset;
+    op->op.free = ListScanFree;
+    return (OpBase*)op;
+}
+
+Node* _node(long int id, const char *name, double v) {
+    Node *n = NewNode(id, NULL);
+    char *keys[2] = {"name", "v"};
+    SIValue vals[2] = {SI_StringVal((char*)name), SI_DoubleVal(v)};
+    Node_Add_Properties(n, 2, keys, vals);
+    return n;
+}
+
+void _validate_record(Record *r, void *udata) {
+    int *seen = (int*)udata;
+    assert(r->entities == NULL);
+    if(r->values[1].doubleval == 1) assert(strcmp(r->values[0].stringval, "one") == 0);
+    else if(r->values[1].doubleval == 2) assert(strcmp(r->values[0].stringval, "two") == 0);
+    else assert(0);
+    (*seen)++;
+}
+
+/* Return elements which aren't sorted by are evaluated only for the top records. */
+void test_produce_results_deferred() {
+    Node *nodes[5] = {_node(1, "four", 4), _node(2, "two", 2), _node(3, "five", 5),
+                      _node(4, "one", 1), _node(5, "three", 3)};
+
+    char *errMsg = NULL;
+    char *query = "MATCH (a) RETURN a.name, a.v ORDER BY a.v LIMIT 2";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    Graph *g = NewGraph();
+    BuildGraph(g, ast->matchNode->graphEntities);
+
+    ResultSet *set = NewResultSet(ast);
+    ProduceResults *produce = NewProduceResults(NULL, ast, set);
+    OpNode *root = NewOpNode((OpBase*)produce);
+    OpNode *scan = NewOpNode(NewListScan(g, nodes, 5));
+    root->children = malloc(sizeof(OpNode*));
+    root->children[0] = scan;
+    root->childCount = 1;
+    scan->parents = malloc(sizeof(OpNode*));
+    scan->parents[0] = root;
+    scan->parentCount = 1;
+
+    ExecutionPlan plan = {.root = root, .graph = g};
+    ExecutionPlan_Execute(&plan);
+
+    /* Only a.name is deferred. */
+    assert(produce->deferred != NULL);
+    assert(produce->deferred[0] == 1 && produce->deferred[1] == 0);
+    assert(produce->ref_count == 1);
+
+    /* Records were materialized against the node each was produced from. */
+    int seen = 0;
+    ResultSet_ForEachRecord(set, _validate_record, &seen);
+    assert(seen == 2);
+
+    /* Materializing leaves a bound to the last node scanned. */
+    assert(*(Node**)Graph_GetEntityRef(g, "a") == nodes[4]);
+}
+
+/* Without a limit every record is kept, nothing is deferred. */
+void test_produce_results_unlimited() {
+    char *errMsg = NULL;
+    char *query = "MATCH (a) RETURN a.name, a.v ORDER BY a.v";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    Graph *g = NewGraph();
+    BuildGraph(g, ast->matchNode->graphEntities);
+
+    ResultSet *set = NewResultSet(ast);
+    ProduceResults *produce = NewProduceResults(NULL, ast, set);
+    assert(ProduceResultsConsume((OpBase*)produce, g) == OP_REFRESH);
+    assert(produce->deferred == NULL);
+    ProduceResultsFree((OpBase*)produce);
+}
+
+int main(int argc, char **argv) {
+    Agg_RegisterFuncs();
+    AR_RegisterFuncs();
+    test_produce_results_deferred();
+    test_produce_results_unlimited();
+    printf("test_produce_results - PASS!\n");
+    return 0;
+}
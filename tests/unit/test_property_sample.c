@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include "assert.h"
+#include "../../src/graph/node.h"
+#include "../../src/parser/grammar.h"
+#include "../../src/stores/property_sample.h"
+
+/* Populates a rax with count persons, every tenth is from "FR", the rest from "US",
+ * age is id modulo 100, persons whose id is a multiple of 7 have no properties. */
+rax* _new_persons(int count) {
+	rax *persons = raxNew();
+	char *keys[2] = {"country", "age"};
+	for(long int id = 0; id < count; id++) {
+		Node *n = NewNode(id, "person");
+		if(id % 7 != 0) {
+			SIValue values[2] = {SI_StringVal((id % 10 == 0) ? "FR" : "US"), SI_LongVal(id % 100)};
+			GraphEntity_Add_Properties((GraphEntity*)n, 2, keys, values);
+		}
+		char key[32];
+		int key_len = sprintf(key, "%ld", id);
+		raxInsert(persons, (unsigned char *)key, key_len, n, NULL);
+	}
+	return persons;
+}
+
+void test_exhaustive_sample() {
+	rax *persons = _new_persons(100);
+	PropertySample *sample = NewPropertySample(persons, "country", 0);
+	assert(sample->count == 100);
+
+	/* 85 persons have a country, 8 of which are from "FR" (ids 10..90 but 70). */
+	SIValue fr = SI_StringVal("fr");
+	assert(PropertySample_Selectivity(sample, EQ, &fr) == 0.08);
+	assert(PropertySample_Selectivity(sample, NE, &fr) == 0.77);
+	SIValue prefix = SI_StringVal("U");
+	assert(PropertySample_Selectivity(sample, STARTS, &prefix) == 0.77);
+
+	/* No person is from "UK", estimate is positive nevertheless. */
+	SIValue uk = SI_StringVal("UK");
+	double selectivity = PropertySample_Selectivity(sample, EQ, &uk);
+	assert(selectivity > 0 && selectivity < 0.01);
+
+	/* Mismatching types never match. */
+	SIValue number = SI_LongVal(1);
+	assert(PropertySample_Selectivity(sample, EQ, &number) < 0.01);
+	PropertySample_Free(sample);
+
+	sample = NewPropertySample(persons, "age", 0);
+	SIValue fifty = SI_DoubleVal(50);
+	/* Ids 0..49 less the 8 multiples of 7 among them. */
+	assert(PropertySample_Selectivity(sample, LT, &fifty) == 0.42);
+
+	/* Stale once enough writes were made. */
+	assert(!PropertySample_Stale(sample, PROPERTY_SAMPLE_REFRESH_MIN - 1, 100));
+	assert(PropertySample_Stale(sample, PROPERTY_SAMPLE_REFRESH_MIN, 100));
+	assert(!PropertySample_Stale(sample, PROPERTY_SAMPLE_REFRESH_MIN, 100000));
+	PropertySample_Free(sample);
+
+	SIValue_Free(&fr);
+	SIValue_Free(&prefix);
+	SIValue_Free(&uk);
+	raxFree(persons);
+}
+
+void test_random_sample() {
+	rax *persons = _new_persons(10000);
+	PropertySample *sample = NewPropertySample(persons, "country", 0);
+	assert(sample->count == PROPERTY_SAMPLE_SIZE);
+
+	/* Roughly 9% of persons are from "FR", 77% from "US". */
+	SIValue fr = SI_StringVal("FR");
+	SIValue us = SI_StringVal("US");
+	double fr_selectivity = PropertySample_Selectivity(sample, EQ, &fr);
+	double us_selectivity = PropertySample_Selectivity(sample, EQ, &us);
+	assert(fr_selectivity > 0.01 && fr_selectivity < 0.3);
+	assert(us_selectivity > 0.6 && us_selectivity < 0.95);
+
+	SIValue_Free(&fr);
+	SIValue_Free(&us);
+	PropertySample_Free(sample);
+	raxFree(persons);
+}
+
+int main(int argc, char **argv) {
+	test_exhaustive_sample();
+	test_random_sample();
+	printf("test_property_sample - PASS!\n");
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <string.h>
+#include "assert.h"
+#include "../../src/parser/ast.h"
+#include "../../src/query_executor.h"
+#include "../../src/execution_plan/execution_plan.h"
+
+/* Patterns which may match an entity more or less than once
+ * aren't counted off a store, the store is never looked up. */
+void test_count_store_rejected() {
+    char *errMsg = NULL;
+    LabelStore *store = NULL;
+    char *queries[] = {
+        // Self loop.
+        "MATCH (a)-[r:knows]->(a) RETURN count(r)",
+        // Labeled endpoints.
+        "MATCH (a:person)-[r]->(b) RETURN count(r)",
+        "MATCH (a)-[r:knows]->(b:person) RETURN count(r)",
+        // Constrained entities.
+        "MATCH (n:person {name:'a'}) RETURN count(n)",
+        "MATCH (a)-[r:knows {since:1}]->(b) RETURN count(r)",
+        "MATCH (n:person) WHERE n.age > 1 RETURN count(n)",
+        // Longer patterns.
+        "MATCH (a)-[r:knows]->(b)-[:knows]->(c) RETURN count(r)",
+        "MATCH (a), (b) RETURN count(a)",
+        // Other return clauses.
+        "MATCH (n:person) RETURN count(n.name)",
+        "MATCH (n:person) RETURN n.name, count(n)",
+        "MATCH (n:person) RETURN sum(n)",
+    };
+
+    for(int i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+        AST_QueryExpressionNode *ast = ParseQuery(queries[i], strlen(queries[i]), &errMsg);
+        assert(ast != NULL);
+        assert(_ExecutionPlan_CountStore(NULL, "g", ast, &store) == 0);
+        Free_AST_QueryExpressionNode(ast);
+    }
+
+    // Undirected patterns match each edge twice.
+    char *query = "MATCH (a)-[r:knows]->(b) RETURN count(r)";
+    AST_QueryExpressionNode *ast = ParseQuery(query, strlen(query), &errMsg);
+    assert(ast != NULL);
+    AST_LinkEntity *link;
+    Vector_Get(ast->matchNode->graphEntities, 1, &link);
+    link->direction = N_DIR_UNKNOWN;
+    assert(_ExecutionPlan_CountStore(NULL, "g", ast, &store) == 0);
+    Free_AST_QueryExpressionNode(ast);
+    assert(store == NULL);
+}
+
+int main(int argc, char **argv) {
+    test_count_store_rejected();
+    printf("test_statistics_count - PASS!\n");
+    return 0;
+}
@@ -28,8 +28,25 @@ void test_value_parse() {
     assert(strcmp(v.stringval, "Test!") == 0);
 }
 
+void test_string_concat() {
+    SIValue values[2] = {SI_StringVal("a"), SI_DoubleVal(1)};
+    char *buf = NULL;
+    size_t cap = 0;
+
+    size_t len = SIValue_StringConcatBuffer(values, 2, &buf, &cap);
+    assert(len == strlen("a,1.000000") && strcmp(buf, "a,1.000000") == 0);
+
+    /* Nothing to concatenate. */
+    len = SIValue_StringConcatBuffer(values, 0, &buf, &cap);
+    assert(len == 0 && buf[0] == '\0');
+
+    free(buf);
+    SIValue_Free(&values[0]);
+}
+
 int main(int argc, char **argv) {
     test_value_parse();
+    test_string_concat();
     printf("test_value - PASS!\n");
     return 0;
 }
\ No newline at end of file